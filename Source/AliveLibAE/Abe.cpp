@@ -53,6 +53,7 @@
 #include "Bullet.hpp"
 #include "Spark.hpp"
 #include "TestAnimation.hpp"
+#include "ObjectTypeIndex.hpp"
 
 using TAbeStateFunction = decltype(&Abe::State_0_Idle_44EEB0);
 
@@ -1963,25 +1964,17 @@ int Abe::vGetSaveState_457110(BYTE* pSaveBuffer)
 
     if (field_114_flags.Get(Flags_114::e114_Bit11_Electrocuting))
     {
-        for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+        ObjectsOfType<BaseGameObject> electrocutes(gBaseGameObject_list_BB47C4, Types::eElectrocute_150);
+        while (BaseGameObject* pObj = electrocutes.Next())
         {
-            auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-            if (!pObj)
+            auto pElectrocute = static_cast<const Electrocute*>(pObj);
+            if (pElectrocute->field_20_target_obj_id == field_8_object_id)
             {
+                pSaveState->field_1e_r = pElectrocute->field_24_r;
+                pSaveState->field_20_g = pElectrocute->field_26_g;
+                pSaveState->field_22_b = pElectrocute->field_28_b;
                 break;
             }
-
-            if (pObj->field_4_typeId == Types::eElectrocute_150)
-            {
-                auto pElectrocute = static_cast<const Electrocute*>(pObj);
-                if (pElectrocute->field_20_target_obj_id == field_8_object_id)
-                {
-                    pSaveState->field_1e_r = pElectrocute->field_24_r;
-                    pSaveState->field_20_g = pElectrocute->field_26_g;
-                    pSaveState->field_22_b = pElectrocute->field_28_b;
-                    break;
-                }
-            }
         }
     }
 
@@ -3325,15 +3318,10 @@ void Abe::State_0_Idle_44EEB0()
             case TlvTypes::WorkWheel_79:
             {
                 bool bCanUseWheel = true;
-                for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+                ObjectsOfType<BaseAliveGameObject> mudokons(gBaseAliveGameObjects_5C1B7C, Types::eMudokon_110);
+                while (BaseAliveGameObject* pObj = mudokons.Next())
                 {
-                    BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                    if (!pObj)
-                    {
-                        break;
-                    }
-
-                    if (pObj->field_4_typeId == Types::eMudokon_110 && pObj->field_D6_scale == field_D6_scale)
+                    if (pObj->field_D6_scale == field_D6_scale)
                     {
                         FP xDiff = pObj->field_B8_xpos - field_B8_xpos;
                         if (xDiff < FP_FromInteger(0))
@@ -7666,22 +7654,14 @@ void Abe::State_112_Chant_45B1C0()
                 if (field_1AC_flags.Get(Flags_1AC::e1AC_eBit15_have_healing))
                 {
                     bool bAliveMudIsInSameScreen = false;
-                    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+                    ObjectsOfType<BaseAliveGameObject> mudokons(gBaseAliveGameObjects_5C1B7C, Types::eMudokon_110);
+                    while (BaseAliveGameObject* pObjIter = mudokons.Next())
                     {
-                        BaseAliveGameObject* pObjIter = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                        if (!pObjIter)
-                        {
-                            break;
-                        }
-
-                        if (pObjIter->field_4_typeId == Types::eMudokon_110)
+                        if (pObjIter->field_114_flags.Get(Flags_114::e114_Bit3_Can_Be_Possessed)) // TODO: Is sick flag ?
                         {
-                            if (pObjIter->field_114_flags.Get(Flags_114::e114_Bit3_Can_Be_Possessed)) // TODO: Is sick flag ?
+                            if (pObjIter->Is_In_Current_Camera_424A70() == CameraPos::eCamCurrent_0 && pObjIter->field_10C_health > FP_FromInteger(0))
                             {
-                                if (pObjIter->Is_In_Current_Camera_424A70() == CameraPos::eCamCurrent_0 && pObjIter->field_10C_health > FP_FromInteger(0))
-                                {
-                                    bAliveMudIsInSameScreen = true;
-                                }
+                                bAliveMudIsInSameScreen = true;
                             }
                         }
                     }
@@ -8190,24 +8170,16 @@ void Abe::State_115_DoorExit_459A40()
                 field_BC_ypos - FP_FromInteger(5));
 
             // Yes, so find it
-            for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            ObjectsOfType<BaseGameObject> doors(gBaseGameObject_list_BB47C4, Types::eDoor_33);
+            while (BaseGameObject* pObj = doors.Next())
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
+                Door* pDoor = static_cast<Door*>(pObj);
+                if (pDoor->field_FA_door_number == field_1A0_door_id)
                 {
+                    // And close it
+                    pDoor->vClose_41EB50();
                     break;
                 }
-
-                if (pObj->field_4_typeId == Types::eDoor_33)
-                {
-                    Door* pDoor = static_cast<Door*>(pObj);
-                    if (pDoor->field_FA_door_number == field_1A0_door_id)
-                    {
-                        // And close it
-                        pDoor->vClose_41EB50();
-                        break;
-                    }
-                }
             }
         }
 
@@ -8803,22 +8775,14 @@ __int16 Abe::TryEnterMineCar_4569E0()
 
 int Abe::NearDoorIsOpen_44EE10()
 {
-    for (int i =0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> doors(gBaseGameObject_list_BB47C4, Types::eDoor_33);
+    while (BaseGameObject* pObj = doors.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
+        auto pDoor = static_cast<Door*>(pObj);
+        if (FP_Abs(field_B8_xpos - pDoor->field_B8_xpos) < FP_FromInteger(15) &&
+            FP_Abs(field_BC_ypos - pDoor->field_BC_ypos) < FP_FromInteger(20))
         {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eDoor_33)
-        {
-            auto pDoor = static_cast<Door*>(pObj);
-            if (FP_Abs(field_B8_xpos - pDoor->field_B8_xpos) < FP_FromInteger(15) &&
-                FP_Abs(field_BC_ypos - pDoor->field_BC_ypos) < FP_FromInteger(20))
-            {
-                return pDoor->vIsOpen_41EB00();
-            }
+            return pDoor->vIsOpen_41EB00();
         }
     }
     // We didn't find a door - so for some reason that makes no sense return that it is open...
@@ -9702,34 +9666,25 @@ void Abe::GiveControlBackToMe_44BA10()
 
 PullRingRope* Abe::GetPullRope_44D120()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> pullRopes(gBaseGameObject_list_BB47C4, Types::ePullRope_103);
+    while (BaseGameObject* pObj = pullRopes.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
+        // Is it on the same scale as us?
+        PullRingRope* pRope = static_cast<PullRingRope*>(pObj);
+        if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
         {
-            break;
-        }
+            PSX_RECT bRect = {};
+            pRope->vGetBoundingRect_424FD0(&bRect, 1);
 
-        // Find a rope.
-        if (pObj->field_4_typeId == Types::ePullRope_103)
-        {
-            // Is it on the same scale as us?
-            PullRingRope* pRope = static_cast<PullRingRope*>(pObj);
-            if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
+            // Check we are near its ypos.
+            if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(75))) <= pRope->field_BC_ypos &&
+                field_BC_ypos > pRope->field_BC_ypos)
             {
-                PSX_RECT bRect = {};
-                pRope->vGetBoundingRect_424FD0(&bRect, 1);
-
-                // Check we are near its ypos.
-                if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(75))) <= pRope->field_BC_ypos &&
-                    field_BC_ypos > pRope->field_BC_ypos)
+                // Check we are near its xpos.
+                if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
                 {
-                    // Check we are near its xpos.
-                    if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
-                    {
-                        // Found a rope we can pull.
-                        return pRope;
-                    }
+                    // Found a rope we can pull.
+                    return pRope;
                 }
             }
         }
@@ -9975,31 +9930,23 @@ __int16 Abe::GetEvilFart_4585F0(__int16 bDontLoad)
     vGetBoundingRect_424FD0(&abeRect, 1);
 
     FartMachine* pBrewMachine = nullptr;
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> brewMachines(gBaseGameObject_list_BB47C4, Types::eBrewMachine_13);
+    while (BaseGameObject* pObj = brewMachines.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            return 0;
-        }
-
-        if (pObj->field_4_typeId == Types::eBrewMachine_13)
-        {
-            pBrewMachine = static_cast<FartMachine*>(pObj);
-
-            PSX_RECT bRect = {};
-            pBrewMachine->vGetBoundingRect_424FD0(&bRect, 1);
+        pBrewMachine = static_cast<FartMachine*>(pObj);
 
-            if (RectsOverlap(abeRect, bRect) &&
-                pBrewMachine->field_CC_sprite_scale == field_CC_sprite_scale &&
-                pBrewMachine->field_144_total_brew_count > 0 &&
-                field_198_has_evil_fart == FALSE)
-            {
-                break;
-            }
+        PSX_RECT bRect = {};
+        pBrewMachine->vGetBoundingRect_424FD0(&bRect, 1);
 
-            pBrewMachine = nullptr;
+        if (RectsOverlap(abeRect, bRect) &&
+            pBrewMachine->field_CC_sprite_scale == field_CC_sprite_scale &&
+            pBrewMachine->field_144_total_brew_count > 0 &&
+            field_198_has_evil_fart == FALSE)
+        {
+            break;
         }
+
+        pBrewMachine = nullptr;
     }
 
     if (!pBrewMachine)
@@ -11,6 +11,7 @@
 #include "ObjectIds.hpp"
 #include "PossessionFlicker.hpp"
 #include "stdlib.hpp"
+#include "ObjectTypeIndex.hpp"
 
 AbilityRing * CC AbilityRing::Factory_482F80(FP xpos, FP ypos, RingTypes type, FP scale)
 {
@@ -585,23 +586,15 @@ void AbilityRing::vScreenChanged_49DE70()
 {
     if (field_284_ring_type == RingTypes::eHealing_Emit_12)
     {
-        for (int i=0; i<gBaseAliveGameObjects_5C1B7C->Size(); i++)
+        ObjectsOfType<BaseAliveGameObject> mudokons(gBaseAliveGameObjects_5C1B7C, Types::eMudokon_110);
+        while (BaseAliveGameObject* pObj = mudokons.Next())
         {
-            BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-            if (!pObj)
+            if (pObj->field_114_flags.Get(Flags_114::e114_Bit3_Can_Be_Possessed))
             {
-                break;
-            }
-
-            if (pObj->field_4_typeId == Types::eMudokon_110)
-            {
-                if (pObj->field_114_flags.Get(Flags_114::e114_Bit3_Can_Be_Possessed))
+                // Only heal alive muds in the same screen
+                if (pObj->Is_In_Current_Camera_424A70() == CameraPos::eCamCurrent_0 && pObj->field_10C_health > FP_FromInteger(0))
                 {
-                    // Only heal alive muds in the same screen
-                    if (pObj->Is_In_Current_Camera_424A70() == CameraPos::eCamCurrent_0 && pObj->field_10C_health > FP_FromInteger(0))
-                    {
-                        pObj->VPossessed_408F70();
-                    }
+                    pObj->VPossessed_408F70();
                 }
             }
         }
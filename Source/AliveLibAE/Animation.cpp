@@ -18,6 +18,7 @@
 #include "Blood.hpp"
 #include "ObjectIds.hpp"
 #include "Sys_common.hpp"
+#include "AnimationFrameCache.hpp"
 
 // Frame call backs ??
 EXPORT int CC Animation_OnFrame_Common_Null_455F40(void*, signed __int16*)
@@ -280,6 +281,46 @@ bool Animation::EnsureDecompressionBuffer()
     return field_24_dbuf != nullptr;
 }
 
+template<typename TDecodeFn>
+void Animation::LoadFrameToVRam(const PSX_RECT& vram_rect, DWORD frameHeaderOffset, bool bCompressed, TDecodeFn fnDecode)
+{
+    // Only frames in the resource heap are cached as it tells the cache when a resource is freed
+    AnimationFrameCache* pCache = ResourceManager::Is_Heap_Handle(field_20_ppBlock) ? AnimFrameCache_Get() : nullptr;
+    if (!pCache)
+    {
+        if (const BYTE* pPixels = fnDecode())
+        {
+            PSX_LoadImage_4F5FB0(&vram_rect, pPixels);
+        }
+        return;
+    }
+
+    if (pCache->IsInVRam(vram_rect, field_20_ppBlock, frameHeaderOffset))
+    {
+        return;
+    }
+
+    // Exactly what PSX_LoadImage_4F5FB0 reads, the width is the clamped one so this can be less than what was decoded
+    const DWORD sizeInBytes = vram_rect.w * vram_rect.h * sizeof(WORD);
+    const BYTE* pPixels = bCompressed ? pCache->Find(field_20_ppBlock, frameHeaderOffset, sizeInBytes) : nullptr;
+    if (!pPixels)
+    {
+        pPixels = fnDecode();
+        if (!pPixels)
+        {
+            return;
+        }
+
+        if (bCompressed)
+        {
+            pCache->Insert(field_20_ppBlock, frameHeaderOffset, pPixels, sizeInBytes);
+        }
+    }
+
+    PSX_LoadImage_4F5FB0(&vram_rect, pPixels);
+    pCache->OnLoadedToVRam(vram_rect, field_20_ppBlock, frameHeaderOffset);
+}
+
 void Animation::DecompressFrame()
 {
     if (field_4_flags.Get(AnimFlags::eBit11_bToggle_Bit10))
@@ -338,12 +379,17 @@ void Animation::DecompressFrame()
         vram_rect.h = field_84_vram_rect.h;
     }
 
+    const DWORD frameHeaderOffset = pFrameInfo->field_0_frame_header_offset;
+
     switch (pFrameHeader->field_7_compression_type)
     {
     case 0:
         // No compression, load the data directly into frame buffer
         field_4_flags.Set(AnimFlags::eBit25_bDecompressDone);
-        PSX_LoadImage_4F5FB0(&vram_rect, reinterpret_cast<const BYTE*>(&pFrameHeader->field_8_width2)); // TODO: Refactor structure to get pixel data
+        LoadFrameToVRam(vram_rect, frameHeaderOffset, false, [&]()
+        {
+            return reinterpret_cast<const BYTE*>(&pFrameHeader->field_8_width2); // TODO: Refactor structure to get pixel data
+        });
         break;
 
     case 1:
@@ -353,49 +399,68 @@ void Animation::DecompressFrame()
 
     case 2:
         field_4_flags.Set(AnimFlags::eBit25_bDecompressDone);
-        if (EnsureDecompressionBuffer())
+        LoadFrameToVRam(vram_rect, frameHeaderOffset, true, [&]() -> const BYTE*
         {
+            if (!EnsureDecompressionBuffer())
+            {
+                return nullptr;
+            }
+
             // TODO: Refactor structure to get pixel data.
             CompressionType2_Decompress_40AA50(
                 reinterpret_cast<const BYTE*>(&pFrameHeader[1]),
                 *field_24_dbuf,
                 width_bpp_adjusted * pFrameHeader->field_5_height * 2);
-
-            PSX_LoadImage_4F5FB0(&vram_rect, *field_24_dbuf);
-        }
+            return *field_24_dbuf;
+        });
         break;
 
     case 3:
         if (field_4_flags.Get(AnimFlags::eBit25_bDecompressDone))
         {
-            if (EnsureDecompressionBuffer())
+            LoadFrameToVRam(vram_rect, frameHeaderOffset, true, [&]() -> const BYTE*
             {
+                if (!EnsureDecompressionBuffer())
+                {
+                    return nullptr;
+                }
+
                 // TODO: Refactor structure to get pixel data.
                 CompressionType_3Ae_Decompress_40A6A0(reinterpret_cast<const BYTE*>(&pFrameHeader->field_8_width2), *field_24_dbuf);
-                PSX_LoadImage_4F5FB0(&vram_rect, *field_24_dbuf);
-            }
+                return *field_24_dbuf;
+            });
         }
         break;
 
     case 4:
     case 5:
-        if (EnsureDecompressionBuffer())
+        LoadFrameToVRam(vram_rect, frameHeaderOffset, true, [&]() -> const BYTE*
         {
+            if (!EnsureDecompressionBuffer())
+            {
+                return nullptr;
+            }
+
             // TODO: Refactor structure to get pixel data.
             CompressionType_4Or5_Decompress_4ABAB0(reinterpret_cast<const BYTE*>(&pFrameHeader->field_8_width2), *field_24_dbuf);
-            PSX_LoadImage_4F5FB0(&vram_rect, *field_24_dbuf);
-        }
+            return *field_24_dbuf;
+        });
         break;
 
     case 6:
         if (field_4_flags.Get(AnimFlags::eBit25_bDecompressDone))
         {
-            if (EnsureDecompressionBuffer())
+            LoadFrameToVRam(vram_rect, frameHeaderOffset, true, [&]() -> const BYTE*
             {
+                if (!EnsureDecompressionBuffer())
+                {
+                    return nullptr;
+                }
+
                 // TODO: Refactor structure to get pixel data.
                 CompressionType6Ae_Decompress_40A8A0(reinterpret_cast<const BYTE*>(&pFrameHeader->field_8_width2), *field_24_dbuf);
-                PSX_LoadImage_4F5FB0(&vram_rect, *field_24_dbuf);
-            }
+                return *field_24_dbuf;
+            });
         }
         break;
 
@@ -108,6 +108,10 @@ public:
     bool EnsureDecompressionBuffer();
     void DecompressFrame();
 
+    // fnDecode returns the frame's pixels or nullptr if they couldn't be decoded, it isn't called when the frame cache has them.
+    template<typename TDecodeFn>
+    void LoadFrameToVRam(const PSX_RECT& vram_rect, DWORD frameHeaderOffset, bool bCompressed, TDecodeFn fnDecode);
+
     EXPORT virtual void vRender_40B820(int xpos, int ypos, PrimHeader** ppOt, __int16 width, signed int height) override;
     EXPORT virtual void vCleanUp_40C630() override;
 
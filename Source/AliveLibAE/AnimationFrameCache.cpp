@@ -0,0 +1,288 @@
+#include "stdafx.h"
+#include "AnimationFrameCache.hpp"
+#include "Function.hpp"
+#include "VRam.hpp"
+#include <memory>
+
+int gAnimFrameCacheBudgetKb = 4096;
+
+AnimationFrameCache::AnimationFrameCache(size_t budgetBytes)
+    : mBudgetBytes(budgetBytes)
+{
+
+}
+
+void AnimationFrameCache::SetBudget(size_t budgetBytes)
+{
+    mBudgetBytes = budgetBytes;
+    EvictToFit(0);
+}
+
+const BYTE* AnimationFrameCache::Find(BYTE** ppBlock, DWORD frameHeaderOffset, DWORD sizeInBytes)
+{
+    auto it = mLookUp.find({ ppBlock, frameHeaderOffset });
+    if (it == mLookUp.end() || it->second->mPixels.size() != sizeInBytes)
+    {
+        // Not cached or was loaded in to a different sized VRAM rect
+        mStats.mMisses++;
+        return nullptr;
+    }
+
+    mStats.mHits++;
+    mEntries.splice(mEntries.begin(), mEntries, it->second);
+    return mEntries.front().mPixels.data();
+}
+
+const BYTE* AnimationFrameCache::Insert(BYTE** ppBlock, DWORD frameHeaderOffset, const BYTE* pPixels, DWORD sizeInBytes)
+{
+    const Key key = { ppBlock, frameHeaderOffset };
+    auto existing = mLookUp.find(key);
+    if (existing != mLookUp.end())
+    {
+        Evict(existing->second);
+    }
+
+    if (sizeInBytes == 0 || sizeInBytes > mBudgetBytes)
+    {
+        return nullptr;
+    }
+
+    EvictToFit(sizeInBytes);
+
+    mEntries.push_front({ key, std::vector<BYTE>(pPixels, pPixels + sizeInBytes) });
+    mLookUp[key] = mEntries.begin();
+    mStats.mBytesUsed += sizeInBytes;
+    return mEntries.front().mPixels.data();
+}
+
+void AnimationFrameCache::ForgetHandle(BYTE** ppBlock)
+{
+    auto it = mLookUp.lower_bound({ ppBlock, 0 });
+    while (it != mLookUp.end() && it->first.mppBlock == ppBlock)
+    {
+        mStats.mBytesUsed -= it->second->mPixels.size();
+        mEntries.erase(it->second);
+        it = mLookUp.erase(it);
+    }
+
+    for (size_t i = 0; i < mVRamFrames.size();)
+    {
+        if (mVRamFrames[i].mKey.mppBlock == ppBlock)
+        {
+            mVRamFrames[i] = mVRamFrames.back();
+            mVRamFrames.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void AnimationFrameCache::ForgetBlock(const BYTE* pBlock)
+{
+    // Handles are still live until they are forgotten so they are safe to look through
+    auto it = mLookUp.begin();
+    while (it != mLookUp.end())
+    {
+        BYTE** ppBlock = it->first.mppBlock;
+        if (*ppBlock == pBlock)
+        {
+            ForgetHandle(ppBlock);
+            return;
+        }
+        it = mLookUp.lower_bound({ ppBlock + 1, 0 });
+    }
+
+    for (const VRamFrame& frame : mVRamFrames)
+    {
+        if (*frame.mKey.mppBlock == pBlock)
+        {
+            ForgetHandle(frame.mKey.mppBlock);
+            return;
+        }
+    }
+}
+
+void AnimationFrameCache::Clear()
+{
+    mEntries.clear();
+    mLookUp.clear();
+    mVRamFrames.clear();
+    mStats.mBytesUsed = 0;
+}
+
+bool AnimationFrameCache::IsInVRam(const PSX_RECT& rect, BYTE** ppBlock, DWORD frameHeaderOffset)
+{
+    for (const VRamFrame& frame : mVRamFrames)
+    {
+        if (frame.mRect.x == rect.x && frame.mRect.y == rect.y && frame.mRect.w == rect.w && frame.mRect.h == rect.h)
+        {
+            if (frame.mKey.mppBlock == ppBlock && frame.mKey.mFrameHeaderOffset == frameHeaderOffset)
+            {
+                mStats.mUploadsSkipped++;
+                return true;
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+void AnimationFrameCache::OnLoadedToVRam(const PSX_RECT& rect, BYTE** ppBlock, DWORD frameHeaderOffset)
+{
+    OnVRamWritten(rect);
+    mVRamFrames.push_back({ rect, { ppBlock, frameHeaderOffset } });
+}
+
+void AnimationFrameCache::OnVRamWritten(const PSX_RECT& rect)
+{
+    for (size_t i = 0; i < mVRamFrames.size();)
+    {
+        if (Vram_rects_overlap_4959E0(&mVRamFrames[i].mRect, &rect))
+        {
+            mVRamFrames[i] = mVRamFrames.back();
+            mVRamFrames.pop_back();
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void AnimationFrameCache::Evict(TEntries::iterator it)
+{
+    mStats.mBytesUsed -= it->mPixels.size();
+    mStats.mEvictions++;
+    mLookUp.erase(it->mKey);
+    mEntries.erase(it);
+}
+
+void AnimationFrameCache::EvictToFit(size_t sizeInBytes)
+{
+    while (!mEntries.empty() && mStats.mBytesUsed + sizeInBytes > mBudgetBytes)
+    {
+        Evict(std::prev(mEntries.end()));
+    }
+}
+
+AnimationFrameCache* AnimFrameCache_Get()
+{
+    static std::unique_ptr<AnimationFrameCache> sCache;
+
+    // The game's own code frees resources and writes VRAM without telling the cache
+    if (RunningAsInjectedDll() || gAnimFrameCacheBudgetKb <= 0)
+    {
+        sCache.reset();
+        return nullptr;
+    }
+
+    const size_t budgetBytes = static_cast<size_t>(gAnimFrameCacheBudgetKb) * 1024;
+    if (!sCache)
+    {
+        sCache.reset(new AnimationFrameCache(budgetBytes));
+    }
+    else if (sCache->Budget() != budgetBytes)
+    {
+        sCache->SetBudget(budgetBytes);
+    }
+    return sCache.get();
+}
+
+void AnimFrameCache_OnVRamWritten(const PSX_RECT& rect)
+{
+    if (AnimationFrameCache* pCache = AnimFrameCache_Get())
+    {
+        pCache->OnVRamWritten(rect);
+    }
+}
+
+namespace Test
+{
+    static void Test_LruEviction()
+    {
+        BYTE* blocks[2] = {};
+        const BYTE pixels[4][16] = { { 1 }, { 2 }, { 3 }, { 4 } };
+
+        AnimationFrameCache cache(48);
+        ASSERT_EQ(nullptr, cache.Find(&blocks[0], 0, 16));
+        ASSERT_NE(nullptr, cache.Insert(&blocks[0], 0, pixels[0], 16));
+        ASSERT_NE(nullptr, cache.Insert(&blocks[0], 8, pixels[1], 16));
+        ASSERT_NE(nullptr, cache.Insert(&blocks[1], 0, pixels[2], 16));
+
+        // Touch the oldest so the next insert evicts block 0 offset 8 instead
+        const BYTE* pHit = cache.Find(&blocks[0], 0, 16);
+        ASSERT_NE(nullptr, pHit);
+        ASSERT_EQ(1, pHit[0]);
+
+        ASSERT_NE(nullptr, cache.Insert(&blocks[1], 8, pixels[3], 16));
+        ASSERT_EQ(nullptr, cache.Find(&blocks[0], 8, 16));
+        ASSERT_NE(nullptr, cache.Find(&blocks[0], 0, 16));
+        ASSERT_EQ(4, cache.Find(&blocks[1], 8, 16)[0]);
+
+        // Wrong size is a miss
+        ASSERT_EQ(nullptr, cache.Find(&blocks[1], 8, 8));
+
+        ASSERT_EQ(48u, cache.Stats().mBytesUsed);
+        ASSERT_EQ(1u, cache.Stats().mEvictions);
+
+        // Too big to ever fit
+        ASSERT_EQ(nullptr, cache.Insert(&blocks[0], 16, pixels[0], 64));
+
+        cache.SetBudget(16);
+        ASSERT_EQ(16u, cache.Stats().mBytesUsed);
+    }
+
+    static void Test_Forget()
+    {
+        BYTE data[2] = {};
+        BYTE* blocks[2] = { &data[0], &data[1] };
+        const BYTE pixels[16] = {};
+
+        AnimationFrameCache cache(1024);
+        cache.Insert(&blocks[0], 0, pixels, 16);
+        cache.Insert(&blocks[0], 4, pixels, 16);
+        cache.Insert(&blocks[1], 0, pixels, 16);
+
+        cache.ForgetBlock(&data[0]);
+        ASSERT_EQ(nullptr, cache.Find(&blocks[0], 0, 16));
+        ASSERT_EQ(nullptr, cache.Find(&blocks[0], 4, 16));
+        ASSERT_NE(nullptr, cache.Find(&blocks[1], 0, 16));
+
+        cache.ForgetHandle(&blocks[1]);
+        ASSERT_EQ(nullptr, cache.Find(&blocks[1], 0, 16));
+        ASSERT_EQ(0u, cache.Stats().mBytesUsed);
+    }
+
+    static void Test_VRamTracking()
+    {
+        BYTE* blocks[1] = {};
+        AnimationFrameCache cache(1024);
+
+        const PSX_RECT rect = { 512, 256, 16, 32 };
+        ASSERT_FALSE(cache.IsInVRam(rect, &blocks[0], 0));
+
+        cache.OnLoadedToVRam(rect, &blocks[0], 0);
+        ASSERT_TRUE(cache.IsInVRam(rect, &blocks[0], 0));
+        ASSERT_FALSE(cache.IsInVRam(rect, &blocks[0], 4));
+
+        // Something else drew over part of it
+        cache.OnVRamWritten({ 520, 280, 64, 64 });
+        ASSERT_FALSE(cache.IsInVRam(rect, &blocks[0], 0));
+
+        cache.OnLoadedToVRam(rect, &blocks[0], 4);
+        cache.OnVRamWritten({ 0, 0, 64, 64 });
+        ASSERT_TRUE(cache.IsInVRam(rect, &blocks[0], 4));
+
+        cache.ForgetHandle(&blocks[0]);
+        ASSERT_FALSE(cache.IsInVRam(rect, &blocks[0], 4));
+    }
+
+    void AnimationFrameCacheTests()
+    {
+        Test_LruEviction();
+        Test_Forget();
+        Test_VRamTracking();
+    }
+}
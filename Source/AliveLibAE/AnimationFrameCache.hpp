@@ -0,0 +1,111 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "Psx_common.hpp"
+#include <list>
+#include <vector>
+
+namespace Test
+{
+    void AnimationFrameCacheTests();
+}
+
+struct AnimFrameCacheStats
+{
+    unsigned int mHits = 0;
+    unsigned int mMisses = 0;
+    unsigned int mUploadsSkipped = 0; // The VRAM rect already had the frame in it
+    unsigned int mEvictions = 0;
+    size_t mBytesUsed = 0;
+};
+
+// LRU cache of decompressed animation frames keyed by the resource handle and frame header offset, holds the
+// exact bytes that are passed to PSX_LoadImage_4F5FB0 so a repeated frame doesn't need decompressing again.
+// Also remembers which frame was last loaded in to each VRAM rect so loading the same frame twice is skipped.
+class AnimationFrameCache
+{
+public:
+    explicit AnimationFrameCache(size_t budgetBytes);
+
+    // Shrinking the budget evicts frames straight away.
+    void SetBudget(size_t budgetBytes);
+    size_t Budget() const
+    {
+        return mBudgetBytes;
+    }
+
+    // Returns the cached pixels or nullptr if the frame isn't cached at this size.
+    const BYTE* Find(BYTE** ppBlock, DWORD frameHeaderOffset, DWORD sizeInBytes);
+
+    // Copies the pixels in to the cache evicting the least recently used frames to make room.
+    // Returns the cached copy or nullptr if the frame is bigger than the whole budget.
+    const BYTE* Insert(BYTE** ppBlock, DWORD frameHeaderOffset, const BYTE* pPixels, DWORD sizeInBytes);
+
+    // Drops every frame of a resource, must be called before its handle can be reused for something else.
+    void ForgetHandle(BYTE** ppBlock);
+
+    // Same as ForgetHandle for when only the resource data pointer is known.
+    void ForgetBlock(const BYTE* pBlock);
+
+    void Clear();
+
+    // True if the frame was the last thing loaded in to exactly this rect and nothing has written over it since.
+    bool IsInVRam(const PSX_RECT& rect, BYTE** ppBlock, DWORD frameHeaderOffset);
+    void OnLoadedToVRam(const PSX_RECT& rect, BYTE** ppBlock, DWORD frameHeaderOffset);
+
+    // Must be called for anything that writes to VRAM other than loading a frame.
+    void OnVRamWritten(const PSX_RECT& rect);
+
+    const AnimFrameCacheStats& Stats() const
+    {
+        return mStats;
+    }
+
+private:
+    struct Key
+    {
+        BYTE** mppBlock;
+        DWORD mFrameHeaderOffset;
+
+        bool operator < (const Key& rhs) const
+        {
+            if (mppBlock != rhs.mppBlock)
+            {
+                return mppBlock < rhs.mppBlock;
+            }
+            return mFrameHeaderOffset < rhs.mFrameHeaderOffset;
+        }
+    };
+
+    struct Entry
+    {
+        Key mKey;
+        std::vector<BYTE> mPixels;
+    };
+
+    using TEntries = std::list<Entry>;
+
+    struct VRamFrame
+    {
+        PSX_RECT mRect;
+        Key mKey;
+    };
+
+    void Evict(TEntries::iterator it);
+    void EvictToFit(size_t sizeInBytes);
+
+    size_t mBudgetBytes = 0;
+    TEntries mEntries; // Most recently used first
+    std::map<Key, TEntries::iterator> mLookUp;
+    std::vector<VRamFrame> mVRamFrames;
+    AnimFrameCacheStats mStats;
+};
+
+// Returns the cache sized by gAnimFrameCacheBudgetKb, or nullptr when it is turned off.
+AnimationFrameCache* AnimFrameCache_Get();
+
+// Tells the cache (if there is one) that VRAM was written to.
+void AnimFrameCache_OnVRamWritten(const PSX_RECT& rect);
+
+// Memory the decompressed frame cache can use in KB, 0 or less turns it off.
+extern int gAnimFrameCacheBudgetKb;
@@ -15,6 +15,8 @@
 #include "BirdPortal.hpp"
 #include "Events.hpp"
 #include "Sys_common.hpp"
+#include "ObjectGrid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_VAR(1, 0x5C1B7C, DynamicArrayT<BaseAliveGameObject>*, gBaseAliveGameObjects_5C1B7C, nullptr);
 
@@ -79,6 +81,7 @@ EXPORT BaseAliveGameObject* BaseAliveGameObject::ctor_408240(short resourceArray
     field_10A_unused = 0;
 
     gBaseAliveGameObjects_5C1B7C->Push_Back(this);
+    ObjectTypeIndex_OnObjectAdded(gBaseAliveGameObjects_5C1B7C, this);
 
     field_6_flags.Set(BaseGameObject::eIsBaseAliveGameObject_Bit6);
 
@@ -91,6 +94,7 @@ EXPORT void BaseAliveGameObject::dtor_4080B0()
 
     BaseAliveGameObject* pField_110 = static_cast<BaseAliveGameObject*>(sObjectIds_5C1B70.Find_449CF0(field_110_id));
     gBaseAliveGameObjects_5C1B7C->Remove_Item(this);
+    ObjectTypeIndex_OnObjectRemoved(gBaseAliveGameObjects_5C1B7C, this);
 
     if (pField_110)
     {
@@ -428,43 +432,35 @@ void BaseAliveGameObject::vCheckCollisionLineStillValid_408A40(__int16 distance)
 
 BirdPortal* BaseAliveGameObject::vIntoBirdPortal_408FD0(__int16 numGridBlocks)
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> birdPortals(gBaseGameObject_list_BB47C4, Types::eBirdPortal_99);
+    while (BaseGameObject* pObj = birdPortals.Next())
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eBirdPortal_99)
+        auto pBirdPortal = static_cast<BirdPortal*>(pObj);
+        if (pBirdPortal->field_2C_xpos >= field_B8_xpos)
         {
-            auto pBirdPortal = static_cast<BirdPortal*>(pObj);
-            if (pBirdPortal->field_2C_xpos >= field_B8_xpos)
+            if (pBirdPortal->field_26_side == PortalSide::eLeft_1)
             {
-                if (pBirdPortal->field_26_side == PortalSide::eLeft_1)
+                if (pBirdPortal->field_2C_xpos - field_B8_xpos <= (ScaleToGridSize_4498B0(field_CC_sprite_scale) * FP_FromInteger(numGridBlocks)) &&
+                    !(field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX)))
                 {
-                    if (pBirdPortal->field_2C_xpos - field_B8_xpos <= (ScaleToGridSize_4498B0(field_CC_sprite_scale) * FP_FromInteger(numGridBlocks)) &&
-                        !(field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX)))
+                    if (FP_Abs(field_BC_ypos - pBirdPortal->field_3C_YPos) < field_CC_sprite_scale * FP_FromInteger(10) && pBirdPortal->VPortalClipper_499430(1))
                     {
-                        if (FP_Abs(field_BC_ypos - pBirdPortal->field_3C_YPos) < field_CC_sprite_scale * FP_FromInteger(10) && pBirdPortal->VPortalClipper_499430(1))
-                        {
-                            field_20_animation.field_C_render_layer = field_CC_sprite_scale != FP_FromInteger(1) ? Layer::eLayer_11 : Layer::eLayer_30;
-                            return pBirdPortal;
-                        }
+                        field_20_animation.field_C_render_layer = field_CC_sprite_scale != FP_FromInteger(1) ? Layer::eLayer_11 : Layer::eLayer_30;
+                        return pBirdPortal;
                     }
                 }
             }
-            else if (pBirdPortal->field_26_side == PortalSide::eRight_0)
+        }
+        else if (pBirdPortal->field_26_side == PortalSide::eRight_0)
+        {
+            if (field_B8_xpos - pBirdPortal->field_2C_xpos <= ScaleToGridSize_4498B0(field_CC_sprite_scale) * FP_FromInteger(numGridBlocks))
             {
-                if (field_B8_xpos - pBirdPortal->field_2C_xpos <= ScaleToGridSize_4498B0(field_CC_sprite_scale) * FP_FromInteger(numGridBlocks))
+                if (field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX))
                 {
-                    if (field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX))
+                    if (FP_Abs(field_BC_ypos - pBirdPortal->field_3C_YPos) < field_CC_sprite_scale * FP_FromInteger(10) && pBirdPortal->VPortalClipper_499430(1))
                     {
-                        if (FP_Abs(field_BC_ypos - pBirdPortal->field_3C_YPos) < field_CC_sprite_scale * FP_FromInteger(10) && pBirdPortal->VPortalClipper_499430(1))
-                        {
-                            field_20_animation.field_C_render_layer = field_CC_sprite_scale != FP_FromInteger(1) ? Layer::eLayer_11 : Layer::eLayer_30;
-                            return pBirdPortal;
-                        }
+                        field_20_animation.field_C_render_layer = field_CC_sprite_scale != FP_FromInteger(1) ? Layer::eLayer_11 : Layer::eLayer_30;
+                        return pBirdPortal;
                     }
                 }
             }
@@ -737,14 +733,9 @@ BaseGameObject* BaseAliveGameObject::FindObjectOfType_425180(Types typeToFind, F
     const int xposI = FP_GetExponent(xpos);
     const int yposI = FP_GetExponent(ypos);
 
-    for (int i=0; i<gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsNear<BaseGameObject> nearObjs(gBaseGameObject_list_BB47C4, { static_cast<short>(xposI), static_cast<short>(yposI), static_cast<short>(xposI), static_cast<short>(yposI) });
+    while (BaseGameObject* pObj = nearObjs.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
         if (pObj->field_4_typeId == typeToFind && pObj != this)
         {
             auto pCasted = static_cast<BaseAnimatedWithPhysicsGameObject*>(pObj);
@@ -8,6 +8,7 @@
 #include "ScreenManager.hpp"
 #include "ShadowZone.hpp"
 #include "BaseAliveGameObject.hpp"
+#include "ObjectGrid.hpp"
 
 BaseAnimatedWithPhysicsGameObject * BaseAnimatedWithPhysicsGameObject::BaseAnimatedWithPhysicsGameObject_ctor_424930(signed __int16 resourceArraySize)
 {
@@ -494,14 +495,9 @@ void BaseAnimatedWithPhysicsGameObject::OnCollisionWith_424EE0(PSX_Point xy, PSX
 
     //LOG_INFO("X " << xy.field_0_x << " Y " << xy.field_2_y << " W " << wh.field_0_x << " H " << wh.field_2_y);
 
-    for (int i = 0; i < pObjList->Size(); i++)
+    ObjectsNear<BaseGameObject> nearObjs(pObjList, { xy.field_0_x, xy.field_2_y, wh.field_0_x, wh.field_2_y });
+    while (BaseGameObject* pElement = nearObjs.Next())
     {
-        BaseGameObject* pElement = pObjList->ItemAt(i);
-        if (!pElement)
-        {
-            break;
-        }
-
         if (pElement->field_6_flags.Get(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5))
         {
             BaseAnimatedWithPhysicsGameObject* pObj = static_cast<BaseAnimatedWithPhysicsGameObject*>(pElement);
@@ -6,9 +6,23 @@
 #include "Map.hpp"
 #include "QuikSave.hpp"
 #include "ObjectIds.hpp"
+#include "ObjectTypeIndex.hpp"
+#include <algorithm>
+#include <vector>
 
 ALIVE_VAR(1, 0xBB47C4, DynamicArrayT<BaseGameObject>*, gBaseGameObject_list_BB47C4, nullptr);
 
+// field_C_objectId to object sorted by id, objects with the same id stay in list order
+struct TlvIdIndexEntry
+{
+    int mTlvId;
+    BaseGameObject* mpObj;
+};
+static std::vector<TlvIdIndexEntry> sTlvIdIndex;
+static bool sTlvIdIndexDirty = true;
+static DynamicArrayT<BaseGameObject>* sTlvIdIndexList = nullptr;
+static int sTlvIdIndexListSize = 0;
+
 void BaseGameObject::VUpdate()
 {
     // Empty 0x4DC080
@@ -78,12 +92,19 @@ void BaseGameObject::BaseGameObject_ctor_4DBFA0(__int16 bAddToObjectList, signed
         {
             field_6_flags.Set(BaseGameObject::eListAddFailed_Bit1);
         }
+        else
+        {
+            ObjectTypeIndex_OnObjectAdded(gBaseGameObject_list_BB47C4, this);
+        }
     }
 
     field_C_objectId = sAccumulatedObjectCount_5C1BF4;
     field_8_object_id = sAccumulatedObjectCount_5C1BF4;
     const int nextId = sAccumulatedObjectCount_5C1BF4++;
     sObjectIds_5C1B70.Insert_449C10(nextId, this);
+
+    // Derived ctors set field_C_objectId after this, the index isn't rebuilt until the next find
+    sTlvIdIndexDirty = true;
 }
 
 EXPORT void BaseGameObject::BaseGameObject_dtor_4DBEC0()
@@ -100,6 +121,10 @@ EXPORT void BaseGameObject::BaseGameObject_dtor_4DBEC0()
     }
 
     sObjectIds_5C1B70.Remove_449C60(field_8_object_id);
+    sTlvIdIndexDirty = true;
+
+    // Whatever destroyed the object has already taken it off the list
+    ObjectTypeIndex_OnObjectRemoved(gBaseGameObject_list_BB47C4, this);
 
     field_10_resources_array.dtor_40CAD0();
 }
@@ -107,6 +132,98 @@ EXPORT void BaseGameObject::BaseGameObject_dtor_4DBEC0()
 EXPORT int CCSTD BaseGameObject::Find_Flags_4DC170(int objectId)
 {
     if (objectId != -1)
+    {
+        BaseGameObject* pObj = Find_By_TlvId(objectId);
+        if (pObj)
+        {
+            return pObj->field_8_object_id;
+        }
+    }
+    return -1;
+}
+
+static void TlvIdIndex_Rebuild()
+{
+    sTlvIdIndex.clear();
+    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    {
+        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
+        if (!pObj)
+        {
+            break;
+        }
+        sTlvIdIndex.push_back({ pObj->field_C_objectId, pObj });
+    }
+
+    std::stable_sort(sTlvIdIndex.begin(), sTlvIdIndex.end(), [](const TlvIdIndexEntry& lhs, const TlvIdIndexEntry& rhs) {
+        return lhs.mTlvId < rhs.mTlvId;
+    });
+
+    sTlvIdIndexDirty = false;
+    sTlvIdIndexList = gBaseGameObject_list_BB47C4;
+    sTlvIdIndexListSize = gBaseGameObject_list_BB47C4->Size();
+}
+
+static BaseGameObject* TlvIdIndex_Find(int tlvId, const Types* pType)
+{
+    if (sTlvIdIndexDirty || sTlvIdIndexList != gBaseGameObject_list_BB47C4 || sTlvIdIndexListSize != gBaseGameObject_list_BB47C4->Size())
+    {
+        TlvIdIndex_Rebuild();
+    }
+
+    // A second go in case something changed its field_C_objectId since the index was built
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        bool bStale = false;
+        auto it = std::lower_bound(sTlvIdIndex.begin(), sTlvIdIndex.end(), tlvId, [](const TlvIdIndexEntry& entry, int id) {
+            return entry.mTlvId < id;
+        });
+
+        for (; it != sTlvIdIndex.end() && it->mTlvId == tlvId; ++it)
+        {
+            if (it->mpObj->field_C_objectId != tlvId)
+            {
+                bStale = true;
+                break;
+            }
+
+            if (!pType || it->mpObj->field_4_typeId == *pType)
+            {
+                return it->mpObj;
+            }
+        }
+
+        if (!bStale)
+        {
+            break;
+        }
+        TlvIdIndex_Rebuild();
+    }
+    return nullptr;
+}
+
+BaseGameObject* BaseGameObject::Find_By_TlvId(int tlvId)
+{
+    return TlvIdIndex_Find(tlvId, nullptr);
+}
+
+BaseGameObject* BaseGameObject::Find_By_TlvId(int tlvId, Types type)
+{
+    return TlvIdIndex_Find(tlvId, &type);
+}
+
+#include <gmock/gmock.h>
+
+namespace Test
+{
+    class TlvIdTestObject : public BaseGameObject
+    {
+    public:
+        virtual BaseGameObject* VDestructor(signed int) override { return this; }
+    };
+
+    // How Find_Flags_4DC170 and the restore code found objects before the index
+    static BaseGameObject* ScanForTlvId(int tlvId, const Types* pType)
     {
         for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
         {
@@ -116,11 +233,69 @@ EXPORT int CCSTD BaseGameObject::Find_Flags_4DC170(int objectId)
                 break;
             }
 
-            if (pObj->field_C_objectId == objectId)
+            if ((!pType || pObj->field_4_typeId == *pType) && pObj->field_C_objectId == tlvId)
             {
-                return pObj->field_8_object_id;
+                return pObj;
             }
         }
+        return nullptr;
+    }
+
+    static void BaseGameObject_FindByTlvId_Test()
+    {
+        DynamicArrayT<BaseGameObject>* pOldList = gBaseGameObject_list_BB47C4;
+
+        DynamicArrayT<BaseGameObject> list;
+        list.ctor_40CA60(10);
+        gBaseGameObject_list_BB47C4 = &list;
+
+        // Spawners share their tlv id with what they spawned so ids repeat across types
+        const int tlvIds[] = { 10, 20, 10, 30, 20, -1 };
+        const Types types[] = { Types::eSlig_125, Types::eScrab_112, Types::eScrab_112, Types::eSlig_125, Types::eSlig_125, Types::eScrab_112 };
+        TlvIdTestObject objects[ALIVE_COUNTOF(tlvIds)];
+        for (int i = 0; i < ALIVE_COUNTOF(tlvIds); i++)
+        {
+            objects[i].field_4_typeId = types[i];
+            objects[i].field_8_object_id = 100 + i;
+            objects[i].field_C_objectId = tlvIds[i];
+            list.Push_Back(&objects[i]);
+        }
+
+        auto CheckAll = [&]()
+        {
+            for (int tlvId : { -1, 10, 20, 30, 40 })
+            {
+                ASSERT_EQ(ScanForTlvId(tlvId, nullptr), BaseGameObject::Find_By_TlvId(tlvId));
+                for (Types type : { Types::eSlig_125, Types::eScrab_112, Types::eAlarm_1 })
+                {
+                    ASSERT_EQ(ScanForTlvId(tlvId, &type), BaseGameObject::Find_By_TlvId(tlvId, type));
+                }
+            }
+        };
+
+        CheckAll();
+        ASSERT_EQ(101, BaseGameObject::Find_Flags_4DC170(20));
+        ASSERT_EQ(-1, BaseGameObject::Find_Flags_4DC170(-1));
+
+        // Changing an id after the index was built is picked up when the old id is looked for
+        objects[0].field_C_objectId = 40;
+        ASSERT_EQ(&objects[2], BaseGameObject::Find_By_TlvId(10));
+        CheckAll();
+
+        // So is adding to the list
+        TlvIdTestObject extra;
+        extra.field_4_typeId = Types::eScrab_112;
+        extra.field_C_objectId = 30;
+        list.Push_Back(&extra);
+        CheckAll();
+
+        list.dtor_40CAD0();
+        gBaseGameObject_list_BB47C4 = pOldList;
+        sTlvIdIndexDirty = true;
+    }
+
+    void BaseGameObjectTests()
+    {
+        BaseGameObject_FindByTlvId_Test();
     }
-    return -1;
 }
@@ -224,6 +224,12 @@ public:
 
     EXPORT static int CCSTD Find_Flags_4DC170(int objectId);
 
+    // The first object in gBaseGameObject_list_BB47C4 with this field_C_objectId, optionally of a type, or nullptr.
+    // Uses an index that is rebuilt on the next call after an object is made or destroyed, so restoring a quick
+    // save links every saved id without scanning the whole list each time.
+    static BaseGameObject* Find_By_TlvId(int tlvId);
+    static BaseGameObject* Find_By_TlvId(int tlvId, Types type);
+
 protected:
     // Helper to check if a timer has expired
     template<class T>
@@ -250,3 +256,8 @@ ALIVE_ASSERT_SIZEOF(BaseGameObject, 0x20);
 
 
 ALIVE_VAR_EXTERN(DynamicArrayT<BaseGameObject>*, gBaseGameObject_list_BB47C4);
+
+namespace Test
+{
+    void BaseGameObjectTests();
+}
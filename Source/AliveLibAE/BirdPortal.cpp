@@ -22,6 +22,7 @@
 #include "OrbWhirlWind.hpp"
 #include "ScreenClipper.hpp"
 #include "Sys_common.hpp"
+#include "ObjectTypeIndex.hpp"
 
 BaseGameObject* BirdPortal::ctor_497E00(Path_BirdPortal* pTlv, int tlvInfo)
 {
@@ -256,7 +257,7 @@ void BirdPortal::vUpdate_498280()
                     }
                     pParticle->field_DC_bApplyShadows &= ~1u;
                     pParticle->field_20_animation.field_B_render_mode = TPageAbr::eBlend_1;
-                    pParticle->field_4_typeId = Types::eBirdPortalTerminator_100;
+                    ObjectTypeIndex_SetType(pParticle, Types::eBirdPortalTerminator_100);
                     pParticle->field_CC_sprite_scale = field_60_scale;
 
                     if (static_cast<int>(sGnFrame_5C1B84) % 2)
@@ -1153,18 +1154,10 @@ void BirdPortal::CreateDovesAndShrykullNumber_497B50()
 
 void BirdPortal::KillTerminators_499220()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> birdPortalTerminators(gBaseGameObject_list_BB47C4, Types::eBirdPortalTerminator_100);
+    while (BaseGameObject* pObj = birdPortalTerminators.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eBirdPortalTerminator_100)
-        {
-            pObj->field_6_flags.Set(BaseGameObject::eDead_Bit3);
-        }
+        pObj->field_6_flags.Set(BaseGameObject::eDead_Bit3);
     }
 }
 
@@ -1187,24 +1180,16 @@ void BirdPortal::CreateTerminators_497D10()
 
 signed __int16 BirdPortal::GetEvent_499A70()
 {
-    for (int idx = 0; idx < gBaseGameObject_list_BB47C4->Size(); idx++)
+    ObjectsOfType<BaseGameObject> birdPortals(gBaseGameObject_list_BB47C4, Types::eBirdPortal_99);
+    while (BaseGameObject* pObj = birdPortals.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(idx);
-        if (!pObj)
+        if (pObj == this)
         {
-            break;
+            return kEventPortalOpen;
         }
-
-        if (pObj->field_4_typeId == Types::eBirdPortal_99)
+        else
         {
-            if (pObj == this)
-            {
-                return kEventPortalOpen;
-            }
-            else
-            {
-                return kEventUnknown20;
-            }
+            return kEventUnknown20;
         }
     }
     return kEventPortalOpen;
@@ -0,0 +1,673 @@
+#include "stdafx.h"
+#include "CamDecoder.hpp"
+#include "Function.hpp"
+#include "vlctable.hpp"
+#include "ResourceManager.hpp"
+#include "LvlArchive.hpp"
+#include "PathData.hpp"
+#include <array>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <gmock/gmock.h>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CAM_DECODER_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define CAM_DECODER_SSE2 0
+#endif
+
+bool gCameraFastDecode = true;
+
+const int kNumStrips = CamVlcDecoder::kWidth / CamDecoder::kStripWidth;
+const int kBlockSize = 16;
+
+// g_VlcTab is 2048 look ups of 4 shorts, the bits the code takes and then up to 3 symbols ending at a 0 or at
+// 0xFFFF which means a 13 bit literal follows the code.
+struct VlcEntry
+{
+    BYTE mBits;
+    BYTE mCount;
+    bool mEscape;
+    WORD mSymbols[3];
+};
+
+using TVlcEntries = std::array<VlcEntry, 2048>;
+
+static TVlcEntries BuildVlcEntries()
+{
+    TVlcEntries entries = {};
+    for (int i = 0; i < 2048; i++)
+    {
+        VlcEntry& entry = entries[i];
+        entry.mBits = static_cast<BYTE>(Oddlib::g_VlcTab[i * 4]);
+        for (int j = 1; j < 4; j++)
+        {
+            const WORD symbol = Oddlib::g_VlcTab[i * 4 + j];
+            if (symbol == 0)
+            {
+                break;
+            }
+
+            if (symbol == 0xFFFF)
+            {
+                entry.mEscape = true;
+                break;
+            }
+            entry.mSymbols[entry.mCount++] = symbol;
+        }
+    }
+    return entries;
+}
+
+static const TVlcEntries& VlcEntries()
+{
+    static const TVlcEntries sEntries = BuildVlcEntries();
+    return sEntries;
+}
+
+// Where each quad tree level's values start in a block, the 3 root values come first.
+static int LevelBase(int level)
+{
+    static const int kBases[4] = { 3, 12, 48, 192 };
+    return kBases[level];
+}
+
+// The coefficients of a block are stored depth first, 9 for each node (3 for red, green then blue) and then the
+// 4 children top left, top right, bottom left, bottom right. This maps each one to a level at a time layout of
+// [level][channel * 3 + coefficient][node y][node x] so each level is read 4 nodes at a time.
+using TCoefficientOrder = std::array<WORD, CamDecoder::kBlockCoefficients>;
+
+static TCoefficientOrder BuildCoefficientOrder()
+{
+    TCoefficientOrder order = {};
+    int next = 0;
+    order[next++] = 0;
+    order[next++] = 1;
+    order[next++] = 2;
+
+    std::function<void(int, int, int)> fnVisit = [&](int level, int x, int y)
+    {
+        const int nodesPerRow = 1 << level;
+        const int nodeCount = nodesPerRow * nodesPerRow;
+        for (int i = 0; i < 9; i++)
+        {
+            order[next++] = static_cast<WORD>(LevelBase(level) + (i * nodeCount) + (y * nodesPerRow) + x);
+        }
+
+        if (level < 3)
+        {
+            fnVisit(level + 1, x * 2, y * 2);
+            fnVisit(level + 1, (x * 2) + 1, y * 2);
+            fnVisit(level + 1, x * 2, (y * 2) + 1);
+            fnVisit(level + 1, (x * 2) + 1, (y * 2) + 1);
+        }
+    };
+    fnVisit(0, 0, 0);
+    return order;
+}
+
+static const TCoefficientOrder& CoefficientOrder()
+{
+    static const TCoefficientOrder sOrder = BuildCoefficientOrder();
+    return sOrder;
+}
+
+// The low 7 bits of a symbol are a signed value, the rest are the zeros that come before it
+static inline int SymbolValue(WORD symbol)
+{
+    return ((symbol & 0x7F) ^ 0x40) - 0x40;
+}
+
+int CamDecoder::UnpackSymbols(const WORD* pStrip, int wordCount, WORD* pSymbols, int maxSymbols)
+{
+    const TVlcEntries& entries = VlcEntries();
+
+    // The next bits to read are the top of the window, refilling once 48 or less are left always leaves enough
+    // for an 11 bit code and a 13 bit literal. Past the end of the strip reads as zeros.
+    uint64_t window = 0;
+    int bitCount = 0;
+    int wordIdx = 0;
+    int symbolCount = 0;
+    while (symbolCount < maxSymbols)
+    {
+        while (bitCount <= 48)
+        {
+            const uint64_t word = wordIdx < wordCount ? pStrip[wordIdx] : 0;
+            wordIdx++;
+            window |= word << (48 - bitCount);
+            bitCount += 16;
+        }
+
+        const VlcEntry& entry = entries[static_cast<unsigned int>(window >> 53)];
+        window <<= entry.mBits;
+        bitCount -= entry.mBits;
+
+        // Always copying all 3 is cheaper than a branch per symbol
+        pSymbols[symbolCount] = entry.mSymbols[0];
+        pSymbols[symbolCount + 1] = entry.mSymbols[1];
+        pSymbols[symbolCount + 2] = entry.mSymbols[2];
+        symbolCount += entry.mCount;
+
+        if (entry.mEscape)
+        {
+            const WORD literal = static_cast<WORD>(window >> 51);
+            window <<= 13;
+            bitCount -= 13;
+            pSymbols[symbolCount++] = literal;
+            if (literal == 1)
+            {
+                break;
+            }
+        }
+    }
+    return std::min(symbolCount, maxSymbols);
+}
+
+// The inverse of a step of the quad tree for one colour channel of 4 nodes, p is the node's value and b0-b2
+// come from the strip. Gives the values of the 4 children.
+#if CAM_DECODER_SSE2
+struct QuadChildren
+{
+    __m128i mTopLeft;
+    __m128i mTopRight;
+    __m128i mBottomLeft;
+    __m128i mBottomRight;
+};
+
+static inline QuadChildren Unquad_SSE2(__m128i p, __m128i b0, __m128i b1, __m128i b2)
+{
+    const __m128i calc1 = _mm_sub_epi32(b2, _mm_srai_epi32(b0, 1));
+    const __m128i calc2 = _mm_add_epi32(calc1, b0);
+    const __m128i calc3 = _mm_sub_epi32(p, _mm_srai_epi32(b1, 1));
+
+    QuadChildren children;
+    children.mTopLeft = _mm_sub_epi32(calc3, _mm_srai_epi32(calc1, 1));
+    children.mTopRight = _mm_add_epi32(children.mTopLeft, calc1);
+    children.mBottomLeft = _mm_add_epi32(_mm_sub_epi32(calc3, _mm_srai_epi32(calc2, 1)), b1);
+    children.mBottomRight = _mm_add_epi32(children.mBottomLeft, calc2);
+    return children;
+}
+#endif
+
+// Same as Oddlib::BitsLogic
+static inline void Unquad(int p, int b0, int b1, int b2, int* pTop, int* pBottom)
+{
+    const int calc1 = b2 - (b0 >> 1);
+    const int calc2 = calc1 + b0;
+    const int calc3 = p - (b1 >> 1);
+
+    pTop[0] = calc3 - (calc1 >> 1);
+    pTop[1] = pTop[0] + calc1;
+    pBottom[0] = calc3 - (calc2 >> 1) + b1;
+    pBottom[1] = pBottom[0] + calc2;
+}
+
+// Undoes one level of the quad tree for one channel, pNodes is nodesPerRow * nodesPerRow and pChildren is twice
+// as wide and high.
+static void UnquadLevel(const int* pNodes, const int* pCoefficients, int nodesPerRow, int* pChildren)
+{
+    const int nodeCount = nodesPerRow * nodesPerRow;
+    const int* pB0 = pCoefficients;
+    const int* pB1 = pCoefficients + nodeCount;
+    const int* pB2 = pCoefficients + (nodeCount * 2);
+    const int childrenPerRow = nodesPerRow * 2;
+
+    for (int y = 0; y < nodesPerRow; y++)
+    {
+        int* pTop = pChildren + (y * 2 * childrenPerRow);
+        int* pBottom = pTop + childrenPerRow;
+        int x = 0;
+
+#if CAM_DECODER_SSE2
+        for (; x + 4 <= nodesPerRow; x += 4)
+        {
+            const int k = (y * nodesPerRow) + x;
+            const QuadChildren children = Unquad_SSE2(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pNodes + k)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB0 + k)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB1 + k)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(pB2 + k)));
+
+            // Left and right children of each node sit next to each other in the row
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pTop + (x * 2)), _mm_unpacklo_epi32(children.mTopLeft, children.mTopRight));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pTop + (x * 2) + 4), _mm_unpackhi_epi32(children.mTopLeft, children.mTopRight));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pBottom + (x * 2)), _mm_unpacklo_epi32(children.mBottomLeft, children.mBottomRight));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pBottom + (x * 2) + 4), _mm_unpackhi_epi32(children.mBottomLeft, children.mBottomRight));
+        }
+#endif
+
+        for (; x < nodesPerRow; x++)
+        {
+            const int k = (y * nodesPerRow) + x;
+            Unquad(pNodes[k], pB0[k], pB1[k], pB2[k], pTop + (x * 2), pBottom + (x * 2));
+        }
+    }
+}
+
+// Same as the g_red_table, g_green_table and g_blue_table look ups for the values they hold (0-63, green can be
+// 64 which is black)
+static inline WORD ToRgb565(int r, int g, int b)
+{
+    const int green = g == 64 ? 0 : std::min(std::max(g, 0), 31);
+    return static_cast<WORD>((std::min(std::max(r, 0), 31) << 11) | (green << 6) | std::min(std::max(b, 0), 31));
+}
+
+#if CAM_DECODER_SSE2
+static inline __m128i Clamp31_SSE2(const int* pValues)
+{
+    const __m128i values = _mm_packs_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pValues)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pValues + 4)));
+    return _mm_max_epi16(_mm_min_epi16(values, _mm_set1_epi16(31)), _mm_setzero_si128());
+}
+
+static inline __m128i ToRgb565_SSE2(const int* pR, const int* pG, const int* pB)
+{
+    const __m128i green = _mm_packs_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pG)),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pG + 4)));
+    const __m128i black = _mm_cmpeq_epi16(green, _mm_set1_epi16(64));
+    const __m128i g = _mm_andnot_si128(black, _mm_max_epi16(_mm_min_epi16(green, _mm_set1_epi16(31)), _mm_setzero_si128()));
+
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(Clamp31_SSE2(pR), 11), _mm_slli_epi16(g, 6)), Clamp31_SSE2(pB));
+}
+#endif
+
+// Undoes the quad tree of a 16x16 block and writes the first rowCount rows of it.
+static void DecodeBlock(const int* pCoefficients, int rowCount, WORD* pPixels, int pitch)
+{
+    // Each level's nodes, the last level is the pixels
+    int values[2][3][kBlockSize * kBlockSize];
+    int cur = 0;
+    for (int channel = 0; channel < 3; channel++)
+    {
+        values[cur][channel][0] = pCoefficients[channel];
+    }
+
+    for (int level = 0; level < 4; level++)
+    {
+        const int nodesPerRow = 1 << level;
+        const int nodeCount = nodesPerRow * nodesPerRow;
+        for (int channel = 0; channel < 3; channel++)
+        {
+            const int* pLevelCoefficients = pCoefficients + LevelBase(level) + (channel * 3 * nodeCount);
+            UnquadLevel(values[cur][channel], pLevelCoefficients, nodesPerRow, values[!cur][channel]);
+        }
+        cur = !cur;
+    }
+
+    const int* pR = values[cur][0];
+    const int* pG = values[cur][1];
+    const int* pB = values[cur][2];
+    for (int y = 0; y < rowCount; y++)
+    {
+        const int row = y * kBlockSize;
+        WORD* pDst = pPixels + (y * pitch);
+#if CAM_DECODER_SSE2
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), ToRgb565_SSE2(pR + row, pG + row, pB + row));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 8), ToRgb565_SSE2(pR + row + 8, pG + row + 8, pB + row + 8));
+#else
+        for (int x = 0; x < kBlockSize; x++)
+        {
+            pDst[x] = ToRgb565(pR[row + x], pG[row + x], pB[row + x]);
+        }
+#endif
+    }
+}
+
+void CamDecoder::DecodeStrip(int symbolCount, WORD* pPixels, int pitch)
+{
+    // Unpack the runs of zeros straight in to the layout DecodeBlock wants. The coefficients carry on from one
+    // block to the next, running out of symbols leaves the rest as zeros.
+    int* pCoefficients = mCoefficients.data();
+    std::fill(mCoefficients.begin(), mCoefficients.end(), 0);
+
+    const TCoefficientOrder& order = CoefficientOrder();
+    int pos = 0;
+    for (int i = 0; i < symbolCount; i++)
+    {
+        const WORD symbol = mSymbols[i];
+        pos += symbol >> 7;
+        if (pos >= kStripCoefficients)
+        {
+            break;
+        }
+
+        const int blockStart = (pos / kBlockCoefficients) * kBlockCoefficients;
+        pCoefficients[blockStart + order[pos - blockStart]] = SymbolValue(symbol);
+        pos++;
+    }
+
+    // The last block is below the bottom of the camera so only its coefficients matter
+    for (int block = 0; block * kBlockSize < CamVlcDecoder::kHeight; block++)
+    {
+        const int rowCount = std::min(kBlockSize, CamVlcDecoder::kHeight - (block * kBlockSize));
+        DecodeBlock(pCoefficients + (block * kBlockCoefficients), rowCount, pPixels + (block * kBlockSize * pitch), pitch);
+    }
+}
+
+const WORD* CamDecoder::FindCamBits(const std::vector<BYTE>& camFile)
+{
+    size_t offset = 0;
+    while (offset + sizeof(ResourceManager::Header) <= camFile.size())
+    {
+        auto pHeader = reinterpret_cast<const ResourceManager::Header*>(&camFile[offset]);
+        if (pHeader->field_8_type == ResourceManager::Resource_End || pHeader->field_0_size < sizeof(ResourceManager::Header))
+        {
+            break;
+        }
+
+        if (pHeader->field_8_type == ResourceManager::Resource_Bits)
+        {
+            return reinterpret_cast<const WORD*>(pHeader + 1);
+        }
+        offset += pHeader->field_0_size;
+    }
+    return nullptr;
+}
+
+void CamDecoder::DecodeCamera(const WORD* pCamBits, WORD* pPixels, int pitch)
+{
+    if (!gCameraFastDecode)
+    {
+        mReference.DecodeCamera(pCamBits, pPixels, pitch);
+        return;
+    }
+
+    mSymbols.resize(kMaxSymbols + 3);
+    mCoefficients.resize(kStripCoefficients);
+
+    const WORD* pIter = pCamBits;
+    for (int i = 0; i < kNumStrips; i++)
+    {
+        const WORD stripSize = *pIter;
+        pIter++;
+
+        if (stripSize > 0)
+        {
+            const int wordCount = stripSize / sizeof(WORD);
+            const int symbolCount = UnpackSymbols(pIter, wordCount, mSymbols.data(), kMaxSymbols);
+            DecodeStrip(symbolCount, pPixels + (i * kStripWidth), pitch);
+        }
+
+        pIter += (stripSize / sizeof(WORD));
+    }
+}
+
+namespace Test
+{
+    // Writes bits most significant first in to words the way the strips are read
+    class BitWriter
+    {
+    public:
+        void Write(unsigned int value, int bitCount)
+        {
+            for (int i = bitCount - 1; i >= 0; i--)
+            {
+                if (mBitPos == 0)
+                {
+                    mWords.push_back(0);
+                }
+
+                if ((value >> i) & 1)
+                {
+                    mWords.back() |= 1 << (15 - mBitPos);
+                }
+                mBitPos = (mBitPos + 1) % 16;
+            }
+        }
+
+        std::vector<WORD> mWords;
+
+    private:
+        int mBitPos = 0;
+    };
+
+    // Encodes symbols with the shortest g_VlcTab code that gives only that symbol, else an escape and a literal.
+    class VlcEncoder
+    {
+    public:
+        struct Code
+        {
+            int mBits = 0;
+            unsigned int mCode = 0;
+        };
+
+        VlcEncoder()
+        {
+            const TVlcEntries& entries = VlcEntries();
+            for (unsigned int i = 0; i < entries.size(); i++)
+            {
+                const VlcEntry& entry = entries[i];
+                const Code code = { entry.mBits, i >> (11 - entry.mBits) };
+                if (entry.mEscape && entry.mCount == 0 && (mEscape.mBits == 0 || code.mBits < mEscape.mBits))
+                {
+                    mEscape = code;
+                }
+                else if (!entry.mEscape && entry.mCount == 1)
+                {
+                    Code& symbolCode = mSymbols[entry.mSymbols[0]];
+                    if (symbolCode.mBits == 0 || code.mBits < symbolCode.mBits)
+                    {
+                        symbolCode = code;
+                    }
+                }
+            }
+        }
+
+        void Encode(WORD symbol, BitWriter& writer) const
+        {
+            auto it = mSymbols.find(symbol);
+            if (it != mSymbols.end())
+            {
+                writer.Write(it->second.mCode, it->second.mBits);
+            }
+            else
+            {
+                // A literal of 1 ends the strip
+                ASSERT_NE(1, symbol);
+                ASSERT_LT(symbol, 0x2000);
+                writer.Write(mEscape.mCode, mEscape.mBits);
+                writer.Write(symbol, 13);
+            }
+        }
+
+        void End(BitWriter& writer) const
+        {
+            writer.Write(mEscape.mCode, mEscape.mBits);
+            writer.Write(1, 13);
+        }
+
+        Code mEscape;
+        std::map<WORD, Code> mSymbols;
+    };
+
+    // Builds a camera with small detail values so every pixel stays in the range the colour tables cover.
+    static std::vector<WORD> MakeCamera(unsigned int seed)
+    {
+        std::mt19937 rng(seed);
+        const VlcEncoder encoder;
+
+        std::vector<WORD> camera;
+        for (int strip = 0; strip < kNumStrips; strip++)
+        {
+            // An empty strip leaves what was already there
+            if (strip == 5)
+            {
+                camera.push_back(0);
+                continue;
+            }
+
+            BitWriter writer;
+            int zeros = 0;
+            for (int i = 0; i < CamDecoder::kStripCoefficients; i++)
+            {
+                const int inBlock = i % CamDecoder::kBlockCoefficients;
+                int value = 0;
+                if (inBlock < 3)
+                {
+                    value = 16 + static_cast<int>(rng() % 32);
+                }
+                else if (rng() % 5 == 0)
+                {
+                    value = static_cast<int>(rng() % 5) - 2;
+                }
+
+                if (value == 0 && i != CamDecoder::kStripCoefficients - 1)
+                {
+                    zeros++;
+                    continue;
+                }
+
+                // Runs longer than a literal can hold are split with a zero value
+                while (zeros > 63)
+                {
+                    encoder.Encode(static_cast<WORD>(63 << 7), writer);
+                    zeros -= 64;
+                }
+                encoder.Encode(static_cast<WORD>((zeros << 7) | (value & 0x7F)), writer);
+                zeros = 0;
+            }
+            encoder.End(writer);
+
+            camera.push_back(static_cast<WORD>(writer.mWords.size() * sizeof(WORD)));
+            camera.insert(camera.end(), writer.mWords.begin(), writer.mWords.end());
+        }
+        return camera;
+    }
+
+    static void CompareDecoders(const WORD* pCamBits, const char* pName)
+    {
+        const int kPixelCount = CamVlcDecoder::kWidth * CamVlcDecoder::kHeight;
+        std::vector<WORD> expected(kPixelCount, 0x1234);
+        std::vector<WORD> actual(kPixelCount, 0x1234);
+
+        CamVlcDecoder reference;
+        reference.DecodeCamera(pCamBits, expected.data(), CamVlcDecoder::kWidth);
+
+        CamDecoder decoder;
+        decoder.DecodeCamera(pCamBits, actual.data(), CamVlcDecoder::kWidth);
+
+        for (int i = 0; i < kPixelCount; i++)
+        {
+            ASSERT_EQ(expected[i], actual[i]) << pName << " x " << (i % CamVlcDecoder::kWidth) << " y " << (i / CamVlcDecoder::kWidth);
+        }
+    }
+
+    static void CamDecoder_UnpackSymbols_Test()
+    {
+        const VlcEncoder encoder;
+        BitWriter writer;
+        std::vector<WORD> symbols;
+        for (WORD symbol = 2; symbol < 0x400; symbol += 3)
+        {
+            symbols.push_back(symbol);
+            encoder.Encode(symbol, writer);
+        }
+        symbols.push_back(1);
+        encoder.End(writer);
+
+        // The original reads a word ahead of what it uses
+        std::vector<WORD> strip = writer.mWords;
+        strip.push_back(0);
+        strip.push_back(0);
+
+        std::vector<WORD> expected(CamDecoder::kMaxSymbols);
+        CamVlcDecoder reference;
+        reference.vlc_decode(strip.data(), expected.data());
+
+        std::vector<WORD> actual(CamDecoder::kMaxSymbols + 3);
+        const int count = CamDecoder::UnpackSymbols(writer.mWords.data(), static_cast<int>(writer.mWords.size()), actual.data(), CamDecoder::kMaxSymbols);
+        ASSERT_EQ(symbols.size(), static_cast<size_t>(count));
+        for (int i = 0; i < count; i++)
+        {
+            ASSERT_EQ(symbols[i], actual[i]);
+            ASSERT_EQ(expected[i], actual[i]);
+        }
+    }
+
+    static void CamDecoder_MatchesReference_Test()
+    {
+        for (unsigned int seed = 1; seed <= 3; seed++)
+        {
+            const std::vector<WORD> camera = MakeCamera(seed);
+            CompareDecoders(camera.data(), "generated");
+        }
+    }
+
+    static std::string LvlFileName(const char* pCdName)
+    {
+        // "\\MI.LVL;1" to "MI.LVL"
+        std::string name = pCdName;
+        if (!name.empty() && name[0] == '\\')
+        {
+            name.erase(0, 1);
+        }
+
+        const size_t versionPos = name.find(';');
+        if (versionPos != std::string::npos)
+        {
+            name.erase(versionPos);
+        }
+        return name;
+    }
+
+    // Every camera of every LVL found in the working directory must decode the same as the original decoder.
+    static void CamDecoder_MatchesReferenceForLvls_Test()
+    {
+        for (const PathRoot& root : sPathData_559660.paths)
+        {
+            if (!root.field_20_lvl_name_cd)
+            {
+                continue;
+            }
+
+            const std::string fileName = LvlFileName(root.field_20_lvl_name_cd);
+            FILE* hFile = fopen(fileName.c_str(), "rb");
+            if (!hFile)
+            {
+                continue;
+            }
+
+            // The same 5 sectors LvlArchive::Open_Archive_432E80 reads
+            std::vector<BYTE> header(2048 * 5);
+            ASSERT_EQ(1u, fread(header.data(), header.size(), 1, hFile));
+            const LvlHeader* pHeader = reinterpret_cast<const LvlHeader*>(header.data());
+            const int maxFiles = static_cast<int>((header.size() - sizeof(LvlHeader)) / sizeof(LvlFileRecord)) + 1;
+
+            int cameraCount = 0;
+            for (int i = 0; i < std::min(pHeader->field_10_sub.field_0_num_files, maxFiles); i++)
+            {
+                const LvlFileRecord& rec = pHeader->field_10_sub.field_10_file_recs[i];
+                const std::string recName(rec.field_0_file_name, strnlen(rec.field_0_file_name, sizeof(rec.field_0_file_name)));
+                if (recName.find(".CAM") == std::string::npos)
+                {
+                    continue;
+                }
+
+                std::vector<BYTE> file(rec.field_14_file_size);
+                fseek(hFile, rec.field_C_start_sector * 2048, SEEK_SET);
+                ASSERT_EQ(1u, fread(file.data(), file.size(), 1, hFile));
+
+                const WORD* pCamBits = CamDecoder::FindCamBits(file);
+                if (pCamBits)
+                {
+                    CompareDecoders(pCamBits, recName.c_str());
+                    cameraCount++;
+                }
+            }
+            fclose(hFile);
+            LOG_INFO(fileName << " " << cameraCount << " cameras decode the same");
+        }
+    }
+
+    void CamDecoderTests()
+    {
+        CamDecoder_UnpackSymbols_Test();
+        CamDecoder_MatchesReference_Test();
+        CamDecoder_MatchesReferenceForLvls_Test();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "ScreenManager.hpp"
+#include <vector>
+
+namespace Test
+{
+    void CamDecoderTests();
+}
+
+// Decodes the VLC strips of a CAM's Bits resource to the same pixels as CamVlcDecoder. The bits are read
+// through a 64 bit window with each table look up giving up to 3 symbols, the run lengths are unpacked
+// straight in to the order the transform reads them and the quad tree is undone a level at a time so 4 nodes
+// are worked on at once. Rows of 16 pixels are written with SIMD stores.
+class CamDecoder
+{
+public:
+    static const int kStripWidth = 16;
+    static const int kBlocksPerStrip = 16;
+    static const int kBlockCoefficients = 768; // 3 root values and 9 for each of the 85 quad tree nodes
+    static const int kStripCoefficients = kBlocksPerStrip * kBlockCoefficients;
+    static const int kMaxSymbols = 0x7E00 / sizeof(WORD); // The size of the VLC resource the game used
+
+    // Decodes the whole camera in to CamVlcDecoder::kWidth x kHeight rgb565 pixels, pitch is in pixels.
+    void DecodeCamera(const WORD* pCamBits, WORD* pPixels, int pitch);
+
+    // The Bits resource of a CAM file read straight from a LVL, nullptr if it has none.
+    static const WORD* FindCamBits(const std::vector<BYTE>& camFile);
+
+    // Turns the strip's bits in to (run << 7) | value symbols the same as CamVlcDecoder::vlc_decode, stops after
+    // the end of strip symbol or maxSymbols. pSymbols needs room for 3 more than maxSymbols.
+    static int UnpackSymbols(const WORD* pStrip, int wordCount, WORD* pSymbols, int maxSymbols);
+
+private:
+    void DecodeStrip(int symbolCount, WORD* pPixels, int pitch);
+
+    std::vector<WORD> mSymbols;
+    std::vector<int> mCoefficients;
+    CamVlcDecoder mReference;
+};
+
+// Use CamDecoder, else every camera goes through the original decoder.
+extern bool gCameraFastDecode;
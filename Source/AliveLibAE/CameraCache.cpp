@@ -0,0 +1,430 @@
+#include "stdafx.h"
+#include "CameraCache.hpp"
+#include "Function.hpp"
+#include "ScreenManager.hpp"
+#include "CamDecoder.hpp"
+#include "ResourceManager.hpp"
+#include "LvlArchive.hpp"
+#include "Map.hpp"
+#include "Path.hpp"
+#include "PathData.hpp"
+#include "Psx.hpp"
+#include "Io.hpp"
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <gmock/gmock.h>
+
+int gCameraCacheKb = 8192;
+bool gCameraPredecode = false;
+
+const int kCameraBytes = CamVlcDecoder::kWidth * CamVlcDecoder::kHeight * sizeof(WORD);
+const int kCamStrips = CamVlcDecoder::kWidth / 16;
+const int kSectorSize = 2048;
+
+CameraCache::CameraCache(size_t budgetBytes)
+    : mBudgetBytes(budgetBytes)
+{
+    mThread = std::thread(&CameraCache::WorkerThread, this);
+}
+
+CameraCache::~CameraCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mQuit = true;
+    }
+    mWorkReady.notify_all();
+    mThread.join();
+}
+
+DWORD CameraCache::Checksum(const WORD* pCamBits)
+{
+    // FNV-1a over each strip's size and data
+    DWORD hash = 2166136261u;
+    const WORD* pIter = pCamBits;
+    for (int i = 0; i < kCamStrips; i++)
+    {
+        const WORD stripSize = *pIter;
+        const int wordCount = 1 + (stripSize / sizeof(WORD));
+        for (int j = 0; j < wordCount; j++)
+        {
+            hash = (hash ^ pIter[j]) * 16777619u;
+        }
+        pIter += wordCount;
+    }
+    return hash;
+}
+
+CameraCache::TEntries::iterator CameraCache::Find(const Key& key)
+{
+    return std::find_if(mEntries.begin(), mEntries.end(), [&](const Entry& entry)
+    {
+        return entry.mKey == key;
+    });
+}
+
+bool CameraCache::CopyTo(const Key& key, DWORD checksum, WORD* pPixels, int pitch)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = Find(key);
+    if (it == mEntries.end() || it->mChecksum != checksum)
+    {
+        mStats.mMisses++;
+        return false;
+    }
+
+    mEntries.splice(mEntries.begin(), mEntries, it);
+    for (int y = 0; y < CamVlcDecoder::kHeight; y++)
+    {
+        memcpy(pPixels + (y * pitch), &it->mPixels[y * CamVlcDecoder::kWidth], CamVlcDecoder::kWidth * sizeof(WORD));
+    }
+    mStats.mHits++;
+    return true;
+}
+
+void CameraCache::AddLocked(Entry&& entry)
+{
+    auto it = Find(entry.mKey);
+    if (it != mEntries.end())
+    {
+        mStats.mBytesHeld -= kCameraBytes;
+        mEntries.erase(it);
+    }
+
+    mEntries.push_front(std::move(entry));
+    mStats.mBytesHeld += kCameraBytes;
+
+    // Always keep the camera that was just added even if the budget is smaller than it
+    while (mStats.mBytesHeld > mBudgetBytes && mEntries.size() > 1)
+    {
+        mEntries.pop_back();
+        mStats.mBytesHeld -= kCameraBytes;
+        mStats.mEvicted++;
+    }
+}
+
+void CameraCache::Add(const Key& key, DWORD checksum, const WORD* pPixels, int pitch)
+{
+    Entry entry = { key, checksum, std::vector<WORD>(CamVlcDecoder::kWidth * CamVlcDecoder::kHeight) };
+    for (int y = 0; y < CamVlcDecoder::kHeight; y++)
+    {
+        memcpy(&entry.mPixels[y * CamVlcDecoder::kWidth], pPixels + (y * pitch), CamVlcDecoder::kWidth * sizeof(WORD));
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    AddLocked(std::move(entry));
+}
+
+bool CameraCache::Contains(const Key& key)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return Find(key) != mEntries.end();
+}
+
+int CameraCache::Capacity() const
+{
+    return static_cast<int>(mBudgetBytes / kCameraBytes);
+}
+
+void CameraCache::Predecode(const char* pArchivePath, const std::vector<PendingCamera>& cameras)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mArchivePath = pArchivePath;
+        mPending = cameras;
+
+        // Taken from the back
+        std::reverse(mPending.begin(), mPending.end());
+    }
+    mWorkReady.notify_all();
+}
+
+CameraCacheStats CameraCache::Stats()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mStats;
+}
+
+void CameraCache::WorkerThread()
+{
+    IO_FileHandleType hFile = nullptr;
+    std::string openedPath;
+    CamDecoder decoder;
+
+    for (;;)
+    {
+        PendingCamera camera = {};
+        std::string archivePath;
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mWorkReady.wait(lock, [this]() { return mQuit || !mPending.empty(); });
+            if (mQuit)
+            {
+                break;
+            }
+
+            camera = mPending.back();
+            mPending.pop_back();
+            archivePath = mArchivePath;
+            if (Find(camera.mKey) != mEntries.end())
+            {
+                continue;
+            }
+        }
+
+        if (archivePath != openedPath)
+        {
+            if (hFile)
+            {
+                IO_Close(hFile);
+            }
+            hFile = IO_Open(archivePath.c_str(), "rb");
+            openedPath = archivePath;
+        }
+
+        if (!hFile)
+        {
+            continue;
+        }
+
+        // Same position conversions as the resource manager's reads, the extra sector keeps the VLC reader
+        // from running off the end of the last strip
+        CdlLOC cdLoc = {};
+        PSX_Pos_To_CdLoc_4FADD0(camera.mStartSector, &cdLoc);
+        const int filePos = PSX_CdLoc_To_Pos_4FAE40(&cdLoc);
+        std::vector<BYTE> fileData(static_cast<size_t>(camera.mNumSectors + 1) * kSectorSize);
+        IO_Seek(hFile, filePos * kSectorSize, SEEK_SET);
+        if (IO_Read(hFile, fileData.data(), 1u, camera.mNumSectors * kSectorSize) == 0)
+        {
+            continue;
+        }
+
+        const WORD* pCamBits = CamDecoder::FindCamBits(fileData);
+        if (!pCamBits)
+        {
+            continue;
+        }
+
+        Entry entry = { camera.mKey, Checksum(pCamBits), std::vector<WORD>(CamVlcDecoder::kWidth * CamVlcDecoder::kHeight) };
+        decoder.DecodeCamera(pCamBits, entry.mPixels.data(), CamVlcDecoder::kWidth);
+
+        std::lock_guard<std::mutex> lock(mLock);
+        if (archivePath == mArchivePath && Find(camera.mKey) == mEntries.end())
+        {
+            AddLocked(std::move(entry));
+            mStats.mPredecoded++;
+        }
+    }
+
+    if (hFile)
+    {
+        IO_Close(hFile);
+    }
+}
+
+CameraCache* CameraCache_Get()
+{
+    static std::unique_ptr<CameraCache> sCache;
+    static size_t sBudgetBytes = 0;
+
+    if (gCameraCacheKb <= 0)
+    {
+        sCache.reset();
+        return nullptr;
+    }
+
+    const size_t budgetBytes = static_cast<size_t>(gCameraCacheKb) * 1024;
+    if (!sCache || sBudgetBytes != budgetBytes)
+    {
+        sCache.reset(new CameraCache(budgetBytes));
+        sBudgetBytes = budgetBytes;
+    }
+    return sCache.get();
+}
+
+CameraCache::Key CameraCache_KeyOf(BYTE** ppCamBits)
+{
+    return { gMap_5C3030.field_0_current_level, static_cast<int>(ResourceManager::Get_Header_49C410(ppCamBits)->field_C_id) };
+}
+
+void CameraCache_OnCameraChanged(Map& map)
+{
+    static LevelIds sLevel = LevelIds::eNone;
+    static __int16 sPath = -1;
+
+    CameraCache* pCache = CameraCache_Get();
+    if (!gCameraPredecode || !pCache || !sPath_dword_BB47C0 || sbEnable_PCOpen_5CA4B0)
+    {
+        sPath = -1;
+        return;
+    }
+
+    if (sLevel == map.field_0_current_level && sPath == map.field_2_current_path)
+    {
+        return;
+    }
+    sLevel = map.field_0_current_level;
+    sPath = map.field_2_current_path;
+
+    struct Nearby
+    {
+        CameraCache::PendingCamera mCamera;
+        int mDistance;
+    };
+
+    std::vector<Nearby> cameras;
+    const BYTE* pPathData = *map.field_54_path_res_array.field_0_pPathRecs[map.field_2_current_path];
+    for (int y = 0; y < sPath_dword_BB47C0->field_8_cams_on_y; y++)
+    {
+        for (int x = 0; x < sPath_dword_BB47C0->field_6_cams_on_x; x++)
+        {
+            // Same look up as Map::Create_Camera_4829E0
+            auto pCamName = reinterpret_cast<const CameraName*>(&pPathData[(x + (y * sPath_dword_BB47C0->field_6_cams_on_x)) * sizeof(CameraName)]);
+            if (!pCamName->name[0])
+            {
+                continue;
+            }
+
+            char camFileName[16] = {};
+            strncpy(camFileName, pCamName->name, ALIVE_COUNTOF(CameraName::name));
+            strcat(camFileName, ".CAM");
+            LvlFileRecord* pFileRec = sLvlArchive_5BC520.Find_File_Record_433160(camFileName);
+            if (!pFileRec)
+            {
+                continue;
+            }
+
+            const int resourceId =
+                1 * (pCamName->name[7] - '0') +
+                10 * (pCamName->name[6] - '0') +
+                100 * (pCamName->name[4] - '0') +
+                1000 * (pCamName->name[3] - '0');
+
+            const CameraCache::Key key = { map.field_0_current_level, resourceId };
+            const int distance = std::abs(x - map.field_D0_cam_x_idx) + std::abs(y - map.field_D2_cam_y_idx);
+            if (distance == 0 || pCache->Contains(key))
+            {
+                continue;
+            }
+
+            const int startSector = pFileRec->field_C_start_sector + sLvlArchive_5BC520.field_4_cd_pos;
+            cameras.push_back({ { key, startSector, pFileRec->field_10_num_sectors }, distance });
+        }
+    }
+
+    std::stable_sort(cameras.begin(), cameras.end(), [](const Nearby& lhs, const Nearby& rhs)
+    {
+        return lhs.mDistance < rhs.mDistance;
+    });
+
+    // Leave room for the current camera, more than this would only evict cameras that were just decoded
+    std::vector<CameraCache::PendingCamera> pending;
+    for (const Nearby& nearby : cameras)
+    {
+        if (static_cast<int>(pending.size()) >= pCache->Capacity() - 1)
+        {
+            break;
+        }
+        pending.push_back(nearby.mCamera);
+    }
+
+    pCache->Predecode(PSX_CD_OpenedFilePath(), pending);
+}
+
+namespace Test
+{
+    static std::vector<WORD> TestCameraPixels(WORD seed)
+    {
+        std::vector<WORD> pixels(CamVlcDecoder::kWidth * CamVlcDecoder::kHeight);
+        for (size_t i = 0; i < pixels.size(); i++)
+        {
+            pixels[i] = static_cast<WORD>(i * 31 + seed);
+        }
+        return pixels;
+    }
+
+    static void CameraCache_LeastRecentlyUsed_Test()
+    {
+        // Room for two cameras
+        CameraCache cache(2 * kCameraBytes);
+        const CameraCache::Key cam1 = { LevelIds::eMines_1, 101 };
+        const CameraCache::Key cam2 = { LevelIds::eMines_1, 102 };
+        const CameraCache::Key cam3 = { LevelIds::eMines_1, 103 };
+
+        const std::vector<WORD> pixels1 = TestCameraPixels(1);
+        cache.Add(cam1, 11, pixels1.data(), CamVlcDecoder::kWidth);
+        cache.Add(cam2, 22, TestCameraPixels(2).data(), CamVlcDecoder::kWidth);
+
+        // Copies to a pitch wider than the camera
+        const int pitch = 1024;
+        std::vector<WORD> vram(pitch * CamVlcDecoder::kHeight, 0xFFFF);
+        ASSERT_TRUE(cache.CopyTo(cam1, 11, vram.data(), pitch));
+        for (int y = 0; y < CamVlcDecoder::kHeight; y++)
+        {
+            ASSERT_EQ(0, memcmp(&vram[y * pitch], &pixels1[y * CamVlcDecoder::kWidth], CamVlcDecoder::kWidth * sizeof(WORD)));
+            ASSERT_EQ(0xFFFF, vram[(y * pitch) + CamVlcDecoder::kWidth]);
+        }
+
+        // A changed camera doesn't match
+        ASSERT_FALSE(cache.CopyTo(cam1, 12, vram.data(), pitch));
+
+        // cam1 was used last so cam2 makes way
+        cache.Add(cam3, 33, TestCameraPixels(3).data(), CamVlcDecoder::kWidth);
+        ASSERT_TRUE(cache.Contains(cam1));
+        ASSERT_FALSE(cache.Contains(cam2));
+        ASSERT_TRUE(cache.Contains(cam3));
+
+        const CameraCacheStats stats = cache.Stats();
+        ASSERT_EQ(1u, stats.mHits);
+        ASSERT_EQ(1u, stats.mMisses);
+        ASSERT_EQ(1u, stats.mEvicted);
+        ASSERT_EQ(static_cast<size_t>(2 * kCameraBytes), stats.mBytesHeld);
+    }
+
+    static void CameraCache_Predecode_Test()
+    {
+        const char* kFileName = "camera_cache_test.tmp";
+
+        // A CAM with an empty Bits resource in its second sector, decodes to all black
+        std::vector<BYTE> fileData(3 * kSectorSize);
+        auto pHeader = reinterpret_cast<ResourceManager::Header*>(&fileData[kSectorSize]);
+        pHeader->field_0_size = sizeof(ResourceManager::Header) + (kCamStrips * sizeof(WORD));
+        pHeader->field_8_type = ResourceManager::Resource_Bits;
+        pHeader->field_C_id = 101;
+        auto pEnd = reinterpret_cast<ResourceManager::Header*>(&fileData[kSectorSize + pHeader->field_0_size]);
+        pEnd->field_0_size = sizeof(ResourceManager::Header);
+        pEnd->field_8_type = ResourceManager::Resource_End;
+
+        FILE* hFile = fopen(kFileName, "wb");
+        ASSERT_NE(nullptr, hFile);
+        fwrite(fileData.data(), 1, fileData.size(), hFile);
+        fclose(hFile);
+
+        {
+            CameraCache cache(4 * kCameraBytes);
+            const CameraCache::Key key = { LevelIds::eMines_1, 101 };
+            cache.Predecode(kFileName, { { key, 1, 1 } });
+
+            const auto timeOut = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!cache.Contains(key) && std::chrono::steady_clock::now() < timeOut)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            std::vector<WORD> vram(CamVlcDecoder::kWidth * CamVlcDecoder::kHeight, 0xFFFF);
+            const DWORD checksum = CameraCache::Checksum(reinterpret_cast<const WORD*>(pHeader + 1));
+            ASSERT_TRUE(cache.CopyTo(key, checksum, vram.data(), CamVlcDecoder::kWidth));
+            ASSERT_EQ(vram.end(), std::find_if(vram.begin(), vram.end(), [](WORD pixel) { return pixel != 0; }));
+            ASSERT_EQ(1u, cache.Stats().mPredecoded);
+        }
+
+        remove(kFileName);
+    }
+
+    void CameraCacheTests()
+    {
+        CameraCache_LeastRecentlyUsed_Test();
+        CameraCache_Predecode_Test();
+    }
+}
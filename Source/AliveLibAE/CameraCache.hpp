@@ -0,0 +1,116 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <list>
+#include <vector>
+#include <string>
+
+class Map;
+enum class LevelIds : __int16;
+
+namespace Test
+{
+    void CameraCacheTests();
+}
+
+struct CameraCacheStats
+{
+    unsigned int mHits = 0;
+    unsigned int mMisses = 0;
+    unsigned int mPredecoded = 0; // Decoded on the worker thread
+    unsigned int mEvicted = 0;
+    size_t mBytesHeld = 0;
+};
+
+// Holds fully decoded camera backgrounds so going back to a camera is a copy instead of a VLC decode. Cameras
+// can also be decoded ahead of time on a worker thread, it only reads the LVL and never touches the
+// resource manager.
+class CameraCache
+{
+public:
+    struct Key
+    {
+        LevelIds mLevel;
+        int mResourceId; // path * 100 + camera, the same as Camera::field_10_camera_resource_id
+
+        bool operator == (const Key& rhs) const
+        {
+            return mLevel == rhs.mLevel && mResourceId == rhs.mResourceId;
+        }
+    };
+
+    struct PendingCamera
+    {
+        Key mKey;
+        int mStartSector;
+        int mNumSectors;
+    };
+
+    explicit CameraCache(size_t budgetBytes);
+    ~CameraCache();
+
+    // Hash of the compressed strips, a camera that was replaced on disk won't match what was cached for it.
+    static DWORD Checksum(const WORD* pCamBits);
+
+    // Copies the camera in to pPixels and returns true if it is held, pitch is in pixels.
+    bool CopyTo(const Key& key, DWORD checksum, WORD* pPixels, int pitch);
+
+    // Holds a copy of the decoded camera, dropping the least recently used ones that no longer fit.
+    void Add(const Key& key, DWORD checksum, const WORD* pPixels, int pitch);
+
+    bool Contains(const Key& key);
+
+    // How many cameras fit in the budget.
+    int Capacity() const;
+
+    // Replaces the cameras the worker decodes ahead of time, in the order given. Cameras are read from the
+    // LVL at pArchivePath.
+    void Predecode(const char* pArchivePath, const std::vector<PendingCamera>& cameras);
+
+    CameraCacheStats Stats();
+
+private:
+    struct Entry
+    {
+        Key mKey;
+        DWORD mChecksum;
+        std::vector<WORD> mPixels;
+    };
+
+    // Most recently used first
+    using TEntries = std::list<Entry>;
+
+    TEntries::iterator Find(const Key& key);
+    void AddLocked(Entry&& entry);
+    void WorkerThread();
+
+    TEntries mEntries;
+    size_t mBudgetBytes = 0;
+    CameraCacheStats mStats;
+
+    std::thread mThread;
+    std::mutex mLock;
+    std::condition_variable mWorkReady;
+    std::vector<PendingCamera> mPending;
+    std::string mArchivePath;
+    bool mQuit = false;
+};
+
+// Returns the cache sized by gCameraCacheKb, or nullptr when it is turned off.
+CameraCache* CameraCache_Get();
+
+// The key of a loaded Bits resource of the current level.
+CameraCache::Key CameraCache_KeyOf(BYTE** ppCamBits);
+
+// Queues the cameras of the current path for decoding ahead of time when gCameraPredecode is set, nearest to
+// the current camera first.
+void CameraCache_OnCameraChanged(Map& map);
+
+// Memory decoded cameras can use in KB, each one is 300 KB. 0 or less turns the cache off.
+extern int gCameraCacheKb;
+
+// Decode the cameras of the current path on a worker thread before they are visited.
+extern bool gCameraPredecode;
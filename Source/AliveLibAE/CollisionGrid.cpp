@@ -0,0 +1,377 @@
+#include "stdafx.h"
+#include "CollisionGrid.hpp"
+#include "Collisions.hpp"
+#include "Function.hpp"
+#include "PathData.hpp"
+#include "LvlArchive.hpp"
+#include "ResourceManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+
+bool gCollisionGridEnabled = true;
+
+CollisionGrid::CollisionGrid(const PathLine* pLines, int lineCount)
+{
+    if (lineCount <= 0)
+    {
+        return;
+    }
+
+    int right = std::max(pLines[0].field_0_rect.x, pLines[0].field_0_rect.w);
+    int bottom = std::max(pLines[0].field_0_rect.y, pLines[0].field_0_rect.h);
+    mLeft = std::min(pLines[0].field_0_rect.x, pLines[0].field_0_rect.w);
+    mTop = std::min(pLines[0].field_0_rect.y, pLines[0].field_0_rect.h);
+    for (int i = 1; i < lineCount; i++)
+    {
+        const PSX_RECT& r = pLines[i].field_0_rect;
+        mLeft = std::min(mLeft, static_cast<int>(std::min(r.x, r.w)));
+        mTop = std::min(mTop, static_cast<int>(std::min(r.y, r.h)));
+        right = std::max(right, static_cast<int>(std::max(r.x, r.w)));
+        bottom = std::max(bottom, static_cast<int>(std::max(r.y, r.h)));
+    }
+
+    mCellsOnX = (right - mLeft) / kCellSize + 1;
+    mCellsOnY = (bottom - mTop) / kCellSize + 1;
+
+    // Count then fill so each cell's lines are packed together and in ascending order
+    mCellStart.assign(mCellsOnX * mCellsOnY + 1, 0);
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::vector<int> fillPos;
+        if (pass == 1)
+        {
+            for (size_t i = 1; i < mCellStart.size(); i++)
+            {
+                mCellStart[i] += mCellStart[i - 1];
+            }
+            mCellLines.resize(mCellStart.back());
+            fillPos.assign(mCellStart.begin(), mCellStart.end() - 1);
+        }
+
+        for (int i = 0; i < lineCount; i++)
+        {
+            const PSX_RECT& r = pLines[i].field_0_rect;
+            const int cellLeft = CellX(std::min(r.x, r.w));
+            const int cellRight = CellX(std::max(r.x, r.w));
+            const int cellTop = CellY(std::min(r.y, r.h));
+            const int cellBottom = CellY(std::max(r.y, r.h));
+            for (int cellY = cellTop; cellY <= cellBottom; cellY++)
+            {
+                for (int cellX = cellLeft; cellX <= cellRight; cellX++)
+                {
+                    const int cell = cellY * mCellsOnX + cellX;
+                    if (pass == 0)
+                    {
+                        mCellStart[cell + 1]++;
+                    }
+                    else
+                    {
+                        mCellLines[fillPos[cell]++] = i;
+                    }
+                }
+            }
+        }
+    }
+
+    mLineStamps.assign(lineCount, 0);
+}
+
+int CollisionGrid::CellX(int x) const
+{
+    return std::min(std::max(x - mLeft, 0) / kCellSize, mCellsOnX - 1);
+}
+
+int CollisionGrid::CellY(int y) const
+{
+    return std::min(std::max(y - mTop, 0) / kCellSize, mCellsOnY - 1);
+}
+
+void CollisionGrid::Query(int minX, int minY, int maxX, int maxY, std::vector<int>& indices) const
+{
+    indices.clear();
+
+    if (mCellsOnX == 0 || maxX < mLeft || maxY < mTop || minX >= mLeft + mCellsOnX * kCellSize || minY >= mTop + mCellsOnY * kCellSize)
+    {
+        // Nothing static out there
+        return;
+    }
+
+    if (++mQueryStamp == 0)
+    {
+        std::fill(mLineStamps.begin(), mLineStamps.end(), 0);
+        mQueryStamp = 1;
+    }
+
+    const int cellLeft = CellX(minX);
+    const int cellRight = CellX(maxX);
+    const int cellTop = CellY(minY);
+    const int cellBottom = CellY(maxY);
+    for (int cellY = cellTop; cellY <= cellBottom; cellY++)
+    {
+        for (int cellX = cellLeft; cellX <= cellRight; cellX++)
+        {
+            const int cell = cellY * mCellsOnX + cellX;
+            for (int i = mCellStart[cell]; i < mCellStart[cell + 1]; i++)
+            {
+                const int lineIdx = mCellLines[i];
+                if (mLineStamps[lineIdx] != mQueryStamp)
+                {
+                    mLineStamps[lineIdx] = mQueryStamp;
+                    indices.push_back(lineIdx);
+                }
+            }
+        }
+    }
+
+    // Only need sorting when more than one cell was looked at
+    if (cellLeft != cellRight || cellTop != cellBottom)
+    {
+        std::sort(indices.begin(), indices.end());
+    }
+}
+
+static std::map<const Collisions*, std::unique_ptr<CollisionGrid>>& CollisionGrids()
+{
+    static std::map<const Collisions*, std::unique_ptr<CollisionGrid>> sGrids;
+    return sGrids;
+}
+
+void CollisionGrid_Build(const Collisions* pCollisions)
+{
+    // The game's own code creates and frees collisions without telling us
+    if (RunningAsInjectedDll())
+    {
+        return;
+    }
+
+    CollisionGrids()[pCollisions].reset(new CollisionGrid(pCollisions->field_0_pArray, pCollisions->field_8_item_count));
+}
+
+void CollisionGrid_Free(const Collisions* pCollisions)
+{
+    CollisionGrids().erase(pCollisions);
+}
+
+const CollisionGrid* CollisionGrid_Get(const Collisions* pCollisions)
+{
+    if (!gCollisionGridEnabled)
+    {
+        return nullptr;
+    }
+
+    auto& grids = CollisionGrids();
+    auto it = grids.find(pCollisions);
+    return it != grids.end() ? it->second.get() : nullptr;
+}
+
+struct BenchmarkRay
+{
+    FP x1;
+    FP y1;
+    FP x2;
+    FP y2;
+    unsigned int modeMask;
+};
+
+// The kinds of rays the game fires the most: floor checks, wall checks and bullet traces
+static void MakeBenchmarkRays(const PathData* pPathData, std::vector<BenchmarkRay>& rays)
+{
+    const unsigned int kFloors = (1 << eFloor_0) | (1 << eBackGroundFloor_4);
+    const unsigned int kWalls = (1 << eWallLeft_1) | (1 << eWallRight_2) | (1 << eBackGroundWallLeft_5) | (1 << eBackGroundWallRight_6);
+    const unsigned int kBullets = kWalls | kFloors | (1 << eCeiling_3) | (1 << eBulletWall_10);
+
+    rays.clear();
+    for (int y = pPathData->field_4_bTop; y < pPathData->field_6_bBottom; y += 20)
+    {
+        for (int x = pPathData->field_0_bLeft; x < pPathData->field_2_bRight; x += 25)
+        {
+            rays.push_back({ FP_FromInteger(x), FP_FromInteger(y), FP_FromInteger(x), FP_FromInteger(y + 60), kFloors });
+            rays.push_back({ FP_FromInteger(x), FP_FromInteger(y), FP_FromInteger(x + 50), FP_FromInteger(y), kWalls });
+            rays.push_back({ FP_FromInteger(x), FP_FromInteger(y), FP_FromInteger(x - 375), FP_FromInteger(y + 15), kBullets });
+        }
+    }
+}
+
+static double TimeRays(Collisions& collisions, const std::vector<BenchmarkRay>& rays, bool bUseGrid, std::vector<PathLine*>& lines, std::vector<FP>& hits)
+{
+    lines.clear();
+    hits.clear();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const BenchmarkRay& ray : rays)
+    {
+        PathLine* pLine = nullptr;
+        FP hitX = {};
+        FP hitY = {};
+        collisions.Raycast_Lines(ray.x1, ray.y1, ray.x2, ray.y2, &pLine, &hitX, &hitY, ray.modeMask, bUseGrid);
+        lines.push_back(pLine);
+        hits.push_back(hitX);
+        hits.push_back(hitY);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void CollisionGrid_RunBenchmark(LevelIds levelId)
+{
+    const PathRoot& pathRoot = sPathData_559660.paths[static_cast<int>(levelId)];
+    if (!pathRoot.field_0_pBlyArrayPtr || !pathRoot.field_20_lvl_name_cd)
+    {
+        LOG_ERROR("Raycast benchmark level " << static_cast<int>(levelId) << " has no paths");
+        return;
+    }
+
+    if (!sLvlArchive_5BC520.Open_Archive_432E80(pathRoot.field_20_lvl_name_cd))
+    {
+        LOG_ERROR("Raycast benchmark couldn't open " << pathRoot.field_20_lvl_name_cd);
+        return;
+    }
+
+    ResourceManager::LoadResourceFile_49C170(pathRoot.field_38_bnd_name, nullptr);
+
+    std::vector<BenchmarkRay> rays;
+    std::vector<PathLine*> bruteLines;
+    std::vector<PathLine*> gridLines;
+    std::vector<FP> bruteHits;
+    std::vector<FP> gridHits;
+    double bruteTotalMs = 0.0;
+    double gridTotalMs = 0.0;
+    int mismatches = 0;
+
+    for (int path = 1; path <= pathRoot.field_18_num_paths; path++)
+    {
+        const PathBlyRec* pBlyRec = Path_Get_Bly_Record_460F30(levelId, static_cast<unsigned __int16>(path));
+        if (!pBlyRec->field_0_blyName || !pBlyRec->field_8_pCollisionData)
+        {
+            continue;
+        }
+
+        BYTE** ppPathRes = ResourceManager::GetLoadedResource_49C2A0(ResourceManager::Resource_Path, path, TRUE, FALSE);
+        if (!ppPathRes)
+        {
+            continue;
+        }
+
+        Collisions collisions = {};
+        collisions.ctor_418930(pBlyRec->field_8_pCollisionData, *ppPathRes);
+
+        MakeBenchmarkRays(pBlyRec->field_4_pPathData, rays);
+        const double bruteMs = TimeRays(collisions, rays, false, bruteLines, bruteHits);
+        const double gridMs = TimeRays(collisions, rays, true, gridLines, gridHits);
+
+        int pathMismatches = 0;
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            if (bruteLines[i] != gridLines[i] || bruteHits[i * 2] != gridHits[i * 2] || bruteHits[i * 2 + 1] != gridHits[i * 2 + 1])
+            {
+                pathMismatches++;
+            }
+        }
+
+        LOG_INFO("Raycast benchmark " << pBlyRec->field_0_blyName << " lines " << collisions.field_8_item_count << " rays " << rays.size()
+            << " brute " << bruteMs << " ms grid " << gridMs << " ms mismatches " << pathMismatches);
+
+        bruteTotalMs += bruteMs;
+        gridTotalMs += gridMs;
+        mismatches += pathMismatches;
+
+        collisions.dtor_4189F0();
+        ResourceManager::FreeResource_49C330(ppPathRes);
+    }
+
+    sLvlArchive_5BC520.Free_433130();
+
+    LOG_INFO("Raycast benchmark total brute " << bruteTotalMs << " ms grid " << gridTotalMs << " ms");
+    if (mismatches > 0)
+    {
+        LOG_ERROR("Raycast benchmark grid results differ from brute force for " << mismatches << " rays");
+    }
+}
+
+namespace Test
+{
+    static void CollisionGrid_MatchesBruteForce_Test()
+    {
+        // Floors, walls and slopes spread over a few cells with some that span lots of them
+        std::vector<PathLine> lines;
+        for (int i = 0; i < 200; i++)
+        {
+            const short x = static_cast<short>((i * 97) % 1500);
+            const short y = static_cast<short>((i * 53) % 700);
+            const short len = static_cast<short>(10 + (i * 31) % 300);
+
+            PathLine line = {};
+            line.field_8_type = static_cast<BYTE>(i % 4);
+            line.field_A_previous = -1;
+            line.field_C_next = -1;
+            switch (line.field_8_type)
+            {
+            case eFloor_0:
+            case eCeiling_3:
+                line.field_0_rect = { x, y, static_cast<short>(x + len), static_cast<short>(y + (i % 3) * 20) };
+                break;
+
+            default:
+                line.field_0_rect = { x, y, x, static_cast<short>(y + len) };
+                break;
+            }
+            lines.push_back(line);
+        }
+
+        CollisionInfo info = {};
+        info.field_C_collision_offset = 0;
+        info.field_10_num_collision_items = static_cast<unsigned int>(lines.size());
+
+        Collisions collisions = {};
+        collisions.ctor_418930(&info, reinterpret_cast<const BYTE*>(lines.data()));
+        ASSERT_NE(nullptr, CollisionGrid_Get(&collisions));
+
+        // A moving platform line on top of everything
+        collisions.Add_Dynamic_Collision_Line_417FA0(400, 300, 500, 300, eFloor_0);
+
+        int hits = 0;
+        for (int y = -40; y < 760; y += 13)
+        {
+            for (int x = -40; x < 1560; x += 17)
+            {
+                const FP rays[3][4] =
+                {
+                    { FP_FromInteger(x), FP_FromInteger(y), FP_FromInteger(x), FP_FromInteger(y + 60) },
+                    { FP_FromInteger(x), FP_FromInteger(y), FP_FromInteger(x + 50), FP_FromInteger(y) },
+                    { FP_FromDouble(x + 0.5), FP_FromInteger(y), FP_FromInteger(x - 375), FP_FromInteger(y + 15) },
+                };
+
+                for (const auto& ray : rays)
+                {
+                    PathLine* pBruteLine = nullptr;
+                    FP bruteX = {};
+                    FP bruteY = {};
+                    const auto bruteRet = collisions.Raycast_Lines(ray[0], ray[1], ray[2], ray[3], &pBruteLine, &bruteX, &bruteY, 0xF, false);
+
+                    PathLine* pGridLine = nullptr;
+                    FP gridX = {};
+                    FP gridY = {};
+                    const auto gridRet = collisions.Raycast_Lines(ray[0], ray[1], ray[2], ray[3], &pGridLine, &gridX, &gridY, 0xF, true);
+
+                    ASSERT_EQ(bruteRet, gridRet);
+                    ASSERT_EQ(pBruteLine, pGridLine);
+                    ASSERT_EQ(bruteX, gridX);
+                    ASSERT_EQ(bruteY, gridY);
+                    hits += bruteRet ? 1 : 0;
+                }
+            }
+        }
+
+        // Make sure the rays actually hit things
+        ASSERT_GT(hits, 1000);
+
+        collisions.dtor_4189F0();
+        ASSERT_EQ(nullptr, CollisionGrid_Get(&collisions));
+    }
+
+    void CollisionGridTests()
+    {
+        CollisionGrid_MatchesBruteForce_Test();
+    }
+}
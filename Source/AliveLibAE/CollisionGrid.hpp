@@ -0,0 +1,59 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include <vector>
+
+class Collisions;
+class PathLine;
+enum class LevelIds : __int16;
+
+namespace Test
+{
+    void CollisionGridTests();
+}
+
+// Uniform grid over the static lines of a path so a ray only has to test the lines whose bounding rects could
+// overlap its own. The dynamic lines (platforms, trap doors etc) come after the static ones in the array and move
+// around so they are always tested.
+class CollisionGrid
+{
+public:
+    CollisionGrid(const PathLine* pLines, int lineCount);
+
+    // Sets indices to the static lines that could overlap the inclusive rect in ascending order, which is the
+    // order the brute force loop would have tested them in.
+    void Query(int minX, int minY, int maxX, int maxY, std::vector<int>& indices) const;
+
+    static const int kCellSize = 64;
+
+private:
+    int CellX(int x) const;
+    int CellY(int y) const;
+
+    int mLeft = 0;
+    int mTop = 0;
+    int mCellsOnX = 0;
+    int mCellsOnY = 0;
+
+    // Lines of cell i are mCellLines[mCellStart[i]] to mCellLines[mCellStart[i + 1]]
+    std::vector<int> mCellStart;
+    std::vector<int> mCellLines;
+
+    // Line indices are stamped with the query that found them so lines that span cells are only returned once
+    mutable std::vector<unsigned int> mLineStamps;
+    mutable unsigned int mQueryStamp = 0;
+};
+
+// Builds the grid for the static lines of a path, called once the lines have been copied in.
+void CollisionGrid_Build(const Collisions* pCollisions);
+void CollisionGrid_Free(const Collisions* pCollisions);
+
+// Returns the grid for these collisions or nullptr if there isn't one or the grid is turned off.
+const CollisionGrid* CollisionGrid_Get(const Collisions* pCollisions);
+
+// Fires the same set of rays at every path of a level with and without the grid, checks they hit the same
+// lines at the same points and logs the timings.
+void CollisionGrid_RunBenchmark(LevelIds levelId);
+
+// When false every ray is tested against every line like the original game.
+extern bool gCollisionGridEnabled;
@@ -6,6 +6,7 @@
 #include "Psx.hpp"
 #include "DebugHelpers.hpp"
 #include "Sys_common.hpp"
+#include "CollisionGrid.hpp"
 
 ALIVE_VAR(1, 0x5C1128, Collisions*, sCollisions_DArray_5C1128, nullptr);
 
@@ -31,11 +32,14 @@ Collisions* Collisions::ctor_418930(const CollisionInfo* pCollisionInfo, const B
         field_0_pArray[i].field_0_rect.w = 0;
         field_0_pArray[i].field_0_rect.h = 0;
     }
+
+    CollisionGrid_Build(this);
     return this;
 }
 
 void Collisions::dtor_4189F0()
 {
+    CollisionGrid_Free(this);
     ae_non_zero_free_495560(field_0_pArray);
 }
 
@@ -154,7 +158,7 @@ signed __int16 Collisions::Raycast_Real_417A60(FP /*X1*/, FP /*Y1*/, FP /*X2*/,
     return 0;
 }
 
-signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, FP Y2_16_16, PathLine** ppLine, FP * hitX, FP * hitY, unsigned int modeMask)
+signed __int16 Collisions::Raycast_Lines(FP X1_16_16, FP Y1_16_16, FP X2_16_16, FP Y2_16_16, PathLine** ppLine, FP * hitX, FP * hitY, unsigned int modeMask, bool bUseGrid)
 {
     // NOTE: The local static k256_dword_5BC034 is omitted since its actually just a constant of 256
 
@@ -182,33 +186,32 @@ signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, F
 
     PathLine* pNearestMatch = nullptr;
 
-    for (int i = 0; i < field_C_max_count; i++)
+    auto testLine = [&](PathLine* pLine)
     {
-        PathLine* pLine = &field_0_pArray[i];
         if (!(1 << (pLine->field_8_type % 32) & modeMask))
         {
             // Not a match on type
-            continue;
+            return;
         }
 
         if (std::min(pLine->field_0_rect.x, pLine->field_0_rect.w) > maxX)
         {
-            continue;
+            return;
         }
 
         if (std::max(pLine->field_0_rect.x, pLine->field_0_rect.w) < minX)
         {
-            continue;
+            return;
         }
 
         if (std::min(pLine->field_0_rect.y, pLine->field_0_rect.h) > maxY)
         {
-            continue;
+            return;
         }
 
         if (std::max(pLine->field_0_rect.y, pLine->field_0_rect.h) < minY)
         {
-            continue;
+            return;
         }
 
         Fixed_24_8 xDiffCurrent(pLine->field_0_rect.w - pLine->field_0_rect.x);
@@ -217,7 +220,7 @@ signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, F
         Fixed_24_8 det = (xDiffCurrent * yDiff) - (xDiff * yDiffCurrent);
         if (det.Abs() < epslion)
         {
-            continue;
+            return;
         }
 
         Fixed_24_8 unknown1 =
@@ -228,24 +231,24 @@ signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, F
         {
             if (unknown1 < Fixed_24_8(0))
             {
-                continue;
+                return;
             }
 
             if (unknown1 > det)
             {
-                continue;
+                return;
             }
         }
         else
         {
             if (unknown1 > Fixed_24_8(0))
             {
-                continue;
+                return;
             }
 
             if (unknown1 < det)
             {
-                continue;
+                return;
             }
         }
 
@@ -257,24 +260,24 @@ signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, F
         {
             if (unknown2 < Fixed_24_8(0))
             {
-                continue;
+                return;
             }
 
             if (unknown2 > det)
             {
-                continue;
+                return;
             }
         }
         else
         {
             if (unknown2 > Fixed_24_8(0))
             {
-                continue;
+                return;
             }
 
             if (unknown2 < det)
             {
-                continue;
+                return;
             }
         }
 
@@ -285,7 +288,30 @@ signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, F
             nearestMatch = unknown1;
             pNearestMatch = pLine;
         }
+    };
+
+    const CollisionGrid* pGrid = bUseGrid ? CollisionGrid_Get(this) : nullptr;
+    if (pGrid)
+    {
+        static std::vector<int> sCandidates;
+        pGrid->Query(minX, minY, maxX, maxY, sCandidates);
+        for (int idx : sCandidates)
+        {
+            testLine(&field_0_pArray[idx]);
+        }
 
+        // Dynamic lines come after the static ones so they are still tested in the same order
+        for (int i = field_8_item_count; i < field_C_max_count; i++)
+        {
+            testLine(&field_0_pArray[i]);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < field_C_max_count; i++)
+        {
+            testLine(&field_0_pArray[i]);
+        }
     }
 
     if (nearestMatch < Fixed_24_8(2))
@@ -299,21 +325,23 @@ signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, F
 
         *ppLine = pNearestMatch;
 
-#if DEVELOPER_MODE
-        DebugAddRaycast({ X1_16_16,Y1_16_16,X2_16_16,Y2_16_16,*hitX,*hitY, *ppLine, modeMask });
-#endif
-
         return TRUE;
     }
 
     *ppLine = nullptr;
 
+    return FALSE;
+}
+
+signed __int16 Collisions::Raycast_Impl(FP X1_16_16, FP Y1_16_16, FP X2_16_16, FP Y2_16_16, PathLine** ppLine, FP * hitX, FP * hitY, unsigned int modeMask)
+{
+    const signed __int16 ret = Raycast_Lines(X1_16_16, Y1_16_16, X2_16_16, Y2_16_16, ppLine, hitX, hitY, modeMask, true);
 
 #if DEVELOPER_MODE
     DebugAddRaycast({ X1_16_16,Y1_16_16,X2_16_16,Y2_16_16,*hitX,*hitY, *ppLine, modeMask });
 #endif
 
-    return FALSE;
+    return ret;
 }
 
 BOOL Collisions::Raycast_417A60(FP X1_16_16, FP Y1_16_16, FP X2_16_16, FP Y2_16_16, PathLine** ppLine, FP* hitX, FP* hitY, unsigned int modeMask)
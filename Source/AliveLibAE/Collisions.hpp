@@ -59,6 +59,9 @@ public:
     EXPORT PathLine* PreviousLine_4180A0(PathLine* pLine);
     EXPORT PathLine* NextLine_418180(PathLine* pLine);
     signed __int16 Raycast_Impl(FP X1, FP Y1, FP X2, FP Y2, PathLine** ppLine, FP * hitX, FP * hitY, unsigned int modeMask);
+
+    // Raycast_Impl without recording the ray for the debug overlay, bUseGrid = false tests every line.
+    signed __int16 Raycast_Lines(FP X1, FP Y1, FP X2, FP Y2, PathLine** ppLine, FP * hitX, FP * hitY, unsigned int modeMask, bool bUseGrid);
 public:
     PathLine* field_0_pArray;
     WORD field_4_current_item_count;
@@ -9,6 +9,13 @@
 #include "ScreenManager.hpp"
 #include "ResourceManager.hpp"
 #include "Abe.hpp"
+#include "FramePacer.hpp"
+#include "AnimationFrameCache.hpp"
+#include "ResourceHeapIndex.hpp"
+#include "ResourcePrefetch.hpp"
+#if USE_SDL2_SOUND
+#include "Sound/SDLSoundSystem.hpp"
+#endif
 
 void DDCheat_ForceLink() { }
 
@@ -353,7 +360,64 @@ void DDCheat::Update_415780()
                 gMap_5C3030.field_4_current_camera,
                 sGnFrame_5C1B84);
 
-            
+            const FramePacerStats& frameStats = GetFramePacer().Stats();
+            DebugStr_4F5560(
+                "\nframe=%.2fms jitter=%.2fms cpu=%.2fms",
+                frameStats.mFrameTimeMs,
+                frameStats.mJitterMs,
+                frameStats.mCpuTimeMs);
+
+            if (AnimationFrameCache* pFrameCache = AnimFrameCache_Get())
+            {
+                const AnimFrameCacheStats& cacheStats = pFrameCache->Stats();
+                DebugStr_4F5560(
+                    "\nanim cache hit=%u miss=%u skip=%u %uKB",
+                    cacheStats.mHits,
+                    cacheStats.mMisses,
+                    cacheStats.mUploadsSkipped,
+                    static_cast<unsigned int>(cacheStats.mBytesUsed / 1024));
+            }
+
+            ResourceHeapStats& heapStats = ResourceHeap_Stats();
+            ResourceHeap_MeasureFree(heapStats);
+            DebugStr_4F5560(
+                "\nheap free=%uKB largest=%uKB frag=%u%% blocks=%u",
+                heapStats.mFreeBytes / 1024,
+                heapStats.mLargestFreeBlock / 1024,
+                heapStats.mFreeBytes ? 100 - static_cast<unsigned int>((static_cast<unsigned long long>(heapStats.mLargestFreeBlock) * 100) / heapStats.mFreeBytes) : 0,
+                heapStats.mFreeBlocks);
+            DebugStr_4F5560(
+                "\nheap alloc=%.1fus max=%.1fus fail=%u defrag=%.2fms",
+                heapStats.mAllocs ? heapStats.mTotalAllocUs / heapStats.mAllocs : 0.0,
+                heapStats.mMaxAllocUs,
+                heapStats.mFailedAllocs,
+                heapStats.mLastCompactionMs);
+
+            if (ResourcePrefetcher* pPrefetcher = ResourcePrefetch_Get())
+            {
+                const ResourcePrefetchStats prefetchStats = pPrefetcher->Stats();
+                const unsigned int prefetchHits = prefetchStats.mHits + prefetchStats.mLateHits;
+                const unsigned int prefetchLoads = prefetchHits + prefetchStats.mMisses;
+                DebugStr_4F5560(
+                    "\nprefetch hit=%u%% late=%u miss=%u unused=%u held=%uKB",
+                    prefetchLoads ? (prefetchHits * 100) / prefetchLoads : 0,
+                    prefetchStats.mLateHits,
+                    prefetchStats.mMisses,
+                    prefetchStats.mUnused,
+                    static_cast<unsigned int>(prefetchStats.mBytesHeld / 1024));
+            }
+
+#if USE_SDL2_SOUND
+            if (sDSound_BBC344)
+            {
+                const SDLAudioStats audioStats = sDSound_BBC344->Stats();
+                DebugStr_4F5560(
+                    "\naudio latency=%.1fms target=%.1fms underruns=%u",
+                    audioStats.mLatencyMs,
+                    audioStats.mTargetLatencyMs,
+                    audioStats.mUnderruns);
+            }
+#endif
 
 #if DEVELOPER_MODE
             if (sActiveHero_5C1B68 && gMap_5C3030.field_0_current_level != LevelIds::eMenu_0)
@@ -15,6 +15,7 @@ DynamicArray* DynamicArray::ctor_40CA60(__int16 startingSize)
     field_0_array = reinterpret_cast<void**>(ae_malloc_non_zero_4954F0(startingSize * sizeof(void*)));
     field_4_used_size = 0;
     field_6_max_size = 0;
+    field_A_removed_count = 0;
 
     if (field_0_array)
     {
@@ -115,6 +116,7 @@ void DynamicArrayIter::Remove_At_Iter_40CCA0()
 {
     field_4_idx--;
     field_0_pDynamicArray->field_4_used_size--;
+    field_0_pDynamicArray->field_A_removed_count++;
 
     // Overwrite the items to remove with the item from the end
     field_0_pDynamicArray->field_0_array[field_4_idx] = field_0_pDynamicArray->field_0_array[field_0_pDynamicArray->field_4_used_size];
@@ -25,7 +25,10 @@ public:
 private:
     __int16 field_6_max_size;
     __int16 field_8_expand_size;
-    // padding
+public:
+    // Was padding, counts removals so users that remember indices can tell when items have been swapped around
+    unsigned __int16 field_A_removed_count;
+private:
 
     friend class DynamicArrayIter;
 };
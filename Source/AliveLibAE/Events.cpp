@@ -4,6 +4,7 @@
 #include "Animation.hpp" // TODO: Move BaseAnimatedWithPhysicsGameObject to its own file
 #include "BaseAliveGameObject.hpp"
 #include "DebugHelpers.hpp"
+#include "ObjectGrid.hpp"
 #include <gmock/gmock.h>
 
 struct EventsArray
@@ -92,9 +93,6 @@ EXPORT void CC Events_Reset_Active_422DA0()
     sEventsToUse_5BC1D4 = !sEventsToUse_5BC1D4;
 }
 
-const int kGridMapWidth = 375;
-const int kGridMapHeight = 260;
-
 EXPORT BaseAnimatedWithPhysicsGameObject* CC Event_Is_Event_In_Range_422C30(__int16 eventType, FP xpos, FP ypos, __int16 scale)
 {
     BaseGameObject* pObj = sEventPtrs_5BC124.field_0_events[sEventsToUse_5BC1D4].field_0_event_ptrs[eventType];
@@ -13,6 +13,7 @@
 #include "stdlib.hpp"
 #include "Slig.hpp"
 #include "ExplosionSet.hpp"
+#include "ObjectGrid.hpp"
 
 Explosion* Explosion::ctor_4A1200(FP xpos, FP ypos, FP scale, __int16 bSmall)
 {
@@ -107,14 +108,9 @@ void Explosion::DealBlastDamage_4A1BD0(PSX_RECT* pRect)
     expandedRect.y += FP_GetExponent(field_BC_ypos);
     expandedRect.h += FP_GetExponent(field_BC_ypos);
 
-    for (int idx = 0; idx < gBaseAliveGameObjects_5C1B7C->Size(); idx++)
+    ObjectsNear<BaseAliveGameObject> nearObjs(gBaseAliveGameObjects_5C1B7C, expandedRect);
+    while (BaseAliveGameObject* pObj = nearObjs.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(idx);
-        if (!pObj)
-        {
-            break;
-        }
-
         if (pObj->field_6_flags.Get(BaseGameObject::eIsBaseAliveGameObject_Bit6))
         {
             PSX_RECT boundRect = {};
@@ -83,6 +83,7 @@
 #include "ColourfulMeter.hpp"
 #include "SecurityDoor.hpp"
 #include "LaughingGas.hpp"
+#include "ObjectTypeIndex.hpp"
 
 template<size_t arraySize>
 struct CompileTimeResourceList
@@ -300,15 +301,10 @@ EXPORT void CC Factory_LiftPoint_4D7250(Path_TLV* pTlv, Path*, TlvItemInfoUnion
     else
     {
         Path_LiftPoint* pLiftTlv = static_cast<Path_LiftPoint*>(pTlv);
-        for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+        ObjectsOfType<BaseGameObject> liftPoints(gBaseGameObject_list_BB47C4, Types::eLiftPoint_78);
+        while (BaseGameObject* pObj = liftPoints.Next())
         {
-            BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-            if (!pObj)
-            {
-                break;
-            }
-
-            if (!(pObj->field_6_flags.Get(BaseGameObject::eDead_Bit3)) && pObj->field_4_typeId == Types::eLiftPoint_78)
+            if (!(pObj->field_6_flags.Get(BaseGameObject::eDead_Bit3)))
             {
                 // Is there already an existing LiftPoint object for this TLV?
                 LiftPoint* pLiftPoint = static_cast<LiftPoint*>(pObj);
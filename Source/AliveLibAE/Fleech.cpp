@@ -21,6 +21,8 @@
 #include "Sfx.hpp"
 #include "SlamDoor.hpp"
 #include "Sound/Midi.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "ObjectGrid.hpp"
 
 ALIVE_VAR(1, 0x5BC20C, BYTE, sFleechRandomIdx_5BC20C, 0);
 ALIVE_VAR(1, 0x5BC20E, short, sFleechCount_5BC20E, 0);
@@ -580,18 +582,10 @@ void Fleech::M_Sleeping_0_42F0B0()
 
 void Fleech::M_WakingUp_1_42F270()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> snoozeParticles(gBaseGameObject_list_BB47C4, Types::eSnoozeParticle_124);
+    while (BaseGameObject* pObj = snoozeParticles.Next())
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eSnoozeParticle_124)
-        {
-            static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
-        }
+        static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
     }
 
     if (field_108_next_motion != -1)
@@ -2037,6 +2031,7 @@ void Fleech::TongueUpdate_42BD30()
                 }
                 pTarget->field_B8_xpos -= (pTarget->field_B8_xpos - field_B8_xpos) * FP_FromDouble(0.25);
                 pTarget->field_BC_ypos -= (pTarget->field_BC_ypos - field_BC_ypos) * FP_FromDouble(0.25);
+                ObjectGrid_OnObjectMoved(pTarget);
                 break;
 
             case 6:
@@ -2045,6 +2040,7 @@ void Fleech::TongueUpdate_42BD30()
                 pTarget->field_20_animation.field_4_flags.Clear(AnimFlags::eBit3_Render);
                 pTarget->field_B8_xpos = field_B8_xpos;
                 pTarget->field_BC_ypos = field_BC_ypos;
+                ObjectGrid_OnObjectMoved(pTarget);
                 if (pTarget == sActiveHero_5C1B68)
                 {
                     sActiveHero_5C1B68->FleechDeath_459350();
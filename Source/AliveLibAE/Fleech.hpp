@@ -317,6 +317,11 @@ private:
 public:
     EXPORT void vOnFrame_42BC50(signed __int16* pData);
 
+    __int16 BrainState() const
+    {
+        return field_124_brain_state;
+    }
+
 private:
     int field_118_tlvInfo;
     int field_11C_obj_id;
@@ -27,6 +27,7 @@
 #include "ParticleBurst.hpp"
 #include "Switch.hpp"
 #include "Sys_common.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_ARY(1, 0x5523A0, TFlyingSligFn, 26, sFlyingSlig_motion_table_5523A0,
 {
@@ -112,6 +113,11 @@ bool FlyingSlig::BrainIs(TFlyingSligFn fn)
     return ::BrainIs(fn, field_29C_brain_state, sFlyingSligAITable);
 }
 
+const char* FlyingSlig::BrainName() const
+{
+    return ::BrainName(field_29C_brain_state, sFlyingSligAITable);
+}
+
 FlyingSlig* FlyingSlig::ctor_4342B0(Path_FlyingSlig* pTlv, int tlvInfo)
 {
     //BaseCtor_4340B0(9); // Omitted for direct call
@@ -670,19 +676,10 @@ void FlyingSlig::vUpdate_434AD0()
 
         if (field_158_obj_id != -1)
         {
-            for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_158_obj_id);
+            if (pObj)
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
-                {
-                    break;
-                }
-
-                if (pObj->field_C_objectId == field_158_obj_id)
-                {
-                    field_158_obj_id = pObj->field_8_object_id;
-                    break;
-                }
+                field_158_obj_id = pObj->field_8_object_id;
             }
         }
     }
@@ -3410,47 +3407,39 @@ __int16 FlyingSlig::TryPullLever_439DB0()
     const short rect_h = FP_GetExponent(rect_h_fp);
     const short rect_y = FP_GetExponent(rect_y_fp);
 
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> levers(gBaseGameObject_list_BB47C4, Types::eLever_139);
+    while (BaseGameObject* pObj = levers.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
+        auto pAliveObj = static_cast<BaseAliveGameObject*>(pObj);
 
-        if (pObj->field_4_typeId == Types::eLever_139)
+        PSX_RECT bObjRect = {};
+        pAliveObj->vGetBoundingRect_424FD0(&bObjRect, 1);
+        if (rect_w <= bObjRect.w &&
+            rect_x >= bObjRect.x &&
+            rect_y >= bObjRect.y &&
+            rect_h <= bObjRect.h)
         {
-            auto pAliveObj = static_cast<BaseAliveGameObject*>(pObj);
-
-            PSX_RECT bObjRect = {};
-            pAliveObj->vGetBoundingRect_424FD0(&bObjRect, 1);
-            if (rect_w <= bObjRect.w &&
-                rect_x >= bObjRect.x &&
-                rect_y >= bObjRect.y &&
-                rect_h <= bObjRect.h)
+            if (field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX))
             {
-                if (field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX))
+                if (field_B8_xpos < pAliveObj->field_B8_xpos)
                 {
-                    if (field_B8_xpos < pAliveObj->field_B8_xpos)
-                    {
-                        return FALSE;
-                    }
-                    field_1C8 = (FP_FromInteger(45) * field_CC_sprite_scale) + pAliveObj->field_B8_xpos;
+                    return FALSE;
                 }
-                else
+                field_1C8 = (FP_FromInteger(45) * field_CC_sprite_scale) + pAliveObj->field_B8_xpos;
+            }
+            else
+            {
+                if (field_B8_xpos > pAliveObj->field_B8_xpos)
                 {
-                    if (field_B8_xpos > pAliveObj->field_B8_xpos)
-                    {
-                        return FALSE;
-                    }
-                    field_1C8 = pAliveObj->field_B8_xpos - (FP_FromInteger(47) * field_CC_sprite_scale);
+                    return FALSE;
                 }
-
-                field_1CC = pAliveObj->field_BC_ypos - (FP_FromInteger(23) * field_CC_sprite_scale);
-                field_158_obj_id = pAliveObj->field_8_object_id;
-                sub_436450();
-                return TRUE;
+                field_1C8 = pAliveObj->field_B8_xpos - (FP_FromInteger(47) * field_CC_sprite_scale);
             }
+
+            field_1CC = pAliveObj->field_BC_ypos - (FP_FromInteger(23) * field_CC_sprite_scale);
+            field_158_obj_id = pAliveObj->field_8_object_id;
+            sub_436450();
+            return TRUE;
         }
     }
     return FALSE;
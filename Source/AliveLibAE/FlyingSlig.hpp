@@ -304,6 +304,7 @@ public:
 
     void SetBrain(TFlyingSligFn fn);
     bool BrainIs(TFlyingSligFn fn);
+    const char* BrainName() const;
 
 private:
     Path_FlyingSlig field_118_data;
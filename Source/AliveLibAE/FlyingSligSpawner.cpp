@@ -93,19 +93,10 @@ void FlyingSligSpawner::vUpdate_433E10()
         field_40_bFirstUpdate &= ~2;
         if (field_24_spawned_slig_id != -1)
         {
-            for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_24_spawned_slig_id, Types::eFlyingSlig_54);
+            if (pObj)
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
-                {
-                    break;
-                }
-
-                if (pObj->field_4_typeId == Types::eFlyingSlig_54 && pObj->field_C_objectId == field_24_spawned_slig_id)
-                {
-                    field_24_spawned_slig_id = pObj->field_8_object_id;
-                    break;
-                }
+                field_24_spawned_slig_id = pObj->field_8_object_id;
             }
         }
     }
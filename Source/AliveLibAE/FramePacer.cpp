@@ -0,0 +1,237 @@
+#include "stdafx.h"
+#include "FramePacer.hpp"
+#include "Sound/PsxSpuApi.hpp"
+#include <thread>
+#include <cmath>
+#include <gmock/gmock.h>
+
+int gFramePacer_VSyncRate = 60;
+bool gFramePacer_Sleep = true;
+
+FramePacer& GetFramePacer()
+{
+    static FramePacer sPacer;
+    return sPacer;
+}
+
+static double ToMilliseconds(FramePacer::TClock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+FramePacer::TClock::time_point FramePacer::Now() const
+{
+    return TClock::now();
+}
+
+void FramePacer::SleepOneMs()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+void FramePacer::UpdateSleepEstimate(double sleptMs)
+{
+    // Forget old samples every so often so a change in system load/timer resolution is picked up
+    if (mSleepSamples >= 1000)
+    {
+        mSleepSamples = 1;
+        mSleepM2 = 0.0;
+    }
+
+    mSleepSamples++;
+    const double delta = sleptMs - mSleepMeanMs;
+    mSleepMeanMs += delta / mSleepSamples;
+    mSleepM2 += delta * (sleptMs - mSleepMeanMs);
+
+    const double stdDev = std::sqrt(mSleepM2 / (mSleepSamples - 1));
+    mSleepEstimateMs = mSleepMeanMs + stdDev;
+}
+
+void FramePacer::WaitUntil(TClock::time_point deadline)
+{
+    for (;;)
+    {
+        // The SEQ player used to be ticked from the busy wait, it does its own 30ms gating so calling
+        // it between sleeps keeps the music timing the same without needing to spin. Not needed when
+        // the audio thread is playing the sequencer.
+        if (!SsExt_SeqOnAudioThread())
+        {
+            SsSeqCalledTbyT_4FDC80();
+        }
+
+        const TClock::time_point now = Now();
+        if (now >= deadline)
+        {
+            return;
+        }
+
+        if (!gFramePacer_Sleep || ToMilliseconds(deadline - now) <= mSleepEstimateMs)
+        {
+            // Not enough time left to trust a sleep not to overshoot
+            break;
+        }
+
+        SleepOneMs();
+        UpdateSleepEstimate(ToMilliseconds(Now() - now));
+    }
+
+    const TClock::time_point spinStart = Now();
+    TClock::time_point now = spinStart;
+    while (now < deadline)
+    {
+        now = Now();
+    }
+    mSpinMs += ToMilliseconds(now - spinStart);
+}
+
+int FramePacer::WaitForVSync(int vsyncCount)
+{
+    const TClock::time_point workEnd = Now();
+    if (!mStarted)
+    {
+        mStarted = true;
+        mLastReturn = workEnd;
+        mLastDeadline = workEnd;
+    }
+
+    if (vsyncCount <= 0)
+    {
+        // Not a paced frame (loading loops etc), start the schedule again from here
+        mLastDeadline = workEnd;
+    }
+    else
+    {
+        const int vsyncRate = gFramePacer_VSyncRate > 0 ? gFramePacer_VSyncRate : 60;
+        const auto period = std::chrono::duration_cast<TClock::duration>(std::chrono::duration<double>(static_cast<double>(vsyncCount) / vsyncRate));
+
+        TClock::time_point deadline = mLastDeadline + period;
+        if (workEnd > deadline + period)
+        {
+            // More than a whole frame behind, catching up would run frames back to back so drop the debt
+            deadline = workEnd;
+        }
+        else if (workEnd < deadline)
+        {
+            WaitUntil(deadline);
+        }
+        mLastDeadline = deadline;
+
+        const TClock::time_point frameEnd = Now();
+        const float targetMs = static_cast<float>(ToMilliseconds(period));
+        mStats.mFrameTimeMs = static_cast<float>(ToMilliseconds(frameEnd - mLastReturn));
+        mStats.mJitterMs += (std::fabs(mStats.mFrameTimeMs - targetMs) - mStats.mJitterMs) * 0.1f;
+        mStats.mWorkTimeMs = static_cast<float>(ToMilliseconds(workEnd - mLastReturn));
+        mStats.mCpuTimeMs = mStats.mWorkTimeMs + static_cast<float>(mSpinMs);
+        mSpinMs = 0.0;
+    }
+
+    const TClock::time_point end = Now();
+    const int elapsedMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(end - mLastReturn).count());
+    mLastReturn = end;
+    return elapsedMs;
+}
+
+namespace Test
+{
+    class FakeClockPacer : public FramePacer
+    {
+    public:
+        // Moves the clock on as if the game had spent this long on a frame.
+        void Work(double ms)
+        {
+            mNow += std::chrono::duration_cast<TClock::duration>(std::chrono::duration<double, std::milli>(ms));
+        }
+
+        double ElapsedMs() const
+        {
+            return ToMilliseconds(mNow - kStart);
+        }
+
+        int mSleeps = 0;
+
+    protected:
+        TClock::time_point Now() const override
+        {
+            // Reading the clock takes a little time so spins always end
+            mNow += std::chrono::microseconds(50);
+            return mNow;
+        }
+
+        void SleepOneMs() override
+        {
+            // Sleeps overshoot a bit like the real thing
+            mNow += std::chrono::microseconds(1100);
+            mSleeps++;
+        }
+
+    private:
+        const TClock::time_point kStart = TClock::time_point(std::chrono::seconds(1));
+        mutable TClock::time_point mNow = kStart;
+    };
+
+    static void Test_FramePacer_Deadlines()
+    {
+        const int oldVSyncRate = gFramePacer_VSyncRate;
+        const bool oldSleep = gFramePacer_Sleep;
+        gFramePacer_VSyncRate = 60;
+        gFramePacer_Sleep = true;
+
+        const double kFrameMs = 2 * 1000.0 / 60;
+
+        FakeClockPacer pacer;
+        pacer.WaitForVSync(2);
+        ASSERT_NEAR(kFrameMs, pacer.ElapsedMs(), 0.5);
+        ASSERT_GT(pacer.mSleeps, 0);
+
+        // Deadlines are absolute so the time spent working doesn't push the next frame back
+        pacer.Work(10.0);
+        const int elapsedMs = pacer.WaitForVSync(2);
+        ASSERT_NEAR(2 * kFrameMs, pacer.ElapsedMs(), 0.5);
+        ASSERT_EQ(static_cast<int>(kFrameMs), elapsedMs);
+        ASSERT_NEAR(kFrameMs, pacer.Stats().mFrameTimeMs, 0.5);
+        ASSERT_NEAR(10.0, pacer.Stats().mWorkTimeMs, 0.5);
+
+        // Late by less than a frame returns straight away and the next frame is back on the schedule
+        pacer.Work(kFrameMs + 5.0);
+        int sleeps = pacer.mSleeps;
+        pacer.WaitForVSync(2);
+        ASSERT_EQ(sleeps, pacer.mSleeps);
+        ASSERT_NEAR(3 * kFrameMs + 5.0, pacer.ElapsedMs(), 0.5);
+        pacer.WaitForVSync(2);
+        ASSERT_NEAR(4 * kFrameMs, pacer.ElapsedMs(), 0.5);
+
+        // Late by more than a frame drops the debt, the schedule starts again from the late frame
+        pacer.Work(3 * kFrameMs);
+        sleeps = pacer.mSleeps;
+        pacer.WaitForVSync(2);
+        ASSERT_EQ(sleeps, pacer.mSleeps);
+        const double droppedAtMs = pacer.ElapsedMs();
+        ASSERT_NEAR(7 * kFrameMs, droppedAtMs, 0.5);
+        pacer.WaitForVSync(2);
+        ASSERT_NEAR(droppedAtMs + kFrameMs, pacer.ElapsedMs(), 0.5);
+
+        // A count of 0 doesn't wait and restarts the schedule
+        pacer.Work(5.0);
+        const double restartMs = pacer.ElapsedMs();
+        pacer.WaitForVSync(0);
+        ASSERT_NEAR(restartMs, pacer.ElapsedMs(), 0.5);
+        pacer.WaitForVSync(1);
+        ASSERT_NEAR(restartMs + kFrameMs / 2, pacer.ElapsedMs(), 0.5);
+
+        // Without sleeping the whole wait is spun
+        gFramePacer_Sleep = false;
+        sleeps = pacer.mSleeps;
+        const double spinFromMs = pacer.ElapsedMs();
+        pacer.WaitForVSync(2);
+        ASSERT_EQ(sleeps, pacer.mSleeps);
+        ASSERT_NEAR(spinFromMs + kFrameMs, pacer.ElapsedMs(), 0.5);
+
+        gFramePacer_VSyncRate = oldVSyncRate;
+        gFramePacer_Sleep = oldSleep;
+    }
+
+    void FramePacerTests()
+    {
+        Test_FramePacer_Deadlines();
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include <chrono>
+
+namespace Test
+{
+    void FramePacerTests();
+}
+
+// Measured timings of the most recently paced frame, all in milliseconds.
+struct FramePacerStats
+{
+    float mFrameTimeMs = 0.0f;  // Time between the last two paced frames
+    float mJitterMs = 0.0f;     // Smoothed absolute difference between mFrameTimeMs and the target
+    float mWorkTimeMs = 0.0f;   // Time the game spent between the last two waits
+    float mCpuTimeMs = 0.0f;    // Work time plus the time spun while waiting, i.e the time a core was busy
+};
+
+// Replaces the busy wait PSX_VSync_4F6170 used to do. Frames are scheduled against an absolute
+// deadline so rounding/lateness doesn't accumulate, the bulk of the wait is spent sleeping and
+// only the final fraction of a millisecond (whatever sleep can't be trusted with) is spun.
+class FramePacer
+{
+public:
+    using TClock = std::chrono::steady_clock;
+
+    virtual ~FramePacer() = default;
+
+    // Waits until vsyncCount vblanks (at gFramePacer_VSyncRate) have passed since the previous paced frame.
+    // A count of 0 doesn't wait and just restarts the schedule from now.
+    // Returns the elapsed milliseconds since the previous call.
+    int WaitForVSync(int vsyncCount);
+
+    const FramePacerStats& Stats() const
+    {
+        return mStats;
+    }
+
+protected:
+    // Overridden by the tests to run the pacer against a fake clock.
+    virtual TClock::time_point Now() const;
+    virtual void SleepOneMs();
+
+private:
+    void WaitUntil(TClock::time_point deadline);
+    void UpdateSleepEstimate(double sleptMs);
+
+    TClock::time_point mLastReturn = {};
+    TClock::time_point mLastDeadline = {};
+    bool mStarted = false;
+
+    // How long a request to sleep for 1ms actually takes, mean and variance (Welford).
+    double mSleepMeanMs = 1.0;
+    double mSleepM2 = 0.0;
+    long long mSleepSamples = 1;
+    double mSleepEstimateMs = 2.0;
+
+    double mSpinMs = 0.0;
+    FramePacerStats mStats;
+};
+
+FramePacer& GetFramePacer();
+
+// Vertical blanks per second the VSync count is based on (PSX NTSC = 60).
+extern int gFramePacer_VSyncRate;
+
+// When false the pacer spins for the entire wait like the original game did.
+extern bool gFramePacer_Sleep;
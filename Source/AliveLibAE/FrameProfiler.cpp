@@ -0,0 +1,636 @@
+#include "stdafx.h"
+#include "FrameProfiler.hpp"
+#include "Function.hpp"
+#include "BaseGameObject.hpp"
+#include "BaseAliveGameObject.hpp"
+#include "Slig.hpp"
+#include "FlyingSlig.hpp"
+#include "NakedSlig.hpp"
+#include "Paramite.hpp"
+#include "Scrab.hpp"
+#include "Glukkon.hpp"
+#include "Mudokon.hpp"
+#include "Fleech.hpp"
+#include "Slog.hpp"
+#include "bmp.hpp"
+#include "PsxRender.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <tuple>
+#include <gmock/gmock.h>
+
+bool gFrameProfilerEnabled = false;
+int gFrameProfileTraceFrames = 120;
+int gUpdateCostSampleInterval = 0;
+
+static const char* kPhaseNames[] = { "Update", "Animate", "Render", "DrawOTag", "Display", "ScreenChange", "Loading" };
+static_assert(ALIVE_COUNTOF(kPhaseNames) == static_cast<int>(FramePhase::eCount), "A name is needed for each phase");
+
+static const char* kObjectCallNames[] = { "VUpdate", "VRender" };
+
+// How long the summary is averaged over
+const int kSummaryWindowMs = 500;
+
+static double ToUs(FrameProfiler::TClock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+bool FrameProfiler::OnGameThread() const
+{
+    return mFrameStarted && std::this_thread::get_id() == mGameThread;
+}
+
+void FrameProfiler::NewFrame(TClock::time_point now)
+{
+    if (mFrameStarted)
+    {
+        mWindowFrameUs += ToUs(now - mFrameStart);
+        mWindowFrames++;
+
+        if (mTraceFramesLeft > 0)
+        {
+            AddTraceEvent(kPhaseCount, 0, 0, mFrameStart, now);
+            mTraceFramesLeft--;
+            mTraceFinished = mTraceFramesLeft == 0;
+        }
+
+        if (now - mWindowStart >= std::chrono::milliseconds(kSummaryWindowMs))
+        {
+            UpdateSummary();
+            mWindowStart = now;
+        }
+    }
+    else
+    {
+        mGameThread = std::this_thread::get_id();
+        mWindowStart = now;
+        mWindowTypes.resize(kMaxTypes);
+        mFrameStarted = true;
+    }
+
+    if (mTraceFramesRequested > 0)
+    {
+        mTraceEvents.clear();
+        mTraceStart = now;
+        mTraceFramesLeft = mTraceFramesRequested;
+        mTraceFramesRequested = 0;
+        mTraceFinished = false;
+    }
+
+    mFrameStart = now;
+}
+
+void FrameProfiler::BeginPhase(FramePhase phase, TClock::time_point now)
+{
+    const int idx = static_cast<int>(phase);
+    if (OnGameThread() && mPhaseDepth[idx]++ == 0)
+    {
+        mPhaseStart[idx] = now;
+    }
+}
+
+void FrameProfiler::EndPhase(FramePhase phase, TClock::time_point now)
+{
+    const int idx = static_cast<int>(phase);
+    if (OnGameThread() && mPhaseDepth[idx] > 0 && --mPhaseDepth[idx] == 0)
+    {
+        mWindowPhaseUs[idx] += ToUs(now - mPhaseStart[idx]);
+        AddTraceEvent(idx, 0, 0, mPhaseStart[idx], now);
+    }
+}
+
+void FrameProfiler::AddObjectCall(FrameObjectCall call, Types type, TClock::time_point start, TClock::time_point end)
+{
+    if (!OnGameThread())
+    {
+        return;
+    }
+
+    const int typeIdx = std::min(std::max(static_cast<int>(type), 0), kMaxTypes - 1);
+    TypeTotals& totals = mWindowTypes[typeIdx];
+    totals.mUs[static_cast<int>(call)] += ToUs(end - start);
+    totals.mCalls[static_cast<int>(call)]++;
+    AddTraceEvent(-1, static_cast<int>(call), static_cast<int>(type), start, end);
+}
+
+void FrameProfiler::AddTraceEvent(int phase, int call, int type, TClock::time_point start, TClock::time_point end)
+{
+    if (mTraceFramesLeft > 0)
+    {
+        const TraceEvent event =
+        {
+            phase,
+            call,
+            type,
+            std::chrono::duration_cast<std::chrono::microseconds>(start - mTraceStart).count(),
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+        };
+        mTraceEvents.push_back(event);
+    }
+}
+
+void FrameProfiler::UpdateSummary()
+{
+    const double frames = std::max(mWindowFrames, 1);
+    mSummary = {};
+    mSummary.mFrameMs = mWindowFrameUs / frames / 1000.0;
+    for (int i = 0; i < kPhaseCount; i++)
+    {
+        mSummary.mPhaseMs[i] = mWindowPhaseUs[i] / frames / 1000.0;
+        mWindowPhaseUs[i] = 0.0;
+    }
+
+    std::vector<FrameProfileTypeCost> costs;
+    for (int i = 0; i < kMaxTypes; i++)
+    {
+        TypeTotals& totals = mWindowTypes[i];
+        const unsigned int calls = totals.mCalls[0] + totals.mCalls[1];
+        if (calls > 0)
+        {
+            const FrameProfileTypeCost cost = { static_cast<Types>(i), (totals.mUs[0] + totals.mUs[1]) / frames / 1000.0, calls / frames };
+            costs.push_back(cost);
+        }
+        totals = {};
+    }
+
+    std::sort(costs.begin(), costs.end(), [](const FrameProfileTypeCost& lhs, const FrameProfileTypeCost& rhs)
+    {
+        return lhs.mMs > rhs.mMs;
+    });
+
+    mSummary.mTopTypeCount = std::min(static_cast<int>(costs.size()), static_cast<int>(ALIVE_COUNTOF(mSummary.mTopTypes)));
+    std::copy(costs.begin(), costs.begin() + mSummary.mTopTypeCount, mSummary.mTopTypes);
+
+    mWindowFrames = 0;
+    mWindowFrameUs = 0.0;
+}
+
+void FrameProfiler::StartTrace(int frameCount)
+{
+    mTraceFramesRequested = std::max(frameCount, 1);
+}
+
+bool FrameProfiler::IsTracing() const
+{
+    return mTraceFramesLeft > 0 || mTraceFramesRequested > 0;
+}
+
+bool FrameProfiler::TraceFinished() const
+{
+    return mTraceFinished;
+}
+
+std::string FrameProfiler::TraceJson() const
+{
+    std::ostringstream json;
+    json << "{\"traceEvents\":[\n";
+    json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Game_Loop_467230\"}}";
+
+    int frame = 0;
+    for (const TraceEvent& event : mTraceEvents)
+    {
+        json << ",\n{\"name\":\"";
+        if (event.mPhase == kPhaseCount)
+        {
+            json << "Frame " << frame++;
+        }
+        else if (event.mPhase >= 0)
+        {
+            json << kPhaseNames[event.mPhase];
+        }
+        else
+        {
+            json << kObjectCallNames[event.mCall] << " " << event.mType;
+        }
+
+        json << "\",\"cat\":\"" << (event.mPhase >= 0 ? "frame" : "object") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+             << ",\"ts\":" << event.mStartUs << ",\"dur\":" << event.mDurationUs;
+        if (event.mPhase < 0)
+        {
+            json << ",\"args\":{\"type\":" << event.mType << "}";
+        }
+        json << "}";
+    }
+
+    json << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return json.str();
+}
+
+void FrameProfiler::ClearTrace()
+{
+    mTraceEvents.clear();
+    mTraceEvents.shrink_to_fit();
+    mTraceFramesLeft = 0;
+    mTraceFramesRequested = 0;
+    mTraceFinished = false;
+}
+
+const FrameProfileSummary& FrameProfiler::Summary() const
+{
+    return mSummary;
+}
+
+bool UpdateCostKey::operator < (const UpdateCostKey& rhs) const
+{
+    if (std::tie(mType, mMotion, mBrain) != std::tie(rhs.mType, rhs.mMotion, rhs.mBrain))
+    {
+        return std::tie(mType, mMotion, mBrain) < std::tie(rhs.mType, rhs.mMotion, rhs.mBrain);
+    }
+
+    // By name rather than by pointer so the report comes out in the same order every run
+    if (!mpBrainName || !rhs.mpBrainName)
+    {
+        return !mpBrainName && rhs.mpBrainName;
+    }
+    return strcmp(mpBrainName, rhs.mpBrainName) < 0;
+}
+
+UpdateCostKey UpdateCostHistogram::KeyOf(BaseGameObject* pObj)
+{
+    UpdateCostKey key = { pObj->field_4_typeId, -1, -1, nullptr };
+    if (pObj->field_6_flags.Get(BaseGameObject::eIsBaseAliveGameObject_Bit6))
+    {
+        key.mMotion = static_cast<BaseAliveGameObject*>(pObj)->field_106_current_motion;
+    }
+
+    switch (pObj->field_4_typeId)
+    {
+    case Types::eSlig_125:
+        key.mpBrainName = static_cast<Slig*>(pObj)->BrainName();
+        break;
+
+    case Types::eFlyingSlig_54:
+        key.mpBrainName = static_cast<FlyingSlig*>(pObj)->BrainName();
+        break;
+
+    case Types::eCrawlingSlig_26:
+        key.mpBrainName = static_cast<NakedSlig*>(pObj)->BrainName();
+        break;
+
+    case Types::eParamite_96:
+        key.mpBrainName = static_cast<Paramite*>(pObj)->BrainName();
+        break;
+
+    case Types::eScrab_112:
+        key.mpBrainName = static_cast<Scrab*>(pObj)->BrainName();
+        break;
+
+    case Types::eGlukkon_67:
+        key.mpBrainName = static_cast<Glukkon*>(pObj)->BrainName();
+        break;
+
+    case Types::eMudokon_110:
+    case Types::eMudokon2_81:
+        key.mBrain = static_cast<int>(static_cast<Mudokon*>(pObj)->field_18E_ai_state);
+        break;
+
+    case Types::eFleech_50:
+        key.mBrain = static_cast<Fleech*>(pObj)->BrainState();
+        break;
+
+    case Types::eSlog_126:
+        key.mBrain = static_cast<Slog*>(pObj)->BrainState();
+        break;
+
+    default:
+        break;
+    }
+    return key;
+}
+
+int UpdateCostHistogram::BucketOf(double us)
+{
+    int bucket = 0;
+    while (bucket < kBuckets - 1 && us >= static_cast<double>(1 << bucket))
+    {
+        bucket++;
+    }
+    return bucket;
+}
+
+void UpdateCostHistogram::Add(const UpdateCostKey& key, double us)
+{
+    Entry& entry = mEntries[key];
+    entry.mCalls++;
+    entry.mTotalUs += us;
+    entry.mMaxUs = std::max(entry.mMaxUs, us);
+    entry.mBuckets[BucketOf(us)]++;
+}
+
+const UpdateCostHistogram::Entry* UpdateCostHistogram::Find(const UpdateCostKey& key) const
+{
+    auto it = mEntries.find(key);
+    return it == mEntries.end() ? nullptr : &it->second;
+}
+
+std::string UpdateCostHistogram::Csv() const
+{
+    std::ostringstream csv;
+    csv << "type,motion,brain,calls,total_us,mean_us,max_us,<1us";
+    for (int i = 1; i < kBuckets - 1; i++)
+    {
+        csv << ",<" << (1 << i) << "us";
+    }
+    csv << ",>=" << (1 << (kBuckets - 2)) << "us\n";
+
+    for (const auto& it : mEntries)
+    {
+        const UpdateCostKey& key = it.first;
+        const Entry& entry = it.second;
+        csv << static_cast<int>(key.mType) << "," << key.mMotion << ",";
+        if (key.mpBrainName)
+        {
+            csv << key.mpBrainName;
+        }
+        else if (key.mBrain >= 0)
+        {
+            csv << key.mBrain;
+        }
+
+        csv << "," << entry.mCalls << "," << entry.mTotalUs << "," << (entry.mTotalUs / entry.mCalls) << "," << entry.mMaxUs;
+        for (unsigned int count : entry.mBuckets)
+        {
+            csv << "," << count;
+        }
+        csv << "\n";
+    }
+    return csv.str();
+}
+
+size_t UpdateCostHistogram::Size() const
+{
+    return mEntries.size();
+}
+
+FrameProfiler& FrameProfiler_Get()
+{
+    static FrameProfiler sProfiler;
+    return sProfiler;
+}
+
+UpdateCostHistogram& UpdateCostHistogram_Get()
+{
+    static UpdateCostHistogram sHistogram;
+    return sHistogram;
+}
+
+static bool sbSampleUpdateCosts = false;
+
+bool UpdateCost_SampleThisFrame()
+{
+    return sbSampleUpdateCosts;
+}
+
+static void WriteFile(const std::string& fileName, const std::string& data)
+{
+    FILE* hFile = fopen(fileName.c_str(), "wb");
+    if (hFile)
+    {
+        fwrite(data.data(), 1, data.size(), hFile);
+        fclose(hFile);
+        LOG_INFO("Wrote " << fileName);
+    }
+    else
+    {
+        LOG_ERROR("Failed to write " << fileName);
+    }
+}
+
+static void WriteTrace(FrameProfiler& profiler)
+{
+    static int sTraceCount = 0;
+    WriteFile("frame_profile_" + std::to_string(sTraceCount++) + ".json", profiler.TraceJson());
+    profiler.ClearTrace();
+}
+
+void FrameProfiler_NewFrame()
+{
+    static unsigned int sFrameNum = 0;
+    sbSampleUpdateCosts = gUpdateCostSampleInterval > 0 && (sFrameNum++ % gUpdateCostSampleInterval) == 0;
+
+    if (!gFrameProfilerEnabled)
+    {
+        return;
+    }
+
+    FrameProfiler& profiler = FrameProfiler_Get();
+    profiler.NewFrame(FrameProfiler::TClock::now());
+    if (profiler.TraceFinished())
+    {
+        WriteTrace(profiler);
+    }
+}
+
+void FrameProfiler_Flush()
+{
+    FrameProfiler& profiler = FrameProfiler_Get();
+    if (profiler.IsTracing())
+    {
+        WriteTrace(profiler);
+    }
+
+    if (UpdateCostHistogram_Get().Size() > 0)
+    {
+        WriteFile("update_costs.csv", UpdateCostHistogram_Get().Csv());
+    }
+}
+
+void FrameProfiler_DrawSummary(Bitmap* pBmp, int x, int y)
+{
+    if (!gFrameProfilerEnabled)
+    {
+        return;
+    }
+
+    const int kLineHeight = 16;
+    const FrameProfileSummary& summary = FrameProfiler_Get().Summary();
+    auto phaseMs = [&](FramePhase phase) { return summary.mPhaseMs[static_cast<int>(phase)]; };
+
+    char strBuffer[128] = {};
+    int line = 0;
+    sprintf(strBuffer, "frame %.2f upd %.2f anim %.2f rnd %.2f ms", summary.mFrameMs, phaseMs(FramePhase::eUpdate), phaseMs(FramePhase::eAnimate), phaseMs(FramePhase::eRender));
+    BMP_Draw_String_4F2230(pBmp, x, y + (line++ * kLineHeight), 0xFF80FFu, 1, strBuffer);
+
+    sprintf(strBuffer, "ot %.2f disp %.2f scr %.2f load %.2f ms", phaseMs(FramePhase::eDrawOTag), phaseMs(FramePhase::eDisplay), phaseMs(FramePhase::eScreenChange), phaseMs(FramePhase::eLoading));
+    BMP_Draw_String_4F2230(pBmp, x, y + (line++ * kLineHeight), 0xFF80FFu, 1, strBuffer);
+
+    for (int i = 0; i < summary.mTopTypeCount; i++)
+    {
+        const FrameProfileTypeCost& cost = summary.mTopTypes[i];
+        sprintf(strBuffer, "type %d %.2f ms x%.0f", static_cast<int>(cost.mType), cost.mMs, cost.mCalls);
+        BMP_Draw_String_4F2230(pBmp, x, y + (line++ * kLineHeight), 0xFF80FFu, 1, strBuffer);
+    }
+
+    if (FrameProfiler_Get().IsTracing())
+    {
+        BMP_Draw_String_4F2230(pBmp, x, y + (line++ * kLineHeight), 0xFF80FFu, 1, "tracing");
+    }
+
+    Add_Dirty_Area_4ED970(x, y, 320, line * kLineHeight);
+}
+
+FrameProfilePhaseScope::FrameProfilePhaseScope(FramePhase phase)
+    : mPhase(phase), mActive(gFrameProfilerEnabled)
+{
+    if (mActive)
+    {
+        FrameProfiler_Get().BeginPhase(mPhase, FrameProfiler::TClock::now());
+    }
+}
+
+FrameProfilePhaseScope::~FrameProfilePhaseScope()
+{
+    if (mActive)
+    {
+        FrameProfiler_Get().EndPhase(mPhase, FrameProfiler::TClock::now());
+    }
+}
+
+FrameProfileObjectScope::FrameProfileObjectScope(FrameObjectCall call, BaseGameObject* pObj)
+    : mCall(call),
+    mType(pObj->field_4_typeId),
+    mActive(gFrameProfilerEnabled),
+    mSampleCost(call == FrameObjectCall::eUpdate && sbSampleUpdateCosts)
+{
+    if (mSampleCost)
+    {
+        // The state the object is in before it updates decides what the update does
+        mCostKey = UpdateCostHistogram::KeyOf(pObj);
+    }
+
+    if (mActive || mSampleCost)
+    {
+        mStart = FrameProfiler::TClock::now();
+    }
+}
+
+FrameProfileObjectScope::~FrameProfileObjectScope()
+{
+    if (mActive || mSampleCost)
+    {
+        const FrameProfiler::TClock::time_point end = FrameProfiler::TClock::now();
+        if (mActive)
+        {
+            FrameProfiler_Get().AddObjectCall(mCall, mType, mStart, end);
+        }
+
+        if (mSampleCost)
+        {
+            UpdateCostHistogram_Get().Add(mCostKey, ToUs(end - mStart));
+        }
+    }
+}
+
+namespace Test
+{
+    static void FrameProfiler_Summary_Test()
+    {
+        using namespace std::chrono;
+        FrameProfiler profiler;
+        FrameProfiler::TClock::time_point now;
+
+        // 2 frames of 10ms, the update phase is entered again by the same frame and counted once
+        for (int frame = 0; frame < 2; frame++)
+        {
+            profiler.NewFrame(now);
+            profiler.BeginPhase(FramePhase::eUpdate, now);
+            profiler.BeginPhase(FramePhase::eUpdate, now + milliseconds(1));
+            profiler.AddObjectCall(FrameObjectCall::eUpdate, Types::eAbe_69, now, now + milliseconds(3));
+            profiler.AddObjectCall(FrameObjectCall::eRender, Types::eAbe_69, now + milliseconds(5), now + milliseconds(6));
+            profiler.AddObjectCall(FrameObjectCall::eUpdate, Types::eSlig_125, now, now + milliseconds(1));
+            profiler.EndPhase(FramePhase::eUpdate, now + milliseconds(2));
+            profiler.EndPhase(FramePhase::eUpdate, now + milliseconds(4));
+            now += milliseconds(10);
+        }
+
+        // Nothing is averaged until half a second has gone by
+        ASSERT_EQ(0.0, profiler.Summary().mFrameMs);
+        profiler.NewFrame(now + milliseconds(kSummaryWindowMs));
+
+        // The second frame took the extra half second
+        const FrameProfileSummary& summary = profiler.Summary();
+        ASSERT_NEAR((10.0 + 10.0 + kSummaryWindowMs) / 2.0, summary.mFrameMs, 0.01);
+        ASSERT_NEAR(4.0, summary.mPhaseMs[static_cast<int>(FramePhase::eUpdate)], 0.01);
+        ASSERT_EQ(0.0, summary.mPhaseMs[static_cast<int>(FramePhase::eRender)]);
+
+        ASSERT_EQ(2, summary.mTopTypeCount);
+        ASSERT_EQ(Types::eAbe_69, summary.mTopTypes[0].mType);
+        ASSERT_NEAR(4.0, summary.mTopTypes[0].mMs, 0.01);
+        ASSERT_NEAR(2.0, summary.mTopTypes[0].mCalls, 0.01);
+        ASSERT_EQ(Types::eSlig_125, summary.mTopTypes[1].mType);
+        ASSERT_NEAR(1.0, summary.mTopTypes[1].mMs, 0.01);
+    }
+
+    static void FrameProfiler_Trace_Test()
+    {
+        using namespace std::chrono;
+        FrameProfiler profiler;
+        FrameProfiler::TClock::time_point now;
+
+        profiler.NewFrame(now);
+        profiler.StartTrace(2);
+        ASSERT_TRUE(profiler.IsTracing());
+
+        for (int frame = 0; frame < 3; frame++)
+        {
+            now += milliseconds(1);
+            profiler.NewFrame(now);
+            profiler.BeginPhase(FramePhase::eDrawOTag, now);
+            profiler.EndPhase(FramePhase::eDrawOTag, now + microseconds(250));
+            profiler.AddObjectCall(FrameObjectCall::eRender, Types::eMudokon_110, now, now + microseconds(100));
+        }
+
+        // Only the 2 traced frames and what happened in them
+        ASSERT_TRUE(profiler.TraceFinished());
+        ASSERT_FALSE(profiler.IsTracing());
+
+        const std::string json = profiler.TraceJson();
+        ASSERT_NE(std::string::npos, json.find("{\"name\":\"DrawOTag\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":250}"));
+        ASSERT_NE(std::string::npos, json.find("{\"name\":\"VRender 110\",\"cat\":\"object\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":1000,\"dur\":100,\"args\":{\"type\":110}}"));
+        ASSERT_NE(std::string::npos, json.find("{\"name\":\"Frame 1\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":1000,\"dur\":1000}"));
+        ASSERT_EQ(std::string::npos, json.find("Frame 2"));
+        ASSERT_EQ(std::string::npos, json.find("\"ts\":2000"));
+    }
+
+    static void UpdateCostHistogram_Test()
+    {
+        ASSERT_EQ(0, UpdateCostHistogram::BucketOf(0.5));
+        ASSERT_EQ(1, UpdateCostHistogram::BucketOf(1.0));
+        ASSERT_EQ(2, UpdateCostHistogram::BucketOf(3.9));
+        ASSERT_EQ(11, UpdateCostHistogram::BucketOf(1024.0));
+        ASSERT_EQ(11, UpdateCostHistogram::BucketOf(100000.0));
+
+        UpdateCostHistogram histogram;
+        const UpdateCostKey walking = { Types::eSlig_125, 2, -1, "AI_Walking_21" };
+        const UpdateCostKey standing = { Types::eSlig_125, 0, -1, "AI_Walking_21" };
+        const UpdateCostKey mud = { Types::eMudokon_110, 0, 3, nullptr };
+        histogram.Add(walking, 2.0);
+        histogram.Add(walking, 6.0);
+        histogram.Add(standing, 0.25);
+        histogram.Add(mud, 2000.0);
+
+        ASSERT_EQ(3u, histogram.Size());
+        const UpdateCostHistogram::Entry* pWalking = histogram.Find(walking);
+        ASSERT_NE(nullptr, pWalking);
+        ASSERT_EQ(2u, pWalking->mCalls);
+        ASSERT_EQ(8.0, pWalking->mTotalUs);
+        ASSERT_EQ(6.0, pWalking->mMaxUs);
+        ASSERT_EQ(1u, pWalking->mBuckets[2]);
+        ASSERT_EQ(1u, pWalking->mBuckets[3]);
+
+        // Sorted by type, then motion
+        const std::string csv = histogram.Csv();
+        ASSERT_EQ(0u, csv.find("type,motion,brain,calls,total_us,mean_us,max_us,<1us,<2us,<4us,"));
+        ASSERT_NE(std::string::npos, csv.find(",<1024us,>=1024us\n"));
+        ASSERT_NE(std::string::npos, csv.find("\n110,0,3,1,2000,2000,2000,0,0,0,0,0,0,0,0,0,0,0,1\n125,0,AI_Walking_21,1,0.25,0.25,0.25,1,0,0,0,0,0,0,0,0,0,0,0\n125,2,AI_Walking_21,2,8,4,6,0,0,1,1,0,0,0,0,0,0,0,0\n"));
+    }
+
+    void FrameProfilerTests()
+    {
+        FrameProfiler_Summary_Test();
+        FrameProfiler_Trace_Test();
+        UpdateCostHistogram_Test();
+    }
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Bitmap;
+class BaseGameObject;
+enum class Types : __int16;
+
+namespace Test
+{
+    void FrameProfilerTests();
+}
+
+// The parts of a Game_Loop_467230 frame that are timed, a phase that is entered again while it is already
+// running is only counted once.
+enum class FramePhase
+{
+    eUpdate,       // VUpdate of every object
+    eAnimate,      // AnimationBase::AnimateAll_40AC20
+    eRender,       // VRender of the drawables and FG1s, which builds the OT
+    eDrawOTag,     // PSX_DrawOTag_4F6540 rasterising the OT
+    eDisplay,      // PSX_Display_Render_OT_41DDF0, includes eDrawOTag and presenting the frame
+    eScreenChange, // Map::ScreenChange_480B80
+    eLoading,      // ResourceManager::LoadingLoop_465590
+    eCount
+};
+
+enum class FrameObjectCall
+{
+    eUpdate,
+    eRender,
+    eCount
+};
+
+struct FrameProfileTypeCost
+{
+    Types mType;
+    double mMs; // Per frame
+    double mCalls; // Per frame
+};
+
+// Averages over the last half second or so, the same as the fps counter.
+struct FrameProfileSummary
+{
+    double mFrameMs = 0.0;
+    double mPhaseMs[static_cast<int>(FramePhase::eCount)] = {};
+    FrameProfileTypeCost mTopTypes[3] = {};
+    int mTopTypeCount = 0; // Object types with the most VUpdate and VRender time
+};
+
+// Times the phases of each frame and the VUpdate/VRender calls grouped by object type. Only the thread that
+// runs the game loop is timed. A trace of every phase and object call can be recorded for a number of frames
+// and written out in the Chrome trace event format (load it in chrome://tracing or Perfetto).
+class FrameProfiler
+{
+public:
+    using TClock = std::chrono::steady_clock;
+
+    // Ends the frame being timed and starts the next one.
+    void NewFrame(TClock::time_point now);
+
+    void BeginPhase(FramePhase phase, TClock::time_point now);
+    void EndPhase(FramePhase phase, TClock::time_point now);
+    void AddObjectCall(FrameObjectCall call, Types type, TClock::time_point start, TClock::time_point end);
+
+    // Records every phase and object call of the next frameCount frames.
+    void StartTrace(int frameCount);
+    bool IsTracing() const;
+    bool TraceFinished() const;
+    std::string TraceJson() const;
+    void ClearTrace();
+
+    const FrameProfileSummary& Summary() const;
+
+private:
+    static const int kMaxTypes = 1024;
+    static const int kPhaseCount = static_cast<int>(FramePhase::eCount);
+
+    struct TypeTotals
+    {
+        double mUs[static_cast<int>(FrameObjectCall::eCount)];
+        unsigned int mCalls[static_cast<int>(FrameObjectCall::eCount)];
+    };
+
+    struct TraceEvent
+    {
+        int mPhase;     // -1 for an object call, kPhaseCount for a whole frame
+        int mCall;
+        int mType;
+        long long mStartUs;
+        long long mDurationUs;
+    };
+
+    bool OnGameThread() const;
+    void AddTraceEvent(int phase, int call, int type, TClock::time_point start, TClock::time_point end);
+    void UpdateSummary();
+
+    std::thread::id mGameThread;
+    bool mFrameStarted = false;
+    TClock::time_point mFrameStart;
+    int mPhaseDepth[kPhaseCount] = {};
+    TClock::time_point mPhaseStart[kPhaseCount];
+
+    TClock::time_point mWindowStart;
+    int mWindowFrames = 0;
+    double mWindowFrameUs = 0.0;
+    double mWindowPhaseUs[kPhaseCount] = {};
+    std::vector<TypeTotals> mWindowTypes;
+
+    FrameProfileSummary mSummary;
+
+    int mTraceFramesLeft = 0;
+    int mTraceFramesRequested = 0;
+    bool mTraceFinished = false;
+    TClock::time_point mTraceStart;
+    std::vector<TraceEvent> mTraceEvents;
+};
+
+// The state an object was in when it was updated
+struct UpdateCostKey
+{
+    Types mType;
+    short mMotion;           // field_106_current_motion, -1 when the object isn't a BaseAliveGameObject
+    int mBrain;              // Brain state for creatures that keep it as a number, else -1
+    const char* mpBrainName; // Brain function for creatures that keep a function pointer, else nullptr
+
+    bool operator < (const UpdateCostKey& rhs) const;
+};
+
+// How long VUpdate took for each object type and the state it was in, for finding which creatures and which
+// of their states are worth optimising.
+class UpdateCostHistogram
+{
+public:
+    // Bucket 0 is under 1us, bucket n is 2^(n-1) to 2^n us and the last bucket is everything longer.
+    static const int kBuckets = 12;
+
+    struct Entry
+    {
+        unsigned int mCalls = 0;
+        double mTotalUs = 0.0;
+        double mMaxUs = 0.0;
+        unsigned int mBuckets[kBuckets] = {};
+    };
+
+    static UpdateCostKey KeyOf(BaseGameObject* pObj);
+    static int BucketOf(double us);
+
+    void Add(const UpdateCostKey& key, double us);
+    const Entry* Find(const UpdateCostKey& key) const;
+    std::string Csv() const;
+    size_t Size() const;
+
+private:
+    std::map<UpdateCostKey, Entry> mEntries;
+};
+
+FrameProfiler& FrameProfiler_Get();
+
+UpdateCostHistogram& UpdateCostHistogram_Get();
+
+// True when the VUpdate calls of this frame are being added to the update cost histogram.
+bool UpdateCost_SampleThisFrame();
+
+// Called at the start of each pass of the game loop, writes frame_profile_<n>.json when a trace finishes.
+void FrameProfiler_NewFrame();
+
+// Writes out a trace that is still being recorded and update_costs.csv if update costs were sampled.
+void FrameProfiler_Flush();
+
+// Summary lines drawn under the fps counter.
+void FrameProfiler_DrawSummary(Bitmap* pBmp, int x, int y);
+
+class FrameProfilePhaseScope
+{
+public:
+    explicit FrameProfilePhaseScope(FramePhase phase);
+    ~FrameProfilePhaseScope();
+
+private:
+    FramePhase mPhase;
+    bool mActive;
+};
+
+class FrameProfileObjectScope
+{
+public:
+    FrameProfileObjectScope(FrameObjectCall call, BaseGameObject* pObj);
+    ~FrameProfileObjectScope();
+
+private:
+    FrameObjectCall mCall;
+    Types mType;
+    bool mActive;
+    bool mSampleCost;
+    UpdateCostKey mCostKey;
+    FrameProfiler::TClock::time_point mStart;
+};
+
+// Set by the frame_profiler ini option, nothing is timed in builds without FRAME_PROFILER.
+extern bool gFrameProfilerEnabled;
+
+// Frames a trace records, a trace is started with F9 (F12 toggles fullscreen).
+extern int gFrameProfileTraceFrames;
+
+// Add every Nth frame's VUpdate calls to the update cost histogram, 0 or less turns it off.
+extern int gUpdateCostSampleInterval;
+
+#define FRAME_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FRAME_PROFILE_CONCAT(a, b) FRAME_PROFILE_CONCAT_IMPL(a, b)
+
+#if FRAME_PROFILER
+    #define FRAME_PROFILE_PHASE(phase) FrameProfilePhaseScope FRAME_PROFILE_CONCAT(frameProfilePhase_, __LINE__)(phase)
+    #define FRAME_PROFILE_OBJECT(call, pObj) FrameProfileObjectScope FRAME_PROFILE_CONCAT(frameProfileObject_, __LINE__)(call, pObj)
+    #define FRAME_PROFILE_NEW_FRAME() FrameProfiler_NewFrame()
+    #define FRAME_PROFILE_FLUSH() FrameProfiler_Flush()
+#else
+    #define FRAME_PROFILE_PHASE(phase)
+    #define FRAME_PROFILE_OBJECT(call, pObj)
+    #define FRAME_PROFILE_NEW_FRAME()
+    #define FRAME_PROFILE_FLUSH()
+#endif
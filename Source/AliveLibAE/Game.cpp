@@ -20,11 +20,16 @@
 #include "GameSpeak.hpp"
 #include "PathData.hpp"
 #include "DDCheat.hpp"
+#include "ObjectGrid.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "CollisionGrid.hpp"
+#include "ObjectIds.hpp"
 #include "QuikSave.hpp"
 #include "Io.hpp"
 #include "LvlArchive.hpp"
 #include "DDraw.hpp"
 #include "Sound/Midi.hpp"
+#include "Sound/Reverb.hpp"
 #include <atomic>
 #include <fstream>
 #include "DebugHelpers.hpp"
@@ -35,6 +40,7 @@
 #include <gmock/gmock.h>
 #include "CheatController.hpp"
 #include "FG1.hpp"
+#include "FrameProfiler.hpp"
 #include "PsxRender.hpp"
 #include "Slurg.hpp"
 #include "Movie.hpp"
@@ -92,9 +98,30 @@ ALIVE_VAR(1, 0x5c1b68, Abe *, sActiveHero_5C1B68, 0);
 
 bool gDebugHelpersEnabled = false;
 
+// Headless mode: no window/renderer, no OT rasterization and no frame cap. Used to run
+// demos/regression sessions as fast as the CPU allows on machines without a display.
+bool gHeadlessMode = false;
+
+// -frames=N stops the game loop after N frames, with or without -headless.
+unsigned int gFrameLimit = 0;
+
+// -bench_raycast=N fires a fixed set of rays at every path of level N then exits.
+LevelIds gRaycastBenchmarkLevel = LevelIds::eNone;
+
+// -bench_reverb times each reverb engine then exits.
+bool gReverbBenchmark = false;
+
+// -bench_object_ids times the object id table then exits.
+bool gObjectIdsBenchmark = false;
+
+// -bench_object_types times the object updates of the game loop with and without the type index.
+bool gObjectTypesBenchmark = false;
+
 #include "GameEnderController.hpp"
 #include "ColourfulMeter.hpp"
 #include "GasCountDown.hpp"
+#include "BaseAliveGameObject.hpp"
+#include "Math.hpp"
 
 EXPORT void CC Init_GameStates_43BF40()
 {
@@ -250,6 +277,17 @@ EXPORT int CC Game_End_Frame_4950F0(DWORD flags)
         Add_Dirty_Area_4ED970(0, 0, 640, 240);
     }
 
+#if FRAME_PROFILER
+    // Record a trace of the next frames
+    static bool sbTraceKeyDown = false;
+    const bool bTraceKeyDown = gFrameProfilerEnabled && Input_IsVKPressed_4EDD40(VK_F9);
+    if (bTraceKeyDown && !sbTraceKeyDown && !FrameProfiler_Get().IsTracing())
+    {
+        FrameProfiler_Get().StartTrace(gFrameProfileTraceFrames);
+    }
+    sbTraceKeyDown = bTraceKeyDown;
+#endif
+
     const double fps = Calculate_FPS_495250(sFrameCount_5CA300);
     CheckShiftCapslock_4953B0();
     if (sCommandLine_ShowFps_5CA4D0)
@@ -265,6 +303,13 @@ EXPORT int CC Game_End_Frame_4950F0(DWORD flags)
             sPSX_EMU_DrawEnvState_C3D080.field_0_clip.x + 4,
             sPSX_EMU_DrawEnvState_C3D080.field_0_clip.y + 4,
             static_cast<float>(fps));
+
+#if FRAME_PROFILER
+        FrameProfiler_DrawSummary(
+            pVram,
+            sPSX_EMU_DrawEnvState_C3D080.field_0_clip.x + 4,
+            sPSX_EMU_DrawEnvState_C3D080.field_0_clip.y + 4 + 16);
+#endif
     }
 
     Draw_Debug_Strings_4F2800();
@@ -311,9 +356,24 @@ EXPORT void CC Main_ParseCommandLineArguments_494EA0(const char* /*pCmdLineNotUs
 
     PSX_EMU_Set_Cd_Emulation_Paths_4FAA70(".", strDrive, strDrive);
 
-    const std::string windowTitle = WindowTitleAE();
-    Sys_WindowClass_Register_4EE22F("ABE_WINCLASS", windowTitle.c_str(), 32, 64, 640, 480);
-    Sys_Set_Hwnd_4F2C50(Sys_GetWindowHandle_4EE180());
+    if (pCommandLine && strstr(pCommandLine, "-headless"))
+    {
+        gHeadlessMode = true;
+    }
+
+    // -frames=N stops the game loop after N frames, 0 means run until the game exits
+    const char* pFrames = pCommandLine ? strstr(pCommandLine, "-frames=") : nullptr;
+    if (pFrames)
+    {
+        gFrameLimit = static_cast<unsigned int>(atoi(pFrames + strlen("-frames=")));
+    }
+
+    if (!gHeadlessMode)
+    {
+        const std::string windowTitle = WindowTitleAE();
+        Sys_WindowClass_Register_4EE22F("ABE_WINCLASS", windowTitle.c_str(), 32, 64, 640, 480);
+        Sys_Set_Hwnd_4F2C50(Sys_GetWindowHandle_4EE180());
+    }
 
     dword_5CA4D4 = 0;
     k1_dword_55EF90 = 1; // Global way to turn off semi trans rendering?
@@ -321,6 +381,31 @@ EXPORT void CC Main_ParseCommandLineArguments_494EA0(const char* /*pCmdLineNotUs
 
     if (pCommandLine)
     {
+        const char* pBenchRaycast = strstr(pCommandLine, "-bench_raycast=");
+        if (pBenchRaycast)
+        {
+            const int levelId = atoi(pBenchRaycast + strlen("-bench_raycast="));
+            if (levelId >= 0 && levelId < ALIVE_COUNTOF(sPathData_559660.paths))
+            {
+                gRaycastBenchmarkLevel = static_cast<LevelIds>(levelId);
+            }
+        }
+
+        if (strstr(pCommandLine, "-bench_reverb"))
+        {
+            gReverbBenchmark = true;
+        }
+
+        if (strstr(pCommandLine, "-bench_object_ids"))
+        {
+            gObjectIdsBenchmark = true;
+        }
+
+        if (strstr(pCommandLine, "-bench_object_types"))
+        {
+            gObjectTypesBenchmark = true;
+        }
+
         if (strstr(pCommandLine, "-ddfps"))
         {
             sCommandLine_ShowFps_5CA4D0 = true;
@@ -373,7 +458,15 @@ EXPORT void CC Main_ParseCommandLineArguments_494EA0(const char* /*pCmdLineNotUs
         PSX_EMU_Set_screen_mode_4F9420(2);
     }
 
-    Init_VGA_AndPsxVram_494690();
+    if (gHeadlessMode)
+    {
+        // No VGA/renderer, but the game still uploads into the emulated vram so it needs a pixel format
+        PSX_EMU_SetDispType_4F9960(2);
+    }
+    else
+    {
+        Init_VGA_AndPsxVram_494690();
+    }
     PSX_EMU_Init_4F9CD0(false);
     PSX_EMU_VideoAlloc_4F9D70();
     PSX_EMU_SetCallBack_4F9430(1, Game_End_Frame_4950F0);
@@ -524,6 +617,27 @@ EXPORT void CC Game_Run_466D40()
 
     camera.dtor_480E00();
 
+    if (gRaycastBenchmarkLevel != LevelIds::eNone)
+    {
+        // Nothing else has been started yet so it can go straight to shutting down
+        CollisionGrid_RunBenchmark(gRaycastBenchmarkLevel);
+        return;
+    }
+
+    if (gObjectIdsBenchmark)
+    {
+        ObjectIds_RunBenchmark();
+        return;
+    }
+
+#if USE_SDL2_SOUND
+    if (gReverbBenchmark)
+    {
+        Reverb_RunBenchmark();
+        return;
+    }
+#endif
+
     Input_Init_491BC0();
     short cameraId = 25;
 #if DEVELOPER_MODE
@@ -555,6 +669,11 @@ EXPORT void CC Game_Run_466D40()
     // Main loop start
     Game_Loop_467230();
 
+    if (gObjectTypesBenchmark)
+    {
+        ObjectTypeIndex_ReportBenchmark();
+    }
+
     // Shut down start
     Game_Free_LoadingIcon_482D40();
     DDCheat::ClearProperties_415390();
@@ -727,103 +846,184 @@ EXPORT void CC Game_Main_4949F0()
     Game_Shutdown_4F2C30();
 }
 
+static void Game_HashBytes(DWORD& hash, const void* pData, size_t size)
+{
+    // FNV-1a
+    const BYTE* pBytes = static_cast<const BYTE*>(pData);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ pBytes[i]) * 16777619u;
+    }
+}
+
+template<class T>
+static void Game_HashValue(DWORD& hash, const T& value)
+{
+    Game_HashBytes(hash, &value, sizeof(T));
+}
+
+DWORD Game_StateHash()
+{
+    DWORD hash = 2166136261u;
+    Game_HashValue(hash, sGnFrame_5C1B84);
+    Game_HashValue(hash, sRandomSeed_5D1E10);
+    Game_HashValue(hash, gMap_5C3030.field_0_current_level);
+    Game_HashValue(hash, gMap_5C3030.field_2_current_path);
+    Game_HashValue(hash, gMap_5C3030.field_4_current_camera);
+
+    if (!gBaseGameObject_list_BB47C4)
+    {
+        return hash;
+    }
+
+    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    {
+        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
+        if (!pObj)
+        {
+            break;
+        }
+
+        Game_HashValue(hash, pObj->field_4_typeId);
+        Game_HashValue(hash, pObj->field_6_flags.Raw());
+
+        if (pObj->field_6_flags.Get(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5))
+        {
+            auto pAnimObj = static_cast<BaseAnimatedWithPhysicsGameObject*>(pObj);
+            Game_HashValue(hash, pAnimObj->field_B8_xpos.fpValue);
+            Game_HashValue(hash, pAnimObj->field_BC_ypos.fpValue);
+            Game_HashValue(hash, pAnimObj->field_C4_velx.fpValue);
+            Game_HashValue(hash, pAnimObj->field_C8_vely.fpValue);
+        }
+
+        if (pObj->field_6_flags.Get(BaseGameObject::eIsBaseAliveGameObject_Bit6))
+        {
+            auto pAliveObj = static_cast<BaseAliveGameObject*>(pObj);
+            Game_HashValue(hash, pAliveObj->field_106_current_motion);
+            Game_HashValue(hash, pAliveObj->field_10C_health.fpValue);
+        }
+    }
+    return hash;
+}
+
 EXPORT void CC Game_Loop_467230()
 {
     dword_5C2F78 = 0;
     sBreakGameLoop_5C2FE0 = 0;
     bool bPauseMenuObjectFound = false;
+
+    const DWORD loopStartTicks = SYS_GetTicks();
+    unsigned int loopFrameCount = 0;
     while (!gBaseGameObject_list_BB47C4->IsEmpty())
     {
+        FRAME_PROFILE_NEW_FRAME();
+
         Events_Reset_Active_422DA0();
         Slurg::Clear_Slurg_Step_Watch_Points_449A90();
         bSkipGameObjectUpdates_5C2FA0 = 0;
 
         // Update objects
-        for (int baseObjIdx = 0; baseObjIdx < gBaseGameObject_list_BB47C4->Size(); baseObjIdx++)
         {
-            BaseGameObject* pBaseGameObject = gBaseGameObject_list_BB47C4->ItemAt(baseObjIdx);
-
-            if (!pBaseGameObject || bSkipGameObjectUpdates_5C2FA0)
+            FRAME_PROFILE_PHASE(FramePhase::eUpdate);
+            ObjectTypeIndexBenchmarkScope typeIndexBenchmark;
+            for (int baseObjIdx = 0; baseObjIdx < gBaseGameObject_list_BB47C4->Size(); baseObjIdx++)
             {
-                break;
-            }
+                BaseGameObject* pBaseGameObject = gBaseGameObject_list_BB47C4->ItemAt(baseObjIdx);
 
-            if (pBaseGameObject->field_6_flags.Get(BaseGameObject::eUpdatable_Bit2)
-                && pBaseGameObject->field_6_flags.Get(BaseGameObject::eDead_Bit3) == false
-                && (sNum_CamSwappers_5C1B66 == 0 || pBaseGameObject->field_6_flags.Get(BaseGameObject::eUpdateDuringCamSwap_Bit10)))
-            {
-                if (pBaseGameObject->field_1C_update_delay <= 0)
+                if (!pBaseGameObject || bSkipGameObjectUpdates_5C2FA0)
                 {
-                    if (pBaseGameObject == pPauseMenu_5C9300)
+                    break;
+                }
+
+                if (pBaseGameObject->field_6_flags.Get(BaseGameObject::eUpdatable_Bit2)
+                    && pBaseGameObject->field_6_flags.Get(BaseGameObject::eDead_Bit3) == false
+                    && (sNum_CamSwappers_5C1B66 == 0 || pBaseGameObject->field_6_flags.Get(BaseGameObject::eUpdateDuringCamSwap_Bit10)))
+                {
+                    if (pBaseGameObject->field_1C_update_delay <= 0)
                     {
-                        bPauseMenuObjectFound = true;
+                        if (pBaseGameObject == pPauseMenu_5C9300)
+                        {
+                            bPauseMenuObjectFound = true;
+                        }
+                        else
+                        {
+                            FRAME_PROFILE_OBJECT(FrameObjectCall::eUpdate, pBaseGameObject);
+                            pBaseGameObject->VUpdate();
+                            ObjectGrid_OnObjectUpdated(pBaseGameObject);
+                        }
                     }
                     else
                     {
-                        pBaseGameObject->VUpdate();
+                        pBaseGameObject->field_1C_update_delay--;
                     }
                 }
-                else
-                {
-                    pBaseGameObject->field_1C_update_delay--;
-                }
             }
         }
 
         // Animate everything
         if (sNum_CamSwappers_5C1B66 <= 0)
         {
+            FRAME_PROFILE_PHASE(FramePhase::eAnimate);
             AnimationBase::AnimateAll_40AC20(gObjList_animations_5C1A24);
         }
 
         PrimHeader** ppOtBuffer = gPsxDisplay_5C1130.field_10_drawEnv[gPsxDisplay_5C1130.field_C_buffer_index].field_70_ot_buffer;
 
-        // Render objects
-        for (int i=0; i < gObjList_drawables_5C1124->Size(); i++)
         {
-            BaseGameObject* pObj = gObjList_drawables_5C1124->ItemAt(i);
-            if (!pObj)
-            {
-                break;
-            }
+            FRAME_PROFILE_PHASE(FramePhase::eRender);
 
-            if (pObj->field_6_flags.Get(BaseGameObject::eDead_Bit3))
+            // Render objects
+            for (int i=0; i < gObjList_drawables_5C1124->Size(); i++)
             {
-                pObj->field_6_flags.Clear(BaseGameObject::eCantKill_Bit11);
-            }
-            else if (pObj->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
-            {
-                pObj->field_6_flags.Set(BaseGameObject::eCantKill_Bit11);
-                pObj->VRender(ppOtBuffer);
-            }
-        }
+                BaseGameObject* pObj = gObjList_drawables_5C1124->ItemAt(i);
+                if (!pObj)
+                {
+                    break;
+                }
 
-        // Render FG1's
-        for (int i=0; i < gFG1List_5D1E28->Size(); i++)
-        {
-            FG1* pFG1 = gFG1List_5D1E28->ItemAt(i);
-            if (!pFG1)
-            {
-                break;
+                if (pObj->field_6_flags.Get(BaseGameObject::eDead_Bit3))
+                {
+                    pObj->field_6_flags.Clear(BaseGameObject::eCantKill_Bit11);
+                }
+                else if (pObj->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
+                {
+                    FRAME_PROFILE_OBJECT(FrameObjectCall::eRender, pObj);
+                    pObj->field_6_flags.Set(BaseGameObject::eCantKill_Bit11);
+                    pObj->VRender(ppOtBuffer);
+                }
             }
 
-            if (pFG1->field_6_flags.Get(BaseGameObject::eDead_Bit3))
+            // Render FG1's
+            for (int i=0; i < gFG1List_5D1E28->Size(); i++)
             {
-                pFG1->field_6_flags.Clear(BaseGameObject::eCantKill_Bit11);
-            }
-            else if (pFG1->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
-            {
-                pFG1->field_6_flags.Set(BaseGameObject::eCantKill_Bit11);
-                pFG1->VRender(ppOtBuffer);
+                FG1* pFG1 = gFG1List_5D1E28->ItemAt(i);
+                if (!pFG1)
+                {
+                    break;
+                }
+
+                if (pFG1->field_6_flags.Get(BaseGameObject::eDead_Bit3))
+                {
+                    pFG1->field_6_flags.Clear(BaseGameObject::eCantKill_Bit11);
+                }
+                else if (pFG1->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
+                {
+                    FRAME_PROFILE_OBJECT(FrameObjectCall::eRender, pFG1);
+                    pFG1->field_6_flags.Set(BaseGameObject::eCantKill_Bit11);
+                    pFG1->VRender(ppOtBuffer);
+                }
             }
+
+            DebugFont_Flush_4DD050();
+            PSX_DrawSync_4F6280(0);
+            pScreenManager_5BB5F4->VRender(ppOtBuffer);
         }
-        
-        DebugFont_Flush_4DD050();
-        PSX_DrawSync_4F6280(0);
-        pScreenManager_5BB5F4->VRender(ppOtBuffer);
         SYS_EventsPump_494580(); // Exit checking?
 
-        gPsxDisplay_5C1130.PSX_Display_Render_OT_41DDF0();
+        {
+            FRAME_PROFILE_PHASE(FramePhase::eDisplay);
+            gPsxDisplay_5C1130.PSX_Display_Render_OT_41DDF0();
+        }
         
         // Destroy objects with certain flags
         for (short idx = 0; idx < gBaseGameObject_list_BB47C4->Size(); idx++)
@@ -852,7 +1052,10 @@ EXPORT void CC Game_Loop_467230()
 
         bPauseMenuObjectFound = false;
 
-        gMap_5C3030.ScreenChange_480B80();
+        {
+            FRAME_PROFILE_PHASE(FramePhase::eScreenChange);
+            gMap_5C3030.ScreenChange_480B80();
+        }
         sInputObject_5BD4E0.Update_45F040();
 
         if (sNum_CamSwappers_5C1B66 == 0)
@@ -864,6 +1067,12 @@ EXPORT void CC Game_Loop_467230()
         {
             break;
         }
+
+        loopFrameCount++;
+        if (gFrameLimit > 0 && loopFrameCount >= gFrameLimit)
+        {
+            break;
+        }
         
         // Enabled only for ddfast option
         if (byte_5CA4D2)
@@ -872,6 +1081,16 @@ EXPORT void CC Game_Loop_467230()
         }
     } // Main loop end
 
+    FRAME_PROFILE_FLUSH();
+
+    if (gHeadlessMode)
+    {
+        const DWORD elapsedTicks = SYS_GetTicks() - loopStartTicks;
+        const double simFps = elapsedTicks > 0 ? static_cast<double>(loopFrameCount) * 1000.0 / static_cast<double>(elapsedTicks) : 0.0;
+        LOG_INFO("Headless run simulated " << loopFrameCount << " frames in " << elapsedTicks << " ms (" << simFps << " fps)");
+        LOG_INFO("Headless run state hash " << std::hex << Game_StateHash() << std::dec);
+    }
+
     // Clear the screen to black
     PSX_RECT rect = {};
     rect.x = 0;
@@ -924,8 +1143,97 @@ namespace Test
 
     }
 
+    class StateHashTestObj : public BaseAliveGameObject
+    {
+    public:
+        virtual BaseGameObject* VDestructor(signed int) override
+        {
+            // Stub
+            return this;
+        }
+    };
+
+    static void Test_Game_StateHash()
+    {
+        const unsigned int oldFrame = sGnFrame_5C1B84;
+        const unsigned char oldSeed = sRandomSeed_5D1E10;
+        DynamicArrayT<BaseGameObject>* pOldList = gBaseGameObject_list_BB47C4;
+
+        StateHashTestObj objs[2];
+        DynamicArrayT<BaseGameObject> list;
+        list.ctor_40CA60(2);
+        for (StateHashTestObj& obj : objs)
+        {
+            obj.field_6_flags.Raw().all = 0;
+            obj.field_6_flags.Set(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5);
+            obj.field_6_flags.Set(BaseGameObject::eIsBaseAliveGameObject_Bit6);
+            obj.field_4_typeId = Types::eSlig_125;
+            obj.field_B8_xpos = FP_FromInteger(100);
+            obj.field_BC_ypos = FP_FromInteger(200);
+            obj.field_C4_velx = FP_FromInteger(0);
+            obj.field_C8_vely = FP_FromInteger(0);
+            obj.field_106_current_motion = 0;
+            obj.field_10C_health = FP_FromInteger(1);
+            list.Push_Back(&obj);
+        }
+        gBaseGameObject_list_BB47C4 = &list;
+        sGnFrame_5C1B84 = 100;
+        sRandomSeed_5D1E10 = 7;
+
+        const DWORD hash = Game_StateHash();
+        ASSERT_EQ(hash, Game_StateHash());
+
+        // Anything that changes what happens next changes the hash
+        objs[1].field_BC_ypos += FP_FromInteger(1);
+        ASSERT_NE(hash, Game_StateHash());
+        objs[1].field_BC_ypos -= FP_FromInteger(1);
+        ASSERT_EQ(hash, Game_StateHash());
+
+        objs[0].field_106_current_motion = 3;
+        ASSERT_NE(hash, Game_StateHash());
+        objs[0].field_106_current_motion = 0;
+
+        Math_NextRandom();
+        ASSERT_NE(hash, Game_StateHash());
+        sRandomSeed_5D1E10 = 7;
+
+        sGnFrame_5C1B84++;
+        ASSERT_NE(hash, Game_StateHash());
+        sGnFrame_5C1B84 = 100;
+        ASSERT_EQ(hash, Game_StateHash());
+
+        list.dtor_40CAD0();
+        gBaseGameObject_list_BB47C4 = pOldList;
+        sGnFrame_5C1B84 = oldFrame;
+        sRandomSeed_5D1E10 = oldSeed;
+    }
+
+    static void Test_Headless_MusicTime()
+    {
+        const bool oldHeadless = gHeadlessMode;
+        const unsigned int oldFrame = sGnFrame_5C1B84;
+
+        // The music clock only moves with the frames so it is the same however fast they are run
+        gHeadlessMode = true;
+        sGnFrame_5C1B84 = 50;
+        MusicController::SetBaseTimeStamp_47FD00();
+        MusicController::UpdateMusicTime_47F8B0();
+        ASSERT_EQ(0u, sMusicTime_5C3024);
+
+        sGnFrame_5C1B84 = 80;
+        MusicController::UpdateMusicTime_47F8B0();
+        ASSERT_EQ(30u, sMusicTime_5C3024);
+
+        gHeadlessMode = oldHeadless;
+        sGnFrame_5C1B84 = oldFrame;
+        MusicController::SetBaseTimeStamp_47FD00();
+        MusicController::UpdateMusicTime_47F8B0();
+    }
+
     void GameTests()
     {
         Test_PSX_getTPage_4F60E0();
+        Test_Game_StateHash();
+        Test_Headless_MusicTime();
     }
 }
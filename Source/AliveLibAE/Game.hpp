@@ -38,4 +38,6 @@ ALIVE_VAR_EXTERN(DynamicArrayT<BaseGameObject>*, ObjList_5C1B78);
 class ShadowZone;
 ALIVE_VAR_EXTERN(DynamicArrayT<ShadowZone>*, sShadowZone_dArray_5C1B80);
 
-extern bool gDebugHelpersEnabled;
\ No newline at end of file
+extern bool gDebugHelpersEnabled;
+extern bool gHeadlessMode;
+extern unsigned int gFrameLimit;
\ No newline at end of file
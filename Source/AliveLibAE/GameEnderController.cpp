@@ -12,6 +12,7 @@
 #include "Abe.hpp"
 #include "Alarm.hpp"
 #include "Function.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_VAR(1, 0x5C1BC6, short, sFeeco_Restart_KilledMudCount_5C1BC6, 0);
 ALIVE_VAR(1, 0x5C1BC8, short, sFeecoRestart_SavedMudCount_5C1BC8, 0);
@@ -19,18 +20,10 @@ ALIVE_VAR(1, 0x5C1BC8, short, sFeecoRestart_SavedMudCount_5C1BC8, 0);
 EXPORT void CC CreateGameEnderController_43B7A0()
 {
     // Exit if it already exists
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> gameEnderControllers(gBaseGameObject_list_BB47C4, Types::eGameEnderController_57);
+    if (gameEnderControllers.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eGameEnderController_57)
-        {
-            return;
-        }
+        return;
     }
 
     // Otherwise create one
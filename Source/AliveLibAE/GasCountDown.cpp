@@ -8,6 +8,7 @@
 #include "Abe.hpp"
 #include "Sfx.hpp"
 #include "DeathGas.hpp"
+#include "ObjectTypeIndex.hpp"
 
 const BYTE byte_5513D4[40] =
 {
@@ -189,17 +190,10 @@ void GasCountDown::DealDamage()
         if (-field_74_time_left > 2)
         {
             sActiveHero_5C1B68->VTakeDamage_408730(this);
-            for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+            ObjectsOfType<BaseAliveGameObject> mudokons(gBaseAliveGameObjects_5C1B7C, Types::eMudokon_110);
+            while (BaseAliveGameObject* pObj = mudokons.Next())
             {
-                BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                if (!pObj)
-                {
-                    break;
-                }
-                if (pObj->field_4_typeId == Types::eMudokon_110)
-                {
-                    pObj->VTakeDamage_408730(this);
-                }
+                pObj->VTakeDamage_408730(this);
             }
         }
         field_74_time_left = 0;
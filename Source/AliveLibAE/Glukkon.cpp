@@ -31,6 +31,7 @@
 #include "Blood.hpp"
 #include "Bullet.hpp"
 #include "Sound/Midi.hpp"
+#include "ObjectTypeIndex.hpp"
 
 #define MAKE_STRINGS(VAR) #VAR,
 const char* const sGlukkonMotionNames[25] =
@@ -172,7 +173,7 @@ signed int CC Glukkon::CreateFromSaveState_442830(const BYTE* pData)
     {
         pGlukkon->ctor_43F030(pTlv, pSaveState->field_44_tlvInfo);
     }
-    pGlukkon->field_4_typeId = pSaveState->field_8E_type_id;
+    ObjectTypeIndex_SetType(pGlukkon, pSaveState->field_8E_type_id);
     pGlukkon->field_C_objectId = pSaveState->field_4_object_id;
     if (pSaveState->field_40_bIsActiveChar)
     {
@@ -272,6 +273,11 @@ bool Glukkon::BrainIs(TGlukkonAIFn fn)
     return ::BrainIs(fn, field_20C_brain_state_fn, sGlukkonAITable);
 }
 
+const char* Glukkon::BrainName() const
+{
+    return ::BrainName(field_20C_brain_state_fn, sGlukkonAITable);
+}
+
 Glukkon* Glukkon::ctor_43F030(Path_Glukkon* pTlv, int tlvInfo)
 {
     ctor_408240(0);
@@ -1729,15 +1735,9 @@ __int16 Glukkon::AI_3_PlayerControlled_441A30()
             return field_210_sub_state;
         }
 
-        for (int i=0; i<gBaseAliveGameObjects_5C1B7C->Size(); i++)
         {
-            auto pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-            if (!pObj)
-            {
-                break;
-            }
-
-            if (pObj->field_4_typeId == Types::eSlig_125)
+            ObjectsOfType<BaseAliveGameObject> sligs(gBaseAliveGameObjects_5C1B7C, Types::eSlig_125);
+            while (BaseAliveGameObject* pObj = sligs.Next())
             {
                 pObj->field_6_flags.Set(BaseGameObject::eDead_Bit3);
             }
@@ -2005,7 +2005,7 @@ __int16 Glukkon::AI_5_WaitToSpawn_442490()
         field_6_flags.Set(BaseGameObject::eDrawable_Bit4);
         field_114_flags.Set(Flags_114::e114_Bit3_Can_Be_Possessed);
 
-        field_4_typeId = Types::eGlukkon_67;
+        ObjectTypeIndex_SetType(this, Types::eGlukkon_67);
 
         if (field_1A8_tlvData.field_1E_spawn_direction == 3)
         {
@@ -2086,12 +2086,12 @@ void Glukkon::Init_43F260()
         field_6_flags.Clear(BaseGameObject::eDrawable_Bit4);
         SetBrain(&Glukkon::AI_5_WaitToSpawn_442490);
         field_210_sub_state = 0;
-        field_4_typeId = Types::eNone_0;
+        ObjectTypeIndex_SetType(this, Types::eNone_0);
     }
     else
     {
         field_114_flags.Set(Flags_114::e114_Bit3_Can_Be_Possessed);
-        field_4_typeId = Types::eGlukkon_67;
+        ObjectTypeIndex_SetType(this, Types::eGlukkon_67);
         SetBrain(&Glukkon::AI_0_Calm_WalkAround_440B40);
         field_210_sub_state = 0;
     }
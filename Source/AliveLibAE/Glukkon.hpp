@@ -274,6 +274,9 @@ private:
     void SetBrain(TGlukkonAIFn fn);
     bool BrainIs(TGlukkonAIFn fn);
 
+public:
+    const char* BrainName() const;
+
 private:
     __int16 field_118_pPalAlloc[64];
     PSX_RECT field_198_pal_rect;
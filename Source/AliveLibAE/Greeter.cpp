@@ -17,6 +17,7 @@
 #include "MotionDetector.hpp"
 #include "Function.hpp"
 #include "Bullet.hpp"
+#include "ObjectTypeIndex.hpp"
 
 EXPORT Greeter* Greeter::ctor_4465B0(Path_Greeter* pTlv, int tlvInfo)
 {
@@ -666,31 +667,23 @@ BOOL Greeter::ZapIsNotBlocked_447240(BaseAliveGameObject* pUs, BaseAliveGameObje
 
 BaseAliveGameObject* Greeter::GetMudToZap_447690()
 {
-    for (int idx = 0; idx < gBaseAliveGameObjects_5C1B7C->Size(); idx++)
+    ObjectsOfType<BaseAliveGameObject> mudokons(gBaseAliveGameObjects_5C1B7C, Types::eMudokon_110);
+    while (BaseAliveGameObject* pObj = mudokons.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(idx);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eMudokon_110)
-        {
-            PSX_RECT bRect = {};
-            pObj->vGetBoundingRect_424FD0(&bRect, 1);
+        PSX_RECT bRect = {};
+        pObj->vGetBoundingRect_424FD0(&bRect, 1);
 
-            const FP xMid = FP_FromInteger((bRect.x + bRect.w) / 2);
-            const FP yMid = FP_FromInteger((bRect.y + bRect.h) / 2);
+        const FP xMid = FP_FromInteger((bRect.x + bRect.w) / 2);
+        const FP yMid = FP_FromInteger((bRect.y + bRect.h) / 2);
 
-            if (xMid - field_B8_xpos < (field_CC_sprite_scale * FP_FromInteger(60)) &&
-                field_B8_xpos - xMid < (field_CC_sprite_scale * FP_FromInteger(60)) &&
-                yMid - (field_BC_ypos - FP_FromInteger(4)) < (field_CC_sprite_scale * FP_FromInteger(60))&&
-                field_BC_ypos - FP_FromInteger(4) - yMid < (field_CC_sprite_scale * FP_FromInteger(60)) &&
-                !(sActiveHero_5C1B68->field_114_flags.Get(Flags_114::e114_Bit7_Electrocuted)) && 
-                !ZapIsNotBlocked_447240(this, pObj))
-            {
-                return pObj;
-            }
+        if (xMid - field_B8_xpos < (field_CC_sprite_scale * FP_FromInteger(60)) &&
+            field_B8_xpos - xMid < (field_CC_sprite_scale * FP_FromInteger(60)) &&
+            yMid - (field_BC_ypos - FP_FromInteger(4)) < (field_CC_sprite_scale * FP_FromInteger(60))&&
+            field_BC_ypos - FP_FromInteger(4) - yMid < (field_CC_sprite_scale * FP_FromInteger(60)) &&
+            !(sActiveHero_5C1B68->field_114_flags.Get(Flags_114::e114_Bit7_Electrocuted)) && 
+            !ZapIsNotBlocked_447240(this, pObj))
+        {
+            return pObj;
         }
     }
     return nullptr;
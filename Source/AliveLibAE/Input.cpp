@@ -12,6 +12,26 @@
 #include "VGA.hpp"
 #include "StringFormatters.hpp"
 #include "TouchController.hpp"
+#include "FramePacer.hpp"
+#include "PsxRenderSpans.hpp"
+#include "PsxRenderBands.hpp"
+#include "PsxRenderCommands.hpp"
+#include "AnimationFrameCache.hpp"
+#include "ObjectGrid.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "CollisionGrid.hpp"
+#include "ResourceHeapIndex.hpp"
+#include "ResourcePrefetch.hpp"
+#include "LvlArchive.hpp"
+#include "Masher.hpp"
+#include "MovieDecodeQueue.hpp"
+#include "CameraCache.hpp"
+#include "CamDecoder.hpp"
+#include "FrameProfiler.hpp"
+#if USE_SDL2_SOUND
+#include "Sound/SDLSoundSystem.hpp"
+#include "Sound/Reverb.hpp"
+#endif
 
 #if _WIN32
 #include <joystickapi.h>
@@ -943,9 +963,36 @@ std::vector<IniCustomSaveEntry> gCustomSaveEntries = {
     { "filter_screen", { &s_VGA_FilterScreen }, true },
 #if USE_SDL2_SOUND
     { "reverb", { &gReverbEnabled }, true },
+    { "reverb_engine", { &gReverbEngine }, false },
     { "audio_stereo", { &gAudioStereo }, true },
+    { "audio_buffer_samples", { &gAudioBufferSamples }, false },
+    { "audio_latency_ms", { &gAudioLatencyMs }, false },
+    { "audio_thread_sequencer", { &gAudioThreadSequencer }, true },
 #endif
     { "debug_mode", { &gDebugHelpersEnabled }, true },
+    { "vsync_rate", { &gFramePacer_VSyncRate }, false },
+    { "frame_pacer_sleep", { &gFramePacer_Sleep }, true },
+    { "renderer_simd", { &gRenderSimdEnabled }, true },
+    { "renderer_band_threads", { &gRenderBandThreads }, false },
+    { "renderer_compare_bands", { &gRenderBandsCompare }, true },
+    { "renderer_command_buffer", { &gRenderCommandBuffer }, true },
+    { "anim_frame_cache_kb", { &gAnimFrameCacheBudgetKb }, false },
+    { "object_grid", { &gObjectGridEnabled }, true },
+    { "object_type_index", { &gObjectTypeIndexEnabled }, true },
+    { "collision_grid", { &gCollisionGridEnabled }, true },
+    { "resource_heap_size_classes", { &gResourceHeapSizeClasses }, true },
+    { "resource_prefetch_kb", { &gResourcePrefetchBudgetKb }, false },
+    { "lvl_mmap", { &gLvlArchiveMmap }, true },
+    { "movie_decode_threads", { &gMovieDecodeThreads }, false },
+    { "movie_decode_ahead", { &gMovieDecodeAhead }, false },
+    { "camera_cache_kb", { &gCameraCacheKb }, false },
+    { "camera_predecode", { &gCameraPredecode }, true },
+    { "camera_fast_decode", { &gCameraFastDecode }, true },
+#if FRAME_PROFILER
+    { "frame_profiler", { &gFrameProfilerEnabled }, true },
+    { "frame_profile_trace_frames", { &gFrameProfileTraceFrames }, false },
+    { "update_cost_sample_interval", { &gUpdateCostSampleInterval }, false },
+#endif
     { "overwrite_ini_by_game", { &canOverwriteIni }, true },
 };
 
@@ -1079,6 +1126,11 @@ void NewParseSettingsIni()
         }
     }
 
+#if USE_SDL2_SOUND
+    // The sound system is already running
+    Reverb_SetEngine(gReverbEngine);
+#endif
+
 #if __ANDROID__ //TODO check/add support
     sJoystickEnabled_5C9F70 = 1;
 #endif
@@ -7,6 +7,7 @@
 #include "SwitchStates.hpp"
 #include "ObjectIds.hpp"
 #include "stdlib.hpp"
+#include "ObjectTypeIndex.hpp"
 
 EXPORT LiftMover* LiftMover::ctor_40CCD0(Path_LiftMover* pTlv, int tlvInfo)
 {
@@ -246,22 +247,14 @@ int LiftMover::vGetSaveState_40D240(LiftMover_State* pState)
 
 LiftPoint* LiftMover::GetLiftPoint_40D0F0()
 {
-    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsOfType<BaseAliveGameObject> liftPoints(gBaseAliveGameObjects_5C1B7C, Types::eLiftPoint_78);
+    while (BaseAliveGameObject* pObj = liftPoints.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
+        LiftPoint* pLift = static_cast<LiftPoint*>(pObj);
+        if (field_22_target_lift_point_id == pLift->field_278_lift_point_id)
         {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eLiftPoint_78)
-        {
-            LiftPoint* pLift = static_cast<LiftPoint*>(pObj);
-            if (field_22_target_lift_point_id == pLift->field_278_lift_point_id)
-            {
-                field_28_lift_id = pObj->field_8_object_id;
-                return pLift;
-            }
+            field_28_lift_id = pObj->field_8_object_id;
+            return pLift;
         }
     }
     return nullptr;
@@ -2,9 +2,24 @@
 #include "LvlArchive.hpp"
 #include "Function.hpp"
 #include "Psx.hpp"
+#include "ResourcePrefetch.hpp"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#if !_WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 const static int kSectorSize = 2048;
 
+bool gLvlArchiveMmap = true;
+
 ALIVE_VAR(1, 0x5CA4B0, BOOL, sbEnable_PCOpen_5CA4B0, FALSE);
 ALIVE_VAR(1, 0x5BC218, int, sWrappingFileIdx_5BC218, 0);
 ALIVE_VAR(1, 0x551D28, int, sTotalOpenedFilesCount_551D28, 3); // Starts at 3.. for some reason
@@ -52,6 +67,153 @@ EXPORT int CC File_close_4FA530(int /*hFile*/)
     return 0;
 }
 
+MappedFile::MappedFile(const char* pFilePath)
+{
+#if !_WIN32
+    // Same as IO_Open
+    if (strlen(pFilePath) >= 3 && pFilePath[0] == '.' && (pFilePath[1] == '/' || pFilePath[1] == '\\'))
+    {
+        pFilePath += 2;
+    }
+
+    const int fd = open(pFilePath, O_RDONLY);
+    if (fd == -1)
+    {
+        return;
+    }
+
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        void* pMapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMapped != MAP_FAILED)
+        {
+            mpData = static_cast<BYTE*>(pMapped);
+            mSize = static_cast<size_t>(fileStat.st_size);
+        }
+    }
+
+    // The mapping keeps the file open
+    close(fd);
+#else
+    (void)pFilePath;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if !_WIN32
+    if (mpData)
+    {
+        munmap(mpData, mSize);
+    }
+#endif
+}
+
+void MappedFile::WillNeed(size_t offset, size_t size) const
+{
+#if !_WIN32
+    if (!mpData || offset >= mSize)
+    {
+        return;
+    }
+
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset - (offset % pageSize);
+    const size_t end = std::min(offset + size, mSize);
+    madvise(mpData + start, end - start, MADV_WILLNEED);
+#else
+    (void)offset;
+    (void)size;
+#endif
+}
+
+// Never destroyed as the archives are freed by atexit handlers
+static std::map<const LvlArchive*, std::shared_ptr<MappedFile>>& ArchiveMappings()
+{
+    static auto pMappings = new std::map<const LvlArchive*, std::shared_ptr<MappedFile>>();
+    return *pMappings;
+}
+
+// Archives that open the same LVL share one mapping
+static std::map<std::string, std::weak_ptr<MappedFile>>& MappedFilesByPath()
+{
+    static auto pMappedFiles = new std::map<std::string, std::weak_ptr<MappedFile>>();
+    return *pMappedFiles;
+}
+
+static size_t Sector_To_File_Offset(int sector)
+{
+    // Go through the CD position conversions the same way seeking to the sector does
+    CdlLOC cdLoc = {};
+    PSX_Pos_To_CdLoc_4FADD0(sector, &cdLoc);
+    return static_cast<size_t>(PSX_CdLoc_To_Pos_4FAE40(&cdLoc)) * kSectorSize;
+}
+
+void LvlArchive::Map_Archive(const char* pFilePath)
+{
+    ArchiveMappings().erase(this);
+
+    // Loose files opened with sbEnable_PCOpen_5CA4B0 aren't in the LVL
+    if (!gLvlArchiveMmap || !pFilePath || sbEnable_PCOpen_5CA4B0 || RunningAsInjectedDll())
+    {
+        return;
+    }
+
+    std::shared_ptr<MappedFile> pMapping = MappedFilesByPath()[pFilePath].lock();
+    if (!pMapping)
+    {
+        pMapping = std::make_shared<MappedFile>(pFilePath);
+        if (!pMapping->Data())
+        {
+            return;
+        }
+        MappedFilesByPath()[pFilePath] = pMapping;
+    }
+    ArchiveMappings()[this] = pMapping;
+}
+
+bool LvlArchive::Is_Mapped() const
+{
+    return ArchiveMappings().count(this) != 0;
+}
+
+const BYTE* LvlArchive::Map_Sectors(int sector, int numSectors) const
+{
+    auto it = ArchiveMappings().find(this);
+    if (it == ArchiveMappings().end())
+    {
+        return nullptr;
+    }
+
+    // The last file can be short of a whole sector, let the normal read deal with it
+    const size_t offset = Sector_To_File_Offset(sector);
+    const size_t size = static_cast<size_t>(numSectors) * kSectorSize;
+    if (offset + size > it->second->Size())
+    {
+        return nullptr;
+    }
+    return it->second->Data() + offset;
+}
+
+const BYTE* LvlArchive::Map_File(const LvlFileRecord* hFile) const
+{
+    if (!hFile)
+    {
+        return nullptr;
+    }
+    return Map_Sectors(field_4_cd_pos + hFile->field_C_start_sector, hFile->field_10_num_sectors);
+}
+
+void LvlArchive::Will_Need(int sector, int numSectors) const
+{
+    auto it = ArchiveMappings().find(this);
+    if (it != ArchiveMappings().end())
+    {
+        it->second->WillNeed(Sector_To_File_Offset(sector), static_cast<size_t>(numSectors) * kSectorSize);
+    }
+}
+
 int LvlArchive::Read_File_433070(const char* pFileName, void* pBuffer)
 {
     return Read_File_4330A0(Find_File_Record_433160(pFileName), pBuffer);
@@ -64,6 +226,12 @@ int LvlArchive::Read_File_4330A0(LvlFileRecord* hFile, void* pBuffer)
         return 0;
     }
 
+    if (const BYTE* pMapped = Map_File(hFile))
+    {
+        memcpy(pBuffer, pMapped, hFile->field_10_num_sectors * kSectorSize);
+        return 1;
+    }
+
     CdlLOC cdLoc = {};
     PSX_Pos_To_CdLoc_4FADD0(field_4_cd_pos + hFile->field_C_start_sector, &cdLoc);
     PSX_CD_File_Seek_4FB1E0(2, &cdLoc);
@@ -84,6 +252,8 @@ int LvlArchive::Free_433130()
         ResourceManager::FreeResource_49C330(field_0_0x2800_res);
         field_0_0x2800_res = nullptr;
     }
+
+    ArchiveMappings().erase(this);
     return 0;
 }
 
@@ -110,6 +280,7 @@ int LvlArchive::Open_Archive_432E80(const char* fileName)
 
     if (!hFile)
     {
+        Map_Archive(nullptr);
         return 0;
     }
 
@@ -119,18 +290,35 @@ int LvlArchive::Open_Archive_432E80(const char* fileName)
     field_4_cd_pos = PSX_CdLoc_To_Pos_4FAE40(&cdLoc);
     PSX_CD_File_Seek_4FB1E0(2, &cdLoc);
 
+    Map_Archive(PSX_CD_OpenedFilePath());
+
     // Read the header
     ResourceManager::Header* pResHeader = ResourceManager::Get_Header_49C410(field_0_0x2800_res);
 
     // OG BUG: Header assumed to be 5 sectors, if its bigger then we are doomed
-    int bOk = PSX_CD_File_Read_4FB210(5, pResHeader);
-    if (PSX_CD_FileIOWait_4FB260(0) == -1)
+    int bOk = 0;
+    if (const BYTE* pMappedHeader = Map_Sectors(field_4_cd_pos, 5))
     {
-        bOk = 0;
+        memcpy(pResHeader, pMappedHeader, 5 * kSectorSize);
+        bOk = 1;
+    }
+    else
+    {
+        bOk = PSX_CD_File_Read_4FB210(5, pResHeader);
+        if (PSX_CD_FileIOWait_4FB260(0) == -1)
+        {
+            bOk = 0;
+        }
     }
 
     // Set ref count to 1 so ResourceManager won't kill it
     pResHeader->field_4_ref_count = 1;
+
+    // The resource manager only loads from this one
+    if (this == &sLvlArchive_5BC520)
+    {
+        ResourcePrefetch_OnArchiveOpened(bOk ? PSX_CD_OpenedFilePath() : nullptr);
+    }
     return bOk;
 }
 
@@ -183,3 +371,44 @@ LvlFileRecord* LvlArchive::Find_File_Record_433160(const char* pFileName)
     }
     return &pHeader->field_10_file_recs[fileRecordIndex];
 }
+
+namespace Test
+{
+    static void LvlArchive_MappedFile_Test()
+    {
+        const char* kFileName = "mapped_file_test.tmp";
+
+        std::vector<BYTE> fileData(3 * kSectorSize + 100);
+        for (size_t i = 0; i < fileData.size(); i++)
+        {
+            fileData[i] = static_cast<BYTE>(i * 13 + i / kSectorSize);
+        }
+
+        FILE* hFile = fopen(kFileName, "wb");
+        ASSERT_NE(nullptr, hFile);
+        fwrite(fileData.data(), 1, fileData.size(), hFile);
+        fclose(hFile);
+
+        {
+            MappedFile mapped(kFileName);
+#if !_WIN32
+            ASSERT_NE(nullptr, mapped.Data());
+            ASSERT_EQ(fileData.size(), mapped.Size());
+            ASSERT_EQ(0, memcmp(fileData.data(), mapped.Data(), fileData.size()));
+            mapped.WillNeed(kSectorSize + 10, 2 * kSectorSize);
+#else
+            ASSERT_EQ(nullptr, mapped.Data());
+#endif
+        }
+
+        MappedFile missing("mapped_file_test_missing.tmp");
+        ASSERT_EQ(nullptr, missing.Data());
+
+        remove(kFileName);
+    }
+
+    void LvlArchiveTests()
+    {
+        LvlArchive_MappedFile_Test();
+    }
+}
@@ -6,6 +6,40 @@
 EXPORT void CC LvlArchive_Static_init_432E00();
 EXPORT void CC static_lvl_init_480350();
 
+namespace Test
+{
+    void LvlArchiveTests();
+}
+
+// A whole file mapped read only in to memory, Data() is nullptr if it couldn't be mapped or mapping isn't
+// supported on this platform.
+class MappedFile
+{
+public:
+    explicit MappedFile(const char* pFilePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+    const BYTE* Data() const
+    {
+        return mpData;
+    }
+
+    size_t Size() const
+    {
+        return mSize;
+    }
+
+    // Hints that the range will be read soon so the pages can be read in ahead of time.
+    void WillNeed(size_t offset, size_t size) const;
+
+private:
+    BYTE* mpData = nullptr;
+    size_t mSize = 0;
+};
+
 struct LvlFileRecord
 {
     char field_0_file_name[12];
@@ -42,7 +76,19 @@ public:
     EXPORT int Read_File_433070(const char* pFileName, void* pBuffer);
     EXPORT int Read_File_4330A0(LvlFileRecord* hFile, void* pBuffer);
     EXPORT int Free_433130();
+
+    // Returns the sectors in the memory mapped LVL without copying them, or nullptr if the LVL isn't mapped
+    // or they are past the end of it. The sector is the same one Read_File_4330A0 would seek to, the data is
+    // read only and stays valid until the archive is freed or opened again.
+    const BYTE* Map_Sectors(int sector, int numSectors) const;
+    const BYTE* Map_File(const LvlFileRecord* hFile) const;
+    bool Is_Mapped() const;
+
+    // Lets the OS read the sectors in before they are needed, does nothing if the LVL isn't mapped.
+    void Will_Need(int sector, int numSectors) const;
 private:
+    void Map_Archive(const char* pFilePath);
+
     BYTE** field_0_0x2800_res;
 public:
     DWORD field_4_cd_pos;
@@ -52,3 +98,7 @@ ALIVE_ASSERT_SIZEOF(LvlArchive, 0x8);
 ALIVE_VAR_EXTERN(LvlArchive, sLvlArchive_5BC520);
 ALIVE_VAR_EXTERN(LvlArchive, stru_5C3110);
 ALIVE_VAR_EXTERN(BOOL, sbEnable_PCOpen_5CA4B0);
+
+// When true the LVL that is opened is mapped in to memory and files are copied or used straight from it
+// instead of being read.
+extern bool gLvlArchiveMmap;
@@ -25,6 +25,8 @@
 #include "Door.hpp"
 #include "Sound/PsxSpuApi.hpp"
 #include "Sys.hpp"
+#include "ResourcePrefetch.hpp"
+#include "CameraCache.hpp"
 #include <assert.h>
 
 void Map_ForceLink() { }
@@ -905,6 +907,9 @@ void Map::GoTo_Camera_481890()
         pResourceManager_5C1BB0->LoadingLoop_465590(FALSE);
     }
 
+    ResourcePrefetch_OnCameraChanged(*this);
+    CameraCache_OnCameraChanged(*this);
+
     if (field_10_screen_change_effect != CameraSwapEffects::eEffect5_1_FMV && field_10_screen_change_effect != CameraSwapEffects::eEffect11_Unknown)
     {
         if (field_1E_door)
@@ -28,3 +28,4 @@ namespace Test
 }
 
 ALIVE_ARY_EXTERN(unsigned char, 256, sRandomBytes_546744);
+ALIVE_VAR_EXTERN(unsigned char, sRandomSeed_5D1E10);
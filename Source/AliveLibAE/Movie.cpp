@@ -13,6 +13,9 @@
 #include "Masher.hpp"
 #include "DDraw.hpp"
 #include "VGA.hpp"
+#include "Game.hpp"
+#include "MovieDecodeQueue.hpp"
+#include <memory>
 
 // Inputs on the controller that can be used for aborting skippable movies
 const unsigned int MOVIE_SKIPPER_GAMEPAD_INPUTS = (InputCommands::eUnPause_OrConfirm | InputCommands::eBack | InputCommands::ePause);
@@ -283,6 +286,65 @@ static Masher* Open_DDV(const char* pMovieName)
     return pMasher;
 }
 
+// Copies a 640x480 frame decoded by Masher_MMX_Decode_4EAC40 to a surface that may have padded rows
+static void Copy_DDV_Frame(const MovieFrame& frame, void* pSurface, int pitchBytes)
+{
+    const int rowBytes = 640 * sizeof(WORD);
+    for (int y = 0; y < 480; y++)
+    {
+        memcpy(static_cast<BYTE*>(pSurface) + (y * pitchBytes), frame.mPixels.data() + (y * rowBytes), rowBytes);
+    }
+}
+
+static std::unique_ptr<MovieDecodeQueue> DDV_StartDecodeQueue()
+{
+    if (gMovieDecodeAhead <= 0)
+    {
+        return nullptr;
+    }
+
+    // Audio is decoded along with the video unless it was already off, the presenter turning it off later only
+    // means the decoded audio isn't used
+    const bool bDecodeAudio = !bNoAudio_5CA1F4;
+    size_t audioBytes = 0;
+    if (bDecodeAudio)
+    {
+        const int format = pMasher_audio_header_5CA1E0->field_0_audio_format;
+        audioBytes = gMasher_single_audio_frame_size_5CA240 * ((format & 1) ? 2 : 1) * ((format & 2) ? 2 : 1);
+    }
+
+    std::unique_ptr<MovieDecodeQueue> pQueue(new MovieDecodeQueue(gMovieDecodeAhead, 640 * 480 * sizeof(WORD), audioBytes));
+    Masher* pMasher = pMasherInstance_5CA1EC;
+    pQueue->Start([pMasher, bDecodeAudio, audioBytes](MovieFrame& frame)
+    {
+        Masher_MMX_Decode_4EAC40(pMasher, frame.mPixels.data());
+
+        frame.mHasAudio = false;
+        if (bDecodeAudio)
+        {
+            void* pDecompressedAudioFrame = Masher::GetDecompressedAudioFrame_4EAC60(pMasher);
+            if (pDecompressedAudioFrame)
+            {
+                memcpy(frame.mAudio.data(), pDecompressedAudioFrame, audioBytes);
+                frame.mHasAudio = true;
+            }
+        }
+
+        frame.mLast = !Masher_ReadNextFrame_4EAC20(pMasher); // read audio and video frame
+    });
+    return pQueue;
+}
+
+static void DDV_LogDecodeStats(MovieDecodeQueue& queue)
+{
+    const MovieDecodeStats stats = queue.Stats();
+    const unsigned int taken = stats.mFramesShown + stats.mFramesDropped;
+    LOG_INFO("Movie frames decoded " << stats.mFramesDecoded << " shown " << stats.mFramesShown
+        << " dropped " << stats.mFramesDropped << " starved " << stats.mStarved << " decoder waits " << stats.mDecoderWaits
+        << " queue depth avg " << (taken ? static_cast<float>(stats.mDepthTotal) / taken : 0.0f)
+        << " min " << stats.mMinDepth << " max " << stats.mMaxDepth);
+}
+
 static void Render_DDV_Frame(Bitmap& tmpBmp)
 {
     // Copy into the emulated vram - when FMV ends the "screen" still have the last video frame "stick"
@@ -352,18 +414,48 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
     BMP_New_4F1990(&tmpBmp, 640, 480, 15, 0);
 #endif
 
+    std::unique_ptr<MovieDecodeQueue> pDecodeQueue;
     if (DDV_StartAudio_493DF0() && Masher_ReadNextFrame_4EAC20(pMasherInstance_5CA1EC) && Masher_ReadNextFrame_4EAC20(pMasherInstance_5CA1EC))
     {
+        // From here on the decode thread owns the masher
+        pDecodeQueue = DDV_StartDecodeQueue();
+
+        bool bRunningLate = false;
         const int dword_5CA244 = SYS_GetTicks();
         for (;;)
         {
             sFrameInterleaveNum_5CA23C++;
 
+            MovieFrame* pFrame = nullptr;
+            bool bShowFrame = true;
+            if (pDecodeQueue)
+            {
+                pFrame = pDecodeQueue->Pop();
+                if (!pFrame)
+                {
+                    break;
+                }
+
+                // Skip drawing frames while behind as long as the next one is already decoded, the last frame
+                // is always drawn as it stays on screen after the movie
+                bShowFrame = !bRunningLate || pFrame->mLast || pDecodeQueue->Depth() == 0;
+            }
+
             // Lock the back buffer
 #if USE_SDL2
-            SDL_LockSurface(tmpBmp.field_0_pSurface);
-            Masher_MMX_Decode_4EAC40(pMasherInstance_5CA1EC, tmpBmp.field_0_pSurface->pixels);
-            SDL_UnlockSurface(tmpBmp.field_0_pSurface);
+            if (bShowFrame)
+            {
+                SDL_LockSurface(tmpBmp.field_0_pSurface);
+                if (pFrame)
+                {
+                    Copy_DDV_Frame(*pFrame, tmpBmp.field_0_pSurface->pixels, tmpBmp.field_0_pSurface->pitch);
+                }
+                else
+                {
+                    Masher_MMX_Decode_4EAC40(pMasherInstance_5CA1EC, tmpBmp.field_0_pSurface->pixels);
+                }
+                SDL_UnlockSurface(tmpBmp.field_0_pSurface);
+            }
 #else
             DDSURFACEDESC surfaceDesc = {};
             surfaceDesc.dwSize = sizeof(DDSURFACEDESC);
@@ -376,7 +468,17 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
                 }
             }
             // Decompress the frame and "render" it into the back buffer
-            Masher_MMX_Decode_4EAC40(pMasherInstance_5CA1EC, FAILED(hr) ? nullptr : surfaceDesc.lpSurface);       
+            if (pFrame)
+            {
+                if (SUCCEEDED(hr) && bShowFrame)
+                {
+                    Copy_DDV_Frame(*pFrame, surfaceDesc.lpSurface, surfaceDesc.lPitch);
+                }
+            }
+            else
+            {
+                Masher_MMX_Decode_4EAC40(pMasherInstance_5CA1EC, FAILED(hr) ? nullptr : surfaceDesc.lpSurface);
+            }
             // Unlock the back buffer
 
             if (SUCCEEDED(hr))
@@ -387,7 +489,16 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
 
             if (!bNoAudio_5CA1F4)
             {
-                void* pDecompressedAudioFrame = (BYTE *)Masher::GetDecompressedAudioFrame_4EAC60(pMasherInstance_5CA1EC);
+                void* pDecompressedAudioFrame = nullptr;
+                if (pFrame)
+                {
+                    pDecompressedAudioFrame = pFrame->mHasAudio ? pFrame->mAudio.data() : nullptr;
+                }
+                else
+                {
+                    pDecompressedAudioFrame = (BYTE *)Masher::GetDecompressedAudioFrame_4EAC60(pMasherInstance_5CA1EC);
+                }
+
                 if (pDecompressedAudioFrame)
                 {
                     if (GetSoundAPI().SND_LoadSamples(&sDDV_SoundEntry_5CA208, sampleOffsetPos_5CA238, (unsigned char*)pDecompressedAudioFrame, gMasher_single_audio_frame_size_5CA240) < 0)
@@ -442,19 +553,35 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
                 Input_IsVKPressed_4EDD40(VK_RETURN);
             }
 
+            if (bShowFrame)
+            {
 #if USE_SDL2
-            Render_DDV_Frame(tmpBmp);
+                Render_DDV_Frame(tmpBmp);
 #else
-            DD_Flip_4F15D0();
+                DD_Flip_4F15D0();
 #endif
+            }
+
+            int bMoreFrames = 0;
+            if (pFrame)
+            {
+                bMoreFrames = !pFrame->mLast;
+                pDecodeQueue->Release(pFrame, bShowFrame);
+            }
+            else
+            {
+                bMoreFrames = Masher_ReadNextFrame_4EAC20(pMasherInstance_5CA1EC); // read audio and video frame
+            }
 
-            const int bMoreFrames = Masher_ReadNextFrame_4EAC20(pMasherInstance_5CA1EC); // read audio and video frame
             if (bNoAudio_5CA1F4)
             {
                 while ((signed int)(SYS_GetTicks() - dword_5CA244) <= (1000 * sFrameInterleaveNum_5CA23C / pMasher_header_5CA1E4->field_8_frame_rate))
                 {
                     // Wait for the amount of time the frame would take to display at the given framerate
                 }
+
+                // More than 2 frames past when this frame should have finished
+                bRunningLate = (signed int)(SYS_GetTicks() - dword_5CA244) > (1000 * (sFrameInterleaveNum_5CA23C + 2) / pMasher_header_5CA1E4->field_8_frame_rate);
             }
             else
             {
@@ -503,6 +630,8 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
 
                         if (total_audio_offset_5CA1F0 < dword_5CA200)
                         {
+                            // The audio is more than 2 frames past this one
+                            bRunningLate = dword_5CA200 - total_audio_offset_5CA1F0 > 2 * gMasher_single_audio_frame_size_5CA240;
                             break;
                         }
                     }
@@ -530,6 +659,13 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
         DD_Flip_4940F0();
     }
 
+    if (pDecodeQueue)
+    {
+        pDecodeQueue->Stop();
+        DDV_LogDecodeStats(*pDecodeQueue);
+        pDecodeQueue.reset();
+    }
+
     if (sDDV_SoundEntry_5CA208.field_4_pDSoundBuffer)
     {
         GetSoundAPI().SND_Free(&sDDV_SoundEntry_5CA208);
@@ -546,6 +682,12 @@ EXPORT char CC DDV_Play_Impl_4932E0(const char* pMovieName)
 
 EXPORT char CC DDV_Play_493210(const char* pDDVName)
 {
+    if (gHeadlessMode)
+    {
+        // Treat as played to the end, nowhere to show it
+        return 1;
+    }
+
     sMovieSoundEntry_5CA230 = &sDDV_SoundEntry_5CA208;
     const char ret = DDV_Play_Impl_4932E0(pDDVName);
     sMovieSoundEntry_5CA230 = nullptr;
@@ -0,0 +1,207 @@
+#include "stdafx.h"
+#include "MovieDecodeQueue.hpp"
+#include "Function.hpp"
+#include <algorithm>
+#include <gmock/gmock.h>
+
+int gMovieDecodeAhead = 4;
+
+MovieDecodeQueue::MovieDecodeQueue(int depth, size_t pixelBytes, size_t audioBytes)
+    : mFrames(depth)
+{
+    for (MovieFrame& frame : mFrames)
+    {
+        frame.mPixels.resize(pixelBytes);
+        frame.mAudio.resize(audioBytes);
+        mFree.push_back(&frame);
+    }
+}
+
+MovieDecodeQueue::~MovieDecodeQueue()
+{
+    Stop();
+}
+
+void MovieDecodeQueue::Start(const TDecodeFrameFn& fnDecodeFrame)
+{
+    mfnDecodeFrame = fnDecodeFrame;
+    mThread = std::thread(&MovieDecodeQueue::DecodeThread, this);
+}
+
+void MovieDecodeQueue::DecodeThread()
+{
+    for (;;)
+    {
+        MovieFrame* pFrame = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            if (mFree.empty() && !mQuit)
+            {
+                mStats.mDecoderWaits++;
+                mFrameFree.wait(lock, [this]() { return !mFree.empty() || mQuit; });
+            }
+
+            if (mQuit)
+            {
+                break;
+            }
+
+            pFrame = mFree.front();
+            mFree.pop_front();
+        }
+
+        mfnDecodeFrame(*pFrame);
+
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mStats.mFramesDecoded++;
+            mReady.push_back(pFrame);
+            mFinished = pFrame->mLast;
+        }
+        mFrameReady.notify_one();
+
+        if (pFrame->mLast)
+        {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    mFinished = true;
+    mFrameReady.notify_all();
+}
+
+MovieFrame* MovieDecodeQueue::Pop()
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    if (mReady.empty() && !mFinished)
+    {
+        mStats.mStarved++;
+        mFrameReady.wait(lock, [this]() { return !mReady.empty() || mFinished; });
+    }
+
+    if (mReady.empty())
+    {
+        return nullptr;
+    }
+
+    const unsigned int depth = static_cast<unsigned int>(mReady.size());
+    const unsigned int taken = mStats.mFramesShown + mStats.mFramesDropped;
+    mStats.mDepthTotal += depth;
+    mStats.mMinDepth = taken == 0 ? depth : std::min(mStats.mMinDepth, depth);
+    mStats.mMaxDepth = std::max(mStats.mMaxDepth, depth);
+
+    MovieFrame* pFrame = mReady.front();
+    mReady.pop_front();
+    return pFrame;
+}
+
+void MovieDecodeQueue::Release(MovieFrame* pFrame, bool bShown)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (bShown)
+        {
+            mStats.mFramesShown++;
+        }
+        else
+        {
+            mStats.mFramesDropped++;
+        }
+        mFree.push_back(pFrame);
+    }
+    mFrameFree.notify_one();
+}
+
+int MovieDecodeQueue::Depth()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return static_cast<int>(mReady.size());
+}
+
+void MovieDecodeQueue::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mQuit = true;
+    }
+    mFrameFree.notify_all();
+
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    mReady.clear();
+    mFinished = true;
+}
+
+MovieDecodeStats MovieDecodeQueue::Stats()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mStats;
+}
+
+namespace Test
+{
+    static void MovieDecodeQueue_InOrder_Test()
+    {
+        const int kFrameCount = 10;
+        const int kDepth = 3;
+
+        MovieDecodeQueue queue(kDepth, 4, 2);
+        int decoded = 0;
+        queue.Start([&](MovieFrame& frame)
+        {
+            frame.mPixels[0] = static_cast<BYTE>(decoded);
+            frame.mHasAudio = (decoded % 2) == 0;
+            decoded++;
+            frame.mLast = decoded == kFrameCount;
+        });
+
+        for (int i = 0; i < kFrameCount; i++)
+        {
+            MovieFrame* pFrame = queue.Pop();
+            ASSERT_NE(nullptr, pFrame);
+            ASSERT_EQ(i, pFrame->mPixels[0]);
+            ASSERT_EQ((i % 2) == 0, pFrame->mHasAudio);
+            ASSERT_EQ(i == kFrameCount - 1, pFrame->mLast);
+
+            // Never more than the queue depth plus the one being decoded ahead of what has been taken
+            ASSERT_LE(queue.Stats().mFramesDecoded, static_cast<unsigned int>(i + kDepth + 1));
+            queue.Release(pFrame, i != 4);
+        }
+
+        ASSERT_EQ(nullptr, queue.Pop());
+
+        const MovieDecodeStats stats = queue.Stats();
+        ASSERT_EQ(static_cast<unsigned int>(kFrameCount), stats.mFramesDecoded);
+        ASSERT_EQ(static_cast<unsigned int>(kFrameCount - 1), stats.mFramesShown);
+        ASSERT_EQ(1u, stats.mFramesDropped);
+        ASSERT_LE(stats.mMaxDepth, static_cast<unsigned int>(kDepth));
+    }
+
+    static void MovieDecodeQueue_StopEarly_Test()
+    {
+        // A decoder that never reaches the end must still stop when playback is skipped
+        MovieDecodeQueue queue(2, 4, 0);
+        queue.Start([](MovieFrame& frame)
+        {
+            frame.mLast = false;
+        });
+
+        MovieFrame* pFrame = queue.Pop();
+        ASSERT_NE(nullptr, pFrame);
+        queue.Release(pFrame, true);
+
+        queue.Stop();
+        ASSERT_EQ(nullptr, queue.Pop());
+    }
+
+    void MovieDecodeQueueTests()
+    {
+        MovieDecodeQueue_InOrder_Test();
+        MovieDecodeQueue_StopEarly_Test();
+    }
+}
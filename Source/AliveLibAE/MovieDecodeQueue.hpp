@@ -0,0 +1,80 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+
+namespace Test
+{
+    void MovieDecodeQueueTests();
+}
+
+struct MovieDecodeStats
+{
+    unsigned int mFramesDecoded = 0;
+    unsigned int mFramesShown = 0;
+    unsigned int mFramesDropped = 0;  // Taken while running late and never drawn
+    unsigned int mStarved = 0;        // The presenter had to wait for the decoder
+    unsigned int mDecoderWaits = 0;   // The queue was full and the decoder had to wait
+    unsigned int mDepthTotal = 0;     // Sum of the decoded frames waiting each time one was taken
+    unsigned int mMinDepth = 0;
+    unsigned int mMaxDepth = 0;
+};
+
+struct MovieFrame
+{
+    std::vector<BYTE> mPixels;
+    std::vector<BYTE> mAudio;
+    bool mHasAudio = false; // Else the audio for this frame is silence
+    bool mLast = false;     // No frames follow this one
+};
+
+// Decodes movie frames on a thread of its own a few frames ahead of the one being shown, so a slow read or a
+// slow frame only eats in to the frames that are already queued instead of putting the video behind the audio.
+class MovieDecodeQueue
+{
+public:
+    // Fills the frame and sets mLast once there are no more to decode.
+    using TDecodeFrameFn = std::function<void(MovieFrame&)>;
+
+    MovieDecodeQueue(int depth, size_t pixelBytes, size_t audioBytes);
+    ~MovieDecodeQueue();
+
+    void Start(const TDecodeFrameFn& fnDecodeFrame);
+
+    // Waits for the next frame, nullptr once the last frame has been taken or the decoder has stopped.
+    MovieFrame* Pop();
+
+    // Hands a frame from Pop back to the decoder, bShown false counts it as dropped.
+    void Release(MovieFrame* pFrame, bool bShown);
+
+    // Decoded frames that are waiting to be taken.
+    int Depth();
+
+    // Stops the decoder once the frame it is on is done, nothing more can be taken afterwards.
+    void Stop();
+
+    MovieDecodeStats Stats();
+
+private:
+    void DecodeThread();
+
+    std::vector<MovieFrame> mFrames;
+    std::deque<MovieFrame*> mFree;
+    std::deque<MovieFrame*> mReady;
+    TDecodeFrameFn mfnDecodeFrame;
+    std::thread mThread;
+    std::mutex mLock;
+    std::condition_variable mFrameFree;
+    std::condition_variable mFrameReady;
+    MovieDecodeStats mStats;
+    bool mFinished = false;
+    bool mQuit = false;
+};
+
+// Frames to decode ahead of the one being shown, 0 or less decodes each frame as it is shown.
+extern int gMovieDecodeAhead;
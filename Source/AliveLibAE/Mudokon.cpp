@@ -31,6 +31,7 @@
 #include "Bullet.hpp"
 #include "LaughingGas.hpp"
 #include "Sys_common.hpp"
+#include "ObjectGrid.hpp"
 
 ALIVE_VAR(1, 0x5C3012, short, sGoingToBirdPortalMudCount_5C3012, 0);
 
@@ -1036,45 +1037,27 @@ void Mudokon::vUpdate_4757A0()
 
         if (field_11C_bird_portal_id != -1)
         {
-            for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_11C_bird_portal_id);
+            if (pObj)
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
+                field_11C_bird_portal_id = pObj->field_8_object_id;
+                sGoingToBirdPortalMudCount_5C3012++;
+                field_16C_flags.Set(Flags_16C::eBit3_Unknown);
+                if (field_18E_ai_state == Mud_AI_State::AI_Escape_6_47A560 && field_190_sub_state == 3)
                 {
-                    break;
-                }
-
-                if (pObj->field_C_objectId == field_11C_bird_portal_id)
-                {
-                    field_11C_bird_portal_id = pObj->field_8_object_id;
-                    sGoingToBirdPortalMudCount_5C3012++;
-                    field_16C_flags.Set(Flags_16C::eBit3_Unknown);
-                    if (field_18E_ai_state == Mud_AI_State::AI_Escape_6_47A560 && field_190_sub_state == 3)
-                    {
-                        static_cast<BirdPortal*>(pObj)->VPortalClipper_499430(1);
-                        field_20_animation.field_C_render_layer = field_CC_sprite_scale != FP_FromInteger(1) ? Layer::eLayer_11 : Layer::eLayer_30;
-                    }
-                    break;
+                    static_cast<BirdPortal*>(pObj)->VPortalClipper_499430(1);
+                    field_20_animation.field_C_render_layer = field_CC_sprite_scale != FP_FromInteger(1) ? Layer::eLayer_11 : Layer::eLayer_30;
                 }
             }
         }
 
         if (field_158_wheel_id != -1)
         {
-            for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_158_wheel_id);
+            if (pObj)
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
-                {
-                    break;
-                }
-
-                if (pObj->field_C_objectId == field_158_wheel_id)
-                {
-                    field_158_wheel_id = pObj->field_8_object_id;
-                    static_cast<WorkWheel*>(pObj)->VStartTurning();
-                    break;
-                }
+                field_158_wheel_id = pObj->field_8_object_id;
+                static_cast<WorkWheel*>(pObj)->VStartTurning();
             }
         }
     }
@@ -7351,14 +7334,9 @@ __int16 Mudokon::StopAtWheel_477880()
     };
 
 
-    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsNear<BaseAliveGameObject> nearObjs(gBaseAliveGameObjects_5C1B7C, ourRect);
+    while (BaseAliveGameObject* pObj = nearObjs.Next())
     {
-        auto pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
         // Found another mud who isn't us
         if (pObj != this && pObj->field_4_typeId == Types::eMudokon_110)
         {
@@ -7573,14 +7551,9 @@ void Mudokon::CheckKnockedOntoABomb_4723C0()
     PSX_RECT bMudRect = {};
     vGetBoundingRect_424FD0(&bMudRect, 1);
 
-    for (int i=0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsNear<BaseAliveGameObject> nearObjs(gBaseAliveGameObjects_5C1B7C, bMudRect);
+    while (BaseAliveGameObject* pObj = nearObjs.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
         if (pObj->field_4_typeId == Types::eMine_88 || pObj->field_4_typeId == Types::eUXB_143)
         {
             PSX_RECT bBombRect = {};
@@ -9,6 +9,7 @@
 #include "ObjectIds.hpp"
 #include "PathData.hpp"
 #include "Sys.hpp"
+#include "Game.hpp"
 
 ALIVE_VAR(1, 0x5C3020, MusicController*, pMusicController_5C3020, nullptr);
 ALIVE_VAR(1, 0x5C301C, DWORD, sMusicControllerBaseTimeStamp_5C301C, 0);
@@ -367,11 +368,19 @@ int CC MusicController::Create_47FC40()
 
 void CC MusicController::SetBaseTimeStamp_47FD00()
 {
-    sMusicControllerBaseTimeStamp_5C301C = SYS_GetTicks();
+    sMusicControllerBaseTimeStamp_5C301C = gHeadlessMode ? sGnFrame_5C1B84 : SYS_GetTicks();
 }
 
 void CC MusicController::UpdateMusicTime_47F8B0()
 {
+    if (gHeadlessMode)
+    {
+        // Headless runs go faster than real time so the music clock follows the frames, one tick (1/30th of a second)
+        // per frame. The music playing changes what the AI does and how many randoms get used so this keeps runs of
+        // the same frames the same.
+        sMusicTime_5C3024 = sGnFrame_5C1B84 - sMusicControllerBaseTimeStamp_5C301C;
+        return;
+    }
     sMusicTime_5C3024 = (3 * SYS_GetTicks() - 3 * sMusicControllerBaseTimeStamp_5C301C) / 100;
 }
 
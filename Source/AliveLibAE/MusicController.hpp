@@ -109,3 +109,4 @@ ALIVE_ASSERT_SIZEOF(MusicController, 0x5C);
 
 
 ALIVE_VAR_EXTERN(MusicController*, pMusicController_5C3020);
+ALIVE_VAR_EXTERN(DWORD, sMusicTime_5C3024);
@@ -27,6 +27,7 @@
 #include "NakedSligButton.hpp"
 #include "Sfx.hpp"
 #include "SlamDoor.hpp"
+#include "ObjectTypeIndex.hpp"
 
 TintEntry stru_5514B8[18] =
 {
@@ -746,6 +747,11 @@ bool NakedSlig::BrainIs(TNakedSligAIFn fn)
     return ::BrainIs(fn, field_204_brain_state, sNakedSligAITable);
 }
 
+const char* NakedSlig::BrainName() const
+{
+    return ::BrainName(field_204_brain_state, sNakedSligAITable);
+}
+
 void NakedSlig::dtor_418FE0()
 {
     SetVTable(this, 0x5446A8);
@@ -1467,7 +1473,7 @@ void NakedSlig::M_UsingButton_1_41B890()
             Set_AnimAndMotion_419890(0, TRUE);
             field_20_animation.field_4_flags.Clear(AnimFlags::eBit2_Animate);
             field_20_animation.field_4_flags.Clear(AnimFlags::eBit3_Render);
-            field_4_typeId = Types::eNone_0;
+            ObjectTypeIndex_SetType(this, Types::eNone_0);
         }
     }
     else
@@ -1481,18 +1487,10 @@ void NakedSlig::M_UsingButton_1_41B890()
 
 void NakedSlig::M_WakingUp_2_41BF00()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> snoozeParticles(gBaseGameObject_list_BB47C4, Types::eSnoozeParticle_124);
+    while (BaseGameObject* pObj = snoozeParticles.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eSnoozeParticle_124)
-        {
-            static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
-        }
+        static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
     }
 
     if (field_20_animation.field_4_flags.Get(AnimFlags::eBit18_IsLastFrame))
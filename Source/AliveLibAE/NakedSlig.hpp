@@ -167,6 +167,9 @@ private:
 
     EXPORT __int16 vTakeDamage_4192B0(BaseGameObject* pFrom);
 
+public:
+    const char* BrainName() const;
+
 private:
     void SetBrain(TNakedSligAIFn fn);
     bool BrainIs(TNakedSligAIFn fn);
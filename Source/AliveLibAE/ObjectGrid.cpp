@@ -0,0 +1,464 @@
+#include "stdafx.h"
+#include "ObjectGrid.hpp"
+#include "Function.hpp"
+#include "BaseAnimatedWithPhysicsGameObject.hpp"
+#include "BaseAliveGameObject.hpp"
+#include "Game.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+bool gObjectGridEnabled = true;
+
+// Rounds towards negative infinity so objects just left of/above 0 don't share cell 0
+static int FloorDiv(int value, int divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+ObjectGrid::ObjectGrid(DynamicArray* pList)
+    : mpList(pList)
+{
+
+}
+
+// Biased so a key is never negative and can't clash with kOverflow or kNotSpatial
+int ObjectGrid::CellKey(int cellX, int cellY)
+{
+    return (((cellX + 0x4000) & 0x7FFF) << 16) | ((cellY + 0x8000) & 0xFFFF);
+}
+
+int ObjectGrid::CellOf(int x, int y)
+{
+    return CellKey(FloorDiv(x, kGridMapWidth), FloorDiv(y, kGridMapHeight));
+}
+
+bool ObjectGrid::IsCurrent() const
+{
+    return mBuilt && mpList->field_A_removed_count == mBuiltRemovedCount && mpList->Size() >= mBuiltSize;
+}
+
+void ObjectGrid::Refresh(unsigned int frame)
+{
+    if (!IsCurrent() || frame != mBuiltFrame)
+    {
+        Rebuild(frame);
+    }
+}
+
+void ObjectGrid::Rebuild(unsigned int frame)
+{
+    mSlots.clear();
+    for (auto& cell : mCells)
+    {
+        cell.second.clear();
+    }
+    mOverflow.clear();
+    mIndexOf.clear();
+    mQueued.clear();
+    mReachX = 0;
+    mReachY = 0;
+
+    auto pList = static_cast<DynamicArrayT<BaseGameObject>*>(mpList);
+    for (int i = 0; i < pList->Size(); i++)
+    {
+        BaseGameObject* pObj = pList->ItemAt(i);
+        if (!pObj)
+        {
+            break;
+        }
+
+        Slot slot;
+        slot.mpObj = pObj;
+        mSlots.push_back(slot);
+        mIndexOf.push_back({ pObj, i });
+        Bin(i);
+    }
+    std::sort(mIndexOf.begin(), mIndexOf.end());
+
+    mBuilt = true;
+    mBuiltFrame = frame;
+    mBuiltSize = static_cast<int>(mSlots.size());
+    mBuiltRemovedCount = mpList->field_A_removed_count;
+}
+
+// How far the object's bounding rect reaches from its position, false if it can't be binned
+static bool GetReach(BaseAnimatedWithPhysicsGameObject* pObj, int& reachX, int& reachY)
+{
+    // The bounding rect can't be looked at for objects that aren't drawn, their animation might not be set up
+    if (!pObj->field_6_flags.Get(BaseGameObject::eDrawable_Bit4))
+    {
+        return false;
+    }
+
+    PSX_RECT bRect = {};
+    pObj->vGetBoundingRect_424FD0(&bRect, 1);
+
+    const int x = FP_GetExponent(pObj->field_B8_xpos);
+    const int y = FP_GetExponent(pObj->field_BC_ypos);
+    reachX = std::max(std::abs(x - bRect.x), std::abs(bRect.w - x));
+    reachY = std::max(std::abs(y - bRect.y), std::abs(bRect.h - y));
+    return reachX <= ObjectGrid::kMaxReach && reachY <= ObjectGrid::kMaxReach;
+}
+
+void ObjectGrid::Bin(int idx)
+{
+    Slot& slot = mSlots[idx];
+    if (!slot.mpObj->field_6_flags.Get(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5))
+    {
+        slot.mCell = kNotSpatial;
+        return;
+    }
+
+    auto pObj = static_cast<BaseAnimatedWithPhysicsGameObject*>(slot.mpObj);
+    int reachX = 0;
+    int reachY = 0;
+    if (GetReach(pObj, reachX, reachY))
+    {
+        mReachX = std::max(mReachX, reachX);
+        mReachY = std::max(mReachY, reachY);
+        slot.mCell = CellOf(FP_GetExponent(pObj->field_B8_xpos), FP_GetExponent(pObj->field_BC_ypos));
+        mCells[slot.mCell].push_back(idx);
+    }
+    else
+    {
+        slot.mCell = kOverflow;
+        mOverflow.push_back(idx);
+    }
+}
+
+void ObjectGrid::Unbin(int idx)
+{
+    Slot& slot = mSlots[idx];
+    std::vector<int>* pIndices = nullptr;
+    if (slot.mCell == kOverflow)
+    {
+        pIndices = &mOverflow;
+    }
+    else if (slot.mCell != kNotSpatial)
+    {
+        pIndices = &mCells[slot.mCell];
+    }
+
+    if (pIndices)
+    {
+        auto it = std::find(pIndices->begin(), pIndices->end(), idx);
+        if (it != pIndices->end())
+        {
+            *it = pIndices->back();
+            pIndices->pop_back();
+        }
+    }
+    slot.mCell = kNotSpatial;
+}
+
+void ObjectGrid::OnObjectUpdated(BaseGameObject* pObj)
+{
+    if (!IsCurrent())
+    {
+        return;
+    }
+
+    auto it = std::lower_bound(mIndexOf.begin(), mIndexOf.end(), IndexOf{ pObj, 0 });
+    if (it == mIndexOf.end() || it->mpObj != pObj)
+    {
+        // Added after the grid was built, always walked anyway
+        return;
+    }
+
+    Slot& slot = mSlots[it->mIdx];
+    if (!slot.mQueued)
+    {
+        slot.mQueued = true;
+        mQueued.push_back(it->mIdx);
+    }
+}
+
+void ObjectGrid::Rebin(int idx)
+{
+    const int oldCell = mSlots[idx].mCell;
+    if (oldCell != kOverflow && oldCell != kNotSpatial)
+    {
+        // Usually still in the same cell so there's nothing to move
+        auto pMoved = static_cast<BaseAnimatedWithPhysicsGameObject*>(mSlots[idx].mpObj);
+        int reachX = 0;
+        int reachY = 0;
+        if (GetReach(pMoved, reachX, reachY)
+            && CellOf(FP_GetExponent(pMoved->field_B8_xpos), FP_GetExponent(pMoved->field_BC_ypos)) == oldCell)
+        {
+            mReachX = std::max(mReachX, reachX);
+            mReachY = std::max(mReachY, reachY);
+            return;
+        }
+    }
+
+    Unbin(idx);
+    Bin(idx);
+}
+
+void ObjectGrid::RebinQueued()
+{
+    for (int idx : mQueued)
+    {
+        mSlots[idx].mQueued = false;
+        Rebin(idx);
+    }
+    mQueued.clear();
+}
+
+bool ObjectGrid::Query(const PSX_RECT& rect, std::vector<int>& indices)
+{
+    // Some callers build their rects flipped
+    const int left = FloorDiv(std::min(rect.x, rect.w) - mReachX - kSlack, kGridMapWidth);
+    const int right = FloorDiv(std::max(rect.x, rect.w) + mReachX + kSlack, kGridMapWidth);
+    const int top = FloorDiv(std::min(rect.y, rect.h) - mReachY - kSlack, kGridMapHeight);
+    const int bottom = FloorDiv(std::max(rect.y, rect.h) + mReachY + kSlack, kGridMapHeight);
+
+    // Looking up this many cells isn't going to be any quicker than walking the list
+    if ((right - left + 1) * (bottom - top + 1) > 64)
+    {
+        return false;
+    }
+
+    RebinQueued();
+
+    indices = mOverflow;
+    for (int cellX = left; cellX <= right; cellX++)
+    {
+        for (int cellY = top; cellY <= bottom; cellY++)
+        {
+            auto it = mCells.find(CellKey(cellX, cellY));
+            if (it != mCells.end())
+            {
+                indices.insert(indices.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+
+    std::sort(indices.begin(), indices.end());
+    return true;
+}
+
+ObjectGrid* ObjectGrid_Get(DynamicArray* pList)
+{
+    static std::unique_ptr<ObjectGrid> sObjectsGrid;
+    static std::unique_ptr<ObjectGrid> sAliveObjectsGrid;
+
+    // The game's own code removes items without counting them
+    if (!gObjectGridEnabled || RunningAsInjectedDll() || !pList)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<ObjectGrid>* ppGrid = nullptr;
+    if (pList == gBaseGameObject_list_BB47C4)
+    {
+        ppGrid = &sObjectsGrid;
+    }
+    else if (pList == gBaseAliveGameObjects_5C1B7C)
+    {
+        ppGrid = &sAliveObjectsGrid;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    if (!*ppGrid || (*ppGrid)->List() != pList)
+    {
+        ppGrid->reset(new ObjectGrid(pList));
+    }
+    return ppGrid->get();
+}
+
+void ObjectGrid_OnObjectUpdated(BaseGameObject* pObj)
+{
+    if (!pObj->field_6_flags.Get(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5))
+    {
+        return;
+    }
+
+    if (ObjectGrid* pGrid = ObjectGrid_Get(gBaseGameObject_list_BB47C4))
+    {
+        pGrid->OnObjectUpdated(pObj);
+    }
+
+    if (pObj->field_6_flags.Get(BaseGameObject::eIsBaseAliveGameObject_Bit6))
+    {
+        if (ObjectGrid* pGrid = ObjectGrid_Get(gBaseAliveGameObjects_5C1B7C))
+        {
+            pGrid->OnObjectUpdated(pObj);
+        }
+    }
+}
+
+void ObjectGrid_OnObjectMoved(BaseGameObject* pObj)
+{
+    ObjectGrid_OnObjectUpdated(pObj);
+}
+
+ObjectsNearIter::ObjectsNearIter(DynamicArray* pList, const PSX_RECT& rect)
+    : mpList(pList)
+{
+    mpGrid = ObjectGrid_Get(pList);
+    if (mpGrid)
+    {
+        mpGrid->Refresh(sGnFrame_5C1B84);
+        if (mpGrid->Query(rect, mCandidates))
+        {
+            mRemovedCount = pList->field_A_removed_count;
+        }
+        else
+        {
+            mpGrid = nullptr;
+        }
+    }
+}
+
+BaseGameObject* ObjectsNearIter::Next()
+{
+    if (!mpGrid)
+    {
+        return NextLinear();
+    }
+
+    auto pList = static_cast<DynamicArrayT<BaseGameObject>*>(mpList);
+    while (mCandidateIdx < mCandidates.size())
+    {
+        if (pList->field_A_removed_count != mRemovedCount)
+        {
+            // Items got swapped around while walking, carry on from here the same way the original loop would
+            mpGrid = nullptr;
+            return NextLinear();
+        }
+
+        const int idx = mCandidates[mCandidateIdx++];
+        mLinearIdx = idx + 1;
+        return pList->ItemAt(idx);
+    }
+
+    // Anything added after the grid was built
+    mLinearIdx = std::max(mLinearIdx, mpGrid->BuiltSize());
+    mpGrid = nullptr;
+    return NextLinear();
+}
+
+BaseGameObject* ObjectsNearIter::NextLinear()
+{
+    auto pList = static_cast<DynamicArrayT<BaseGameObject>*>(mpList);
+    if (mLinearIdx >= pList->Size())
+    {
+        return nullptr;
+    }
+    return pList->ItemAt(mLinearIdx++);
+}
+
+namespace Test
+{
+    class GridTestObj : public BaseAnimatedWithPhysicsGameObject
+    {
+    public:
+        virtual BaseGameObject* VDestructor(signed int) override
+        {
+            // Stub
+            return this;
+        }
+    };
+
+    struct GridTestAnimData
+    {
+        AnimationHeader mHeader;
+        FrameInfoHeader mFrameInfoHeader;
+        FrameHeader mFrameHeader;
+    };
+
+    static void ObjectGrid_Query_Test()
+    {
+        GridTestAnimData testData = {};
+        testData.mHeader.mFrameOffsets[0] = sizeof(AnimationHeader);
+        testData.mFrameInfoHeader.field_0_frame_header_offset = sizeof(AnimationHeader) + sizeof(FrameInfoHeader);
+        testData.mFrameInfoHeader.field_8_data.points[1].x = -10;
+        testData.mFrameInfoHeader.field_8_data.points[1].y = -40;
+        testData.mFrameInfoHeader.field_8_data.points[2].x = 10;
+        testData.mFrameInfoHeader.field_8_data.points[2].y = 0;
+        GridTestAnimData* pTestData = &testData;
+
+        const int kObjCount = 6;
+        const int xPositions[kObjCount] = { 100, 2000, 120, 5000, 2100, 130 };
+        GridTestObj objs[kObjCount];
+
+        DynamicArrayT<BaseGameObject> list;
+        list.ctor_40CA60(kObjCount);
+
+        for (int i = 0; i < kObjCount; i++)
+        {
+            objs[i].field_6_flags.Raw().all = 0;
+            objs[i].field_6_flags.Set(BaseGameObject::eIsBaseAnimatedWithPhysicsObj_Bit5);
+            objs[i].field_6_flags.Set(BaseGameObject::eDrawable_Bit4);
+            objs[i].field_20_animation.field_4_flags.Raw().all = 0;
+            objs[i].field_20_animation.field_92_current_frame = 0;
+            objs[i].field_20_animation.field_20_ppBlock = reinterpret_cast<BYTE**>(&pTestData);
+            objs[i].field_20_animation.field_18_frame_table_offset = 0;
+            objs[i].field_CC_sprite_scale = FP_FromInteger(1);
+            objs[i].field_B8_xpos = FP_FromInteger(xPositions[i]);
+            objs[i].field_BC_ypos = FP_FromInteger(100);
+            list.Push_Back(&objs[i]);
+        }
+
+        // Not drawn so can't be binned, always a candidate
+        objs[3].field_6_flags.Clear(BaseGameObject::eDrawable_Bit4);
+
+        ObjectGrid grid(&list);
+        grid.Rebuild(1);
+
+        std::vector<int> indices;
+        ASSERT_TRUE(grid.Query({ 90, 60, 140, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 0, 2, 3, 5 }), indices);
+
+        ASSERT_TRUE(grid.Query({ 1990, 60, 2010, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 1, 3, 4 }), indices);
+
+        // Moves to another cell
+        objs[0].field_B8_xpos = FP_FromInteger(2050);
+        grid.OnObjectUpdated(&objs[0]);
+        ASSERT_TRUE(grid.Query({ 1990, 60, 2010, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 0, 1, 3, 4 }), indices);
+        ASSERT_TRUE(grid.Query({ 90, 60, 140, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 2, 3, 5 }), indices);
+
+        // Nudged in to the next cell by something else before its own update, still found
+        objs[5].field_B8_xpos = FP_FromInteger(kGridMapWidth - 10);
+        grid.OnObjectUpdated(&objs[5]);
+        objs[5].field_B8_xpos = FP_FromInteger(kGridMapWidth - 10 + ObjectGrid::kSlack);
+        ASSERT_TRUE(grid.Query({ 420, 60, 430, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 2, 3, 5 }), indices);
+
+        // Teleported by something else
+        objs[5].field_B8_xpos = FP_FromInteger(5030);
+        grid.OnObjectUpdated(&objs[5]);
+        ASSERT_TRUE(grid.Query({ 5020, 60, 5040, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 3, 5 }), indices);
+        ASSERT_TRUE(grid.Query({ 90, 60, 140, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 2, 3 }), indices);
+        objs[5].field_B8_xpos = FP_FromInteger(130);
+
+        // Removing anything means the indices can't be trusted until rebuilt
+        ASSERT_TRUE(grid.IsCurrent());
+        list.Remove_Item(&objs[2]);
+        ASSERT_FALSE(grid.IsCurrent());
+        grid.Refresh(1);
+        ASSERT_TRUE(grid.IsCurrent());
+        ASSERT_TRUE(grid.Query({ 90, 60, 140, 100 }, indices));
+        ASSERT_EQ((std::vector<int>{ 2, 3 }), indices); // 5 was swapped in to where 2 was
+
+        // Too big to be worth it
+        ASSERT_FALSE(grid.Query({ -20000, -20000, 20000, 20000 }, indices));
+
+        list.dtor_40CAD0();
+    }
+
+    void ObjectGridTests()
+    {
+        ObjectGrid_Query_Test();
+    }
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "DynamicArray.hpp"
+#include "Psx_common.hpp"
+#include <functional>
+#include <vector>
+#include <unordered_map>
+
+class BaseGameObject;
+
+namespace Test
+{
+    void ObjectGridTests();
+}
+
+// The same sized grid that Event_Is_Event_In_Range_422C30 uses, one cell per camera.
+const int kGridMapWidth = 375;
+const int kGridMapHeight = 260;
+
+// Buckets the BaseAnimatedWithPhysicsGameObjects of an object list in to camera sized cells by position so collision
+// and "find object" scans only have to look at what is near the area being tested.
+//
+// The grid is rebuilt at the start of every frame and an object is queued to be moved to its new cell when its own
+// VUpdate returns, the next query rebins only what was queued. Something else can move an object during the frame
+// (lifts, knockback) before its own VUpdate runs so queries look kSlack further out, anything that moves another
+// object further than that has to call ObjectGrid_OnObjectMoved.
+class ObjectGrid
+{
+public:
+    explicit ObjectGrid(DynamicArray* pList);
+
+    // Rebuilds if the frame has changed or the list has had items removed since the last build.
+    void Refresh(unsigned int frame);
+    void Rebuild(unsigned int frame);
+
+    // Queues the object to be put back in the right cell by the next query.
+    void OnObjectUpdated(BaseGameObject* pObj);
+
+    // Sets indices to all the objects that could overlap the inclusive rect (x, y, w = right, h = bottom, either way
+    // round) in list order.
+    // Objects added since the last build are not included, they start at BuiltSize(). Returns false when the rect
+    // covers so many cells that walking the whole list would be quicker.
+    bool Query(const PSX_RECT& rect, std::vector<int>& indices);
+
+    bool IsCurrent() const;
+
+    int BuiltSize() const
+    {
+        return mBuiltSize;
+    }
+
+    DynamicArray* List() const
+    {
+        return mpList;
+    }
+
+    // How far an object can be moved by something else without it calling ObjectGrid_OnObjectMoved.
+    static const int kSlack = 64;
+
+    // Objects that reach further than this from their position (long web lines etc) are always returned.
+    static const int kMaxReach = kGridMapHeight;
+
+private:
+    static const int kOverflow = -1;   // Always a candidate
+    static const int kNotSpatial = -2; // Never a candidate
+
+    static int CellKey(int cellX, int cellY);
+    static int CellOf(int x, int y);
+    void Bin(int idx);
+    void Unbin(int idx);
+    void Rebin(int idx);
+    void RebinQueued();
+
+    struct Slot
+    {
+        BaseGameObject* mpObj = nullptr;
+        int mCell = kOverflow;
+        bool mQueued = false;
+    };
+
+    struct IndexOf
+    {
+        BaseGameObject* mpObj;
+        int mIdx;
+
+        bool operator<(const IndexOf& rhs) const
+        {
+            return std::less<BaseGameObject*>()(mpObj, rhs.mpObj);
+        }
+    };
+
+    DynamicArray* mpList = nullptr;
+    unsigned __int16 mBuiltRemovedCount = 0;
+    int mBuiltSize = 0;
+    unsigned int mBuiltFrame = 0;
+    bool mBuilt = false;
+
+    std::vector<Slot> mSlots;
+    // Cells are emptied rather than erased on a rebuild so their storage is reused
+    std::unordered_map<int, std::vector<int>> mCells;
+    std::vector<int> mOverflow;
+    std::vector<IndexOf> mIndexOf; // Sorted by object
+    std::vector<int> mQueued; // Slots to rebin on the next query
+
+    // Furthest any binned object's bounding rect reaches from its position
+    int mReachX = 0;
+    int mReachY = 0;
+};
+
+// Returns the grid for gBaseGameObject_list_BB47C4 or gBaseAliveGameObjects_5C1B7C, nullptr for any other list or
+// when the grid is turned off.
+ObjectGrid* ObjectGrid_Get(DynamicArray* pList);
+
+// Called by the game loop after every VUpdate.
+void ObjectGrid_OnObjectUpdated(BaseGameObject* pObj);
+
+// Called when something moves another object further than ObjectGrid::kSlack (teleports etc).
+void ObjectGrid_OnObjectMoved(BaseGameObject* pObj);
+
+// Walks the objects of a list that could overlap a rect in list order, including any added while walking.
+// Falls back to walking the whole list when there is no grid for it.
+class ObjectsNearIter
+{
+public:
+    ObjectsNearIter(DynamicArray* pList, const PSX_RECT& rect);
+
+    BaseGameObject* Next();
+
+private:
+    BaseGameObject* NextLinear();
+
+    DynamicArray* mpList = nullptr;
+    ObjectGrid* mpGrid = nullptr;
+    unsigned __int16 mRemovedCount = 0;
+    std::vector<int> mCandidates;
+    size_t mCandidateIdx = 0;
+    int mLinearIdx = 0;
+};
+
+template<class T>
+class ObjectsNear
+{
+public:
+    ObjectsNear(DynamicArrayT<T>* pList, const PSX_RECT& rect)
+        : mIter(pList, rect)
+    {
+
+    }
+
+    // Next object that could overlap the rect or nullptr when there are no more, the caller still has to test the overlap.
+    T* Next()
+    {
+        return static_cast<T*>(mIter.Next());
+    }
+
+private:
+    ObjectsNearIter mIter;
+};
+
+// When false every scan walks the whole object list like the original game.
+extern bool gObjectGridEnabled;
@@ -3,6 +3,10 @@
 #include "Function.hpp"
 #include "stdlib.hpp"
 #include "Sys_common.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
 
 ALIVE_VAR(1, 0x5C1B70, ObjectIds, sObjectIds_5C1B70, {});
 
@@ -25,74 +29,209 @@ void ObjectIds::dtor_43EC90()
 
 void ObjectIds::Destructor()
 {
-    for (unsigned int i = 0; i < field_0_buffer_size; i++)
+    if (RunningAsInjectedDll())
     {
-        while (field_4_pBuffer[i])
+        for (unsigned int i = 0; i < field_0_buffer_size; i++)
         {
-            // Keep a copy of the current item
-            ObjectId_Record* pCurrent = field_4_pBuffer[i];
+            while (field_4_pBuffer[i])
+            {
+                // Keep a copy of the current item
+                ObjectId_Record* pCurrent = field_4_pBuffer[i];
 
-            // Set the array to point to the next item
-            field_4_pBuffer[i] = pCurrent->field_8_pNext;
+                // Set the array to point to the next item
+                field_4_pBuffer[i] = pCurrent->field_8_pNext;
 
-            // Now free current, repeat until everything is gone
-            ae_delete_free_495540(pCurrent);
+                // Now free current, repeat until everything is gone
+                ae_delete_free_495540(pCurrent);
+            }
         }
+
+        // Free the backing array
+        ae_non_zero_free_495560(field_4_pBuffer);
+        return;
     }
 
-    // Free the backing array
-    ae_non_zero_free_495560(field_4_pBuffer);
+    // The records are in line so there is only the table to free
+    ae_non_zero_free_495560(field_4_pTable);
+    field_4_pTable = nullptr;
+    field_0_buffer_size = 0;
+}
+
+static ObjectId_Table* ObjectIds_AllocTable(unsigned int size)
+{
+    auto pTable = reinterpret_cast<ObjectId_Table*>(ae_malloc_non_zero_4954F0(sizeof(ObjectId_Table) + (sizeof(ObjectId_Record) * (size - 1))));
+    pTable->mUsed = 0;
+    for (unsigned int i = 0; i < size; i++)
+    {
+        pTable->mRecords[i].field_0_id = -1;
+        pTable->mRecords[i].field_4_obj_ptr = nullptr;
+        pTable->mRecords[i].field_8_pNext = nullptr;
+    }
+    return pTable;
 }
 
 void ObjectIds::ctor_449AE0(unsigned int size)
 {
-    // Allocate the array and set all items to nullptr
-    field_0_buffer_size = size;
-    field_4_pBuffer = reinterpret_cast<ObjectId_Record**>(ae_malloc_non_zero_4954F0(sizeof(ObjectId_Record*) * size));
-    for (unsigned int i = 0; i < field_0_buffer_size; i++)
+    if (RunningAsInjectedDll())
+    {
+        // Allocate the array and set all items to nullptr
+        field_0_buffer_size = size;
+        field_4_pBuffer = reinterpret_cast<ObjectId_Record**>(ae_malloc_non_zero_4954F0(sizeof(ObjectId_Record*) * size));
+        for (unsigned int i = 0; i < field_0_buffer_size; i++)
+        {
+            field_4_pBuffer[i] = nullptr;
+        }
+        return;
+    }
+
+    field_0_buffer_size = 16;
+    while (field_0_buffer_size < size)
     {
-        field_4_pBuffer[i] = nullptr;
+        field_0_buffer_size *= 2;
     }
+    field_4_pTable = ObjectIds_AllocTable(field_0_buffer_size);
 }
 
 unsigned int ObjectIds::Id_To_Buffer_Size_Range_449BA0(TObjectId_KeyType id)
 {
-    return id % field_0_buffer_size;
+    if (RunningAsInjectedDll())
+    {
+        return id % field_0_buffer_size;
+    }
+
+    // Ids are handed out in order so mix them up before masking or they would all land in one run
+    unsigned int hash = static_cast<unsigned int>(id) * 0x9E3779B1u;
+    hash ^= hash >> 15;
+    return hash & (field_0_buffer_size - 1);
 }
 
 ObjectId_Record* ObjectIds::Find_By_Id_449BC0(TObjectId_KeyType idToFind, ObjectId_Record** ppLastMatch)
 {
-    ObjectId_Record* pRecord = field_4_pBuffer[Id_To_Buffer_Size_Range_449BA0(idToFind)];
     *ppLastMatch = nullptr;
 
-    while (pRecord)
+    if (RunningAsInjectedDll())
+    {
+        ObjectId_Record* pRecord = field_4_pBuffer[Id_To_Buffer_Size_Range_449BA0(idToFind)];
+        while (pRecord)
+        {
+            if (pRecord->field_0_id == idToFind)
+            {
+                return pRecord;
+            }
+
+            // Keep track of what it was so we can fix links when removing found items
+            *ppLastMatch = pRecord;
+
+            // Go to the next record
+            pRecord = pRecord->field_8_pNext;
+        }
+        return nullptr;
+    }
+
+    if (idToFind == -1)
     {
+        return nullptr;
+    }
+
+    // Never more than half full so there is always an empty slot to stop at
+    unsigned int idx = Id_To_Buffer_Size_Range_449BA0(idToFind);
+    for (;;)
+    {
+        ObjectId_Record* pRecord = &field_4_pTable->mRecords[idx];
         if (pRecord->field_0_id == idToFind)
         {
             return pRecord;
         }
 
-        // Keep track of what it was so we can fix links when removing found items
-        *ppLastMatch = pRecord;
+        if (pRecord->field_0_id == -1)
+        {
+            return nullptr;
+        }
+        idx = (idx + 1) & (field_0_buffer_size - 1);
+    }
+}
+
+void ObjectIds::Place(TObjectId_KeyType id, BaseGameObject* pGameObj, bool bBeforeSameId)
+{
+    unsigned int idx = Id_To_Buffer_Size_Range_449BA0(id);
+    for (;;)
+    {
+        ObjectId_Record* pRecord = &field_4_pTable->mRecords[idx];
+        if (pRecord->field_0_id == -1)
+        {
+            pRecord->field_0_id = id;
+            pRecord->field_4_obj_ptr = pGameObj;
+            return;
+        }
+
+        if (bBeforeSameId && pRecord->field_0_id == id)
+        {
+            // Take its place and carry on with the older one so they stay newest first
+            std::swap(pRecord->field_4_obj_ptr, pGameObj);
+        }
+        idx = (idx + 1) & (field_0_buffer_size - 1);
+    }
+}
+
+void ObjectIds::Grow()
+{
+    ObjectId_Table* pOld = field_4_pTable;
+    const unsigned int oldSize = field_0_buffer_size;
+
+    field_0_buffer_size *= 2;
+    field_4_pTable = ObjectIds_AllocTable(field_0_buffer_size);
+    field_4_pTable->mUsed = pOld->mUsed;
 
-        // Go to the next record
-        pRecord = pRecord->field_8_pNext;
+    // Start after an empty slot so every run is walked in probe order, then appending keeps records for the same
+    // id newest first
+    unsigned int start = 0;
+    while (pOld->mRecords[start].field_0_id != -1)
+    {
+        start++;
+    }
+
+    for (unsigned int i = 1; i <= oldSize; i++)
+    {
+        const ObjectId_Record& record = pOld->mRecords[(start + i) & (oldSize - 1)];
+        if (record.field_0_id != -1)
+        {
+            Place(record.field_0_id, record.field_4_obj_ptr, false);
+        }
     }
-    return nullptr;
+
+    ae_non_zero_free_495560(pOld);
 }
 
 void ObjectIds::Insert_449C10(TObjectId_KeyType nextId, BaseGameObject* pGameObj)
 {
-    // Create new record
-    ObjectId_Record* pRec = ae_new<ObjectId_Record>();
-    pRec->field_0_id = nextId;
-    pRec->field_4_obj_ptr = pGameObj;
+    if (RunningAsInjectedDll())
+    {
+        // Create new record
+        ObjectId_Record* pRec = ae_new<ObjectId_Record>();
+        pRec->field_0_id = nextId;
+        pRec->field_4_obj_ptr = pGameObj;
+
+        // Insert and fix links
+        const unsigned int id = Id_To_Buffer_Size_Range_449BA0(nextId);
+
+        pRec->field_8_pNext = field_4_pBuffer[id];
+        field_4_pBuffer[id] = pRec;
+        return;
+    }
+
+    if (nextId == -1)
+    {
+        // Nothing can find it
+        return;
+    }
 
-    // Insert and fix links
-    const unsigned int id = Id_To_Buffer_Size_Range_449BA0(nextId);
+    if ((field_4_pTable->mUsed + 1) * 2 > field_0_buffer_size)
+    {
+        Grow();
+    }
 
-    pRec->field_8_pNext = field_4_pBuffer[id];
-    field_4_pBuffer[id] = pRec;
+    Place(nextId, pGameObj, true);
+    field_4_pTable->mUsed++;
 }
 
 signed __int16 ObjectIds::Remove_449C60(TObjectId_KeyType idToRemove)
@@ -105,27 +244,66 @@ signed __int16 ObjectIds::Remove_449C60(TObjectId_KeyType idToRemove)
         return 0;
     }
 
-    // Fix the links
-    const unsigned int idx = Id_To_Buffer_Size_Range_449BA0(idToRemove);
-    if (pLastMatch)
+    if (RunningAsInjectedDll())
     {
-        // There was an object before this, so point to the one after what we found
-        // so we can remove it.
-        pLastMatch->field_8_pNext = pFound->field_8_pNext;
+        // Fix the links
+        const unsigned int idx = Id_To_Buffer_Size_Range_449BA0(idToRemove);
+        if (pLastMatch)
+        {
+            // There was an object before this, so point to the one after what we found
+            // so we can remove it.
+            pLastMatch->field_8_pNext = pFound->field_8_pNext;
+        }
+        else
+        {
+            // There was not an object before this, so set the root to point the one after
+            // we found so we can remove it.
+            field_4_pBuffer[idx] = pFound->field_8_pNext;
+        }
+
+        // Free the found record
+        ae_delete_free_495540(pFound);
+
+        return 1;
     }
-    else
+
+    // Shift back anything after it that would no longer be found past the gap
+    const unsigned int mask = field_0_buffer_size - 1;
+    unsigned int hole = static_cast<unsigned int>(pFound - field_4_pTable->mRecords);
+    for (unsigned int idx = (hole + 1) & mask; field_4_pTable->mRecords[idx].field_0_id != -1; idx = (idx + 1) & mask)
     {
-        // There was not an object before this, so set the root to point the one after
-        // we found so we can remove it.
-        field_4_pBuffer[idx] = pFound->field_8_pNext;
+        const unsigned int home = Id_To_Buffer_Size_Range_449BA0(field_4_pTable->mRecords[idx].field_0_id);
+        if (((idx - home) & mask) >= ((idx - hole) & mask))
+        {
+            field_4_pTable->mRecords[hole] = field_4_pTable->mRecords[idx];
+            hole = idx;
+        }
     }
 
-    // Free the found record
-    ae_delete_free_495540(pFound);
+    field_4_pTable->mRecords[hole].field_0_id = -1;
+    field_4_pTable->mRecords[hole].field_4_obj_ptr = nullptr;
+    field_4_pTable->mUsed--;
 
     return 1;
 }
 
+unsigned int ObjectIds::Size() const
+{
+    if (RunningAsInjectedDll())
+    {
+        unsigned int count = 0;
+        for (unsigned int i = 0; i < field_0_buffer_size; i++)
+        {
+            for (const ObjectId_Record* pRecord = field_4_pBuffer[i]; pRecord; pRecord = pRecord->field_8_pNext)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+    return field_4_pTable->mUsed;
+}
+
 BaseGameObject* ObjectIds::Find_449CF0(TObjectId_KeyType idToFind)
 {
     BaseGameObject* pFound = nullptr;
@@ -154,6 +332,161 @@ BaseGameObject* ObjectIds::Find(TObjectId_KeyType idToFind, Types type)
     return pItem;
 }
 
+// How ObjectIds is laid out when injected, an allocation per record chained off 101 buckets
+class ChainedObjectIds
+{
+public:
+    ChainedObjectIds()
+        : mBuckets(101)
+    {
+    }
+
+    ~ChainedObjectIds()
+    {
+        for (ObjectId_Chain* pChain : mBuckets)
+        {
+            while (pChain)
+            {
+                ObjectId_Chain* pNext = pChain->mpNext;
+                ae_delete_free_495540(pChain);
+                pChain = pNext;
+            }
+        }
+    }
+
+    void Insert(TObjectId_KeyType id, BaseGameObject* pGameObj)
+    {
+        ObjectId_Chain* pRec = ae_new<ObjectId_Chain>();
+        pRec->mId = id;
+        pRec->mpObj = pGameObj;
+        pRec->mpNext = mBuckets[id % mBuckets.size()];
+        mBuckets[id % mBuckets.size()] = pRec;
+    }
+
+    BaseGameObject* Find(TObjectId_KeyType id)
+    {
+        for (ObjectId_Chain* pRec = mBuckets[id % mBuckets.size()]; pRec; pRec = pRec->mpNext)
+        {
+            if (pRec->mId == id)
+            {
+                return pRec->mpObj;
+            }
+        }
+        return nullptr;
+    }
+
+    void Remove(TObjectId_KeyType id)
+    {
+        for (ObjectId_Chain** ppRec = &mBuckets[id % mBuckets.size()]; *ppRec; ppRec = &(*ppRec)->mpNext)
+        {
+            if ((*ppRec)->mId == id)
+            {
+                ObjectId_Chain* pFound = *ppRec;
+                *ppRec = pFound->mpNext;
+                ae_delete_free_495540(pFound);
+                return;
+            }
+        }
+    }
+
+private:
+    struct ObjectId_Chain
+    {
+        TObjectId_KeyType mId;
+        BaseGameObject* mpObj;
+        ObjectId_Chain* mpNext;
+    };
+
+    std::vector<ObjectId_Chain*> mBuckets;
+};
+
+// Stand ins for the objects, only their addresses are used
+static char sBenchmarkObjects[16];
+
+// A few hundred objects alive, a handful made and destroyed each frame and lots of finds for target, platform and
+// lift ids, some of which are for objects that have gone.
+template<class TInsert, class TFind, class TRemove>
+static double ObjectIds_TimeChurn(TInsert insert, TFind find, TRemove remove, size_t& checksum)
+{
+    const int kFrames = 20000;
+    const int kLiveObjects = 400;
+    const int kChurnPerFrame = 6;
+    const int kFindsPerFrame = 1500;
+
+    auto ObjectFor = [](TObjectId_KeyType id) { return reinterpret_cast<BaseGameObject*>(&sBenchmarkObjects[id & 15]); };
+
+    std::mt19937 rng(23);
+    std::vector<TObjectId_KeyType> live;
+    TObjectId_KeyType nextId = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kLiveObjects; i++)
+    {
+        live.push_back(nextId);
+        insert(nextId, ObjectFor(nextId));
+        nextId++;
+    }
+
+    for (int frame = 0; frame < kFrames; frame++)
+    {
+        for (int i = 0; i < kChurnPerFrame; i++)
+        {
+            const size_t victim = rng() % live.size();
+            remove(live[victim]);
+            live[victim] = nextId;
+            insert(nextId, ObjectFor(nextId));
+            nextId++;
+        }
+
+        for (int i = 0; i < kFindsPerFrame; i++)
+        {
+            const unsigned int roll = rng();
+            const TObjectId_KeyType id = (roll & 7) ? live[roll % live.size()] : static_cast<TObjectId_KeyType>(roll % nextId);
+            checksum += reinterpret_cast<size_t>(find(id));
+        }
+    }
+
+    for (TObjectId_KeyType id : live)
+    {
+        remove(id);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void ObjectIds_RunBenchmark()
+{
+    if (RunningAsInjectedDll())
+    {
+        // The real table is the bucket chains too
+        LOG_INFO("ObjectIds benchmark skipped, only the standalone build uses open addressing");
+        return;
+    }
+
+    size_t tableChecksum = 0;
+    ObjectIds table;
+    table.ctor_449AE0(101);
+    const double tableMs = ObjectIds_TimeChurn(
+        [&](TObjectId_KeyType id, BaseGameObject* pObj) { table.Insert_449C10(id, pObj); },
+        [&](TObjectId_KeyType id) { return table.Find_449CF0(id); },
+        [&](TObjectId_KeyType id) { table.Remove_449C60(id); },
+        tableChecksum);
+    table.Destructor();
+
+    size_t chainedChecksum = 0;
+    ChainedObjectIds chained;
+    const double chainedMs = ObjectIds_TimeChurn(
+        [&](TObjectId_KeyType id, BaseGameObject* pObj) { chained.Insert(id, pObj); },
+        [&](TObjectId_KeyType id) { return chained.Find(id); },
+        [&](TObjectId_KeyType id) { chained.Remove(id); },
+        chainedChecksum);
+
+    LOG_INFO("ObjectIds benchmark open addressing " << tableMs << " ms, bucket chains " << chainedMs << " ms");
+    if (tableChecksum != chainedChecksum)
+    {
+        LOG_ERROR("ObjectIds benchmark tables found different objects");
+    }
+}
+
 #include <gmock/gmock.h>
 
 namespace Test
@@ -164,8 +497,60 @@ namespace Test
         virtual BaseGameObject* VDestructor(signed int) override { return this; }
     };
 
+    static void ObjectIds_MatchesChains_Test()
+    {
+        // Lots of duplicate ids and more records than the first buffer holds so it grows and wraps around
+        std::mt19937 rng(24);
+        std::vector<FakeGameObject> objects(8);
+        std::vector<std::vector<BaseGameObject*>> expected(300);
+
+        ObjectIds ids;
+        ids.ctor_449AE0(101);
+        for (int i = 0; i < 20000; i++)
+        {
+            const TObjectId_KeyType id = static_cast<TObjectId_KeyType>(rng() % expected.size());
+            if (rng() % 3 == 0)
+            {
+                ASSERT_EQ(expected[id].empty() ? 0 : 1, ids.Remove_449C60(id));
+                if (!expected[id].empty())
+                {
+                    expected[id].pop_back();
+                }
+            }
+            else
+            {
+                BaseGameObject* pObj = &objects[rng() % objects.size()];
+                ids.Insert_449C10(id, pObj);
+                expected[id].push_back(pObj);
+            }
+
+            const TObjectId_KeyType checkId = static_cast<TObjectId_KeyType>(rng() % expected.size());
+            ASSERT_EQ(expected[checkId].empty() ? nullptr : expected[checkId].back(), ids.Find_449CF0(checkId));
+        }
+
+        unsigned int count = 0;
+        for (TObjectId_KeyType id = 0; id < static_cast<TObjectId_KeyType>(expected.size()); id++)
+        {
+            ASSERT_EQ(expected[id].empty() ? nullptr : expected[id].back(), ids.Find_449CF0(id));
+            count += static_cast<unsigned int>(expected[id].size());
+        }
+        ASSERT_EQ(count, ids.Size());
+
+        if (!RunningAsInjectedDll())
+        {
+            // The bucket chains store -1 like any other id
+            ids.Insert_449C10(-1, &objects[0]);
+            ASSERT_EQ(nullptr, ids.Find_449CF0(-1));
+            ASSERT_EQ(0, ids.Remove_449C60(-1));
+        }
+
+        ids.Destructor();
+    }
+
     void ObjectIdsTests()
     {
+        ObjectIds_MatchesChains_Test();
+
         ObjectIds ids;
         ids.ctor_449AE0(101);
 
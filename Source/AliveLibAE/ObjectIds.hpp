@@ -16,9 +16,23 @@ struct ObjectId_Record
 };
 ALIVE_ASSERT_SIZEOF(ObjectId_Record, 0xC);
 
+// The slots of a standalone ObjectIds, ObjectIds::field_0_buffer_size of them. The records are kept in line so
+// inserting doesn't allocate, a field_0_id of -1 is an empty slot (Find_449CF0 never finds -1 anyway) and
+// field_8_pNext isn't used.
+struct ObjectId_Table
+{
+    unsigned int mUsed;
+    ObjectId_Record mRecords[1];
+};
+
 class BaseGameObject;
 enum class Types : __int16;
 
+// When RunningAsInjectedDll() this is the game's own table, field_0_buffer_size buckets of records chained newest
+// first, and is left laid out that way.
+// Standalone builds use open addressing with linear probing instead. Records for the same id, which can happen once
+// a quick save has wound the id counter back, are kept newest first in probe order so Find and Remove see the newest
+// one like the bucket chains do. Removing shifts the records after it back instead of leaving tombstones.
 class ObjectIds
 {
 public:
@@ -26,6 +40,7 @@ public:
     EXPORT static void dtor_43EC90();
     EXPORT void ctor_449AE0(unsigned int size);
     EXPORT unsigned int Id_To_Buffer_Size_Range_449BA0(TObjectId_KeyType id);
+    // ppLastMatch is always set to nullptr in standalone builds, there are no chains
     EXPORT ObjectId_Record* Find_By_Id_449BC0(TObjectId_KeyType idToFind, ObjectId_Record** ppLastMatch);
     EXPORT void Insert_449C10(TObjectId_KeyType objCount, BaseGameObject* pGameObj);
     EXPORT signed __int16 Remove_449C60(TObjectId_KeyType idToRemove);
@@ -35,14 +50,26 @@ public:
 public:
     BaseGameObject* Find(TObjectId_KeyType idToFind, Types type);
 
+    unsigned int Size() const;
+
 private:
-    unsigned int field_0_buffer_size;
-    ObjectId_Record** field_4_pBuffer;
+    void Grow();
+    void Place(TObjectId_KeyType id, BaseGameObject* pGameObj, bool bBeforeSameId);
+
+    unsigned int field_0_buffer_size; // Standalone it's a power of 2 so the hash can be masked
+    union
+    {
+        ObjectId_Record** field_4_pBuffer; // The bucket chains when injected
+        ObjectId_Table* field_4_pTable;    // Standalone
+    };
 };
 ALIVE_ASSERT_SIZEOF(ObjectIds, 0x8);
 
 ALIVE_VAR_EXTERN(ObjectIds, sObjectIds_5C1B70);
 
+// -bench_object_ids times the open addressing table against bucket chains under object churn then exits.
+void ObjectIds_RunBenchmark();
+
 namespace Test
 {
     void ObjectIdsTests();
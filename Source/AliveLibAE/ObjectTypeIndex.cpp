@@ -0,0 +1,587 @@
+#include "stdafx.h"
+#include "ObjectTypeIndex.hpp"
+#include "Function.hpp"
+#include "BaseAliveGameObject.hpp"
+#include "Abe.hpp"
+#include "Game.hpp"
+#include <algorithm>
+#include <memory>
+
+bool gObjectTypeIndexEnabled = true;
+
+ObjectTypeIndex::ObjectTypeIndex(DynamicArray* pList)
+    : mpList(pList)
+{
+
+}
+
+bool ObjectTypeIndex::IsCurrent() const
+{
+    return mBuilt && !mMissedChange && mpList->field_A_removed_count == mRemovedCount && mpList->Size() == mSize;
+}
+
+void ObjectTypeIndex::InsertInOrder(std::vector<Entry>& entries, const Entry& entry)
+{
+    // Nearly always the newest object so it goes on the end
+    if (entries.empty() || entries.back().mPos < entry.mPos)
+    {
+        entries.push_back(entry);
+        return;
+    }
+
+    auto it = std::lower_bound(entries.begin(), entries.end(), entry, [](const Entry& lhs, const Entry& rhs)
+    {
+        return lhs.mPos < rhs.mPos;
+    });
+    entries.insert(it, entry);
+}
+
+std::vector<ObjectTypeIndex::Entry>* ObjectTypeIndex::FindEntry(BaseGameObject* pObj, Types type, size_t& idx)
+{
+    auto typeIt = mTypes.find(static_cast<int>(type));
+    std::vector<Entry>* candidates[] = { typeIt != mTypes.end() ? &typeIt->second : nullptr, &mPending };
+    for (std::vector<Entry>* pEntries : candidates)
+    {
+        if (!pEntries)
+        {
+            continue;
+        }
+
+        // Searched from the back as recently made objects are the ones that come and go
+        for (size_t i = pEntries->size(); i-- > 0;)
+        {
+            if ((*pEntries)[i].mpObj == pObj)
+            {
+                idx = i;
+                return pEntries;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void ObjectTypeIndex::OnObjectAdded(BaseGameObject* pObj)
+{
+    if (!mBuilt || mMissedChange)
+    {
+        return;
+    }
+
+    auto pList = static_cast<DynamicArrayT<BaseGameObject>*>(mpList);
+    if (pList->field_A_removed_count != mRemovedCount || pList->Size() != mSize + 1 || pList->ItemAt(mSize) != pObj)
+    {
+        mMissedChange = true;
+        return;
+    }
+
+    // The derived ctor hasn't set the type yet
+    mPending.push_back({ pObj, mSize, sGnFrame_5C1B84 });
+    mSize++;
+    mVersion++;
+}
+
+void ObjectTypeIndex::OnObjectRemoved(BaseGameObject* pObj)
+{
+    if (!mBuilt || mMissedChange || mpList->field_A_removed_count == mRemovedCount)
+    {
+        // Not taken off this list
+        return;
+    }
+
+    size_t idx = 0;
+    std::vector<Entry>* pEntries = FindEntry(pObj, pObj->field_4_typeId, idx);
+    if (static_cast<unsigned __int16>(mRemovedCount + 1) != mpList->field_A_removed_count || mpList->Size() != mSize - 1 || !pEntries)
+    {
+        mMissedChange = true;
+        return;
+    }
+
+    const int pos = (*pEntries)[idx].mPos;
+    pEntries->erase(pEntries->begin() + idx);
+
+    // The list moves its last item in to the gap
+    const int lastPos = mSize - 1;
+    if (pos != lastPos)
+    {
+        BaseGameObject* pMoved = static_cast<DynamicArrayT<BaseGameObject>*>(mpList)->ItemAt(pos);
+        std::vector<Entry>* pMovedEntries = FindEntry(pMoved, pMoved->field_4_typeId, idx);
+        if (!pMovedEntries || (*pMovedEntries)[idx].mPos != lastPos)
+        {
+            mMissedChange = true;
+            return;
+        }
+
+        Entry moved = (*pMovedEntries)[idx];
+        moved.mPos = pos;
+        pMovedEntries->erase(pMovedEntries->begin() + idx);
+        InsertInOrder(*pMovedEntries, moved);
+    }
+
+    mSize--;
+    mRemovedCount++;
+    mVersion++;
+}
+
+void ObjectTypeIndex::OnTypeChanged(BaseGameObject* pObj, Types oldType)
+{
+    if (!mBuilt || mMissedChange)
+    {
+        return;
+    }
+
+    size_t idx = 0;
+    std::vector<Entry>* pEntries = FindEntry(pObj, oldType, idx);
+    if (!pEntries)
+    {
+        mMissedChange = true;
+        return;
+    }
+
+    if (pEntries != &mPending)
+    {
+        const Entry entry = (*pEntries)[idx];
+        pEntries->erase(pEntries->begin() + idx);
+        InsertInOrder(mTypes[static_cast<int>(pObj->field_4_typeId)], entry);
+        mVersion++;
+    }
+}
+
+void ObjectTypeIndex::Refresh(unsigned int frame)
+{
+    if (!IsCurrent())
+    {
+        Rebuild(frame);
+        return;
+    }
+
+    // Anything made in an earlier frame has finished its ctor even if it never got a type
+    size_t kept = 0;
+    for (const Entry& entry : mPending)
+    {
+        if (entry.mpObj->field_4_typeId == Types::eNone_0 && entry.mAddedFrame == frame)
+        {
+            mPending[kept++] = entry;
+        }
+        else
+        {
+            InsertInOrder(mTypes[static_cast<int>(entry.mpObj->field_4_typeId)], entry);
+        }
+    }
+
+    if (kept != mPending.size())
+    {
+        mPending.resize(kept);
+        mVersion++;
+    }
+}
+
+void ObjectTypeIndex::Rebuild(unsigned int frame)
+{
+    for (auto& type : mTypes)
+    {
+        type.second.clear();
+    }
+    mPending.clear();
+
+    auto pList = static_cast<DynamicArrayT<BaseGameObject>*>(mpList);
+    for (int i = 0; i < pList->Size(); i++)
+    {
+        BaseGameObject* pObj = pList->ItemAt(i);
+        if (!pObj)
+        {
+            break;
+        }
+
+        // Could still be in its ctor
+        if (pObj->field_4_typeId == Types::eNone_0)
+        {
+            mPending.push_back({ pObj, i, frame });
+        }
+        else
+        {
+            mTypes[static_cast<int>(pObj->field_4_typeId)].push_back({ pObj, i, frame });
+        }
+    }
+
+    mBuilt = true;
+    mMissedChange = false;
+    mSize = pList->Size();
+    mRemovedCount = mpList->field_A_removed_count;
+    mVersion++;
+}
+
+const std::vector<ObjectTypeIndex::Entry>& ObjectTypeIndex::OfType(Types type)
+{
+    return mTypes[static_cast<int>(type)];
+}
+
+ObjectTypeIndex* ObjectTypeIndex_Get(DynamicArray* pList)
+{
+    static std::unique_ptr<ObjectTypeIndex> sObjectsIndex;
+    static std::unique_ptr<ObjectTypeIndex> sAliveObjectsIndex;
+
+    // The game's own code removes items without telling the index
+    if (!gObjectTypeIndexEnabled || RunningAsInjectedDll() || !pList)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<ObjectTypeIndex>* ppIndex = nullptr;
+    if (pList == gBaseGameObject_list_BB47C4)
+    {
+        ppIndex = &sObjectsIndex;
+    }
+    else if (pList == gBaseAliveGameObjects_5C1B7C)
+    {
+        ppIndex = &sAliveObjectsIndex;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    if (!*ppIndex || (*ppIndex)->List() != pList)
+    {
+        ppIndex->reset(new ObjectTypeIndex(pList));
+    }
+    return ppIndex->get();
+}
+
+void ObjectTypeIndex_OnObjectAdded(DynamicArray* pList, BaseGameObject* pObj)
+{
+    if (ObjectTypeIndex* pIndex = ObjectTypeIndex_Get(pList))
+    {
+        pIndex->OnObjectAdded(pObj);
+    }
+}
+
+void ObjectTypeIndex_OnObjectRemoved(DynamicArray* pList, BaseGameObject* pObj)
+{
+    if (ObjectTypeIndex* pIndex = ObjectTypeIndex_Get(pList))
+    {
+        pIndex->OnObjectRemoved(pObj);
+    }
+}
+
+void ObjectTypeIndex_SetType(BaseGameObject* pObj, Types type)
+{
+    const Types oldType = pObj->field_4_typeId;
+    pObj->field_4_typeId = type;
+    if (oldType == type)
+    {
+        return;
+    }
+
+    if (ObjectTypeIndex* pIndex = ObjectTypeIndex_Get(gBaseGameObject_list_BB47C4))
+    {
+        pIndex->OnTypeChanged(pObj, oldType);
+    }
+
+    if (pObj->field_6_flags.Get(BaseGameObject::eIsBaseAliveGameObject_Bit6))
+    {
+        if (ObjectTypeIndex* pIndex = ObjectTypeIndex_Get(gBaseAliveGameObjects_5C1B7C))
+        {
+            pIndex->OnTypeChanged(pObj, oldType);
+        }
+    }
+}
+
+ObjectsOfTypeIter::ObjectsOfTypeIter(DynamicArray* pList, Types type)
+    : mpList(pList), mType(type)
+{
+    mpIndex = ObjectTypeIndex_Get(pList);
+    if (mpIndex)
+    {
+        mpIndex->Refresh(sGnFrame_5C1B84);
+        mpOfType = &mpIndex->OfType(type);
+        mVersion = mpIndex->Version();
+        mRemovedCount = pList->field_A_removed_count;
+    }
+}
+
+static size_t FirstEntryFrom(const std::vector<ObjectTypeIndex::Entry>& entries, int pos)
+{
+    return std::lower_bound(entries.begin(), entries.end(), pos, [](const ObjectTypeIndex::Entry& entry, int value)
+    {
+        return entry.mPos < value;
+    }) - entries.begin();
+}
+
+BaseGameObject* ObjectsOfTypeIter::Next()
+{
+    while (mpIndex)
+    {
+        if (mpList->field_A_removed_count != mRemovedCount || !mpIndex->IsCurrent())
+        {
+            // Items got swapped around while walking, carry on from here the same way the original loop would
+            break;
+        }
+
+        const std::vector<ObjectTypeIndex::Entry>& pending = mpIndex->Pending();
+        if (mpIndex->Version() != mVersion)
+        {
+            // Something was added or changed type while walking
+            mOfTypeIdx = FirstEntryFrom(*mpOfType, mLinearIdx);
+            mPendingIdx = FirstEntryFrom(pending, mLinearIdx);
+            mVersion = mpIndex->Version();
+        }
+
+        // Both are in list order so take whichever comes first
+        const ObjectTypeIndex::Entry* pEntry = nullptr;
+        if (mOfTypeIdx < mpOfType->size() && (mPendingIdx >= pending.size() || (*mpOfType)[mOfTypeIdx].mPos < pending[mPendingIdx].mPos))
+        {
+            pEntry = &(*mpOfType)[mOfTypeIdx++];
+        }
+        else if (mPendingIdx < pending.size())
+        {
+            pEntry = &pending[mPendingIdx++];
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        mLinearIdx = pEntry->mPos + 1;
+        if (pEntry->mpObj->field_4_typeId == mType)
+        {
+            return pEntry->mpObj;
+        }
+    }
+
+    mpIndex = nullptr;
+    return NextLinear();
+}
+
+BaseGameObject* ObjectsOfTypeIter::NextLinear()
+{
+    auto pList = static_cast<DynamicArrayT<BaseGameObject>*>(mpList);
+    while (mLinearIdx < pList->Size())
+    {
+        BaseGameObject* pObj = pList->ItemAt(mLinearIdx++);
+        if (!pObj)
+        {
+            break;
+        }
+
+        if (pObj->field_4_typeId == mType)
+        {
+            return pObj;
+        }
+    }
+    return nullptr;
+}
+
+struct TypeIndexBenchmarkTotals
+{
+    double mMs[2] = {};
+    int mFrames[2] = {};
+    long long mObjects[2] = {};
+};
+
+static TypeIndexBenchmarkTotals sTypeIndexBenchmark;
+
+ObjectTypeIndexBenchmarkScope::ObjectTypeIndexBenchmarkScope()
+{
+    // Only time frames that are being played, the menus have next to nothing in them
+    if (!gObjectTypesBenchmark || !sActiveHero_5C1B68 || sActiveHero_5C1B68 == spAbe_554D5C)
+    {
+        return;
+    }
+
+    mActive = true;
+    mIndexed = (sGnFrame_5C1B84 / kFramesPerRun) % 2 == 0;
+    gObjectTypeIndexEnabled = mIndexed;
+    mStart = std::chrono::steady_clock::now();
+}
+
+ObjectTypeIndexBenchmarkScope::~ObjectTypeIndexBenchmarkScope()
+{
+    if (!mActive)
+    {
+        return;
+    }
+
+    sTypeIndexBenchmark.mMs[mIndexed] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mStart).count();
+    sTypeIndexBenchmark.mFrames[mIndexed]++;
+    sTypeIndexBenchmark.mObjects[mIndexed] += gBaseGameObject_list_BB47C4->Size();
+}
+
+void ObjectTypeIndex_ReportBenchmark()
+{
+    const TypeIndexBenchmarkTotals& totals = sTypeIndexBenchmark;
+    if (totals.mFrames[0] == 0 || totals.mFrames[1] == 0)
+    {
+        LOG_ERROR("Object type benchmark didn't get to play both with and without the index, run it for more -frames");
+        return;
+    }
+
+    LOG_INFO("Object type benchmark object updates per frame: walking the list " << totals.mMs[0] / totals.mFrames[0]
+        << " ms over " << totals.mFrames[0] << " frames of " << totals.mObjects[0] / totals.mFrames[0] << " objects, type index "
+        << totals.mMs[1] / totals.mFrames[1] << " ms over " << totals.mFrames[1] << " frames of " << totals.mObjects[1] / totals.mFrames[1] << " objects");
+}
+
+namespace Test
+{
+    class TypeIndexTestObj : public BaseGameObject
+    {
+    public:
+        virtual BaseGameObject* VDestructor(signed int) override
+        {
+            // Stub
+            return this;
+        }
+    };
+
+    // In the same order as BaseGameObject_ctor_4DBFA0 and then the derived ctor
+    static void AddTestObj(DynamicArrayT<BaseGameObject>& list, TypeIndexTestObj& obj, Types type)
+    {
+        obj.field_6_flags.Raw().all = 0;
+        obj.field_4_typeId = Types::eNone_0;
+        list.Push_Back(&obj);
+        ObjectTypeIndex_OnObjectAdded(&list, &obj);
+        obj.field_4_typeId = type;
+    }
+
+    static void RemoveTestObj(DynamicArrayT<BaseGameObject>& list, TypeIndexTestObj& obj)
+    {
+        list.Remove_Item(&obj);
+        ObjectTypeIndex_OnObjectRemoved(&list, &obj);
+    }
+
+    static std::vector<BaseGameObject*> WalkType(ObjectsOfTypeIter& iter)
+    {
+        std::vector<BaseGameObject*> found;
+        while (BaseGameObject* pObj = iter.Next())
+        {
+            found.push_back(pObj);
+        }
+        return found;
+    }
+
+    static std::vector<BaseGameObject*> WalkType(DynamicArrayT<BaseGameObject>& list, Types type)
+    {
+        ObjectsOfTypeIter iter(&list, type);
+        return WalkType(iter);
+    }
+
+    static void ObjectTypeIndex_Track_Test()
+    {
+        const bool oldEnabled = gObjectTypeIndexEnabled;
+        const unsigned int oldFrame = sGnFrame_5C1B84;
+        DynamicArrayT<BaseGameObject>* pOldList = gBaseGameObject_list_BB47C4;
+
+        const int kObjCount = 8;
+        const Types types[kObjCount - 2] = { Types::eMudokon_110, Types::eSlig_125, Types::eMudokon_110, Types::eDoor_33, Types::eMudokon_110, Types::eSlig_125 };
+        TypeIndexTestObj objs[kObjCount];
+
+        DynamicArrayT<BaseGameObject> list;
+        list.ctor_40CA60(kObjCount);
+        gBaseGameObject_list_BB47C4 = &list;
+        gObjectTypeIndexEnabled = true;
+        sGnFrame_5C1B84 = 1;
+
+        for (int i = 0; i < kObjCount - 2; i++)
+        {
+            AddTestObj(list, objs[i], types[i]);
+        }
+
+        // Built on the first walk
+        ObjectTypeIndex* pIndex = ObjectTypeIndex_Get(&list);
+        ASSERT_FALSE(pIndex->IsCurrent());
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[0], &objs[2], &objs[4] }), WalkType(list, Types::eMudokon_110));
+        ASSERT_TRUE(pIndex->IsCurrent());
+
+        // Still in its ctor without a type
+        AddTestObj(list, objs[6], Types::eNone_0);
+        ASSERT_TRUE(pIndex->IsCurrent());
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[0], &objs[2], &objs[4] }), WalkType(list, Types::eMudokon_110));
+        objs[6].field_4_typeId = Types::eMudokon_110;
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[0], &objs[2], &objs[4], &objs[6] }), WalkType(list, Types::eMudokon_110));
+        ASSERT_TRUE(pIndex->Pending().empty());
+
+        // Never got a type, filed once its frame is over
+        AddTestObj(list, objs[7], Types::eNone_0);
+        ASSERT_EQ(1u, pIndex->Pending().size());
+        sGnFrame_5C1B84++;
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[1], &objs[5] }), WalkType(list, Types::eSlig_125));
+        ASSERT_TRUE(pIndex->Pending().empty());
+
+        // objs[7] gets swapped in to where objs[2] was and then objs[6] in to where objs[0] was, the walk follows the list
+        RemoveTestObj(list, objs[2]);
+        RemoveTestObj(list, objs[0]);
+        ASSERT_TRUE(pIndex->IsCurrent());
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[6], &objs[4] }), WalkType(list, Types::eMudokon_110));
+        ASSERT_EQ(2u, pIndex->OfType(Types::eMudokon_110).size());
+
+        // Changing type after being made
+        ObjectTypeIndex_SetType(&objs[5], Types::eMudokon_110);
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[6], &objs[4], &objs[5] }), WalkType(list, Types::eMudokon_110));
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[1] }), WalkType(list, Types::eSlig_125));
+
+        // Changing the list behind the index's back means it has to be rebuilt
+        list.Push_Back(&objs[0]);
+        ASSERT_FALSE(pIndex->IsCurrent());
+        ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[6], &objs[4], &objs[5], &objs[0] }), WalkType(list, Types::eMudokon_110));
+        ASSERT_TRUE(pIndex->IsCurrent());
+
+        list.dtor_40CAD0();
+        gBaseGameObject_list_BB47C4 = pOldList;
+        gObjectTypeIndexEnabled = oldEnabled;
+        sGnFrame_5C1B84 = oldFrame;
+    }
+
+    static void ObjectTypeIndex_Iter_Test()
+    {
+        const bool oldEnabled = gObjectTypeIndexEnabled;
+        DynamicArrayT<BaseGameObject>* pOldList = gBaseGameObject_list_BB47C4;
+
+        const int kObjCount = 8;
+        const Types types[kObjCount] = { Types::eMudokon_110, Types::eSlig_125, Types::eMudokon_110, Types::eDoor_33, Types::eMudokon_110, Types::eSlig_125, Types::eMudokon_110, Types::eMudokon_110 };
+        TypeIndexTestObj objs[kObjCount];
+
+        DynamicArrayT<BaseGameObject> list;
+        list.ctor_40CA60(kObjCount);
+        gBaseGameObject_list_BB47C4 = &list;
+
+        for (bool bEnabled : { false, true })
+        {
+            gObjectTypeIndexEnabled = bEnabled;
+            for (int i = 0; i < kObjCount - 1; i++)
+            {
+                AddTestObj(list, objs[i], types[i]);
+            }
+
+            ObjectsOfTypeIter muds(&list, Types::eMudokon_110);
+            ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[0], &objs[2], &objs[4], &objs[6] }), WalkType(muds));
+
+            // Added while walking
+            ObjectsOfTypeIter sligs(&list, Types::eSlig_125);
+            ASSERT_EQ(&objs[1], sligs.Next());
+            AddTestObj(list, objs[7], Types::eSlig_125);
+            ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[5], &objs[7] }), WalkType(sligs));
+
+            // Removed while walking, objs[7] gets swapped in to where objs[2] was
+            ObjectsOfTypeIter moreSligs(&list, Types::eSlig_125);
+            ASSERT_EQ(&objs[1], moreSligs.Next());
+            RemoveTestObj(list, objs[2]);
+            ASSERT_EQ((std::vector<BaseGameObject*>{ &objs[7], &objs[5] }), WalkType(moreSligs));
+
+            // Empty it for the next go
+            while (!list.IsEmpty())
+            {
+                RemoveTestObj(list, static_cast<TypeIndexTestObj&>(*list.ItemAt(list.Size() - 1)));
+            }
+            sGnFrame_5C1B84++;
+        }
+
+        list.dtor_40CAD0();
+        gBaseGameObject_list_BB47C4 = pOldList;
+        gObjectTypeIndexEnabled = oldEnabled;
+    }
+
+    void ObjectTypeIndexTests()
+    {
+        ObjectTypeIndex_Track_Test();
+        ObjectTypeIndex_Iter_Test();
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "DynamicArray.hpp"
+#include <chrono>
+#include <vector>
+#include <unordered_map>
+
+class BaseGameObject;
+enum class Types : __int16;
+
+namespace Test
+{
+    void ObjectTypeIndexTests();
+}
+
+// The objects of each type in an object list, in list order, so "find every X" scans only look at the Xs.
+//
+// Objects are added by the BaseGameObject/BaseAliveGameObject ctors when they are pushed on to a list and removed by
+// their dtors once they have been taken off it, which is also when the list swaps its last item in to the gap.
+// Derived ctors set the type after the object has been added so new objects stay pending, and are always looked at,
+// until they have a type or the frame they were made in is over. Anything else that changes an object's type must
+// use ObjectTypeIndex_SetType. If the list is changed in a way the index didn't see it is rebuilt from the list on
+// the next scan.
+class ObjectTypeIndex
+{
+public:
+    struct Entry
+    {
+        BaseGameObject* mpObj;
+        int mPos; // Index in the list
+        unsigned int mAddedFrame;
+    };
+
+    explicit ObjectTypeIndex(DynamicArray* pList);
+
+    // Called once the object has been pushed on to the end of the list.
+    void OnObjectAdded(BaseGameObject* pObj);
+
+    // Called once the object has been taken off the list.
+    void OnObjectRemoved(BaseGameObject* pObj);
+
+    // Called after the type of an object on the list has been changed from oldType.
+    void OnTypeChanged(BaseGameObject* pObj, Types oldType);
+
+    // Rebuilds if the index missed a change to the list, otherwise files the pending objects that now have a type.
+    void Refresh(unsigned int frame);
+    void Rebuild(unsigned int frame);
+
+    bool IsCurrent() const;
+
+    // Objects that had the type when they were filed, in list order.
+    const std::vector<Entry>& OfType(Types type);
+
+    // Objects that could still be in their ctor without their real type, in list order.
+    const std::vector<Entry>& Pending() const
+    {
+        return mPending;
+    }
+
+    // Changes whenever entries are added, removed or moved so a walk knows to find its place again.
+    unsigned int Version() const
+    {
+        return mVersion;
+    }
+
+    DynamicArray* List() const
+    {
+        return mpList;
+    }
+
+private:
+    std::vector<Entry>* FindEntry(BaseGameObject* pObj, Types type, size_t& idx);
+    static void InsertInOrder(std::vector<Entry>& entries, const Entry& entry);
+
+    DynamicArray* mpList = nullptr;
+    unsigned __int16 mRemovedCount = 0;
+    int mSize = 0;
+    unsigned int mVersion = 0;
+    bool mBuilt = false;
+    bool mMissedChange = false;
+
+    // Emptied rather than erased on a rebuild so walks can keep pointers to them
+    std::unordered_map<int, std::vector<Entry>> mTypes;
+    std::vector<Entry> mPending;
+};
+
+// Returns the index for gBaseGameObject_list_BB47C4 or gBaseAliveGameObjects_5C1B7C, nullptr for any other list or
+// when the index is turned off.
+ObjectTypeIndex* ObjectTypeIndex_Get(DynamicArray* pList);
+
+void ObjectTypeIndex_OnObjectAdded(DynamicArray* pList, BaseGameObject* pObj);
+void ObjectTypeIndex_OnObjectRemoved(DynamicArray* pList, BaseGameObject* pObj);
+
+// Changes the type of an object that has finished being made.
+void ObjectTypeIndex_SetType(BaseGameObject* pObj, Types type);
+
+// Walks the objects of a type in a list in list order, including any added while walking.
+// Falls back to walking the whole list when there is no index for it.
+class ObjectsOfTypeIter
+{
+public:
+    ObjectsOfTypeIter(DynamicArray* pList, Types type);
+
+    BaseGameObject* Next();
+
+private:
+    BaseGameObject* NextLinear();
+
+    DynamicArray* mpList = nullptr;
+    ObjectTypeIndex* mpIndex = nullptr;
+    const std::vector<ObjectTypeIndex::Entry>* mpOfType = nullptr;
+    Types mType;
+    unsigned __int16 mRemovedCount = 0;
+    unsigned int mVersion = 0;
+    size_t mOfTypeIdx = 0;
+    size_t mPendingIdx = 0;
+    int mLinearIdx = 0;
+};
+
+template<class T>
+class ObjectsOfType
+{
+public:
+    ObjectsOfType(DynamicArrayT<T>* pList, Types type)
+        : mIter(pList, type)
+    {
+
+    }
+
+    // Next object of the type or nullptr when there are no more.
+    T* Next()
+    {
+        return static_cast<T*>(mIter.Next());
+    }
+
+private:
+    ObjectsOfTypeIter mIter;
+};
+
+// Times the object updates of a Game_Loop_467230 frame for -bench_object_types, the index is switched on and off
+// every kFramesPerRun frames so both see the same scenes.
+class ObjectTypeIndexBenchmarkScope
+{
+public:
+    ObjectTypeIndexBenchmarkScope();
+    ~ObjectTypeIndexBenchmarkScope();
+
+    static const int kFramesPerRun = 250;
+
+private:
+    bool mActive = false;
+    bool mIndexed = false;
+    std::chrono::steady_clock::time_point mStart;
+};
+
+// Logs the -bench_object_types results once the game loop has finished.
+void ObjectTypeIndex_ReportBenchmark();
+
+// -bench_object_types times the object updates of every frame with and without the index, use with -headless and
+// -frames=N, the main menu plays its demos when left alone.
+extern bool gObjectTypesBenchmark;
+
+// When false every typed scan walks the whole object list like the original game.
+extern bool gObjectTypeIndexEnabled;
@@ -26,6 +26,7 @@
 #include "ParamiteWeb.hpp"
 #include "ParamiteWebLine.hpp"
 #include "ScreenShake.hpp"
+#include "ObjectTypeIndex.hpp"
 
 TintEntry stru_55D73C[24] =
 {
@@ -80,6 +81,11 @@ bool Paramite::BrainIs(TParamiteAIFn fn)
     return ::BrainIs(fn, field_128_fn_brainState, sParamiteAITable);
 }
 
+const char* Paramite::BrainName() const
+{
+    return ::BrainName(field_128_fn_brainState, sParamiteAITable);
+}
+
 
 Paramite* Paramite::ctor_4879B0(Path_Paramite* pTlv, int tlvInfo)
 {
@@ -5403,17 +5409,10 @@ void Paramite::vUpdate_4871B0()
 
 __int16 Paramite::Find_Paramite_488810()
 {
-    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsOfType<BaseAliveGameObject> paramites(gBaseAliveGameObjects_5C1B7C, Types::eParamite_96);
+    while (BaseAliveGameObject* pObj = paramites.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eParamite_96 &&
-            pObj != this &&
-            gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pObj->field_C2_lvl_number, pObj->field_C0_path_number, pObj->field_B8_xpos, pObj->field_BC_ypos, 0))
+        if (pObj != this && gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pObj->field_C2_lvl_number, pObj->field_C0_path_number, pObj->field_B8_xpos, pObj->field_BC_ypos, 0))
         {
             return 1;
         }
@@ -5430,31 +5429,23 @@ void Paramite::vUpdateAnim_487170()
 
 Meat* Paramite::FindMeat_488930()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> meats(gBaseGameObject_list_BB47C4, Types::eMeat_84);
+    while (BaseGameObject* pObj = meats.Next())
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eMeat_84)
+        auto pMeat = static_cast<Meat*>(pObj);
+        if (pMeat->VCanEatMe_4696A0())
         {
-            auto pMeat = static_cast<Meat*>(pObj);
-            if (pMeat->VCanEatMe_4696A0())
+            if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pMeat->field_C2_lvl_number, pMeat->field_C0_path_number, pMeat->field_B8_xpos, pMeat->field_BC_ypos, 0) &&
+                !WallHit_408750(field_BC_ypos, pMeat->field_B8_xpos - field_B8_xpos))
             {
-                if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pMeat->field_C2_lvl_number, pMeat->field_C0_path_number, pMeat->field_B8_xpos, pMeat->field_BC_ypos, 0) &&
-                    !WallHit_408750(field_BC_ypos, pMeat->field_B8_xpos - field_B8_xpos))
+                if (!pMeat->field_130_pLine)
                 {
-                    if (!pMeat->field_130_pLine)
-                    {
-                        return pMeat;
-                    }
+                    return pMeat;
+                }
 
-                    if (FP_Abs(pMeat->field_BC_ypos - field_BC_ypos) <= FP_FromInteger(20))
-                    {
-                        return pMeat;
-                    }
+                if (FP_Abs(pMeat->field_BC_ypos - field_BC_ypos) <= FP_FromInteger(20))
+                {
+                    return pMeat;
                 }
             }
         }
@@ -5669,15 +5660,10 @@ void Paramite::vOn_TLV_Collision_488640(Path_TLV* pTlv)
 
 __int16 Paramite::AnotherParamiteNear_4886E0()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> paramites(gBaseGameObject_list_BB47C4, Types::eParamite_96);
+    while (BaseGameObject* pObj = paramites.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eParamite_96 && pObj != this)
+        if (pObj != this)
         {
             auto pOther = static_cast<Paramite*>(pObj);
             if (pOther->field_CC_sprite_scale == field_CC_sprite_scale && 
@@ -5836,28 +5822,20 @@ __int16 Paramite::HandleEnemyStopper_4893B0(__int16 numGridBlocks)
 
 PullRingRope* Paramite::FindPullRope_488F20()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> pullRopes(gBaseGameObject_list_BB47C4, Types::ePullRope_103);
+    while (BaseGameObject* pObj = pullRopes.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
+        auto pRope = static_cast<PullRingRope*>(pObj);
 
-        if (pObj->field_4_typeId == Types::ePullRope_103)
+        if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
         {
-            auto pRope = static_cast<PullRingRope*>(pObj);
-
-            if (pRope->field_CC_sprite_scale == field_CC_sprite_scale)
+            PSX_RECT bRect = {};
+            pRope->vGetBoundingRect_424FD0(&bRect, 1);
+            if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(40))) <= pRope->field_BC_ypos && field_BC_ypos > pRope->field_BC_ypos)
             {
-                PSX_RECT bRect = {};
-                pRope->vGetBoundingRect_424FD0(&bRect, 1);
-                if ((field_BC_ypos - (field_CC_sprite_scale * FP_FromInteger(40))) <= pRope->field_BC_ypos && field_BC_ypos > pRope->field_BC_ypos)
+                if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
                 {
-                    if (field_B8_xpos > FP_FromInteger(bRect.x) && field_B8_xpos < FP_FromInteger(bRect.w))
-                    {
-                        return pRope;
-                    }
+                    return pRope;
                 }
             }
         }
@@ -353,6 +353,9 @@ private:
     void SetBrain(TParamiteAIFn fn);
     bool BrainIs(TParamiteAIFn fn);
 
+public:
+    const char* BrainName() const;
+
 private:
     EXPORT void dtor_487FC0();
     EXPORT Paramite* vdtor_487F90(signed int flags);
@@ -5,6 +5,7 @@
 #include "Game.hpp"
 #include "stdlib.hpp"
 #include "Function.hpp"
+#include "ObjectTypeIndex.hpp"
 
 BaseGameObject* PossessionFlicker::VDestructor(signed int flags)
 {
@@ -30,17 +31,10 @@ PossessionFlicker* PossessionFlicker::ctor_4319E0(BaseAliveGameObject* pToApplyF
     field_30_obj_id = pToApplyFlicker->field_8_object_id;
 
     // Check if another PossessionFlicker is already applying flicker to pToApplyFlicker
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> possessionFlickers(gBaseGameObject_list_BB47C4, Types::ePossessionFlicker_51);
+    while (BaseGameObject* pObj = possessionFlickers.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj != this &&
-            pObj->field_4_typeId == Types::ePossessionFlicker_51 &&
-            static_cast<PossessionFlicker*>(pObj)->ObjectId() == field_30_obj_id)
+        if (pObj != this && static_cast<PossessionFlicker*>(pObj)->ObjectId() == field_30_obj_id)
         {
             // It is to don't store the id, first update will destroy this object
             field_30_obj_id = -1;
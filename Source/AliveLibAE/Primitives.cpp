@@ -3,6 +3,7 @@
 #include "Function.hpp"
 #include "stdlib.hpp"
 #include "Game.hpp"
+#include "PsxRenderCommands.hpp"
 
 void Primitives_ForceLink() { }
 
@@ -124,6 +125,11 @@ void CC OrderingTable_Add_4F8AA0(PrimHeader** ppOt, PrimHeader* pItem)
         abort();
     }
 
+    if (PSX_Commands_Add(ppOt, pItem))
+    {
+        return;
+    }
+
     // Get current OT ptr
     PrimHeader* pOt = *ppOt;
 
@@ -12,6 +12,8 @@
 #include "Game.hpp" // sIOSyncReads_BD2A5C, sCdRomDrives_5CA488
 #include "PsxRender.hpp"
 #include "Sys.hpp"
+#include "FramePacer.hpp"
+#include "AnimationFrameCache.hpp"
 #include "PsxRender.hpp"
 #include <gmock/gmock.h>
 
@@ -21,16 +23,16 @@ ALIVE_VAR(1, 0x578325, char, sVSync_Unused_578325, 0);
 ALIVE_VAR(1, 0xBD0F2C, int, sVSyncLastMillisecond_BD0F2C, 0);
 ALIVE_VAR(1, 0xBD0F24, int, sLastFrameTimestampMilliseconds_BD0F24, 0);
 
-ALIVE_VAR(1, 0xC3D080, PSX_DRAWENV, sPSX_EMU_DrawEnvState_C3D080, {});
+ALIVE_VAR_TLS(1, 0xC3D080, PSX_DRAWENV, sPSX_EMU_DrawEnvState_C3D080, {});
 ALIVE_VAR(1, 0x578E88, int, sConst_1000_578E88, 1000);
 ALIVE_VAR(1, 0xBD1464, BYTE, bDontUseXYOffsetInRender_BD1464, 0);
 
-ALIVE_VAR(1, 0xBDCD40, int, sPsx_drawenv_clipx_BDCD40, 0);
-ALIVE_VAR(1, 0xBDCD44, int, sPsx_drawenv_clipy_BDCD44, 0);
-ALIVE_VAR(1, 0xBDCD48, int, sPsx_drawenv_clipw_BDCD48, 0);
-ALIVE_VAR(1, 0xBDCD4C, int, sPsx_drawenv_cliph_BDCD4C, 0);
-ALIVE_VAR(1, 0xBDCD50, int, sPsx_drawenv_k500_BDCD50, 0);
-ALIVE_VAR(1, 0xBDCD54, BYTE*, sPsx_drawenv_buffer_BDCD54, nullptr);
+ALIVE_VAR_TLS(1, 0xBDCD40, int, sPsx_drawenv_clipx_BDCD40, 0);
+ALIVE_VAR_TLS(1, 0xBDCD44, int, sPsx_drawenv_clipy_BDCD44, 0);
+ALIVE_VAR_TLS(1, 0xBDCD48, int, sPsx_drawenv_clipw_BDCD48, 0);
+ALIVE_VAR_TLS(1, 0xBDCD4C, int, sPsx_drawenv_cliph_BDCD4C, 0);
+ALIVE_VAR_TLS(1, 0xBDCD50, int, sPsx_drawenv_k500_BDCD50, 0);
+ALIVE_VAR_TLS(1, 0xBDCD54, BYTE*, sPsx_drawenv_buffer_BDCD54, nullptr);
 ALIVE_VAR(1, 0xBD1465, BYTE, sPsxEMU_show_vram_BD1465, 0);
 
 ALIVE_VAR(1, 0xC1D160, Bitmap, sPsxVram_C1D160, {});
@@ -49,6 +51,14 @@ ALIVE_ARY(1, 0xC145A0, char, 128, sCdEmu_Path3_C145A0, {});
 ALIVE_VAR(1, 0xBD1CC4, IO_Handle*, sCdFileHandle_BD1CC4, nullptr);
 ALIVE_VAR(1, 0xBD1894, int, sCdReadPos_BD1894, 0);
 
+// Where sCdFileHandle_BD1CC4 was opened from so it can be opened again by other threads
+static char sCdFilePath[1024] = {};
+
+const char* PSX_CD_OpenedFilePath()
+{
+    return sCdFileHandle_BD1CC4 ? sCdFilePath : nullptr;
+}
+
 EXPORT int CC PSX_CD_OpenFile_4FAE80(const char* pFileName, int bTryAllPaths)
 {
     static char sLastOpenedFileName_BD1898[1024] = {};
@@ -93,6 +103,7 @@ EXPORT int CC PSX_CD_OpenFile_4FAE80(const char* pFileName, int bTryAllPaths)
                     sCdFileHandle_BD1CC4 = IO_Open_4F2320(pFileName, openMode);
                     if (sCdFileHandle_BD1CC4)
                     {
+                        strcpy(sCdFilePath, pFileName);
                         return 1;
                     }
 
@@ -118,6 +129,7 @@ EXPORT int CC PSX_CD_OpenFile_4FAE80(const char* pFileName, int bTryAllPaths)
                                 // Update the default CD-ROM to try
                                 sCdEmu_Path2_C144C0[0] = fullFilePath[0];
                                 strcpy(sLastOpenedFileName_BD1898, pFileName);
+                                strcpy(sCdFilePath, fullFilePath);
                                 return 1;
                             }
                         }
@@ -145,6 +157,7 @@ EXPORT int CC PSX_CD_OpenFile_4FAE80(const char* pFileName, int bTryAllPaths)
             sCdFileHandle_BD1CC4 = hFile;
         }
         strcpy(sLastOpenedFileName_BD1898, pFileName);
+        strcpy(sCdFilePath, fullFilePath);
     }
     return 1;
 }
@@ -465,7 +478,7 @@ EXPORT void CC PSX_PutDispEnv_Impl_4F5640(const PSX_DISPENV* pDispEnv, char a2)
         BMP_unlock_4F2100(&sPsxVram_C1D160);
     }
 
-    if (!turn_off_rendering_BD0F20 && byte_578324)
+    if (!turn_off_rendering_BD0F20 && byte_578324 && !gHeadlessMode)
     {
         if (sPsxEMU_show_vram_BD1465)
         {
@@ -666,6 +679,8 @@ EXPORT int CC PSX_LoadImage_4F5FB0(const PSX_RECT* pRect, const BYTE* pData)
         return 1;
     }
 
+    AnimFrameCache_OnVRamWritten(*pRect);
+
     // TODO: Clean up more, treat as 1024x512 16bit array
     const unsigned int bytesPerPixel = sPsxVram_C1D160.field_14_bpp / 8;
     unsigned int srcWidthInBytes = pRect->w * bytesPerPixel;
@@ -800,6 +815,7 @@ EXPORT signed int CC PSX_MoveImage_4F5D50(const PSX_RECT* pRect, int xpos, int y
         rect.right = pRect->x + pRect->w;
         rect.bottom = pRect->y + pRect->h;
         BMP_Blt_4F1E50(&sPsxVram_C1D160, xpos, ypos, &sPsxVram_C1D160, &rect, 0);
+        AnimFrameCache_OnVRamWritten({ static_cast<short>(xpos), static_cast<short>(ypos), pRect->w, pRect->h });
         return 0;
     }
 
@@ -873,23 +889,16 @@ EXPORT int CC PSX_VSync_4F6170(int mode)
     }
     else
     {
-        int frameTimeInMilliseconds = currentTime - sVSyncLastMillisecond_BD0F2C;
-        if (mode > 0 && frameTimeInMilliseconds < 1000 * mode / 60)
+        // NOTE: Used to busy wait (ticking the SEQ player) until the frame time had passed which kept a core at 100%
+        if (mode > 0)
         {
-            int timeSinceLastFrame = 0;
             sVSync_Unused_578325 = 1;
-
-            do
-            {
-                timeSinceLastFrame = SYS_GetTicks() - sVSyncLastMillisecond_BD0F2C;
-                SsSeqCalledTbyT_4FDC80();
-            } while (timeSinceLastFrame < 1000 * mode / 60);
-
-            frameTimeInMilliseconds = 1000 * mode / 60;
         }
 
-        sVSyncLastMillisecond_BD0F2C += frameTimeInMilliseconds;
-        sLastFrameTimestampMilliseconds_BD0F24 = currentTime + frameTimeInMilliseconds;
+        const int frameTimeInMilliseconds = GetFramePacer().WaitForVSync(mode);
+
+        sVSyncLastMillisecond_BD0F2C = SYS_GetTicks();
+        sLastFrameTimestampMilliseconds_BD0F24 = sVSyncLastMillisecond_BD0F2C;
 
         return 240 * frameTimeInMilliseconds / 60000;
     }
@@ -47,6 +47,9 @@ EXPORT void CC PSX_SetDrawEnv_Impl_4FE420(int x, int y, int w, int h, int unknow
 EXPORT void CC PSX_CD_Normalize_FileName_4FAD90(char* pNormalized, const char* pFileName);
 EXPORT int CC PSX_CD_OpenFile_4FAE80(const char* pFileName, int bTryAllPaths);
 
+// The full path of the file PSX_CD_OpenFile_4FAE80 last opened or nullptr if there isn't one.
+const char* PSX_CD_OpenedFilePath();
+
 EXPORT void CC PSX_Prevent_Rendering_4945B0();
 
 
@@ -58,7 +61,7 @@ EXPORT int CC PSX_CD_FileIOWait_4FB260(int bASync);
 
 ALIVE_VAR_EXTERN(Bitmap, sPsxVram_C1D160);
 ALIVE_VAR_EXTERN(BYTE, turn_off_rendering_BD0F20);
-ALIVE_VAR_EXTERN(PSX_DRAWENV, sPSX_EMU_DrawEnvState_C3D080);
+ALIVE_VAR_TLS_EXTERN(PSX_DRAWENV, sPSX_EMU_DrawEnvState_C3D080);
 ALIVE_VAR_EXTERN(BYTE, sPsxEMU_show_vram_BD1465);
 ALIVE_VAR_EXTERN(Bitmap*, spBitmap_C2D038);
 
@@ -71,10 +74,12 @@ ALIVE_ARY_EXTERN(char, 128, sCdEmu_Path1_C14620);
 ALIVE_ARY_EXTERN(char, 128, sCdEmu_Path2_C144C0);
 ALIVE_ARY_EXTERN(char, 128, sCdEmu_Path3_C145A0);
 
-ALIVE_VAR_EXTERN(int, sPsx_drawenv_clipx_BDCD40);
-ALIVE_VAR_EXTERN(int, sPsx_drawenv_clipy_BDCD44);
-ALIVE_VAR_EXTERN(int, sPsx_drawenv_clipw_BDCD48);
-ALIVE_VAR_EXTERN(int, sPsx_drawenv_cliph_BDCD4C);
+ALIVE_VAR_TLS_EXTERN(int, sPsx_drawenv_clipx_BDCD40);
+ALIVE_VAR_TLS_EXTERN(int, sPsx_drawenv_clipy_BDCD44);
+ALIVE_VAR_TLS_EXTERN(int, sPsx_drawenv_clipw_BDCD48);
+ALIVE_VAR_TLS_EXTERN(int, sPsx_drawenv_cliph_BDCD4C);
+ALIVE_VAR_TLS_EXTERN(int, sPsx_drawenv_k500_BDCD50);
+ALIVE_VAR_TLS_EXTERN(BYTE*, sPsx_drawenv_buffer_BDCD54);
 
 
 namespace Test
@@ -5,6 +5,7 @@
 #include "VGA.hpp"
 #include "Error.hpp"
 #include "Sound/Midi.hpp"
+#include "Sound/PsxSpuApi.hpp"
 #include "stdlib.hpp"
 #include <type_traits>
 #include <gmock/gmock.h>
@@ -12,6 +13,7 @@
 #include "DebugHelpers.hpp"
 #include "PsxRender.hpp"
 #include "Sys.hpp"
+#include "Game.hpp"
 
 ALIVE_VAR(1, 0x5C1130, PsxDisplay, gPsxDisplay_5C1130, {});
 
@@ -276,6 +278,15 @@ void PsxDisplay::PSX_Display_Render_OT_41DDF0()
     DEV::DebugOnFrameDraw(field_10_drawEnv[0].field_70_ot_buffer);
 #endif
 
+    if (gHeadlessMode)
+    {
+        // No rasterization, presentation or frame cap - just keep the sequencer ticking and reset the OT for the next frame
+        SsSeqCalledTbyT_4FDC80();
+        PSX_ClearOTag_4F6290(field_10_drawEnv[0].field_70_ot_buffer, field_A_buffer_size);
+        field_C_buffer_index = 0;
+        return;
+    }
+
     if (field_8_max_buffers <= 1)
     {
         // Single buffered rendering
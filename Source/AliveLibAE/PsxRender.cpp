@@ -12,6 +12,15 @@
 #include <gmock/gmock.h>
 #include "VGA.hpp"
 #include "Renderer/IRenderer.hpp"
+#include "Renderer/SoftwareRenderer.hpp"
+#include "PsxRenderSpans.hpp"
+#include "PsxRenderBands.hpp"
+#include "PsxRenderCommands.hpp"
+#include "AnimationFrameCache.hpp"
+#include "FrameProfiler.hpp"
+#include <cstdint>
+#include <vector>
+#include <algorithm>
 
 struct OtUnknown
 {
@@ -24,17 +33,17 @@ ALIVE_ARY(1, 0xBD0D88, OtUnknown, 32, sOt_Stack_BD0D88, {});
 ALIVE_VAR(1, 0xBD0C08, int, sOtIdxRollOver_BD0C08, 0);
 
 
-ALIVE_VAR(1, 0x578318, short, sActiveTPage_578318, -1);
-ALIVE_VAR(1, 0xbd0f0c, DWORD, sTexture_page_x_BD0F0C, 0);
-ALIVE_VAR(1, 0xbd0f10, DWORD, sTexture_page_y_BD0F10, 0);
-ALIVE_VAR(1, 0xbd0f14, DWORD, sTexture_mode_BD0F14, 0);
-ALIVE_VAR(1, 0x57831c, DWORD, tpage_width_57831C, 10);
-ALIVE_VAR(1, 0xBD0F18, DWORD, sTexture_page_abr_BD0F18, 0);
-ALIVE_VAR(1, 0xbd0f1c, WORD *, sTPage_src_ptr_BD0F1C, nullptr);
+ALIVE_VAR_TLS(1, 0x578318, short, sActiveTPage_578318, -1);
+ALIVE_VAR_TLS(1, 0xbd0f0c, DWORD, sTexture_page_x_BD0F0C, 0);
+ALIVE_VAR_TLS(1, 0xbd0f10, DWORD, sTexture_page_y_BD0F10, 0);
+ALIVE_VAR_TLS(1, 0xbd0f14, DWORD, sTexture_mode_BD0F14, 0);
+ALIVE_VAR_TLS(1, 0x57831c, DWORD, tpage_width_57831C, 10);
+ALIVE_VAR_TLS(1, 0xBD0F18, DWORD, sTexture_page_abr_BD0F18, 0);
+ALIVE_VAR_TLS(1, 0xbd0f1c, WORD *, sTPage_src_ptr_BD0F1C, nullptr);
 
-ALIVE_VAR(1, 0xBD2A04, DWORD, sTile_r_BD2A04, 0);
-ALIVE_VAR(1, 0xBD2A00, DWORD, sTile_g_BD2A00, 0);
-ALIVE_VAR(1, 0xBD29FC, DWORD, sTile_b_BD29FC, 0);
+ALIVE_VAR_TLS(1, 0xBD2A04, DWORD, sTile_r_BD2A04, 0);
+ALIVE_VAR_TLS(1, 0xBD2A00, DWORD, sTile_g_BD2A00, 0);
+ALIVE_VAR_TLS(1, 0xBD29FC, DWORD, sTile_b_BD29FC, 0);
 
 ALIVE_ARY(1, 0xC19160, float, 4096, sPsxEmu_float_table_C19160, {});
 ALIVE_ARY(1, 0xC1D5C0, int, 4096, sPsxEmu_fixed_point_table_C1D5C0, {});
@@ -54,21 +63,13 @@ struct Render_Unknown
 };
 ALIVE_ASSERT_SIZEOF(Render_Unknown, 0x28);
 
-ALIVE_VAR(1, 0xbd3350, WORD, sPoly_fill_colour_BD3350, 0);
+ALIVE_VAR_TLS(1, 0xbd3350, WORD, sPoly_fill_colour_BD3350, 0);
 
-ALIVE_VAR(1, 0xbd3320, Render_Unknown, left_side_BD3320, {});
-ALIVE_VAR(1, 0xbd3200, Render_Unknown, slope_1_BD3200, {});
+ALIVE_VAR_TLS(1, 0xbd3320, Render_Unknown, left_side_BD3320, {});
+ALIVE_VAR_TLS(1, 0xbd3200, Render_Unknown, slope_1_BD3200, {});
 
-ALIVE_VAR(1, 0xbd32a0, Render_Unknown, right_side_BD32A0, {});
-ALIVE_VAR(1, 0xbd32e0, Render_Unknown, slope_2_BD32E0, {});
-
-struct Psx_Test
-{
-    __int16 r[32][32];
-    __int16 g[32][32];
-    __int16 b[32][32];
-};
-ALIVE_ASSERT_SIZEOF(Psx_Test, 0x1800); // 3072 words
+ALIVE_VAR_TLS(1, 0xbd32a0, Render_Unknown, right_side_BD32A0, {});
+ALIVE_VAR_TLS(1, 0xbd32e0, Render_Unknown, slope_2_BD32E0, {});
 
 ALIVE_ARY(1, 0xC215E0, Psx_Test, 4, sPsx_abr_lut_C215E0, {});
 
@@ -106,21 +107,33 @@ struct OT_Prim
 };
 ALIVE_ASSERT_SIZEOF(OT_Prim, 380); // could be up to 380
 
-ALIVE_ARY(1, 0xBD0C0C, BYTE, 380, byte_BD0C0C, {});
+ALIVE_ARY_TLS(1, 0xBD0C0C, BYTE, 380, byte_BD0C0C, {});
+
+ALIVE_VAR_TLS(1, 0x578330, OT_Prim*, off_578330, reinterpret_cast<OT_Prim*>(&byte_BD0C0C[0]));
 
-ALIVE_VAR(1, 0x578330, OT_Prim*, off_578330, reinterpret_cast<OT_Prim*>(&byte_BD0C0C[0]));
+ALIVE_VAR_TLS(1, 0xbd3264, OT_Vert *, pVerts_dword_BD3264, nullptr);
+ALIVE_VAR_TLS(1, 0xbd3270, WORD *, pClut_src_BD3270, nullptr);
+ALIVE_VAR_TLS(1, 0xbd32c8, WORD *, pTPage_src_BD32C8, nullptr);
 
-ALIVE_VAR(1, 0xbd3264, OT_Vert *, pVerts_dword_BD3264, nullptr);
-ALIVE_VAR(1, 0xbd3270, WORD *, pClut_src_BD3270, nullptr);
-ALIVE_VAR(1, 0xbd32c8, WORD *, pTPage_src_BD32C8, nullptr);
+ALIVE_VAR_TLS(1, 0xbd3308, __int16*, r_lut_dword_BD3308, nullptr);
+ALIVE_VAR_TLS(1, 0xbd32d8, __int16*, g_lut_dword_BD32D8, nullptr);
+ALIVE_VAR_TLS(1, 0xbd3348, __int16*, b_lut_dword_BD3348, nullptr);
 
-ALIVE_VAR(1, 0xbd3308, __int16*, r_lut_dword_BD3308, nullptr);
-ALIVE_VAR(1, 0xbd32d8, __int16*, g_lut_dword_BD32D8, nullptr);
-ALIVE_VAR(1, 0xbd3348, __int16*, b_lut_dword_BD3348, nullptr);
+ALIVE_VAR_TLS(1, 0xbd32cc, BYTE*, rTable_dword_BD32CC, nullptr);
+ALIVE_VAR_TLS(1, 0xbd3358, BYTE*, gTable_dword_BD3358, nullptr);
+ALIVE_VAR_TLS(1, 0xbd334c, BYTE*, bTable_dword_BD334C, nullptr);
 
-ALIVE_VAR(1, 0xbd32cc, BYTE*, rTable_dword_BD32CC, nullptr);
-ALIVE_VAR(1, 0xbd3358, BYTE*, gTable_dword_BD3358, nullptr);
-ALIVE_VAR(1, 0xbd334c, BYTE*, bTable_dword_BD334C, nullptr);
+// Frame buffer rows the calling thread writes to when the OT is drawn in bands (see PSX_DrawOTag_4F6540).
+// Rows outside of the band are still walked so the state of each thread stays the same as the serial path,
+// only the pixel writes are skipped.
+static thread_local std::uintptr_t sBandStart = 0;
+static thread_local std::uintptr_t sBandEnd = UINTPTR_MAX;
+
+static inline bool PSX_Band_Owns(const WORD* pPixel)
+{
+    const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(pPixel);
+    return addr >= sBandStart && addr < sBandEnd;
+}
 
 enum TextureModes
 {
@@ -159,25 +172,66 @@ EXPORT int CC PSX_poly_helper_fixed_point_scale_517FA0(int fixedPoint, int scale
     return (static_cast<signed __int64>(fixedPoint) * scaleFactor) / 0x10000;
 }
 
+static PsxSpanMode MakeSpanMode(bool skipBlack, PsxSpanBlend blend, const BYTE* pModulateR = nullptr, const BYTE* pModulateG = nullptr, const BYTE* pModulateB = nullptr)
+{
+    PsxSpanMode mode;
+    mode.mSkipBlack = skipBlack;
+    mode.mBlend = blend;
+    mode.mAbr = sTexture_page_abr_BD0F18;
+    mode.mpAbrLut = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
+    mode.mpModulate[0] = pModulateR;
+    mode.mpModulate[1] = pModulateG;
+    mode.mpModulate[2] = pModulateB;
+    return mode;
+}
+
+// Texels are fetched a chunk at a time by the texture walk and then written out by the span kernels
 template<class T>
-static inline void WriteSinglePixelOfXLine(WORD* pVRam, int xLeft, int xRight, T writePixel)
+static inline void WriteTexturedSpan(WORD* pDst, int count, const PsxSpanMode& mode, T fetchTexel)
+{
+    WORD texels[64];
+    while (count > 0)
+    {
+        const int chunk = std::min(count, static_cast<int>(ALIVE_COUNTOF(texels)));
+        for (int i = 0; i < chunk; i++)
+        {
+            texels[i] = fetchTexel();
+        }
+        PSX_Span_Texels(pDst, texels, chunk, mode);
+        pDst += chunk;
+        count -= chunk;
+    }
+}
+
+static void WriteClut4Span(WORD* pDst, const BYTE* pNibbles, const WORD* pClut, int count, const PsxSpanMode& mode)
 {
-    WORD* pStart = &pVRam[xLeft];
-    WORD* pEnd = &pVRam[xRight];
-    while (pStart < pEnd)
+    WORD texels[64];
+    while (count > 0)
     {
-        writePixel(pStart);
-        ++pStart;
+        // Chunks are always even so each starts on a low nibble
+        const int chunk = std::min(count, static_cast<int>(ALIVE_COUNTOF(texels)));
+        PSX_Span_Clut4(texels, pNibbles, pClut, chunk);
+        PSX_Span_Texels(pDst, texels, chunk, mode);
+        pDst += chunk;
+        pNibbles += chunk / 2;
+        count -= chunk;
     }
 }
 
 EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(WORD* pVRam, int ySize)
 {
+    // Texture sources are per thread, look them up once instead of per texel
+    const WORD* pClutSrc = pClut_src_BD3270;
+    const WORD* pTPageSrc = pTPage_src_BD32C8;
+
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
 
     const Render_Unknown* pLeft = &left_side_BD3320;
     const Render_Unknown* pRight = &right_side_BD32A0;
 
+    const PsxSpanMode skipBlackMode = MakeSpanMode(true, PsxSpanBlend::eNone);
+    const PsxSpanMode copyMode = MakeSpanMode(false, PsxSpanBlend::eNone);
+
     for (int i = 0; i < ySize; i++)
     {
         if (pLeft->field_0_x > pRight->field_0_x)
@@ -188,7 +242,7 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(WORD* pVRam,
         const int x_left = pLeft->field_0_x >> 16;
         const int x_diff = x_right - x_left;
 
-        if (x_diff > 0)
+        if (x_diff > 0 && PSX_Band_Owns(pVRam))
         {
             int x_diff_m1 = x_right - x_left - 1;
             // Prevent divide by zero
@@ -219,15 +273,12 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(WORD* pVRam,
 
             if (sTexture_mode_BD0F14 == TextureModes::e8Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut) 
+                WriteTexturedSpan(&pVRam[x_left], x_diff, skipBlackMode, [&]() -> WORD
                 {
-                    const WORD clut_pixel = pClut_src_BD3270[*((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_pos + (v_pos & 0x1FE00000)) >> 10))];
-                    if (clut_pixel)
-                    {
-                        *pOut = clut_pixel;
-                    }
+                    const WORD clut_pixel = pClutSrc[*((unsigned __int8 *)pTPageSrc + ((signed int)(u_pos + (v_pos & 0x1FE00000)) >> 10))];
                     u_pos += u_diff;
                     v_pos += v_diff;
+                    return clut_pixel;
                 });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e16Bit)
@@ -236,40 +287,37 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(WORD* pVRam,
 
                 if (sActiveTPage_578318 >= 0)
                 {
-                    WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut)
+                    WriteTexturedSpan(&pVRam[x_left], x_diff, skipBlackMode, [&]() -> WORD
                     {
-                        const WORD tpage_pixel = pTPage_src_BD32C8[(u_pos + (k255_s20 & v_pos)) >> 10];
-                        if (tpage_pixel)
-                        {
-                            *pOut = tpage_pixel;
-                        }
+                        const WORD tpage_pixel = pTPageSrc[(u_pos + (k255_s20 & v_pos)) >> 10];
                         u_pos += u_diff;
                         v_pos += v_diff;
+                        return tpage_pixel;
                     });
                 }
                 else
                 {
                     if (x_diff == 1)
                     {
-                        pVRam[x_left] = pTPage_src_BD32C8[(pLeft->field_14_u + (k255_s20 & (pLeft->field_18_v << 10))) >> 10];
+                        pVRam[x_left] = pTPageSrc[(pLeft->field_14_u + (k255_s20 & (pLeft->field_18_v << 10))) >> 10];
                     }
                     else
                     {
-                        WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut)
+                        WriteTexturedSpan(&pVRam[x_left], x_diff, copyMode, [&]() -> WORD
                         {
                             const unsigned int tpage_idx = (u_pos + (k255_s20 & v_pos)) >> 10;
-                            *pOut = pTPage_src_BD32C8[tpage_idx];
                             u_pos += u_diff;
                             v_pos += v_diff;
+                            return pTPageSrc[tpage_idx];
                         });
                     }
                 }
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e4Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut)
+                WriteTexturedSpan(&pVRam[x_left], x_diff, skipBlackMode, [&]() -> WORD
                 {
-                    const unsigned int tpage_nibbles = *((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_pos + (v_pos & 0x3FC00000)) >> 11));
+                    const unsigned int tpage_nibbles = *((unsigned __int8 *)pTPageSrc + ((signed int)(u_pos + (v_pos & 0x3FC00000)) >> 11));
                     
                     unsigned int nibble = 0;
                     if (u_pos & 0x400)
@@ -280,15 +328,10 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(WORD* pVRam,
                     {
                         nibble = tpage_nibbles & 0xF;
                     }
-                    
-                    const WORD clut_pixel = pClut_src_BD3270[nibble];
-                    if (clut_pixel)
-                    {
-                        *pOut = clut_pixel;
-                    }
 
                     u_pos += u_diff;
                     v_pos += v_diff;
+                    return pClutSrc[nibble];
                 });
             }
         }
@@ -308,10 +351,18 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_Opqaue_51CCA0(WORD* pVRam,
 // TODO: Refactor/remove duplication
 EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRam, int ySize)
 {
+    // Texture sources are per thread, look them up once instead of per texel
+    const WORD* pClutSrc = pClut_src_BD3270;
+    const WORD* pTPageSrc = pTPage_src_BD32C8;
+
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
     Render_Unknown* pLeft = &left_side_BD3320;
     Render_Unknown* pRight = &right_side_BD32A0;
 
+    // Texels are modulated by the poly colour
+    const PsxSpanMode skipBlackMode = MakeSpanMode(true, PsxSpanBlend::eNone, rTable_dword_BD32CC, gTable_dword_BD3358, bTable_dword_BD334C);
+    const PsxSpanMode copyMode = MakeSpanMode(false, PsxSpanBlend::eNone, rTable_dword_BD32CC, gTable_dword_BD3358, bTable_dword_BD334C);
+
     for (int i = 0; i < ySize; i++)
     {
         if (pLeft->field_0_x > pRight->field_0_x)
@@ -323,7 +374,7 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
         const int x_left = pLeft->field_0_x >> 16;
 
         const int x_diff = x_right - x_left;
-        if (x_diff > 0)
+        if (x_diff > 0 && PSX_Band_Owns(pVRam))
         {
             DWORD u_left = pLeft->field_14_u;
             const DWORD left_v = pLeft->field_18_v;
@@ -338,20 +389,13 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
             if (sTexture_mode_BD0F14 == TextureModes::e8Bit)
             {
                 DWORD left_v_fixed = left_v << 11;
-                WORD* pStart = &pVRam[x_left];
-                for (WORD* pEnd = &pVRam[x_right]; pStart < pEnd; left_v_fixed += v_diff << 11)
+                WriteTexturedSpan(&pVRam[x_left], x_diff, skipBlackMode, [&]() -> WORD
                 {
-                    const int clut_idx = *((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_left + (left_v_fixed & 0x1FE00000)) >> 10));
-                    if (pClut_src_BD3270[clut_idx])
-                    {
-                        *pStart =
-                            b_lut_dword_BD3348[pClut_src_BD3270[clut_idx] & 0x1F]
-                            | r_lut_dword_BD3308[(pClut_src_BD3270[clut_idx] >> 11) & 0x1F]
-                            | g_lut_dword_BD32D8[(pClut_src_BD3270[clut_idx] >> 6) & 0x1F];
-                    }
-                    ++pStart;
+                    const int clut_idx = *((unsigned __int8 *)pTPageSrc + ((signed int)(u_left + (left_v_fixed & 0x1FE00000)) >> 10));
                     u_left += u_diff;
-                }
+                    left_v_fixed += v_diff << 11;
+                    return pClutSrc[clut_idx];
+                });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e16Bit)
             {
@@ -361,23 +405,15 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
                 {
                     const DWORD v_left = pLeft->field_18_v;
 
-                    WORD* pStart = &pVRam[x_left];
-                    WORD* pEnd2 = &pVRam[x_right];
                     DWORD v_current = v_left << 10;
-                    int v_pos = v_diff << 10;
-                    while (pStart < pEnd2)
+                    const int v_pos = v_diff << 10;
+                    WriteTexturedSpan(&pVRam[x_left], x_diff, skipBlackMode, [&]() -> WORD
                     {
-                        if (pTPage_src_BD32C8[(u_left + (k_255_sr10_p10 & v_current)) >> 10])
-                        {
-                            *pStart =
-                                b_lut_dword_BD3348[(pTPage_src_BD32C8[(u_left + (k_255_sr10_p10 & v_current)) >> 10] & 0x1F)]
-                                | r_lut_dword_BD3308[(pTPage_src_BD32C8[(u_left + (k_255_sr10_p10 & v_current)) >> 10] >> 11) & 0x1F]
-                                | g_lut_dword_BD32D8[(pTPage_src_BD32C8[(u_left + (k_255_sr10_p10 & v_current)) >> 10] >> 6) & 0x1F];
-                        }
+                        const WORD tpage_pixel = pTPageSrc[(u_left + (k_255_sr10_p10 & v_current)) >> 10];
                         u_left += u_diff;
-                        ++pStart;
                         v_current += v_pos;
-                    }
+                        return tpage_pixel;
+                    });
                 }
                 else
                 {
@@ -385,7 +421,7 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
                     if (x_diff == 1)
                     {
                         const DWORD v_left = pLeft->field_18_v;
-                        const WORD tpage_pixel = pTPage_src_BD32C8[(u_left + (k_255_sr10_p10 & (v_left << 10))) >> 10];
+                        const WORD tpage_pixel = pTPageSrc[(u_left + (k_255_sr10_p10 & (v_left << 10))) >> 10];
                         *pStart =
                             b_lut_dword_BD3348[tpage_pixel & 0x1F]
                             | r_lut_dword_BD3308[(tpage_pixel >> 11) & 0x1F]
@@ -396,22 +432,13 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
                         const DWORD v_left = pLeft->field_18_v;
                         DWORD v_diff_fixed = v_left << 10;
                         const int u_diff_fixed = v_diff << 10;
-                        WORD* pEnd = &pVRam[x_right];
-                        if (pStart < pEnd)
+                        WriteTexturedSpan(pStart, x_diff, copyMode, [&]() -> WORD
                         {
-                            while (pStart < pEnd)
-                            {
-                                ++pStart;
-                                const WORD tpage_pixel = pTPage_src_BD32C8[(u_left + (k_255_sr10_p10 & v_diff_fixed)) >> 10];
-                                const WORD pixel_value =
-                                    b_lut_dword_BD3348[tpage_pixel & 0x1F]
-                                    | r_lut_dword_BD3308[(tpage_pixel >> 11) & 0x1F]
-                                    | g_lut_dword_BD32D8[(tpage_pixel >> 6) & 0x1F];
-                                v_diff_fixed += u_diff_fixed;
-                                *(pStart - 1) = pixel_value;
-                                u_left += u_diff;
-                            }
-                        }
+                            const WORD tpage_pixel = pTPageSrc[(u_left + (k_255_sr10_p10 & v_diff_fixed)) >> 10];
+                            v_diff_fixed += u_diff_fixed;
+                            u_left += u_diff;
+                            return tpage_pixel;
+                        });
                     }
                 }
             }
@@ -419,13 +446,10 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
             {
                 const DWORD v_left = pLeft->field_18_v;
                 DWORD v_fixed_1 = v_left << 12;
-                WORD* pStart = &pVRam[x_left];
-
-                int v_fixed = v_diff << 12;
-                const int _v_fixed_2 = v_fixed;
-                while (pStart < &pVRam[x_right])
+                const int v_fixed = v_diff << 12;
+                WriteTexturedSpan(&pVRam[x_left], x_diff, skipBlackMode, [&]() -> WORD
                 {
-                    const unsigned int tpage_pixel_1 = *((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_left + (v_fixed_1 & 0x3FC00000)) >> 11));
+                    const unsigned int tpage_pixel_1 = *((unsigned __int8 *)pTPageSrc + ((signed int)(u_left + (v_fixed_1 & 0x3FC00000)) >> 11));
                     unsigned int nibble = 0;
                     if (u_left & 0x400)
                     {
@@ -435,19 +459,10 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_Opaque_51E140(WORD* pVRa
                     {
                         nibble = tpage_pixel_1 & 0xF;
                     }
-                    const WORD clut_pixel = pClut_src_BD3270[nibble];
-                    if (clut_pixel)
-                    {
-                        v_fixed = _v_fixed_2;
-                        *pStart =
-                            b_lut_dword_BD3348[(clut_pixel & 0x1F)]
-                            | r_lut_dword_BD3308[(clut_pixel >> 11) & 0x1F]
-                            | g_lut_dword_BD32D8[(clut_pixel >> 6) & 0x1F];
-                    }
-                    ++pStart;
                     u_left += u_diff;
                     v_fixed_1 += v_fixed;
-                }
+                    return pClutSrc[nibble];
+                });
             }
         }
 
@@ -472,12 +487,17 @@ static inline WORD Calc_Abr_Pixel(const Psx_Test& abr_lut, WORD vram_pixel, WORD
 
 EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(WORD* pVRam, int ySize)
 {
+    // Texture sources are per thread, look them up once instead of per texel
+    const WORD* pClutSrc = pClut_src_BD3270;
+    const WORD* pTPageSrc = pTPage_src_BD32C8;
+
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
 
     const Render_Unknown* pLeft = &left_side_BD3320;
     const Render_Unknown* pRight = &right_side_BD32A0;
     
-    const Psx_Test& abr_lut = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
+    // Texels are modulated by the poly colour, only the ones with the semi trans bit set are blended
+    const PsxSpanMode spanMode = MakeSpanMode(true, PsxSpanBlend::eSemiTransFlag, rTable_dword_BD32CC, gTable_dword_BD3358, bTable_dword_BD334C);
 
     for (int i = 0; i < ySize; i++)
     {
@@ -489,7 +509,7 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(WORD* p
         const int x_left = pLeft->field_0_x >> 16;
         const int x_diff = x_right - x_left;
 
-        if (x_diff > 0)
+        if (x_diff > 0 && PSX_Band_Owns(pVRam))
         {
             int x_diff_m1 = x_right - x_left - 1;
             // Prevent divide by zero
@@ -520,56 +540,29 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(WORD* p
 
             if (sTexture_mode_BD0F14 == TextureModes::e8Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut)
+                WriteTexturedSpan(&pVRam[x_left], x_diff, spanMode, [&]() -> WORD
                 {
-                    const WORD clut_pixel = pClut_src_BD3270[*((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_pos + (v_pos & 0x1FE00000)) >> 10))];
-                    if (clut_pixel)
-                    {
-                        WORD rLut = r_lut_dword_BD3308[(clut_pixel >> 11) & 0x1F];
-                        WORD gLut = g_lut_dword_BD32D8[(clut_pixel >> 6) & 0x1F];
-                        WORD bLut = b_lut_dword_BD3348[(clut_pixel & 0x1F)];
-
-                        WORD pixel_value = rLut | gLut | bLut;
-
-                        if (clut_pixel & 0x20)
-                        {
-                            pixel_value = Calc_Abr_Pixel(abr_lut, *pOut, pixel_value);
-                        }
-                        *pOut = pixel_value;
-                    }
+                    const WORD clut_pixel = pClutSrc[*((unsigned __int8 *)pTPageSrc + ((signed int)(u_pos + (v_pos & 0x1FE00000)) >> 10))];
                     u_pos += u_diff;
                     v_pos += v_diff;
+                    return clut_pixel;
                 });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e16Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut)
+                WriteTexturedSpan(&pVRam[x_left], x_diff, spanMode, [&]() -> WORD
                 {
-                    const WORD texture_pixel = pTPage_src_BD32C8[(u_pos + (v_pos & 0x0ff00000)) >> 10];
-                    if (texture_pixel)
-                    {
-                        const WORD rLut = r_lut_dword_BD3308[(texture_pixel >> 11) & 0x1F];
-                        const WORD gLut = g_lut_dword_BD32D8[(texture_pixel >> 6) & 0x1F];
-                        const WORD bLut = b_lut_dword_BD3348[texture_pixel & 0x1F];
-
-                        WORD pixel = rLut | gLut | bLut;
-                        if (texture_pixel & 0x20)
-                        {
-                            pixel = Calc_Abr_Pixel(abr_lut, *pOut, pixel);
-                        }
-
-                        *pOut = pixel;
-                    }
-
+                    const WORD texture_pixel = pTPageSrc[(u_pos + (v_pos & 0x0ff00000)) >> 10];
                     u_pos += u_diff;
                     v_pos += v_diff;
+                    return texture_pixel;
                 });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e4Bit)
             {
-                WriteSinglePixelOfXLine(pVRam, x_left, x_right, [&](WORD* pOut)
+                WriteTexturedSpan(&pVRam[x_left], x_diff, spanMode, [&]() -> WORD
                 {
-                    const WORD nibbles = *((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_pos + (v_pos & 0x3FC00000)) >> 11));
+                    const WORD nibbles = *((unsigned __int8 *)pTPageSrc + ((signed int)(u_pos + (v_pos & 0x3FC00000)) >> 11));
                     WORD nibble = 0;
                     if (u_pos & 0x400)
                     {
@@ -579,26 +572,9 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_NoBlending_SemiTrans_51E890(WORD* p
                     {
                         nibble = nibbles & 0xF;
                     }
-                    const WORD clut_pixel_1 = pClut_src_BD3270[nibble];
-
-                    if (clut_pixel_1)
-                    {
-                        WORD rLut = r_lut_dword_BD3308[(clut_pixel_1 >> 11) & 0x1F];
-                        WORD gLut = g_lut_dword_BD32D8[(clut_pixel_1 >> 6) & 0x1F];
-                        WORD bLut = b_lut_dword_BD3348[(clut_pixel_1 & 0x1F)];
-
-                        WORD pixel4 = rLut | gLut | bLut;
-
-                        if (clut_pixel_1 & 0x20)
-                        {
-                            pixel4 = Calc_Abr_Pixel(abr_lut, *pOut, pixel4);
-                        }
-
-                        *pOut = pixel4;
-                    }
-                    
                     u_pos += u_diff;
                     v_pos += v_diff;
+                    return pClutSrc[nibble];
                 });
             }
         }
@@ -626,6 +602,7 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0(WORD* pVram,
     Render_Unknown* pRight = &right_side_BD32A0;
 
     const unsigned int width_pitch = ((unsigned int)spBitmap_C2D038->field_10_locked_pitch) / sizeof(WORD);
+    const PsxSpanMode fillMode = MakeSpanMode(false, PsxSpanBlend::eNone);
     for (int i = 0; i < ySize; i++)
     {
         if (pLeft->field_0_x > pRight->field_0_x)
@@ -635,12 +612,11 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0(WORD* pVram,
             pRight = pTmpLeft;
         }
 
-        WORD* pDst = &pVram[pLeft->field_0_x >> 16];
-        WORD* pEnd = &pVram[pRight->field_0_x >> 16];
-        while (pDst < pEnd)
+        const int x_left = pLeft->field_0_x >> 16;
+        const int x_right = pRight->field_0_x >> 16;
+        if (PSX_Band_Owns(pVram))
         {
-            *pDst = sPoly_fill_colour_BD3350;
-            pDst++;
+            PSX_Span_Solid(&pVram[x_left], sPoly_fill_colour_BD3350, x_right - x_left, fillMode);
         }
 
         pVram = &pVram[width_pitch];
@@ -651,9 +627,7 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_Opqaue_51C4C0(WORD* pVram,
 
 EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590(WORD* pVRam, int ySize)
 {
-    const auto lut_b = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].b[(sPoly_fill_colour_BD3350 & 0x1F)][0];
-    const auto lut_r = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].r[(sPoly_fill_colour_BD3350 >> 11) & 0x1F][0];
-    const auto lut_g = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].g[(sPoly_fill_colour_BD3350 >> 6) & 0x1F][0];
+    const PsxSpanMode blendMode = MakeSpanMode(false, PsxSpanBlend::eAlways);
 
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
     const Render_Unknown* pLeft1 = &left_side_BD3320;
@@ -668,13 +642,11 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590(WORD* pVR
             pRight1 = pLeft1Temp;
         }
 
-        WORD* pStart = &pVRam[pLeft1->field_0_x >> 16];
-        WORD* pEnd =   &pVRam[pRight1->field_0_x >> 16];
-        while (pStart < pEnd)
+        const int x_left = pLeft1->field_0_x >> 16;
+        const int x_right = pRight1->field_0_x >> 16;
+        if (PSX_Band_Owns(pVRam))
         {
-            const WORD vram_pixel = *pStart;
-            *pStart = lut_b[vram_pixel & 0x1F] | lut_r[(vram_pixel >> 11) & 0x1F] | lut_g[(vram_pixel >> 6) & 0x1F];
-            ++pStart;
+            PSX_Span_Solid(&pVRam[x_left], sPoly_fill_colour_BD3350, x_right - x_left, blendMode);
         }
 
         left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
@@ -685,11 +657,18 @@ EXPORT void CC PSX_EMU_Render_Polys_FShaded_NoTexture_SemiTrans_51C590(WORD* pVR
 
 EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0(WORD* pVram, int ySize)
 {
+    // Texture sources are per thread, look them up once instead of per texel
+    const WORD* pClutSrc = pClut_src_BD3270;
+    const WORD* pTPageSrc = pTPage_src_BD32C8;
+
     const Render_Unknown* pRight = &right_side_BD32A0;
     const Render_Unknown* pLeft = &left_side_BD3320;
 
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
-    const Psx_Test& abr_lut = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
+    // 8bit CLUTs can mark which entries are semi trans, 4/16bit textures are always blended
+    const PsxSpanMode semiTransFlagMode = MakeSpanMode(true, PsxSpanBlend::eSemiTransFlag);
+    const PsxSpanMode semiTransMode = MakeSpanMode(true, PsxSpanBlend::eAlways);
+
     for (int i = 0; i < ySize; i++)
     {
         if (pLeft->field_0_x > pRight->field_0_x)
@@ -698,7 +677,8 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0(WORD* pVr
         }
         const int x_right = pRight->field_0_x >> 16;
         const int x_left = pLeft->field_0_x >> 16;
-        if (x_right - x_left > 0)
+        const int x_diff = x_right - x_left;
+        if (x_diff > 0 && PSX_Band_Owns(pVram))
         {
             int x_diff_m1 = x_right - x_left - 1;
             if (x_diff_m1 <= 0)
@@ -710,66 +690,42 @@ EXPORT void CC PSX_EMU_Render_Polys_Textured_Blending_SemiTrans_51D2B0(WORD* pVr
             DWORD u_pos = pLeft->field_14_u;
 
             WORD* pStart = &pVram[x_left];
-            WORD* pEnd = &pVram[x_right];
 
             if (sTexture_mode_BD0F14 == TextureModes::e8Bit)
             {
                 const int v_diff = ((signed int)(pRight->field_18_v - pLeft->field_18_v) / x_diff_m1) * 2048;
                 DWORD v_pos = pLeft->field_18_v * 2048;
-                while (pStart < pEnd)
+                WriteTexturedSpan(pStart, x_diff, semiTransFlagMode, [&]() -> WORD
                 {
-                    // TODO: Refactor
-                    const int clut_idx = *((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_pos + (v_pos & 0x1FE00000)) >> 10));
-                    if (pClut_src_BD3270[clut_idx] != 0) // Black pixels are transparent
-                    {
-                        if (pClut_src_BD3270[clut_idx] & 0x20) // unknown flag
-                        {
-                            *pStart = Calc_Abr_Pixel(abr_lut, *pStart, pClut_src_BD3270[clut_idx]);
-                        }
-                        else
-                        {
-                            *pStart = pClut_src_BD3270[clut_idx];
-                        }
-                    }
+                    const int clut_idx = *((unsigned __int8 *)pTPageSrc + ((signed int)(u_pos + (v_pos & 0x1FE00000)) >> 10));
                     u_pos += u_diff;
                     v_pos += v_diff;
-                    ++pStart;
-                }
+                    return pClutSrc[clut_idx];
+                });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e16Bit)
             {
                 int v_diff = ((signed int)(pRight->field_18_v - pLeft->field_18_v) / x_diff_m1) * 1024;
                 DWORD v_pos = pLeft->field_18_v * 1024;
-
-                while (pStart < pEnd)
+                WriteTexturedSpan(pStart, x_diff, semiTransMode, [&]() -> WORD
                 {
-                    // TODO: Refactor
                     const DWORD tpage_idx = (u_pos + (v_pos & 0x0ff00000)) / 1024;
-                    if (pTPage_src_BD32C8[tpage_idx] != 0) // Black pixels are transparent
-                    {
-                        *pStart = Calc_Abr_Pixel(abr_lut, *pStart, pTPage_src_BD32C8[tpage_idx]);
-                    }
-                    ++pStart;
                     u_pos += u_diff;
                     v_pos += v_diff;
-                }
+                    return pTPageSrc[tpage_idx];
+                });
             }
             else if (sTexture_mode_BD0F14 == TextureModes::e4Bit)
             {
                 int v_diff = ((signed int)(pRight->field_18_v - pLeft->field_18_v) / x_diff_m1) * 4096;
                 DWORD v_pos = pLeft->field_18_v * 4096;
-                while (pStart < pEnd)
+                WriteTexturedSpan(pStart, x_diff, semiTransMode, [&]() -> WORD
                 {
-                    // TODO: Refactor
-                    const int clut_idx = (*((unsigned __int8 *)pTPage_src_BD32C8 + ((signed int)(u_pos + (v_pos & 0x3FC00000)) >> 11)) >> (BYTE1(u_pos) & 4)) & 0xF;
-                    if (pClut_src_BD3270[clut_idx] != 0) // Black pixels are transparent
-                    {
-                        *pStart = Calc_Abr_Pixel(abr_lut, *pStart, pClut_src_BD3270[clut_idx]);
-                    }
-                    ++pStart;
+                    const int clut_idx = (*((unsigned __int8 *)pTPageSrc + ((signed int)(u_pos + (v_pos & 0x3FC00000)) >> 11)) >> (BYTE1(u_pos) & 4)) & 0xF;
                     u_pos += u_diff;
                     v_pos += v_diff;
-                }
+                    return pClutSrc[clut_idx];
+                });
             }
         }
 
@@ -806,7 +762,7 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0(WORD* pVRam,
         }
 
         const int xdiff_f = (pRight->field_0_x >> 16) - (pLeft->field_0_x >> 16);
-        if (xdiff_f > 0)
+        if (xdiff_f > 0 && PSX_Band_Owns(pVRam))
         {
             int shade_r = pLeft->field_1C_GShadeR;
             int shade_g = pLeft->field_20_GShadeG;
@@ -816,16 +772,7 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_Opqaue_51C6E0(WORD* pVRam,
             const int g_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_20_GShadeG - shade_g, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             const int b_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_24_GShadeB - shade_b, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             
-            WORD* pStart = &pVRam[pLeft->field_0_x >> 16];
-            WORD* pEnd = &pVRam[pRight->field_0_x >> 16];
-            while (pStart < pEnd)
-            {
-                *pStart = ((shade_b >> 16) & 0x1F) | ((shade_g >> 10) & 0x7C0) | ((shade_r >> 5) & 0xF800);
-                ++pStart;
-                shade_r += r_scaled;
-                shade_g += g_scaled;
-                shade_b += b_scaled;
-            }
+            PSX_Span_Gouraud(&pVRam[pLeft->field_0_x >> 16], shade_r, shade_g, shade_b, r_scaled, g_scaled, b_scaled, xdiff_f);
         }
 
         left_side_BD3320.field_0_x += slope_1_BD3200.field_0_x;
@@ -846,9 +793,7 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0(WORD* pVr
 {
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
 
-    const auto r_table = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].r;
-    const auto g_table = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].g;
-    const auto b_table = sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18].b;
+    const PsxSpanMode blendMode = MakeSpanMode(false, PsxSpanBlend::eAlways);
 
     const Render_Unknown* pLeft = &left_side_BD3320;
     const Render_Unknown* pRight = &right_side_BD32A0;
@@ -863,7 +808,7 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0(WORD* pVr
         }
 
         const int xdiff_f = (pRight->field_0_x >> 16) - (pLeft->field_0_x >> 16);
-        if (xdiff_f > 0)
+        if (xdiff_f > 0 && PSX_Band_Owns(pVram))
         {
             int shade_r = pLeft->field_1C_GShadeR;
             int shade_g = pLeft->field_20_GShadeG;
@@ -873,22 +818,22 @@ EXPORT void CC PSX_EMU_Render_Polys_GShaded_NoTexture_SemiTrans_51C8D0(WORD* pVr
             const int g_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_20_GShadeG - shade_g, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
             const int b_scaled = PSX_poly_helper_fixed_point_scale_517FA0(pRight->field_24_GShadeB - shade_b, sPsxEmu_fixed_point_table_C1D5C0[xdiff_f + 1]);
 
-            WORD* pStart = &pVram[pLeft->field_0_x  >> 16];
-            WORD* pEnd =   &pVram[pRight->field_0_x >> 16];
-
-            while (pStart < pEnd)
+            // Shade a chunk then blend it in
+            WORD shades[64];
+            WORD* pStart = &pVram[pLeft->field_0_x >> 16];
+            int remaining = xdiff_f;
+            while (remaining > 0)
             {
-                const WORD existingPixel = *pStart;
-                *pStart =
-                      (unsigned __int16)b_table[(shade_b >> 16) & 0x1F][existingPixel & 0x1F]
-                    | (unsigned __int16)r_table[(shade_r >> 16) & 0x1F][(existingPixel >> 11) & 0x1F]
-                    | (unsigned __int16)g_table[(shade_g >> 16) & 0x1F][(existingPixel >> 6) & 0x1F];
+                const int chunk = std::min(remaining, static_cast<int>(ALIVE_COUNTOF(shades)));
+                PSX_Span_Gouraud(shades, shade_r, shade_g, shade_b, r_scaled, g_scaled, b_scaled, chunk);
+                PSX_Span_Texels(pStart, shades, chunk, blendMode);
 
-                shade_r += r_scaled;
-                shade_g += g_scaled;
-                shade_b += b_scaled;
+                shade_r += r_scaled * chunk;
+                shade_g += g_scaled * chunk;
+                shade_b += b_scaled * chunk;
 
-                pStart++;
+                pStart += chunk;
+                remaining -= chunk;
             }
         }
 
@@ -923,12 +868,6 @@ ALIVE_VAR(1, 0xc215c4, DWORD, sRedShift_C215C4, 0);
 ALIVE_VAR(1, 0xc1d180, DWORD, sGreenShift_C1D180, 0);
 ALIVE_VAR(1, 0xc19140, DWORD, sBlueShift_C19140, 0);
 
-struct Psx_Data
-{
-    BYTE field_0[32];
-};
-ALIVE_ASSERT_SIZEOF(Psx_Data, 32);
-
 ALIVE_ARY(1, 0xC1D1C0, Psx_Data, 32, stru_C1D1C0, {});
 ALIVE_VAR(1, 0xC146C0, Psx_Test, stru_C146C0, {});
 
@@ -1087,9 +1026,12 @@ static void VRam_Rect_Fill(WORD* pVRamIter, int rect_w, int rect_h, int pitch_wo
     {
         for (int y = 0; y < rect_h; y++)
         {
-            for (int x = 0; x < rect_w; x++)
+            if (PSX_Band_Owns(pVRamIter))
             {
-                pVRamIter[x] = fill_colour;
+                for (int x = 0; x < rect_w; x++)
+                {
+                    pVRamIter[x] = fill_colour;
+                }
             }
 
             pVRamIter += pitch_words;
@@ -1116,6 +1058,8 @@ EXPORT int CC PSX_ClearImage_4F5BD0(const PSX_RECT* pRect, unsigned __int8 r, un
         return 0;
     }
 
+    AnimFrameCache_OnVRamWritten(*pRect);
+
     int rect_x1 = pRect->x;
     int rect_y1 = pRect->y;
     int rect_right = pRect->w + rect_x1 - 1;
@@ -1215,6 +1159,7 @@ EXPORT void CC PSX_ClearOTag_4F6290(PrimHeader** otBuffer, int otBufferSize)
 {
    // PSX_OrderingTable_SaveRecord_4F62C0(otBuffer, otBufferSize);
     Push_OTInformation(otBuffer, otBufferSize);
+    PSX_Commands_OnClearOTag(otBuffer, otBufferSize);
 
     // Set each element to point to the next
     int i = 0;
@@ -1269,11 +1214,11 @@ EXPORT void CC PSX_4F6ED0(WORD* /*pVRam*/, int /*width*/, int /*height*/, int /*
     NOT_IMPLEMENTED();
 }
 
-static int sLast_TILE_r_578328 = 0;
-static int sLast_TILE_g_C3D0E0 = 0;
-static int sLast_TILE_b_C3D0DC = 0;
-static DWORD sLast_Tile_abr_57832C = 0;
-ALIVE_ARY(1, 0xC2D080, short, 16384, word_C2D080, {});
+static thread_local int sLast_TILE_r_578328 = 0;
+static thread_local int sLast_TILE_g_C3D0E0 = 0;
+static thread_local int sLast_TILE_b_C3D0DC = 0;
+static thread_local DWORD sLast_Tile_abr_57832C = 0;
+ALIVE_ARY_TLS(1, 0xC2D080, short, 16384, word_C2D080, {});
 
 void PSX_Render_TILE_Blended_Large_Impl(WORD *pVRam, int width, int height, int r, int g, int b, int pitch)
 {
@@ -1305,12 +1250,15 @@ void PSX_Render_TILE_Blended_Large_Impl(WORD *pVRam, int width, int height, int
     {
         for (int y = 0; y < height; y++)
         {
-            for (int x = 0; x < width; x++)
+            if (PSX_Band_Owns(pVRam))
             {
-                // Index into the look up table using the vram limited value as the index
-                // which in turn is used as the output
-                const WORD v1 = (pVRam[x] >> 2) & 0x3FFF;
-                pVRam[x] = word_C2D080[v1];
+                for (int x = 0; x < width; x++)
+                {
+                    // Index into the look up table using the vram limited value as the index
+                    // which in turn is used as the output
+                    const WORD v1 = (pVRam[x] >> 2) & 0x3FFF;
+                    pVRam[x] = word_C2D080[v1];
+                }
             }
 
             pVRam += pitch;
@@ -1639,11 +1587,14 @@ static void Scaled_Poly_FT4_Inline_Texture_Render(
                                 WORD* pDstVRamLine = pVramXOff;
                                 for (int yLinesToWrite = 0; yLinesToWrite < yDuplicateCount; yLinesToWrite++)
                                 {
-                                    for (int widthPixelsToWrite = 0; widthPixelsToWrite < width_to_write; widthPixelsToWrite++)
+                                    if (PSX_Band_Owns(pDstVRamLine))
                                     {
-                                        const WORD converted_pixel = fnConvertPixel(clut_pixel, *pDstVRamLine);
-                                        *pDstVRamLine = converted_pixel;
-                                        pDstVRamLine += (bytesToNextPixel / sizeof(WORD));
+                                        for (int widthPixelsToWrite = 0; widthPixelsToWrite < width_to_write; widthPixelsToWrite++)
+                                        {
+                                            const WORD converted_pixel = fnConvertPixel(clut_pixel, *pDstVRamLine);
+                                            *pDstVRamLine = converted_pixel;
+                                            pDstVRamLine += (bytesToNextPixel / sizeof(WORD));
+                                        }
                                     }
                                     pDstVRamLine = &pVramXOff[vram_pitch / sizeof(WORD)];
                                     pVramXOff = pDstVRamLine;
@@ -1990,15 +1941,18 @@ EXPORT void CC PSX_Render_PolyFT4_16bit_517990(OT_Prim* pPrim, int width, int he
        
         for (int yIter = 0; yIter < height_clipped; yIter++)
         {
-            DWORD bitMask = (*pFg1Data) >> skipBits;
-            size_t dst_off = pSrc - pDst;
-            for (int xIter = 0; xIter < width; xIter++)
+            if (PSX_Band_Owns(pDst))
             {
-                if (bitMask & 1)
+                DWORD bitMask = (*pFg1Data) >> skipBits;
+                size_t dst_off = pSrc - pDst;
+                for (int xIter = 0; xIter < width; xIter++)
                 {
-                    pDst[xIter] = pDst[dst_off + xIter];
+                    if (bitMask & 1)
+                    {
+                        pDst[xIter] = pDst[dst_off + xIter];
+                    }
+                    bitMask >>= 1; // To next bit
                 }
-                bitMask >>= 1; // To next bit
             }
 
             pDst += pitch;
@@ -2655,8 +2609,8 @@ EXPORT void CC PSX_Render_Internal_Format_Polygon_4F7960(OT_Prim* prim, int xoff
     sPsx_drawenv_cliph_BDCD4C -= 16;
 }
 
-ALIVE_VAR(1, 0xbd30e4, int, sScreenXOffSet_BD30E4, 0);
-ALIVE_VAR(1, 0xbd30a4, int, sScreenYOffset_BD30A4, 0);
+ALIVE_VAR_TLS(1, 0xbd30e4, int, sScreenXOffSet_BD30E4, 0);
+ALIVE_VAR_TLS(1, 0xbd30a4, int, sScreenYOffset_BD30A4, 0);
 
 enum LineSegmentClipEdges
 {
@@ -2855,19 +2809,22 @@ EXPORT void CC PSX_EMU_Render_G_LineSegment_4F8250(void* pOtPrim1, signed int x0
         int yLine = (y_max << 16) + 0x7FFF;
         for (int i = 0; i <= width; i++)
         {
-            if (bSemiTrans)
-            {
-                WORD* pVramSrcDst = &pVram[pitch * (yLine >> 16)];
-                DWORD src = *pVramSrcDst;
-                *pVramSrcDst =
-                      abr_lut->b[(b0_fixed >> 19) & 0x1F][((src >> sBlueShift_C19140) & 0x1F)]
-                    | abr_lut->g[(g0_fixed >> 19) & 0x1F][((src >> sGreenShift_C1D180) & 0x1F)]
-                    | abr_lut->r[(r0_fixed >> 19) & 0x1F][((src >> sRedShift_C215C4) & 0x1F)];
-            }
-            else
+            WORD* pVramSrcDst = &pVram[pitch * (yLine >> 16)];
+            if (PSX_Band_Owns(pVramSrcDst))
             {
-                const WORD pixel = (r0_fixed >> 19 << sRedShift_C215C4) | (g0_fixed >> 19 << sGreenShift_C1D180) | (b0_fixed >> 19 << sBlueShift_C19140);
-                pVram[pitch * (yLine >> 16)] = pixel;
+                if (bSemiTrans)
+                {
+                    DWORD src = *pVramSrcDst;
+                    *pVramSrcDst =
+                          abr_lut->b[(b0_fixed >> 19) & 0x1F][((src >> sBlueShift_C19140) & 0x1F)]
+                        | abr_lut->g[(g0_fixed >> 19) & 0x1F][((src >> sGreenShift_C1D180) & 0x1F)]
+                        | abr_lut->r[(r0_fixed >> 19) & 0x1F][((src >> sRedShift_C215C4) & 0x1F)];
+                }
+                else
+                {
+                    const WORD pixel = (r0_fixed >> 19 << sRedShift_C215C4) | (g0_fixed >> 19 << sGreenShift_C1D180) | (b0_fixed >> 19 << sBlueShift_C19140);
+                    *pVramSrcDst = pixel;
+                }
             }
             pVram++; // Move X across
             r0_fixed += rDiff;
@@ -2905,18 +2862,21 @@ EXPORT void CC PSX_EMU_Render_G_LineSegment_4F8250(void* pOtPrim1, signed int x0
         int xpos = (x0 << 16) + 0x7FFF;
         for (int i = 0; i <= height; i++)
         {
-            if (bSemiTrans)
-            {
-                WORD* pVramSrcDst = &pVRam[xpos >> 16];
-                DWORD src = *pVramSrcDst;
-                *pVramSrcDst =
-                      abr_lut->b[(b0_fixed >> 19) & 0x1F][((src >> sBlueShift_C19140) & 0x1F)]
-                    | abr_lut->g[(g0_fixed >> 19) & 0x1F][((src >> sGreenShift_C1D180) & 0x1F)]
-                    | abr_lut->r[(r0_fixed >> 19) & 0x1F][((src >> sRedShift_C215C4) & 0x1F)];
-            }
-            else
+            WORD* pVramSrcDst = &pVRam[xpos >> 16];
+            if (PSX_Band_Owns(pVramSrcDst))
             {
-                pVRam[xpos >> 16] = (r0_fixed >> 19 << sRedShift_C215C4) | (g0_fixed >> 19 << sGreenShift_C1D180) | (b0_fixed >> 19 << sBlueShift_C19140);
+                if (bSemiTrans)
+                {
+                    DWORD src = *pVramSrcDst;
+                    *pVramSrcDst =
+                          abr_lut->b[(b0_fixed >> 19) & 0x1F][((src >> sBlueShift_C19140) & 0x1F)]
+                        | abr_lut->g[(g0_fixed >> 19) & 0x1F][((src >> sGreenShift_C1D180) & 0x1F)]
+                        | abr_lut->r[(r0_fixed >> 19) & 0x1F][((src >> sRedShift_C215C4) & 0x1F)];
+                }
+                else
+                {
+                    *pVramSrcDst = (r0_fixed >> 19 << sRedShift_C215C4) | (g0_fixed >> 19 << sGreenShift_C1D180) | (b0_fixed >> 19 << sBlueShift_C19140);
+                }
             }
 
             pVRam += pitch;
@@ -2990,7 +2950,10 @@ EXPORT void CC PSX_EMU_Render_F_LineSegment_4F80C0(int x0, int y0, int x1, int y
         int yPos = (y0_max << 16) + 0x7FFF; // +1 in fixed ?
         for (int i = 0; i <= width; i++)
         {
-            pVRam[pitch * (yPos >> 16)] = fill_colour;
+            if (PSX_Band_Owns(&pVRam[pitch * (yPos >> 16)]))
+            {
+                pVRam[pitch * (yPos >> 16)] = fill_colour;
+            }
             pVRam++;
             yPos += y_diff;
         }
@@ -3020,7 +2983,10 @@ EXPORT void CC PSX_EMU_Render_F_LineSegment_4F80C0(int x0, int y0, int x1, int y
         int xpos = (x0_max << 16) + 0x7FFF; // +1 in fixed ?
         for (int i = 0; i <= height; i++)
         {
-            pVRam[xpos >> 16] = fill_colour;
+            if (PSX_Band_Owns(pVRam))
+            {
+                pVRam[xpos >> 16] = fill_colour;
+            }
             pVRam += pitch;
             xpos += x_diff;
         }
@@ -3219,14 +3185,17 @@ EXPORT void CC PSX_RenderLaughingGasEffect_4F7B80(int xpos, int ypos, int width,
         WORD* pSrcIter = pSrc2;
         WORD* pDstLineIter = &pDstIter[dst_idx];
 
-        for (int xCounter = xClipped; xCounter < wCountToWrite; xCounter++)
+        if (PSX_Band_Owns(pDstLineIter))
         {
-            if (*pSrcIter)
+            for (int xCounter = xClipped; xCounter < wCountToWrite; xCounter++)
             {
-                *pDstLineIter = (*pSrcIter + (unsigned int)(unsigned __int16)(pixel_mask & *pDstLineIter)) >> 1;
+                if (*pSrcIter)
+                {
+                    *pDstLineIter = (*pSrcIter + (unsigned int)(unsigned __int16)(pixel_mask & *pDstLineIter)) >> 1;
+                }
+                pDstLineIter += 2;
+                pSrcIter += (xCounter & 1);
             }
-            pDstLineIter += 2;
-            pSrcIter += (xCounter & 1);
         }
 
         if (!dst_idx)
@@ -3376,22 +3345,41 @@ static void DrawOTag_HandlePrimRendering(IRenderer& renderer, PrimAny& any)
     }
 }
 
-static bool DrawOTagImpl(PrimHeader** ppOt, __int16 drawEnv_of0, __int16 drawEnv_of1)
+static void DrawOTagItem(IRenderer& renderer, PrimAny any, int itemToDrawType)
 {
-    sScreenXOffSet_BD30E4 = 0;
-    sScreenYOffset_BD30A4 = 0;
-    sActiveTPage_578318 = -1;
-
-    OTInformation otInfo = {};
-    if (!Pop_OTInformation(ppOt, otInfo))
+    switch (itemToDrawType)
     {
-        ALIVE_FATAL("Failed to look up OT info record");
-    }
+    case PrimTypeCodes::eSetTPage:
+        renderer.SetTPage(static_cast<short>(any.mSetTPage->field_C_tpage));
+        break;
 
-    IRenderer& renderer = *IRenderer::GetRenderer();
+    case PrimTypeCodes::ePrimClipper:
+        renderer.SetClip(*any.mPrimClipper);
+        break;
 
-    renderer.StartFrame(drawEnv_of0, drawEnv_of1);
+    // Always the lowest command in the list
+    case PrimTypeCodes::eScreenOffset:
+        // NOTE: Conditional on dword_55EF94 removed as it is constant 1
+        sScreenXOffSet_BD30E4 = any.mScreenOffset->field_C_xoff * 2;
+        sScreenYOffset_BD30A4 = any.mScreenOffset->field_E_yoff;
+        break;
+
+    case PrimTypeCodes::eMoveImage:
+        ALIVE_FATAL("eMoveImage should never be added to the OT");
+        break;
+
+    case PrimTypeCodes::eLaughingGas:
+        renderer.Draw(*any.mGas);
+        break;
+
+    default:
+        DrawOTag_HandlePrimRendering(renderer, any);
+        break;
+    }
+}
 
+static void DrawOTagItems(IRenderer& renderer, PrimHeader** ppOt, const OTInformation& otInfo, bool bTickSequencer)
+{
     PrimHeader* pOtItem = ppOt[0];
     while (pOtItem)
     {
@@ -3400,43 +3388,17 @@ static bool DrawOTagImpl(PrimHeader** ppOt, __int16 drawEnv_of0, __int16 drawEnv
             break;
         }
 
-        SsSeqCalledTbyT_4FDC80();
+        if (bTickSequencer)
+        {
+            SsSeqCalledTbyT_4FDC80();
+        }
 
         PrimAny any;
         any.mVoid = pOtItem;
 
         if (!otInfo.IsRootPointer(pOtItem))
         {
-            const int itemToDrawType = any.mPrimHeader->rgb_code.code_or_pad;
-            switch (itemToDrawType)
-            {
-            case PrimTypeCodes::eSetTPage:
-                renderer.SetTPage(static_cast<short>(any.mSetTPage->field_C_tpage));
-                break;
-
-            case PrimTypeCodes::ePrimClipper:
-                renderer.SetClip(*any.mPrimClipper);
-                break;
-
-            // Always the lowest command in the list
-            case PrimTypeCodes::eScreenOffset:
-                // NOTE: Conditional on dword_55EF94 removed as it is constant 1
-                sScreenXOffSet_BD30E4 = any.mScreenOffset->field_C_xoff * 2;
-                sScreenYOffset_BD30A4 = any.mScreenOffset->field_E_yoff;
-                break;
-
-            case PrimTypeCodes::eMoveImage:
-                ALIVE_FATAL("eMoveImage should never be added to the OT");
-                break;
-
-            case PrimTypeCodes::eLaughingGas:
-                renderer.Draw(*any.mGas);
-                break;
-
-            default:
-                DrawOTag_HandlePrimRendering(renderer, any);
-                break;
-            }
+            DrawOTagItem(renderer, any, any.mPrimHeader->rgb_code.code_or_pad);
         }
         else
         {
@@ -3446,90 +3408,558 @@ static bool DrawOTagImpl(PrimHeader** ppOt, __int16 drawEnv_of0, __int16 drawEnv
         // To the next item
         pOtItem = any.mPrimHeader->tag; // offset 0
     }
-
-    return false;
 }
 
-EXPORT void CC PSX_DrawOTag_4F6540(PrimHeader** ppOt)
+static void DrawCommandItems(IRenderer& renderer, const std::vector<PsxRenderCommand>& commands, bool bTickSequencer)
 {
-    if (!sPsxEmu_EndFrameFnPtr_C1D17C || !sPsxEmu_EndFrameFnPtr_C1D17C(0))
+    // The sequencer only does anything every 30ms so there is no need to look at the clock for every prim
+    const size_t kTickInterval = 32;
+
+    for (size_t i = 0; i < commands.size(); i++)
     {
-        if (turn_off_rendering_BD0F20 || !BMP_Lock_4F1FF0(&sPsxVram_C1D160))
+        if (bTickSequencer && (i % kTickInterval) == 0)
         {
-            if (sPsxEmu_EndFrameFnPtr_C1D17C)
-            {
-                sPsxEmu_EndFrameFnPtr_C1D17C(1);
-            }
-            return;
+            SsSeqCalledTbyT_4FDC80();
         }
 
-        __int16 drawEnv_of0 = 0;
-        __int16 drawEnv_of1 = 0;
+        PrimAny any;
+        any.mPrimHeader = commands[i].mpPrim;
+        DrawOTagItem(renderer, any, commands[i].mCode);
+    }
+}
 
-        if (bDontUseXYOffsetInRender_BD1464)
-        {
-            if (!BMP_Lock_4F1FF0(&sBitmap_C1D1A0))
-            {
-                BMP_unlock_4F2100(&sPsxVram_C1D160);
-                if (sPsxEmu_EndFrameFnPtr_C1D17C)
-                {
-                    sPsxEmu_EndFrameFnPtr_C1D17C(1);
-                }
-                return;
-            }
-            spBitmap_C2D038 = &sBitmap_C1D1A0;
-            drawEnv_of1 = 0;
-            drawEnv_of0 = 0;
-        }
-        else
-        {
-            spBitmap_C2D038 = &sPsxVram_C1D160;
-            drawEnv_of0 = sPSX_EMU_DrawEnvState_C3D080.field_8_ofs[0];
-            drawEnv_of1 = sPSX_EMU_DrawEnvState_C3D080.field_8_ofs[1];
-        }
+// What DrawOTagImpl draws, either the OT linked list or its sorted command buffer.
+struct OTDrawList
+{
+    PrimHeader** mOt;
+    OTInformation mOtInfo;
+    const std::vector<PsxRenderCommand>* mpCommands;
+};
 
-        if (DrawOTagImpl(ppOt, drawEnv_of0, drawEnv_of1))
-        {
-            return;
-        }
+static void StartDrawList()
+{
+    sScreenXOffSet_BD30E4 = 0;
+    sScreenYOffset_BD30A4 = 0;
+    sActiveTPage_578318 = -1;
+}
 
-        if (bDontUseXYOffsetInRender_BD1464)
-        {
-            BMP_unlock_4F2100(&sBitmap_C1D1A0);
-        }
+static void DrawOTDrawList(IRenderer& renderer, const OTDrawList& drawList, bool bTickSequencer)
+{
+    // Nothing to keep moving when the audio thread plays the sequencer
+    bTickSequencer = bTickSequencer && !SsExt_SeqOnAudioThread();
 
-        BMP_unlock_4F2100(&sPsxVram_C1D160);
-        if (sPsxEmu_EndFrameFnPtr_C1D17C)
-        {
-            sPsxEmu_EndFrameFnPtr_C1D17C(1);
-        }
-        return;
+    StartDrawList();
+
+    if (drawList.mpCommands)
+    {
+        DrawCommandItems(renderer, *drawList.mpCommands, bTickSequencer);
+    }
+    else
+    {
+        DrawOTagItems(renderer, drawList.mOt, drawList.mOtInfo, bTickSequencer);
     }
 }
 
-EXPORT void CC PSX_TPage_Change_4F6430(__int16 tPage)
+// The rasterizer state that carries over from one frame to the next, each band starts from the main thread's copy.
+// Everything else (edges, scratch prims, colour LUTs) is set up again by every primitive that uses it.
+struct PsxRasterState
 {
-    if (sActiveTPage_578318 != tPage)
-    {
-        sActiveTPage_578318 = tPage;
-
-        // NOTE: Branch guarded by PSX_Ret_0_4F60D0 removed
+    short mActiveTPage;
+    DWORD mTexturePageX;
+    DWORD mTexturePageY;
+    DWORD mTextureMode;
+    DWORD mTPageWidth;
+    DWORD mTexturePageAbr;
+    WORD* mpTPageSrc;
+
+    DWORD mTileR;
+    DWORD mTileG;
+    DWORD mTileB;
+
+    PSX_DRAWENV mDrawEnv;
+    int mClipX;
+    int mClipY;
+    int mClipW;
+    int mClipH;
+    int mK500;
+    BYTE* mpDrawEnvBuffer;
+};
 
-        // Extract parts of the tpage
-        sTexture_page_x_BD0F0C = (tPage & 0xF) << 6;
-        sTexture_page_y_BD0F10 = 16 * (tPage & 0x10) + (((unsigned int)tPage >> 2) & 0x200);
+static PsxRasterState CaptureRasterState()
+{
+    PsxRasterState state = {};
+    state.mActiveTPage = sActiveTPage_578318;
+    state.mTexturePageX = sTexture_page_x_BD0F0C;
+    state.mTexturePageY = sTexture_page_y_BD0F10;
+    state.mTextureMode = sTexture_mode_BD0F14;
+    state.mTPageWidth = tpage_width_57831C;
+    state.mTexturePageAbr = sTexture_page_abr_BD0F18;
+    state.mpTPageSrc = sTPage_src_ptr_BD0F1C;
+
+    state.mTileR = sTile_r_BD2A04;
+    state.mTileG = sTile_g_BD2A00;
+    state.mTileB = sTile_b_BD29FC;
+
+    state.mDrawEnv = sPSX_EMU_DrawEnvState_C3D080;
+    state.mClipX = sPsx_drawenv_clipx_BDCD40;
+    state.mClipY = sPsx_drawenv_clipy_BDCD44;
+    state.mClipW = sPsx_drawenv_clipw_BDCD48;
+    state.mClipH = sPsx_drawenv_cliph_BDCD4C;
+    state.mK500 = sPsx_drawenv_k500_BDCD50;
+    state.mpDrawEnvBuffer = sPsx_drawenv_buffer_BDCD54;
+    return state;
+}
 
-        sTexture_mode_BD0F14 = ((unsigned int)tPage >> 7) & 3;
-        sTexture_page_abr_BD0F18 = ((unsigned int)tPage >> 5) & 3;
+static void ApplyRasterState(const PsxRasterState& state)
+{
+    sActiveTPage_578318 = state.mActiveTPage;
+    sTexture_page_x_BD0F0C = state.mTexturePageX;
+    sTexture_page_y_BD0F10 = state.mTexturePageY;
+    sTexture_mode_BD0F14 = state.mTextureMode;
+    tpage_width_57831C = state.mTPageWidth;
+    sTexture_page_abr_BD0F18 = state.mTexturePageAbr;
+    sTPage_src_ptr_BD0F1C = state.mpTPageSrc;
+
+    sTile_r_BD2A04 = state.mTileR;
+    sTile_g_BD2A00 = state.mTileG;
+    sTile_b_BD29FC = state.mTileB;
+
+    sPSX_EMU_DrawEnvState_C3D080 = state.mDrawEnv;
+    sPsx_drawenv_clipx_BDCD40 = state.mClipX;
+    sPsx_drawenv_clipy_BDCD44 = state.mClipY;
+    sPsx_drawenv_clipw_BDCD48 = state.mClipW;
+    sPsx_drawenv_cliph_BDCD4C = state.mClipH;
+    sPsx_drawenv_k500_BDCD50 = state.mK500;
+    sPsx_drawenv_buffer_BDCD54 = state.mpDrawEnvBuffer;
+}
 
-        if (sTexture_mode_BD0F14 == (TextureModes::e16Bit | TextureModes::e8Bit))
+// Calls fnItem(pPrim, code) for everything DrawOTDrawList would draw, in the same order.
+template<class TFn>
+static void ForEachDrawItem(const OTDrawList& drawList, TFn fnItem)
+{
+    if (drawList.mpCommands)
+    {
+        for (const PsxRenderCommand& command : *drawList.mpCommands)
         {
-            // 0, 1 and 2 are valid values. So if for some reason 1 and 2 are set then default to 2
-            sTexture_mode_BD0F14 = TextureModes::e16Bit;
+            fnItem(command.mpPrim, command.mCode);
         }
+        return;
+    }
+
+    for (PrimHeader* pOtItem = drawList.mOt[0]; pOtItem && pOtItem != reinterpret_cast<PrimHeader*>(static_cast<size_t>(0xFFFFFFFF)); pOtItem = pOtItem->tag)
+    {
+        if (!drawList.mOtInfo.IsRootPointer(pOtItem))
+        {
+            fnItem(pOtItem, pOtItem->rgb_code.code_or_pad);
+        }
+    }
+}
+
+template<class T>
+static void PolyRows(T* pPoly, int vertCount, int& top, int& bottom)
+{
+    const short ys[4] = { Y0(pPoly), Y1(pPoly), Y2(pPoly), vertCount > 3 ? Y3(pPoly) : Y2(pPoly) };
+    top = *std::min_element(std::begin(ys), std::end(ys));
+    bottom = *std::max_element(std::begin(ys), std::end(ys));
+}
+
+// Which frame buffer rows drawing an item can write to. Returns false for anything every band has to see, state
+// changes, lines and the gas effect but also tiles and FT4s drawn in ways that leave the rasterizer state changed.
+// bTPageWhenMissed is set for an animation or FG1 FT4, drawing those changes the tpage and nothing else lasts.
+static bool DrawItemRows(PrimHeader* pPrim, int code, int yOff, int& top, int& bottom, bool& bTPageWhenMissed)
+{
+    bTPageWhenMissed = false;
+    if (code >= PrimTypeCodes::eSetTPage)
+    {
+        return false;
+    }
+
+    PrimAny any;
+    any.mPrimHeader = pPrim;
+    switch (PSX_Prim_Code_Without_Blending_Or_SemiTransparency(code))
+    {
+    case PrimTypeCodes::eSprt:
+        top = yOff + Y0(any.mSprt);
+        bottom = top + any.mSprt->field_16_h - 1;
+        return true;
+
+    case PrimTypeCodes::eTile:
+        // Adds up the blended tile colours instead of drawing
+        if (dword_5CA4D4)
+        {
+            return false;
+        }
+        top = yOff + Y0(any.mTile);
+        bottom = top + any.mTile->field_16_h - 1;
+        return true;
+
+    case PrimTypeCodes::ePolyF3:
+        PolyRows(any.mPolyF3, 3, top, bottom);
+        break;
+
+    case PrimTypeCodes::ePolyG3:
+        PolyRows(any.mPolyG3, 3, top, bottom);
+        break;
+
+    case PrimTypeCodes::ePolyF4:
+        PolyRows(any.mPolyF4, 4, top, bottom);
+        break;
+
+    case PrimTypeCodes::ePolyG4:
+        PolyRows(any.mPolyG4, 4, top, bottom);
+        break;
+
+    case PrimTypeCodes::ePolyFT4:
+        // Anything else sets its tpage then puts the old one back, unless it was clipped away
+        if (!GetPrimExtraPointerHack(any.mPolyFT4))
+        {
+            return false;
+        }
+        PolyRows(any.mPolyFT4, 4, top, bottom);
+        bTPageWhenMissed = true;
+
+        // Only moved down by the frame offset
+        yOff = std::max(yOff, 0);
+        break;
+
+    default:
+        return false;
+    }
+
+    // Edges are stepped in sub pixels so allow for rounding either way
+    top += yOff - 1;
+    bottom += yOff + 1;
+    return true;
+}
+
+// One item of a band's share of the frame. A run of FT4s that are all below or above the band is kept as the tpage
+// changes drawing them would have made, only the last tpage and one that differs from it matter.
+struct PsxBandItem
+{
+    PrimHeader* mpPrim; // nullptr for tpage changes only
+    BYTE mCode;
+    bool mHasOtherTPage;
+    short mOtherTPage;
+    short mTPage;
+};
+
+// Files every item of the draw list under the bands it can touch in one walk over the OT.
+static void BinDrawList(const OTDrawList& drawList, const int* pBandRows, int bandCount, int yOff, std::vector<std::vector<PsxBandItem>>& bands)
+{
+    bands.resize(bandCount);
+    for (std::vector<PsxBandItem>& items : bands)
+    {
+        items.clear();
+    }
+
+    // Prims are put in screen space differently when this is set
+    const bool bBin = !bDontUseXYOffsetInRender_BD1464;
+
+    ForEachDrawItem(drawList, [&](PrimHeader* pPrim, int code)
+    {
+        int top = 0;
+        int bottom = 0;
+        bool bTPageWhenMissed = false;
+        if (!bBin || !DrawItemRows(pPrim, code, yOff, top, bottom, bTPageWhenMissed))
+        {
+            for (std::vector<PsxBandItem>& items : bands)
+            {
+                items.push_back({ pPrim, static_cast<BYTE>(code), false, 0, 0 });
+            }
+            return;
+        }
+
+        for (int band = 0; band < bandCount; band++)
+        {
+            // The first and last bands also own anything above or below the draw area
+            const bool bAfterStart = band == 0 || bottom >= pBandRows[band];
+            const bool bBeforeEnd = band == bandCount - 1 || top < pBandRows[band + 1];
+            std::vector<PsxBandItem>& items = bands[band];
+            if (bAfterStart && bBeforeEnd)
+            {
+                items.push_back({ pPrim, static_cast<BYTE>(code), false, 0, 0 });
+            }
+            else if (bTPageWhenMissed)
+            {
+                const short tpage = static_cast<short>(GetTPage(reinterpret_cast<Poly_FT4*>(pPrim)));
+                if (!items.empty() && !items.back().mpPrim)
+                {
+                    PsxBandItem& last = items.back();
+                    if (last.mTPage != tpage)
+                    {
+                        last.mHasOtherTPage = true;
+                        last.mOtherTPage = last.mTPage;
+                    }
+                    last.mTPage = tpage;
+                }
+                else
+                {
+                    items.push_back({ nullptr, 0, false, 0, tpage });
+                }
+            }
+        }
+    });
+}
+
+static void DrawBandItems(IRenderer& renderer, const std::vector<PsxBandItem>& items, bool bTickSequencer)
+{
+    // Same as DrawCommandItems
+    const size_t kTickInterval = 32;
+
+    bTickSequencer = bTickSequencer && !SsExt_SeqOnAudioThread();
+    StartDrawList();
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        if (bTickSequencer && (i % kTickInterval) == 0)
+        {
+            SsSeqCalledTbyT_4FDC80();
+        }
+
+        const PsxBandItem& item = items[i];
+        if (item.mpPrim)
+        {
+            PrimAny any;
+            any.mPrimHeader = item.mpPrim;
+            DrawOTagItem(renderer, any, item.mCode);
+        }
+        else
+        {
+            if (item.mHasOtherTPage)
+            {
+                renderer.SetTPage(item.mOtherTPage);
+            }
+            renderer.SetTPage(item.mTPage);
+        }
+    }
+}
+
+// The OT is walked once to give each band the items that can write to its rows, plus every state change, so the
+// state is the same as serially wherever a band draws something. A band only writes the frame buffer rows it owns
+// for the prims that span more than one. Band 0 runs on the calling thread so its state ends up the same as drawing
+// serially would have left it.
+static void DrawOTagBands(WorkerGroup& workers, IRenderer& renderer, const OTDrawList& drawList, int yOff)
+{
+    static std::vector<std::vector<PsxBandItem>> sBandItems;
+
+    const PsxRasterState state = CaptureRasterState();
+
+    const PSX_RECT clip = sPSX_EMU_DrawEnvState_C3D080.field_0_clip;
+    const WORD* pPixels = reinterpret_cast<const WORD*>(spBitmap_C2D038->field_4_pLockedPixels);
+    const int pitchWords = spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
+    const int bandCount = workers.Count();
+
+    // Split the draw area evenly
+    int bandRows[kMaxRenderBands + 1] = {};
+    for (int band = 0; band <= bandCount; band++)
+    {
+        bandRows[band] = clip.y + (clip.h * band) / bandCount;
+    }
+
+    BinDrawList(drawList, bandRows, bandCount, yOff, sBandItems);
+
+    workers.Run([&](int band)
+    {
+        if (band != 0)
+        {
+            ApplyRasterState(state);
+        }
+
+        // The first and last bands also own anything above or below the draw area
+        sBandStart = band == 0 ? 0 : reinterpret_cast<std::uintptr_t>(pPixels + (bandRows[band] * pitchWords));
+        sBandEnd = band == bandCount - 1 ? UINTPTR_MAX : reinterpret_cast<std::uintptr_t>(pPixels + (bandRows[band + 1] * pitchWords));
+
+        // The SEQ player isn't thread safe
+        DrawBandItems(renderer, sBandItems[band], band == 0);
+
+        sBandStart = 0;
+        sBandEnd = UINTPTR_MAX;
+    });
+}
+
+// Draws the frame in bands and then serially from the same starting point, keeps the serial
+// result and logs where the two differ.
+static void DrawOTagBandsAndCompare(WorkerGroup& workers, IRenderer& renderer, const OTDrawList& drawList, int yOff)
+{
+    static std::vector<WORD> sBefore;
+    static std::vector<WORD> sBanded;
+
+    WORD* pPixels = reinterpret_cast<WORD*>(spBitmap_C2D038->field_4_pLockedPixels);
+    const int pitchWords = spBitmap_C2D038->field_10_locked_pitch / sizeof(WORD);
+    const size_t pixelCount = static_cast<size_t>(pitchWords) * spBitmap_C2D038->field_C_height;
+
+    const PsxRasterState state = CaptureRasterState();
+    sBefore.assign(pPixels, pPixels + pixelCount);
+
+    DrawOTagBands(workers, renderer, drawList, yOff);
+    sBanded.assign(pPixels, pPixels + pixelCount);
+
+    std::copy(sBefore.begin(), sBefore.end(), pPixels);
+    ApplyRasterState(state);
+    DrawOTDrawList(renderer, drawList, false);
+
+    size_t mismatchCount = 0;
+    size_t firstMismatch = 0;
+    for (size_t i = 0; i < pixelCount; i++)
+    {
+        if (pPixels[i] != sBanded[i])
+        {
+            if (mismatchCount == 0)
+            {
+                firstMismatch = i;
+            }
+            mismatchCount++;
+        }
+    }
+
+    PsxBandStats& stats = PSX_Bands_Stats();
+    stats.mComparedFrames++;
+    if (mismatchCount > 0)
+    {
+        stats.mMismatchedFrames++;
+        LOG_WARNING("Banded frame " << stats.mComparedFrames << " differs from serial in " << mismatchCount
+            << " pixels, first at " << (firstMismatch % pitchWords) << "," << (firstMismatch / pitchWords));
+    }
+}
+
+// Takes the OT's info record so it can only be done once per PSX_ClearOTag_4F6290.
+static OTDrawList MakeOTDrawList(PrimHeader** ppOt)
+{
+    OTDrawList drawList = {};
+    drawList.mOt = ppOt;
+    if (!Pop_OTInformation(ppOt, drawList.mOtInfo))
+    {
+        ALIVE_FATAL("Failed to look up OT info record");
+    }
+
+    if (PsxRenderCommandBuffer* pCommands = PSX_Commands_Find(ppOt))
+    {
+        drawList.mpCommands = &pCommands->Sort();
+    }
+    return drawList;
+}
+
+static bool DrawOTagImpl(PrimHeader** ppOt, __int16 drawEnv_of0, __int16 drawEnv_of1)
+{
+    const OTDrawList drawList = MakeOTDrawList(ppOt);
+
+    IRenderer& renderer = *IRenderer::GetRenderer();
+
+    renderer.StartFrame(drawEnv_of0, drawEnv_of1);
+
+    // Only the software renderer can draw from more than one thread. The gas effect always writes to
+    // VRAM so the frame buffer has to be VRAM for the band rows to line up.
+    WorkerGroup* pWorkers = nullptr;
+    SoftwareRenderer* pSoftwareRenderer = dynamic_cast<SoftwareRenderer*>(&renderer);
+    if (pSoftwareRenderer && spBitmap_C2D038 == &sPsxVram_C1D160)
+    {
+        pWorkers = PSX_Bands_GetWorkers();
+    }
+
+    if (!pWorkers)
+    {
+        DrawOTDrawList(renderer, drawList, true);
+    }
+    else if (gRenderBandsCompare)
+    {
+        DrawOTagBandsAndCompare(*pWorkers, renderer, drawList, pSoftwareRenderer->FrameYOffset());
+    }
+    else
+    {
+        DrawOTagBands(*pWorkers, renderer, drawList, pSoftwareRenderer->FrameYOffset());
+    }
+
+    return false;
+}
+
+EXPORT void CC PSX_DrawOTag_4F6540(PrimHeader** ppOt)
+{
+    FRAME_PROFILE_PHASE(FramePhase::eDrawOTag);
+
+    if (gHeadlessMode)
+    {
+        // Nothing to rasterize to
+        return;
+    }
+
+    if (!sPsxEmu_EndFrameFnPtr_C1D17C || !sPsxEmu_EndFrameFnPtr_C1D17C(0))
+    {
+        if (turn_off_rendering_BD0F20 || !BMP_Lock_4F1FF0(&sPsxVram_C1D160))
+        {
+            if (sPsxEmu_EndFrameFnPtr_C1D17C)
+            {
+                sPsxEmu_EndFrameFnPtr_C1D17C(1);
+            }
+            return;
+        }
+
+        __int16 drawEnv_of0 = 0;
+        __int16 drawEnv_of1 = 0;
+
+        if (bDontUseXYOffsetInRender_BD1464)
+        {
+            if (!BMP_Lock_4F1FF0(&sBitmap_C1D1A0))
+            {
+                BMP_unlock_4F2100(&sPsxVram_C1D160);
+                if (sPsxEmu_EndFrameFnPtr_C1D17C)
+                {
+                    sPsxEmu_EndFrameFnPtr_C1D17C(1);
+                }
+                return;
+            }
+            spBitmap_C2D038 = &sBitmap_C1D1A0;
+            drawEnv_of1 = 0;
+            drawEnv_of0 = 0;
+        }
+        else
+        {
+            spBitmap_C2D038 = &sPsxVram_C1D160;
+            drawEnv_of0 = sPSX_EMU_DrawEnvState_C3D080.field_8_ofs[0];
+            drawEnv_of1 = sPSX_EMU_DrawEnvState_C3D080.field_8_ofs[1];
+        }
+
+        if (DrawOTagImpl(ppOt, drawEnv_of0, drawEnv_of1))
+        {
+            return;
+        }
+
+        if (bDontUseXYOffsetInRender_BD1464)
+        {
+            BMP_unlock_4F2100(&sBitmap_C1D1A0);
+        }
+
+        BMP_unlock_4F2100(&sPsxVram_C1D160);
+        if (sPsxEmu_EndFrameFnPtr_C1D17C)
+        {
+            sPsxEmu_EndFrameFnPtr_C1D17C(1);
+        }
+        return;
+    }
+}
+
+EXPORT void CC PSX_TPage_Change_4F6430(__int16 tPage)
+{
+    if (sActiveTPage_578318 != tPage)
+    {
+        sActiveTPage_578318 = tPage;
+
+        // NOTE: Branch guarded by PSX_Ret_0_4F60D0 removed
+
+        // Extract parts of the tpage
+        sTexture_page_x_BD0F0C = (tPage & 0xF) << 6;
+        sTexture_page_y_BD0F10 = 16 * (tPage & 0x10) + (((unsigned int)tPage >> 2) & 0x200);
+
+        sTexture_mode_BD0F14 = ((unsigned int)tPage >> 7) & 3;
+        sTexture_page_abr_BD0F18 = ((unsigned int)tPage >> 5) & 3;
+
+        if (sTexture_mode_BD0F14 == (TextureModes::e16Bit | TextureModes::e8Bit))
+        {
+            // 0, 1 and 2 are valid values. So if for some reason 1 and 2 are set then default to 2
+            sTexture_mode_BD0F14 = TextureModes::e16Bit;
+        }
+
+        // NOTE: Branch guarded by dword_BD2250[tPage & 31] removed as it is never written
 
-        // NOTE: Branch guarded by dword_BD2250[tPage & 31] removed as it is never written
-
         tpage_width_57831C = 10;
         sTPage_src_ptr_BD0F1C = reinterpret_cast<WORD*>(sPsxVram_C1D160.field_4_pLockedPixels) + (sTexture_page_x_BD0F0C + (sTexture_page_y_BD0F10 * 1024));
     }
@@ -3586,189 +4016,28 @@ EXPORT bool CC PSX_Rects_intersect_point_4FA100(const PSX_RECT* pScreen, const P
 EXPORT void CC PSX_EMU_Render_SPRT_4bit_51F0E0(const PSX_RECT* pRect, int u, int v, unsigned __int8 r, unsigned __int8 g, unsigned __int8 b, WORD clut, char bSemiTrans)
 {
     const int tpagey = sTexture_page_y_BD0F10 + v;
-    const unsigned int rect_w = pRect->w;
     const WORD* pClutSrc1 = (WORD *)((char *)sPsxVram_C1D160.field_4_pLockedPixels  + 32 * ((clut & 63) + ((unsigned int)clut >> 6 << 6)));
-    
-    Psx_Test* pAbrLut = nullptr;
-    if (bSemiTrans)
-    {
-        pAbrLut = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
-    }
 
-    const unsigned int texture_remainder_pitch = 2048 - (rect_w  / 2);
     const unsigned int pitchWords = spBitmap_C2D038->field_10_locked_pitch / 2;
-    const unsigned int vram_remainder_pitch = pitchWords - pRect->w;
     const BYTE* pTexture_4bit_src1 = (BYTE *)sPsxVram_C1D160.field_4_pLockedPixels + 2 * (sTexture_page_x_BD0F0C + (u / 4) + (tpagey / 1024));
     WORD* pVram_start = (WORD *)((char *)spBitmap_C2D038->field_4_pLockedPixels + 2 * (pRect->x + pitchWords * pRect->y));
 
+    // Semi trans sprites blend every texel regardless of the CLUT semi trans bit
+    const PsxSpanBlend blend = bSemiTrans ? PsxSpanBlend::eAlways : PsxSpanBlend::eNone;
+    PsxSpanMode mode = MakeSpanMode(true, blend);
     if (r != 128 || g != 128 || b != 128)
     {
-        if (bSemiTrans)
-        {
-            const Psx_Data* pLut_r = &stru_C1D1C0[r >> 3];
-            const Psx_Data* pLut_g = &stru_C1D1C0[g >> 3];
-            const Psx_Data* pLut_b = &stru_C1D1C0[b >> 3];
-            for (int y = 0; y < pRect->h; y++)
-            {
-                WORD* pLineEnd1 = &pVram_start[pRect->w];
-                WORD* pLineEnd2 = &pVram_start[pRect->w];
-                while (pVram_start < pLineEnd1)
-                {
-                    const int clut_4_bit_idx1 = *pTexture_4bit_src1 & 0xF;
-                    if (pClutSrc1[clut_4_bit_idx1])
-                    {
-                        const WORD clut_pixel = pClutSrc1[clut_4_bit_idx1];
-                        const WORD vram_pixel = *pVram_start;
-                        pLineEnd1 = pLineEnd2;
-
-                        const BYTE lutR = pLut_r->field_0[clut_pixel >> 11];
-                        const BYTE lutG = pLut_g->field_0[(clut_pixel >> 6) & 31];
-                        const BYTE lutB = pLut_b->field_0[clut_pixel & 31];
-
-                        *pVram_start =
-                            pAbrLut->r[lutR][vram_pixel >> 11]
-                            | pAbrLut->g[lutG][((vram_pixel >> 6) & 31)]
-                            | pAbrLut->b[lutB][vram_pixel & 31];
-                    }
-                    ++pVram_start;
-
-                    if (pVram_start >= pLineEnd1)
-                    {
-                        break;
-                    }
-
-                    const unsigned int clut_4_bit_idx2 = (*pTexture_4bit_src1++) >> 4;
-                    const WORD clut_pixel2 = pClutSrc1[clut_4_bit_idx2];
-                    const WORD vram_pixel2 = *pVram_start;
-                    if (clut_pixel2)
-                    {
-                        const BYTE lutR = pLut_r->field_0[clut_pixel2 >> 11];
-                        const BYTE lutG = pLut_g->field_0[(clut_pixel2 >> 6) & 31];
-                        const BYTE lutB = pLut_b->field_0[clut_pixel2 & 31];
-
-                        *pVram_start =
-                            pAbrLut->r[lutR][vram_pixel2 >> 11]
-                            | pAbrLut->g[lutG][((vram_pixel2 >> 6) & 31)]
-                            | pAbrLut->b[lutB][vram_pixel2 & 31];
-                    }
-                    ++pVram_start;
-                }
-                pTexture_4bit_src1 += texture_remainder_pitch;
-                pVram_start += vram_remainder_pitch;
-            }
-        }
-        else
-        {
-            const __int16* g_lut = stru_C146C0.g[g >> 3];
-            const __int16* r_lut = stru_C146C0.r[r >> 3];
-            const __int16* b_lut = stru_C146C0.b[b >> 3];
-
-            for (int y = 0; y < pRect->h; y++)
-            {
-                WORD* pLineEnd3 = &pVram_start[pRect->w];
-                WORD* pLineEnd4 = &pVram_start[pRect->w];
-                while (pVram_start < pLineEnd3)
-                {
-                    if (pClutSrc1[*pTexture_4bit_src1 & 0xF])
-                    {
-                        *pVram_start =
-                              b_lut[pClutSrc1[*pTexture_4bit_src1 & 0xF] & 31]
-                            | r_lut[pClutSrc1[*pTexture_4bit_src1 & 0xF] >> 11]
-                            | g_lut[(pClutSrc1[*pTexture_4bit_src1 & 0xF] >> 6) & 31];
-                        pLineEnd3 = pLineEnd4;
-                    }
-                    ++pVram_start;
-
-                    if (pVram_start >= pLineEnd3)
-                    {
-                        break;
-                    }
-
-                    const unsigned int clut_4_bit_idx3 = (*pTexture_4bit_src1++) >> 4;
-                    const WORD clut_pixel3 = pClutSrc1[clut_4_bit_idx3];
-                    if (clut_pixel3)
-                    {
-                        *pVram_start =
-                              r_lut[clut_pixel3 >> 11]
-                            | g_lut[(clut_pixel3 >> 6) & 31]
-                            | b_lut[clut_pixel3 & 31];
-
-                        pLineEnd3 = pLineEnd4;
-                    }
-                    ++pVram_start;
-                }
-
-                pTexture_4bit_src1 += texture_remainder_pitch;
-                pVram_start += vram_remainder_pitch;
-            }
-        }
+        mode = MakeSpanMode(true, blend, stru_C1D1C0[r >> 3].field_0, stru_C1D1C0[g >> 3].field_0, stru_C1D1C0[b >> 3].field_0);
     }
-    else if (bSemiTrans)
-    {
-        for (int y = 0; y < pRect->h; y++)
-        {
-            WORD* pLineEnd = &pVram_start[pRect->w];
-            while (pVram_start < pLineEnd)
-            {
-                const WORD clut_4_bit_idx4 = pClutSrc1[*pTexture_4bit_src1 & 0xF];
-                if (clut_4_bit_idx4)
-                {
-                    const WORD vram_pixel2 = *pVram_start;
-
-                    *pVram_start = Calc_Abr_Pixel(*pAbrLut, vram_pixel2, clut_4_bit_idx4);
-                }
-
-                ++pVram_start;
-                if (pVram_start >= pLineEnd)
-                {
-                    break;
-                }
-
-                const unsigned int clut_4_bit_idx5 = (*pTexture_4bit_src1) >> 4;
-                const WORD clut_pixel5 = pClutSrc1[clut_4_bit_idx5];
-                if (clut_pixel5)
-                {
-                    const WORD vram_pixel2 = *pVram_start;
-                    *pVram_start = Calc_Abr_Pixel(*pAbrLut, vram_pixel2, clut_pixel5);
-                }
 
-                pTexture_4bit_src1++;
-                ++pVram_start;
-            }
-
-            pTexture_4bit_src1 += texture_remainder_pitch;
-            pVram_start += vram_remainder_pitch;
-        }
-    }
-    else
+    for (int y = 0; y < pRect->h; y++)
     {
-        for (int y = 0; y < pRect->h; y++)
+        if (PSX_Band_Owns(pVram_start))
         {
-            WORD* pLineEnd = &pVram_start[pRect->w];
-            while (pVram_start < pLineEnd)
-            {
-                const WORD clut_pixel_from_nibble1 = pClutSrc1[*pTexture_4bit_src1 & 0xF];
-                if (clut_pixel_from_nibble1)
-                {
-                    *pVram_start = clut_pixel_from_nibble1;
-                }
-                ++pVram_start;
-
-                if (pVram_start >= pLineEnd)
-                {
-                    break;
-                }
-
-                const WORD clut_pixel_from_nibble2 = pClutSrc1[(*pTexture_4bit_src1++) >> 4];
-                if (clut_pixel_from_nibble2)
-                {
-                    *pVram_start = clut_pixel_from_nibble2;
-                }
-                ++pVram_start;
-            }
-            pVram_start += vram_remainder_pitch;
-            pTexture_4bit_src1 += texture_remainder_pitch;
+            WriteClut4Span(pVram_start, pTexture_4bit_src1, pClutSrc1, pRect->w, mode);
         }
+        pTexture_4bit_src1 += 2048;
+        pVram_start += pitchWords;
     }
 }
 
@@ -3777,221 +4046,81 @@ EXPORT void CC PSX_EMU_Render_SPRT_8bit_51F660(const PSX_RECT* pRect, int u, int
 {
     const int tpagex = sTexture_page_x_BD0F0C + (u / 2);
     const int tpagey = sTexture_page_y_BD0F10 + v;
-    BYTE* pTexture_8bit_src = (unsigned __int8 *)sPsxVram_C1D160.field_4_pLockedPixels + 2 * (tpagex + (tpagey * 1024));
-    const int texture_8bit_remainder = 2048 - pRect->w;
+    const BYTE* pTexture_8bit_src = (unsigned __int8 *)sPsxVram_C1D160.field_4_pLockedPixels + 2 * (tpagex + (tpagey * 1024));
 
     const WORD* pClutSrc = (WORD *)((char *)sPsxVram_C1D160.field_4_pLockedPixels + 32 * ((clut & 63) + (((unsigned int)clut / 64) * 64)));
 
     const unsigned int pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch / 2;
-    const int vram_dst_remainder = pitch - pRect->w;
     unsigned __int16* pVram_dst = (unsigned __int16 *)((char *)spBitmap_C2D038->field_4_pLockedPixels + 2 * (pRect->x + pitch * pRect->y));
-    WORD* pVram_End = &pVram_dst[(pRect->w - 1) + pitch * (pRect->h - 1)];
+    const WORD* pVram_End = &pVram_dst[(pRect->w - 1) + pitch * (pRect->h - 1)];
 
+    PsxSpanMode mode;
     if (r != 128 || g != 128 || b != 128)
     {
-        if (bSemiTrans)
-        {
-            Psx_Test* pAbr_Lut = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
-            while (pVram_dst < pVram_End)
-            {
-                WORD* pLineEnd = &pVram_dst[pRect->w];
-                while (pVram_dst < pLineEnd)
-                {
-                    const int vram_8bit_idx = *pTexture_8bit_src;
-                    if (pClutSrc[vram_8bit_idx])
-                    {
-                        const WORD clut_pixel = pClutSrc[vram_8bit_idx];
-
-                        const BYTE g_lut_idx = stru_C1D1C0[g >> 3].field_0[(clut_pixel >> 6) & 31];
-                        const BYTE r_lut_idx = stru_C1D1C0[r >> 3].field_0[(clut_pixel >> 11) & 31];
-                        const BYTE b_lut_idx = stru_C1D1C0[b >> 3].field_0[(clut_pixel) & 31];
-
-                        const WORD vram_pixel = *pVram_dst;
-                        *pVram_dst =
-                              pAbr_Lut->r[r_lut_idx][(vram_pixel >> 11) & 31]
-                            | pAbr_Lut->g[g_lut_idx][(vram_pixel >> 6) & 31]
-                            | pAbr_Lut->b[b_lut_idx][(vram_pixel) & 31];
-                    }
-                    pVram_dst++;
-                    pTexture_8bit_src++;
-                }
-                pVram_dst += vram_dst_remainder;
-                pTexture_8bit_src += texture_8bit_remainder;
-            }
-        }
-        else
-        {
-            while (pVram_dst < pVram_End)
-            {
-                WORD* pLineEnd = &pVram_dst[pRect->w];
-                while (pVram_dst < pLineEnd)
-                {
-                    const WORD vram_8bit_idx = *pTexture_8bit_src;
-                    const WORD clut_pixel = pClutSrc[vram_8bit_idx];
-                    if (clut_pixel)
-                    {
-                        *pVram_dst =
-                              stru_C146C0.b[b >> 3][clut_pixel & 31]
-                            | stru_C146C0.r[r >> 3][clut_pixel >> 11]
-                            | stru_C146C0.g[g >> 3][(clut_pixel >> 6) & 31];
-                    }
-                    pVram_dst++;
-                    pTexture_8bit_src++;
-                }
-                pTexture_8bit_src += texture_8bit_remainder;
-                pVram_dst += vram_dst_remainder;
-            }
-        }
+        // Modulated semi trans sprites blend every texel
+        mode = MakeSpanMode(true, bSemiTrans ? PsxSpanBlend::eAlways : PsxSpanBlend::eNone, stru_C1D1C0[r >> 3].field_0, stru_C1D1C0[g >> 3].field_0, stru_C1D1C0[b >> 3].field_0);
     }
-    else if (bSemiTrans)
+    else
     {
-        Psx_Test* pAbr_Lut = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
-        while (pVram_dst < pVram_End)
-        {
-            WORD* pLineEnd = &pVram_dst[pRect->w];
-            while (pVram_dst < pLineEnd)
-            {
-                const WORD vram_8bit_idx = *pTexture_8bit_src;
-                const WORD clut_pixel = pClutSrc[vram_8bit_idx];
-
-                if (clut_pixel)
-                {
-                    // Semi trans flag
-                    if (clut_pixel & 0x20) 
-                    {
-                        const BYTE r_lut_idx = (clut_pixel >> 11);
-                        const BYTE g_lut_idx = (((clut_pixel >> 6) & 31));
-                        const BYTE b_lut_idx = ((clut_pixel & 31));
-
-                        const WORD vram_pixel = *pVram_dst;
-                        *pVram_dst =
-                              pAbr_Lut->r[r_lut_idx][(vram_pixel >> 11)]
-                            | pAbr_Lut->g[g_lut_idx][((vram_pixel >> 6) & 31)]
-                            | pAbr_Lut->b[b_lut_idx][(vram_pixel & 31)];
-                    }
-                    else
-                    {
-                        *pVram_dst = clut_pixel;
-                    }
-                }
-                else
-                {
-                    // Pure black pixels skipped
-                }
-
-                pVram_dst++;
-                pTexture_8bit_src++;
-            }
-            pVram_dst += vram_dst_remainder;
-            pTexture_8bit_src += texture_8bit_remainder;
-        }
+        // Otherwise only the CLUT entries with the semi trans flag are blended
+        mode = MakeSpanMode(true, bSemiTrans ? PsxSpanBlend::eSemiTransFlag : PsxSpanBlend::eNone);
     }
-    else
+
+    while (pVram_dst < pVram_End)
     {
-        while (pVram_dst < pVram_End)
+        if (PSX_Band_Owns(pVram_dst))
         {
-            WORD* pLineEnd = &pVram_dst[pRect->w];
-            while (pVram_dst < pLineEnd)
+            const BYTE* pTexels = pTexture_8bit_src;
+            WriteTexturedSpan(pVram_dst, pRect->w, mode, [&]() -> WORD
             {
-                const WORD vram_8bit_idx = *pTexture_8bit_src;
-                if (pClutSrc[vram_8bit_idx])
-                {
-                    *pVram_dst = pClutSrc[vram_8bit_idx];
-                }
-                pTexture_8bit_src++;
-                pVram_dst++;
-            }
-            pTexture_8bit_src += texture_8bit_remainder;
-            pVram_dst += vram_dst_remainder;
+                return pClutSrc[*pTexels++];
+            });
         }
+        pTexture_8bit_src += 2048;
+        pVram_dst += pitch;
     }
 }
 
 EXPORT void CC PSX_EMU_Render_SPRT_16bit_51FA30(const PSX_RECT* pRect, int u, int v, unsigned __int8 r, unsigned __int8 g, unsigned __int8 b, int /*clut*/, char bSemiTrans)
 {
-    const int texture_row_width = (1 << tpage_width_57831C) - pRect->w;
+    const int texture_row_width = 1 << tpage_width_57831C;
     const unsigned int line_pitch = (unsigned int)spBitmap_C2D038->field_10_locked_pitch >> 1;
-    const unsigned int pitch_remainder = line_pitch - pRect->w;
 
     const WORD* pTexture_src = &sTPage_src_ptr_BD0F1C[u + (v << tpage_width_57831C)];// tpage_width_57831C = tpage width/bpp? becomes / 1024 ?
     WORD* pVram_start = reinterpret_cast<WORD*>(spBitmap_C2D038->field_4_pLockedPixels) + (pRect->x + (line_pitch * pRect->y));
-    WORD* pVram_end = &pVram_start[(pRect->w - 1) + line_pitch * (pRect->h - 1)];
-
-    if (!bSemiTrans && (r != 128 || g != 128 || b != 128))
-    {
-        while (pVram_start < pVram_end)
-        {
-            WORD* pLineEnd = &pVram_start[pRect->w];
-            while (pVram_start < pLineEnd)
-            {
-                const WORD texture_pixel = *pTexture_src;
-                if (texture_pixel)
-                {
-                    *pVram_start =
-                        stru_C146C0.r[r >> 3][(texture_pixel >> 11) & 31]
-                        | stru_C146C0.g[g >> 3][(texture_pixel >> 6) & 31]
-                        | stru_C146C0.b[b >> 3][(texture_pixel & 31)];
-                }
-                pTexture_src++;
-                pVram_start++;
-            }
-            pTexture_src += texture_row_width;
-            pVram_start += pitch_remainder;
-        }
-        return;
-    }
+    const WORD* pVram_end = &pVram_start[(pRect->w - 1) + line_pitch * (pRect->h - 1)];
 
-    if (bSemiTrans)
+    if (bSemiTrans || r != 128 || g != 128 || b != 128)
     {
-        const auto pAbr_lut = &sPsx_abr_lut_C215E0[sTexture_page_abr_BD0F18];
+        // Semi trans is always modulated (128 is a no-op) and blends every texel
+        const PsxSpanMode mode = MakeSpanMode(true, bSemiTrans ? PsxSpanBlend::eAlways : PsxSpanBlend::eNone, stru_C1D1C0[r >> 3].field_0, stru_C1D1C0[g >> 3].field_0, stru_C1D1C0[b >> 3].field_0);
         while (pVram_start < pVram_end)
         {
-            WORD* pLineEnd = &pVram_start[pRect->w];
-            while (pVram_start < pLineEnd)
+            if (PSX_Band_Owns(pVram_start))
             {
-                const WORD texture_pixel = *pTexture_src;
-                if (texture_pixel)
-                {
-                    const WORD vram_pixel = *pVram_start;
-
-                    const BYTE rLut = stru_C1D1C0[r >> 3].field_0[texture_pixel >> 11];
-                    const BYTE gLut = stru_C1D1C0[g >> 3].field_0[(texture_pixel >> 6) & 31];
-                    const BYTE bLut = stru_C1D1C0[b >> 3].field_0[texture_pixel & 31];
-
-                    *pVram_start =
-                        pAbr_lut->r[rLut][(vram_pixel >> 11)]
-                        | pAbr_lut->g[gLut][((vram_pixel >> 6) & 31)]
-                        | pAbr_lut->b[bLut][(vram_pixel & 31)];
-                }
-
-                pTexture_src++;
-                pVram_start++;
+                PSX_Span_Texels(pVram_start, pTexture_src, pRect->w, mode);
             }
-
-            pVram_start += pitch_remainder;
             pTexture_src += texture_row_width;
+            pVram_start += line_pitch;
         }
         return;
     }
 
-    const int widthBytes = pRect->w + pitch_remainder;
-    const int nextWriteOffset = widthBytes;
+    // Skip black pixels these become see through
     const bool ignoreBlackPixels = sActiveTPage_578318 >= 0;
+    const PsxSpanMode mode = MakeSpanMode(ignoreBlackPixels, PsxSpanBlend::eNone);
 
     // NOTE: Odd optimization case removed
     while (pVram_start < pVram_end)
     {
-        for (int i = 0; i < pRect->w; i++)
+        if (PSX_Band_Owns(pVram_start))
         {
-            // Skip black pixels these become see through
-            const bool writePixel = ignoreBlackPixels == false || pTexture_src[i];
-            if (writePixel)
-            {
-                pVram_start[i] = pTexture_src[i];
-            }
+            PSX_Span_Texels(pVram_start, pTexture_src, pRect->w, mode);
         }
-        pVram_start += nextWriteOffset;
-        pTexture_src += nextWriteOffset;
+
+        // NOTE: The texture is stepped by the frame buffer pitch, not its own width
+        pVram_start += line_pitch;
+        pTexture_src += line_pitch;
     }
 }
 
@@ -4032,7 +4161,7 @@ EXPORT void CC PSX_EMU_Render_SPRT_51EF90(__int16 x, __int16 y, int u, int v, BY
     }
 }
 
-ALIVE_ARY(1, 0xBD1D00, OT_Prim, 7, stru_BD1D00, {});
+ALIVE_ARY_TLS(1, 0xBD1D00, OT_Prim, 7, stru_BD1D00, {});
 
 static OT_Vert* GetVert(OT_Prim* prim, int idx)
 {
@@ -4564,8 +4693,171 @@ namespace Test
         ASSERT_EQ(0xFFFE0, PSX_poly_helper_fixed_point_scale_517FA0(0x7FFF0002, 32));
     }
     
+    // One of each kind of prim, spread over and across the bands.
+    struct BandTestPrims
+    {
+        Prim_PrimClipper mClipper;
+        Prim_SetTPage mTPage;
+        Poly_FT4 mFg1;
+        Prim_Sprt mSprite;
+        Prim_Tile mShadow;
+        Poly_G4 mGradient;
+        Poly_F3 mTriangle;
+        Line_F2 mLine;
+        Prim_Tile mFloor;
+        Prim_Tile mLedge;
+    };
+
+    static void AddBandTestPrims(PrimHeader** ppOt, int otSize, BandTestPrims& prims, const PSX_RECT& clip, const DWORD* pFg1Mask)
+    {
+        PSX_ClearOTag_4F6290(ppOt, otSize);
+
+        Init_PrimClipper_4F5B80(&prims.mClipper, &clip);
+        OrderingTable_Add_4F8AA0(&ppOt[0], &prims.mClipper.mBase);
+
+        // Not the tpage the sprite wants, the FG1 block leaves that one set
+        Init_SetTPage_4F5B60(&prims.mTPage, 0, 0, PSX_getTPage_4F60E0(TPageMode::e8Bit_1, TPageAbr::eBlend_0, 0, 0));
+        OrderingTable_Add_4F8AA0(&ppOt[1], &prims.mTPage.mBase);
+
+        // Only in the bottom band
+        PolyFT4_Init(&prims.mFg1);
+        SetXY0(&prims.mFg1, 100, 200);
+        SetXY1(&prims.mFg1, 116, 200);
+        SetXY2(&prims.mFg1, 100, 216);
+        SetXY3(&prims.mFg1, 116, 216);
+        SetTPage(&prims.mFg1, static_cast<short>(PSX_getTPage_4F60E0(TPageMode::e16Bit_2, TPageAbr::eBlend_0, 640, 0)));
+        SetPrimExtraPointerHack(&prims.mFg1, pFg1Mask);
+        OrderingTable_Add_4F8AA0(&ppOt[2], &prims.mFg1.mBase.header);
+
+        // Only in the top band
+        Sprt_Init_4F8910(&prims.mSprite);
+        SetXY0(&prims.mSprite, 20, 10);
+        SetUV0(&prims.mSprite, 0, 0);
+        SetRGB0(&prims.mSprite, 128, 128, 128);
+        prims.mSprite.field_14_w = 16;
+        prims.mSprite.field_16_h = 16;
+        OrderingTable_Add_4F8AA0(&ppOt[3], &prims.mSprite.mBase.header);
+
+        // Everything below spans more than one band
+        Init_Tile(&prims.mShadow);
+        SetXY0(&prims.mShadow, 10, 5);
+        SetRGB0(&prims.mShadow, 64, 32, 16);
+        prims.mShadow.field_14_w = 200;
+        prims.mShadow.field_16_h = 220;
+        Poly_Set_SemiTrans_4F8A60(&prims.mShadow.mBase.header, TRUE);
+        OrderingTable_Add_4F8AA0(&ppOt[4], &prims.mShadow.mBase.header);
+
+        PolyG4_Init_4F88B0(&prims.mGradient);
+        SetXY0(&prims.mGradient, 150, 40);
+        SetXY1(&prims.mGradient, 300, 40);
+        SetXY2(&prims.mGradient, 150, 180);
+        SetXY3(&prims.mGradient, 300, 180);
+        SetRGB0(&prims.mGradient, 255, 0, 0);
+        SetRGB1(&prims.mGradient, 0, 255, 0);
+        SetRGB2(&prims.mGradient, 0, 0, 255);
+        SetRGB3(&prims.mGradient, 255, 255, 255);
+        OrderingTable_Add_4F8AA0(&ppOt[5], &prims.mGradient.mBase.header);
+
+        PolyF3_Init(&prims.mTriangle);
+        SetXY0(&prims.mTriangle, 320, 20);
+        SetXY1(&prims.mTriangle, 250, 230);
+        SetXY2(&prims.mTriangle, 400, 150);
+        SetRGB0(&prims.mTriangle, 200, 100, 50);
+        OrderingTable_Add_4F8AA0(&ppOt[6], &prims.mTriangle.mBase.header);
+
+        Line_F2_Init(&prims.mLine);
+        SetXY0(&prims.mLine, 5, 5);
+        SetXY1(&prims.mLine, 600, 235);
+        SetRGB0(&prims.mLine, 255, 255, 0);
+        OrderingTable_Add_4F8AA0(&ppOt[7], &prims.mLine.mBase.header);
+
+        Init_Tile(&prims.mFloor);
+        SetXY0(&prims.mFloor, 0, 225);
+        SetRGB0(&prims.mFloor, 0, 128, 255);
+        prims.mFloor.field_14_w = 640;
+        prims.mFloor.field_16_h = 15;
+        OrderingTable_Add_4F8AA0(&ppOt[8], &prims.mFloor.mBase.header);
+
+        // Only just reaches in to the second band
+        Init_Tile(&prims.mLedge);
+        SetXY0(&prims.mLedge, 420, 50);
+        SetRGB0(&prims.mLedge, 255, 255, 255);
+        prims.mLedge.field_14_w = 100;
+        prims.mLedge.field_16_h = 12;
+        OrderingTable_Add_4F8AA0(&ppOt[9], &prims.mLedge.mBase.header);
+    }
+
+    static void Test_PSX_DrawOTag_Bands()
+    {
+        sPsxVram_C1D160.field_4_pLockedPixels = vramTest;
+        sPsxVram_C1D160.field_8_width = 1024;
+        sPsxVram_C1D160.field_C_height = 512;
+        sPsxVram_C1D160.field_10_locked_pitch = 2048;
+        spBitmap_C2D038 = &sPsxVram_C1D160;
+        PSX_EMU_SetDispType_4F9960(2);
+
+        const PSX_RECT clip = { 0, 0, 640, 240 };
+        DWORD fg1Mask[16] = {};
+        for (DWORD& row : fg1Mask)
+        {
+            row = 0x5AF0;
+        }
+
+        SoftwareRenderer renderer;
+        renderer.StartFrame(0, 0);
+
+        PrimHeader* ot[16] = {};
+        BandTestPrims prims = {};
+
+        // The sprite's texture and what the FG1 block copies
+        memset(vramTest, 0, sizeof(vramTest));
+        for (int y = 0; y < 512; y++)
+        {
+            for (int x = 0; x < 1024; x++)
+            {
+                if (x >= 640 || y >= 272)
+                {
+                    vramTest[y][x] = static_cast<WORD>((x * 31) ^ (y * 2047));
+                }
+            }
+        }
+
+        Prim_PrimClipper startClipper = {};
+        Init_PrimClipper_4F5B80(&startClipper, &clip);
+        renderer.SetClip(startClipper);
+        const PsxRasterState startState = CaptureRasterState();
+        const std::vector<WORD> startVram(&vramTest[0][0], &vramTest[0][0] + (512 * 1024));
+
+        AddBandTestPrims(ot, ALIVE_COUNTOF(ot), prims, clip, fg1Mask);
+        DrawOTDrawList(renderer, MakeOTDrawList(ot), false);
+        const std::vector<WORD> serialVram(&vramTest[0][0], &vramTest[0][0] + (512 * 1024));
+
+        // Something was drawn in each band
+        for (int band = 0; band < 4; band++)
+        {
+            const int y = (240 * band / 4) + 30;
+            ASSERT_NE(serialVram[(y * 1024) + 160], startVram[(y * 1024) + 160]);
+        }
+
+        std::copy(startVram.begin(), startVram.end(), &vramTest[0][0]);
+        ApplyRasterState(startState);
+
+        WorkerGroup workers(4);
+        AddBandTestPrims(ot, ALIVE_COUNTOF(ot), prims, clip, fg1Mask);
+        DrawOTagBands(workers, renderer, MakeOTDrawList(ot), 0);
+
+        for (int y = 0; y < 512; y++)
+        {
+            for (int x = 0; x < 1024; x++)
+            {
+                ASSERT_EQ(serialVram[(y * 1024) + x], vramTest[y][x]) << "at " << x << "," << y;
+            }
+        }
+    }
+
     void PsxRenderTests()
     {
+        Test_PSX_DrawOTag_Bands();
         Test_PSX_Rects_intersect_point_4FA100();
         Test_PSX_Render_Convert_Polys_To_Internal_Format_4F7110();
         Test_PSX_poly_FShaded_NoTexture_517DF0();
@@ -35,10 +35,15 @@ EXPORT void CC Add_Dirty_Area_4ED970(int x, int y, int w, int h);
 
 void Psx_Render_Float_Table_Init();
 
-ALIVE_VAR_EXTERN(int, sScreenXOffSet_BD30E4);
-ALIVE_VAR_EXTERN(int, sScreenYOffset_BD30A4);
+ALIVE_VAR_TLS_EXTERN(int, sScreenXOffSet_BD30E4);
+ALIVE_VAR_TLS_EXTERN(int, sScreenYOffset_BD30A4);
 
 ALIVE_VAR_EXTERN(DWORD, sSemiTransShift_C215C0);
 ALIVE_VAR_EXTERN(DWORD, sRedShift_C215C4);
 ALIVE_VAR_EXTERN(DWORD, sGreenShift_C1D180);
-ALIVE_VAR_EXTERN(DWORD, sBlueShift_C19140);
\ No newline at end of file
+ALIVE_VAR_EXTERN(DWORD, sBlueShift_C19140);
+
+struct Psx_Test;
+struct Psx_Data;
+ALIVE_ARY_EXTERN(Psx_Test, 4, sPsx_abr_lut_C215E0);
+ALIVE_ARY_EXTERN(Psx_Data, 32, stru_C1D1C0);
\ No newline at end of file
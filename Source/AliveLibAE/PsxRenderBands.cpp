@@ -0,0 +1,33 @@
+#include "stdafx.h"
+#include "PsxRenderBands.hpp"
+#include "Function.hpp"
+#include <memory>
+#include <algorithm>
+
+int gRenderBandThreads = 1;
+bool gRenderBandsCompare = false;
+
+WorkerGroup* PSX_Bands_GetWorkers()
+{
+    static std::unique_ptr<WorkerGroup> sWorkers;
+
+    // All the threads would share the game's copy of the rasterizer state
+    if (RunningAsInjectedDll() || gRenderBandThreads <= 1)
+    {
+        sWorkers.reset();
+        return nullptr;
+    }
+
+    const int bandCount = std::min(gRenderBandThreads, kMaxRenderBands);
+    if (!sWorkers || sWorkers->Count() != bandCount)
+    {
+        sWorkers.reset(new WorkerGroup(bandCount));
+    }
+    return sWorkers.get();
+}
+
+PsxBandStats& PSX_Bands_Stats()
+{
+    static PsxBandStats sStats;
+    return sStats;
+}
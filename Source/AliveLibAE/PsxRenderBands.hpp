@@ -0,0 +1,24 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "WorkerGroup.hpp"
+
+// Returns one worker per band for gRenderBandThreads, or nullptr when the OT should be drawn serially.
+WorkerGroup* PSX_Bands_GetWorkers();
+
+struct PsxBandStats
+{
+    unsigned int mComparedFrames = 0;
+    unsigned int mMismatchedFrames = 0;
+};
+
+PsxBandStats& PSX_Bands_Stats();
+
+// More bands than this just duplicates the per band work for little gain.
+const int kMaxRenderBands = 16;
+
+// Number of horizontal bands the frame buffer is split in to and drawn in parallel, 1 or less draws serially.
+extern int gRenderBandThreads;
+
+// When true each banded frame is drawn again serially and any pixel differences are logged.
+extern bool gRenderBandsCompare;
@@ -0,0 +1,221 @@
+#include "stdafx.h"
+#include "PsxRenderCommands.hpp"
+#include "Function.hpp"
+#include "Primitives.hpp"
+#include "PsxRender.hpp"
+#include <gmock/gmock.h>
+#include <random>
+
+bool gRenderCommandBuffer = false;
+
+void PsxRenderCommandBuffer::Reset(PrimHeader** ppOt, int layerCount)
+{
+    mpOt = ppOt;
+    mLayerCount = layerCount;
+    mCommands.clear();
+}
+
+PrimHeader** PsxRenderCommandBuffer::Ot() const
+{
+    return mpOt;
+}
+
+bool PsxRenderCommandBuffer::Contains(PrimHeader** ppOtLayer) const
+{
+    return ppOtLayer >= mpOt && ppOtLayer < mpOt + mLayerCount;
+}
+
+void PsxRenderCommandBuffer::Add(PrimHeader** ppOtLayer, PrimHeader* pPrim)
+{
+    PsxRenderCommand command = {};
+    command.mpPrim = pPrim;
+    command.mLayer = static_cast<WORD>(ppOtLayer - mpOt);
+    command.mCode = pPrim->rgb_code.code_or_pad;
+    mCommands.push_back(command);
+}
+
+const std::vector<PsxRenderCommand>& PsxRenderCommandBuffer::Sort()
+{
+    mLayerStarts.assign(mLayerCount + 1, 0);
+    for (const PsxRenderCommand& command : mCommands)
+    {
+        mLayerStarts[command.mLayer + 1]++;
+    }
+
+    for (int i = 0; i < mLayerCount; i++)
+    {
+        mLayerStarts[i + 1] += mLayerStarts[i];
+    }
+
+    // Going backwards puts the last prim added to each layer first
+    mSorted.resize(mCommands.size());
+    for (auto it = mCommands.rbegin(); it != mCommands.rend(); ++it)
+    {
+        mSorted[mLayerStarts[it->mLayer]++] = *it;
+    }
+    return mSorted;
+}
+
+size_t PsxRenderCommandBuffer::Size() const
+{
+    return mCommands.size();
+}
+
+// The two display buffers and the loading screen's OT are all there ever are
+static PsxRenderCommandBuffer sCommandBuffers[8];
+static bool sCommandBufferUsed[ALIVE_COUNTOF(sCommandBuffers)] = {};
+static int sLastCommandBuffer = 0;
+
+void PSX_Commands_OnClearOTag(PrimHeader** ppOt, int layerCount)
+{
+    // Anything left over from an OT that used to be at or overlap this memory is stale now
+    int freeIdx = -1;
+    for (int i = 0; i < ALIVE_COUNTOF(sCommandBuffers); i++)
+    {
+        if (sCommandBufferUsed[i])
+        {
+            PrimHeader** ppOther = sCommandBuffers[i].Ot();
+            if (sCommandBuffers[i].Contains(ppOt) || (ppOther >= ppOt && ppOther < ppOt + layerCount))
+            {
+                sCommandBufferUsed[i] = false;
+            }
+        }
+
+        if (!sCommandBufferUsed[i] && freeIdx == -1)
+        {
+            freeIdx = i;
+        }
+    }
+
+    if (!gRenderCommandBuffer)
+    {
+        return;
+    }
+
+    if (freeIdx == -1)
+    {
+        LOG_WARNING("No free render command buffer, OT will use its linked list");
+        return;
+    }
+
+    sCommandBuffers[freeIdx].Reset(ppOt, layerCount);
+    sCommandBufferUsed[freeIdx] = true;
+    sLastCommandBuffer = freeIdx;
+}
+
+bool PSX_Commands_Add(PrimHeader** ppOtLayer, PrimHeader* pItem)
+{
+    if (sCommandBufferUsed[sLastCommandBuffer] && sCommandBuffers[sLastCommandBuffer].Contains(ppOtLayer))
+    {
+        sCommandBuffers[sLastCommandBuffer].Add(ppOtLayer, pItem);
+        return true;
+    }
+
+    for (int i = 0; i < ALIVE_COUNTOF(sCommandBuffers); i++)
+    {
+        if (sCommandBufferUsed[i] && sCommandBuffers[i].Contains(ppOtLayer))
+        {
+            sLastCommandBuffer = i;
+            sCommandBuffers[i].Add(ppOtLayer, pItem);
+            return true;
+        }
+    }
+    return false;
+}
+
+PsxRenderCommandBuffer* PSX_Commands_Find(PrimHeader** ppOt)
+{
+    for (int i = 0; i < ALIVE_COUNTOF(sCommandBuffers); i++)
+    {
+        if (sCommandBufferUsed[i] && sCommandBuffers[i].Ot() == ppOt)
+        {
+            return &sCommandBuffers[i];
+        }
+    }
+    return nullptr;
+}
+
+namespace Test
+{
+    // The prims in the order DrawOTagItems walks them
+    static std::vector<PrimHeader*> WalkOt(PrimHeader** ppOt, int layerCount)
+    {
+        std::vector<PrimHeader*> prims;
+        PrimHeader* pItem = ppOt[0];
+        while (pItem != reinterpret_cast<PrimHeader*>(static_cast<size_t>(0xFFFFFFFF)))
+        {
+            const bool bRoot = reinterpret_cast<PrimHeader**>(pItem) >= ppOt && reinterpret_cast<PrimHeader**>(pItem) < ppOt + layerCount;
+            if (!bRoot)
+            {
+                prims.push_back(pItem);
+            }
+            pItem = pItem->tag;
+        }
+        return prims;
+    }
+
+    static void PsxRenderCommands_SameOrderAsOt_Test()
+    {
+        const bool oldEnabled = gRenderCommandBuffer;
+
+        const int kLayers = 43;
+        PrimHeader* ot[kLayers] = {};
+        std::vector<Poly_F4> polys(500);
+
+        std::mt19937 rng(20);
+        std::vector<int> layers(polys.size());
+        for (int& layer : layers)
+        {
+            // Bunch them up in a few layers so each layer gets plenty
+            layer = (rng() % 2) ? static_cast<int>(rng() % 4) : static_cast<int>(rng() % kLayers);
+        }
+
+        gRenderCommandBuffer = false;
+        PSX_ClearOTag_4F6290(ot, kLayers);
+        ASSERT_EQ(nullptr, PSX_Commands_Find(ot));
+        for (size_t i = 0; i < polys.size(); i++)
+        {
+            PolyF4_Init_4F8830(&polys[i]);
+            OrderingTable_Add_4F8AA0(&ot[layers[i]], &polys[i].mBase.header);
+        }
+        const std::vector<PrimHeader*> expected = WalkOt(ot, kLayers);
+        ASSERT_EQ(polys.size(), expected.size());
+
+        gRenderCommandBuffer = true;
+        PSX_ClearOTag_4F6290(ot, kLayers);
+        for (size_t i = 0; i < polys.size(); i++)
+        {
+            OrderingTable_Add_4F8AA0(&ot[layers[i]], &polys[i].mBase.header);
+        }
+
+        // Nothing went in to the linked list
+        ASSERT_TRUE(WalkOt(ot, kLayers).empty());
+
+        PsxRenderCommandBuffer* pCommands = PSX_Commands_Find(ot);
+        ASSERT_NE(nullptr, pCommands);
+        ASSERT_EQ(polys.size(), pCommands->Size());
+
+        const std::vector<PsxRenderCommand>& sorted = pCommands->Sort();
+        ASSERT_EQ(expected.size(), sorted.size());
+        for (size_t i = 0; i < sorted.size(); i++)
+        {
+            ASSERT_EQ(expected[i], sorted[i].mpPrim);
+            ASSERT_EQ(expected[i]->rgb_code.code_or_pad, sorted[i].mCode);
+        }
+
+        // Clearing again empties it and turning it off goes back to the linked list
+        PSX_ClearOTag_4F6290(ot, kLayers);
+        ASSERT_EQ(0u, PSX_Commands_Find(ot)->Size());
+
+        gRenderCommandBuffer = false;
+        PSX_ClearOTag_4F6290(ot, kLayers);
+        ASSERT_EQ(nullptr, PSX_Commands_Find(ot));
+
+        gRenderCommandBuffer = oldEnabled;
+    }
+
+    void PsxRenderCommandsTests()
+    {
+        PsxRenderCommands_SameOrderAsOt_Test();
+    }
+}
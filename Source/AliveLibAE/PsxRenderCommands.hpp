@@ -0,0 +1,58 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include <vector>
+
+struct PrimHeader;
+
+namespace Test
+{
+    void PsxRenderCommandsTests();
+}
+
+// One OrderingTable_Add_4F8AA0 call.
+struct PsxRenderCommand
+{
+    PrimHeader* mpPrim;
+    WORD mLayer;
+    BYTE mCode; // rgb_code.code_or_pad when the prim was added
+};
+
+// Stands in for the linked list of an OT. Adds go in to a flat array that is sorted by layer once when the OT is
+// drawn, so drawing is a walk over one array instead of chasing tag pointers through every object's prims. The
+// order is the same as the linked list: layer 0 first and the last prim added to a layer comes first.
+class PsxRenderCommandBuffer
+{
+public:
+    void Reset(PrimHeader** ppOt, int layerCount);
+
+    PrimHeader** Ot() const;
+    bool Contains(PrimHeader** ppOtLayer) const;
+
+    void Add(PrimHeader** ppOtLayer, PrimHeader* pPrim);
+
+    // Counting sort by layer, which is a radix sort with a single digit as there are only ever a few dozen layers.
+    const std::vector<PsxRenderCommand>& Sort();
+
+    size_t Size() const;
+
+private:
+    PrimHeader** mpOt = nullptr;
+    int mLayerCount = 0;
+    std::vector<PsxRenderCommand> mCommands;
+    std::vector<PsxRenderCommand> mSorted;
+    std::vector<int> mLayerStarts;
+};
+
+// Called by PSX_ClearOTag_4F6290, gives the OT an empty command buffer when gRenderCommandBuffer is on.
+void PSX_Commands_OnClearOTag(PrimHeader** ppOt, int layerCount);
+
+// Returns true if pItem went in to a command buffer, else it should be linked in to the OT.
+bool PSX_Commands_Add(PrimHeader** ppOtLayer, PrimHeader* pItem);
+
+// The command buffer of an OT or nullptr if its prims are in the linked list. Drawing doesn't empty it, the same
+// as drawing doesn't unlink anything from an OT.
+PsxRenderCommandBuffer* PSX_Commands_Find(PrimHeader** ppOt);
+
+// Draw from sorted command buffers instead of walking the OT linked list.
+extern bool gRenderCommandBuffer;
@@ -0,0 +1,672 @@
+#include "stdafx.h"
+#include "PsxRenderSpans.hpp"
+#include "PsxRender.hpp"
+#include "Function.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <random>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    #define PSX_SPAN_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        // MSVC allows any intrinsic without changing the target arch
+        #define PSX_SPAN_TARGET_SSE2
+        #define PSX_SPAN_TARGET_AVX2
+    #else
+        #define PSX_SPAN_TARGET_SSE2 __attribute__((target("sse2")))
+        #define PSX_SPAN_TARGET_AVX2 __attribute__((target("avx2")))
+    #endif
+#else
+    #define PSX_SPAN_X86 0
+#endif
+
+bool gRenderSimdEnabled = true;
+
+// Texels are staged on the stack in chunks of this size by the callers that have to build them first
+const int kSpanChunkSize = 64;
+
+static inline bool Span_ShouldBlend(const PsxSpanMode& mode, WORD texel)
+{
+    return mode.mBlend == PsxSpanBlend::eAlways || (mode.mBlend == PsxSpanBlend::eSemiTransFlag && (texel & 0x20));
+}
+
+// The reference implementation, this is what the original per pixel loops did.
+static void Span_Texels_Scalar(WORD* pDst, const WORD* pTexels, int count, const PsxSpanMode& mode)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const WORD texel = pTexels[i];
+        if (mode.mSkipBlack && !texel)
+        {
+            continue;
+        }
+
+        int r = (texel >> 11) & 0x1F;
+        int g = (texel >> 6) & 0x1F;
+        int b = texel & 0x1F;
+
+        WORD pixel = texel;
+        if (mode.mpModulate[0])
+        {
+            r = mode.mpModulate[0][r];
+            g = mode.mpModulate[1][g];
+            b = mode.mpModulate[2][b];
+            pixel = static_cast<WORD>((r << 11) | (g << 6) | b);
+        }
+
+        if (Span_ShouldBlend(mode, texel))
+        {
+            const WORD vram_pixel = pDst[i];
+            pixel = static_cast<WORD>(
+                  mode.mpAbrLut->r[r][(vram_pixel >> 11) & 0x1F]
+                | mode.mpAbrLut->g[g][(vram_pixel >> 6) & 0x1F]
+                | mode.mpAbrLut->b[b][vram_pixel & 0x1F]);
+        }
+
+        pDst[i] = pixel;
+    }
+}
+
+static void Span_Gouraud_Scalar(WORD* pDst, int r, int g, int b, int rStep, int gStep, int bStep, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        pDst[i] = static_cast<WORD>(((b >> 16) & 0x1F) | ((g >> 10) & 0x7C0) | ((r >> 5) & 0xF800));
+        r += rStep;
+        g += gStep;
+        b += bStep;
+    }
+}
+
+static void Span_Clut4_Scalar(WORD* pDst, const BYTE* pNibbles, const WORD* pClut, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const BYTE nibbles = pNibbles[i / 2];
+        pDst[i] = pClut[(i & 1) ? (nibbles >> 4) : (nibbles & 0xF)];
+    }
+}
+
+#if PSX_SPAN_X86
+// The PSX blend modes on 5bit components:
+// 0 = 0.5xB + 0.5xF, 1 = 1.0xB + 1.0xF, 2 = 1.0xB - 1.0xF, 3 = 1.0xB + 0.25xF
+PSX_SPAN_TARGET_SSE2 static inline __m128i BlendChannel_SSE2(DWORD abr, __m128i fg, __m128i bg)
+{
+    const __m128i k31 = _mm_set1_epi16(31);
+    switch (abr)
+    {
+    case 0:
+        return _mm_srli_epi16(_mm_add_epi16(fg, bg), 1);
+    case 1:
+        return _mm_min_epi16(_mm_add_epi16(fg, bg), k31);
+    case 2:
+        return _mm_max_epi16(_mm_sub_epi16(bg, fg), _mm_setzero_si128());
+    default:
+        return _mm_min_epi16(_mm_add_epi16(bg, _mm_srli_epi16(fg, 2)), k31);
+    }
+}
+
+PSX_SPAN_TARGET_SSE2 static inline __m128i Select_SSE2(__m128i mask, __m128i ifSet, __m128i ifClear)
+{
+    return _mm_or_si128(_mm_and_si128(mask, ifSet), _mm_andnot_si128(mask, ifClear));
+}
+
+PSX_SPAN_TARGET_SSE2 static void Span_Texels_SSE2(WORD* pDst, const WORD* pTexels, int count, const PsxSpanMode& mode)
+{
+    const __m128i k31 = _mm_set1_epi16(31);
+    const __m128i kSemiTransFlag = _mm_set1_epi16(0x20);
+    const __m128i kZero = _mm_setzero_si128();
+
+    const bool modulate = mode.mpModulate[0] != nullptr;
+    const __m128i modR = _mm_set1_epi16(modulate ? static_cast<short>(mode.mpModulate[0][16]) : 0);
+    const __m128i modG = _mm_set1_epi16(modulate ? static_cast<short>(mode.mpModulate[1][16]) : 0);
+    const __m128i modB = _mm_set1_epi16(modulate ? static_cast<short>(mode.mpModulate[2][16]) : 0);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i texel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pTexels[i]));
+        const __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pDst[i]));
+
+        __m128i r = _mm_srli_epi16(texel, 11);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(texel, 6), k31);
+        __m128i b = _mm_and_si128(texel, k31);
+
+        __m128i pixel = texel;
+        if (modulate)
+        {
+            // min(texel * colour / 16, 31), the same thing stru_C1D1C0 holds
+            r = _mm_min_epi16(_mm_srli_epi16(_mm_mullo_epi16(r, modR), 4), k31);
+            g = _mm_min_epi16(_mm_srli_epi16(_mm_mullo_epi16(g, modG), 4), k31);
+            b = _mm_min_epi16(_mm_srli_epi16(_mm_mullo_epi16(b, modB), 4), k31);
+            pixel = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 6)), b);
+        }
+
+        if (mode.mBlend != PsxSpanBlend::eNone)
+        {
+            const __m128i bgR = _mm_srli_epi16(dst, 11);
+            const __m128i bgG = _mm_and_si128(_mm_srli_epi16(dst, 6), k31);
+            const __m128i bgB = _mm_and_si128(dst, k31);
+
+            const __m128i blended = _mm_or_si128(
+                _mm_or_si128(_mm_slli_epi16(BlendChannel_SSE2(mode.mAbr, r, bgR), 11), _mm_slli_epi16(BlendChannel_SSE2(mode.mAbr, g, bgG), 6)),
+                BlendChannel_SSE2(mode.mAbr, b, bgB));
+
+            if (mode.mBlend == PsxSpanBlend::eAlways)
+            {
+                pixel = blended;
+            }
+            else
+            {
+                pixel = Select_SSE2(_mm_cmpeq_epi16(_mm_and_si128(texel, kSemiTransFlag), kSemiTransFlag), blended, pixel);
+            }
+        }
+
+        if (mode.mSkipBlack)
+        {
+            pixel = Select_SSE2(_mm_cmpeq_epi16(texel, kZero), dst, pixel);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i]), pixel);
+    }
+
+    Span_Texels_Scalar(pDst + i, pTexels + i, count - i, mode);
+}
+
+PSX_SPAN_TARGET_SSE2 static inline __m128i Gouraud_Pack_SSE2(__m128i r, __m128i g, __m128i b)
+{
+    // Only bits 16-20 of each channel are used so logical shifts give the same result as the scalar arithmetic ones
+    const __m128i pixel = _mm_or_si128(_mm_or_si128(
+        _mm_and_si128(_mm_srli_epi32(b, 16), _mm_set1_epi32(0x1F)),
+        _mm_and_si128(_mm_srli_epi32(g, 10), _mm_set1_epi32(0x7C0))),
+        _mm_and_si128(_mm_srli_epi32(r, 5), _mm_set1_epi32(0xF800)));
+
+    // Bias into the signed range so the saturating pack can't clamp
+    return _mm_sub_epi32(pixel, _mm_set1_epi32(0x8000));
+}
+
+PSX_SPAN_TARGET_SSE2 static void Span_Gouraud_SSE2(WORD* pDst, int r, int g, int b, int rStep, int gStep, int bStep, int count)
+{
+    const unsigned int ur = r;
+    const unsigned int ug = g;
+    const unsigned int ub = b;
+    const unsigned int urStep = rStep;
+    const unsigned int ugStep = gStep;
+    const unsigned int ubStep = bStep;
+
+    // Lanes hold pixel 0-3, the second set 4-7
+    __m128i vr = _mm_setr_epi32(static_cast<int>(ur), static_cast<int>(ur + urStep), static_cast<int>(ur + urStep * 2), static_cast<int>(ur + urStep * 3));
+    __m128i vg = _mm_setr_epi32(static_cast<int>(ug), static_cast<int>(ug + ugStep), static_cast<int>(ug + ugStep * 2), static_cast<int>(ug + ugStep * 3));
+    __m128i vb = _mm_setr_epi32(static_cast<int>(ub), static_cast<int>(ub + ubStep), static_cast<int>(ub + ubStep * 2), static_cast<int>(ub + ubStep * 3));
+
+    const __m128i step4R = _mm_set1_epi32(static_cast<int>(urStep * 4));
+    const __m128i step4G = _mm_set1_epi32(static_cast<int>(ugStep * 4));
+    const __m128i step4B = _mm_set1_epi32(static_cast<int>(ubStep * 4));
+    const __m128i kBias = _mm_set1_epi16(static_cast<short>(0x8000));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i lo = Gouraud_Pack_SSE2(vr, vg, vb);
+        vr = _mm_add_epi32(vr, step4R);
+        vg = _mm_add_epi32(vg, step4G);
+        vb = _mm_add_epi32(vb, step4B);
+
+        const __m128i hi = Gouraud_Pack_SSE2(vr, vg, vb);
+        vr = _mm_add_epi32(vr, step4R);
+        vg = _mm_add_epi32(vg, step4G);
+        vb = _mm_add_epi32(vb, step4B);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i]), _mm_add_epi16(_mm_packs_epi32(lo, hi), kBias));
+    }
+
+    const unsigned int done = static_cast<unsigned int>(i);
+    Span_Gouraud_Scalar(pDst + i,
+        static_cast<int>(ur + urStep * done),
+        static_cast<int>(ug + ugStep * done),
+        static_cast<int>(ub + ubStep * done),
+        rStep, gStep, bStep, count - i);
+}
+
+PSX_SPAN_TARGET_AVX2 static inline __m256i BlendChannel_AVX2(DWORD abr, __m256i fg, __m256i bg)
+{
+    const __m256i k31 = _mm256_set1_epi16(31);
+    switch (abr)
+    {
+    case 0:
+        return _mm256_srli_epi16(_mm256_add_epi16(fg, bg), 1);
+    case 1:
+        return _mm256_min_epi16(_mm256_add_epi16(fg, bg), k31);
+    case 2:
+        return _mm256_max_epi16(_mm256_sub_epi16(bg, fg), _mm256_setzero_si256());
+    default:
+        return _mm256_min_epi16(_mm256_add_epi16(bg, _mm256_srli_epi16(fg, 2)), k31);
+    }
+}
+
+PSX_SPAN_TARGET_AVX2 static void Span_Texels_AVX2(WORD* pDst, const WORD* pTexels, int count, const PsxSpanMode& mode)
+{
+    const __m256i k31 = _mm256_set1_epi16(31);
+    const __m256i kSemiTransFlag = _mm256_set1_epi16(0x20);
+    const __m256i kZero = _mm256_setzero_si256();
+
+    const bool modulate = mode.mpModulate[0] != nullptr;
+    const __m256i modR = _mm256_set1_epi16(modulate ? static_cast<short>(mode.mpModulate[0][16]) : 0);
+    const __m256i modG = _mm256_set1_epi16(modulate ? static_cast<short>(mode.mpModulate[1][16]) : 0);
+    const __m256i modB = _mm256_set1_epi16(modulate ? static_cast<short>(mode.mpModulate[2][16]) : 0);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m256i texel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pTexels[i]));
+        const __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&pDst[i]));
+
+        __m256i r = _mm256_srli_epi16(texel, 11);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi16(texel, 6), k31);
+        __m256i b = _mm256_and_si256(texel, k31);
+
+        __m256i pixel = texel;
+        if (modulate)
+        {
+            r = _mm256_min_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(r, modR), 4), k31);
+            g = _mm256_min_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(g, modG), 4), k31);
+            b = _mm256_min_epi16(_mm256_srli_epi16(_mm256_mullo_epi16(b, modB), 4), k31);
+            pixel = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 6)), b);
+        }
+
+        if (mode.mBlend != PsxSpanBlend::eNone)
+        {
+            const __m256i bgR = _mm256_srli_epi16(dst, 11);
+            const __m256i bgG = _mm256_and_si256(_mm256_srli_epi16(dst, 6), k31);
+            const __m256i bgB = _mm256_and_si256(dst, k31);
+
+            const __m256i blended = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi16(BlendChannel_AVX2(mode.mAbr, r, bgR), 11), _mm256_slli_epi16(BlendChannel_AVX2(mode.mAbr, g, bgG), 6)),
+                BlendChannel_AVX2(mode.mAbr, b, bgB));
+
+            if (mode.mBlend == PsxSpanBlend::eAlways)
+            {
+                pixel = blended;
+            }
+            else
+            {
+                pixel = _mm256_blendv_epi8(pixel, blended, _mm256_cmpeq_epi16(_mm256_and_si256(texel, kSemiTransFlag), kSemiTransFlag));
+            }
+        }
+
+        if (mode.mSkipBlack)
+        {
+            pixel = _mm256_blendv_epi8(pixel, dst, _mm256_cmpeq_epi16(texel, kZero));
+        }
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&pDst[i]), pixel);
+    }
+
+    Span_Texels_SSE2(pDst + i, pTexels + i, count - i, mode);
+}
+
+PSX_SPAN_TARGET_AVX2 static void Span_Clut4_AVX2(WORD* pDst, const BYTE* pNibbles, const WORD* pClut, int count)
+{
+    // The 16 entry CLUT fits in a register when split into its low and high bytes, so the lookup is a pair of byte shuffles
+    const __m128i clut0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pClut[0]));
+    const __m128i clut1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pClut[8]));
+    const __m128i kEvenBytes = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i kOddBytes = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i clutLo = _mm_unpacklo_epi64(_mm_shuffle_epi8(clut0, kEvenBytes), _mm_shuffle_epi8(clut1, kEvenBytes));
+    const __m128i clutHi = _mm_unpacklo_epi64(_mm_shuffle_epi8(clut0, kOddBytes), _mm_shuffle_epi8(clut1, kOddBytes));
+    const __m128i kNibbleMask = _mm_set1_epi8(0xF);
+
+    int i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&pNibbles[i / 2]));
+
+        // Low nibble is the first pixel
+        const __m128i idx = _mm_unpacklo_epi8(_mm_and_si128(packed, kNibbleMask), _mm_and_si128(_mm_srli_epi16(packed, 4), kNibbleMask));
+        const __m128i lo = _mm_shuffle_epi8(clutLo, idx);
+        const __m128i hi = _mm_shuffle_epi8(clutHi, idx);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i]), _mm_unpacklo_epi8(lo, hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDst[i + 8]), _mm_unpackhi_epi8(lo, hi));
+    }
+
+    Span_Clut4_Scalar(pDst + i, pNibbles + (i / 2), pClut, count - i);
+}
+#endif
+
+struct PsxSpanKernels
+{
+    PsxSimdLevel mLevel;
+    void(*mTexels)(WORD* pDst, const WORD* pTexels, int count, const PsxSpanMode& mode);
+    void(*mGouraud)(WORD* pDst, int r, int g, int b, int rStep, int gStep, int bStep, int count);
+    void(*mClut4)(WORD* pDst, const BYTE* pNibbles, const WORD* pClut, int count);
+};
+
+static const PsxSpanKernels kSpanKernelsScalar = { PsxSimdLevel::eScalar, Span_Texels_Scalar, Span_Gouraud_Scalar, Span_Clut4_Scalar };
+#if PSX_SPAN_X86
+static const PsxSpanKernels kSpanKernelsSSE2 = { PsxSimdLevel::eSSE2, Span_Texels_SSE2, Span_Gouraud_SSE2, Span_Clut4_Scalar };
+static const PsxSpanKernels kSpanKernelsAVX2 = { PsxSimdLevel::eAVX2, Span_Texels_AVX2, Span_Gouraud_SSE2, Span_Clut4_AVX2 };
+#endif
+
+static const PsxSpanKernels* sSpanKernels = nullptr;
+
+static const PsxSpanKernels& Span_Kernels()
+{
+    if (!sSpanKernels)
+    {
+        // Deferred to the first span as the ini isn't loaded yet when the display type is set
+        PSX_Span_SetSimdLevel(gRenderSimdEnabled ? PSX_Span_DetectSimdLevel() : PsxSimdLevel::eScalar);
+    }
+    return *sSpanKernels;
+}
+
+PsxSimdLevel PSX_Span_DetectSimdLevel()
+{
+#if PSX_SPAN_X86
+    #if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool hasSSE2 = (info[3] & (1 << 26)) != 0;
+    const bool hasAVX = (info[2] & (1 << 28)) != 0;
+    const bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+
+    bool hasAVX2 = false;
+    // AVX needs the OS to save the YMM registers on a context switch as well as CPU support
+    if (maxLeaf >= 7 && hasAVX && hasOSXSAVE && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuidex(info, 7, 0);
+        hasAVX2 = (info[1] & (1 << 5)) != 0;
+    }
+    #else
+    __builtin_cpu_init();
+    const bool hasSSE2 = __builtin_cpu_supports("sse2") != 0;
+    const bool hasAVX2 = __builtin_cpu_supports("avx2") != 0;
+    #endif
+
+    if (hasAVX2)
+    {
+        return PsxSimdLevel::eAVX2;
+    }
+
+    if (hasSSE2)
+    {
+        return PsxSimdLevel::eSSE2;
+    }
+#endif
+    return PsxSimdLevel::eScalar;
+}
+
+PsxSimdLevel PSX_Span_SetSimdLevel(PsxSimdLevel level)
+{
+    const PsxSimdLevel supported = PSX_Span_DetectSimdLevel();
+    if (static_cast<int>(level) > static_cast<int>(supported))
+    {
+        level = supported;
+    }
+
+    switch (level)
+    {
+#if PSX_SPAN_X86
+    case PsxSimdLevel::eAVX2:
+        sSpanKernels = &kSpanKernelsAVX2;
+        break;
+
+    case PsxSimdLevel::eSSE2:
+        sSpanKernels = &kSpanKernelsSSE2;
+        break;
+#endif
+
+    default:
+        sSpanKernels = &kSpanKernelsScalar;
+        break;
+    }
+
+    return sSpanKernels->mLevel;
+}
+
+PsxSimdLevel PSX_Span_GetSimdLevel()
+{
+    return Span_Kernels().mLevel;
+}
+
+void PSX_Span_Texels(WORD* pDst, const WORD* pTexels, int count, const PsxSpanMode& mode)
+{
+    if (count > 0)
+    {
+        Span_Kernels().mTexels(pDst, pTexels, count, mode);
+    }
+}
+
+void PSX_Span_Solid(WORD* pDst, WORD colour, int count, const PsxSpanMode& mode)
+{
+    if (count <= 0 || (mode.mSkipBlack && !colour))
+    {
+        return;
+    }
+
+    if (mode.mBlend == PsxSpanBlend::eNone && !mode.mpModulate[0])
+    {
+        std::fill_n(pDst, count, colour);
+        return;
+    }
+
+    WORD colours[kSpanChunkSize];
+    std::fill_n(colours, std::min(count, kSpanChunkSize), colour);
+
+    const PsxSpanKernels& kernels = Span_Kernels();
+    while (count > 0)
+    {
+        const int chunk = std::min(count, kSpanChunkSize);
+        kernels.mTexels(pDst, colours, chunk, mode);
+        pDst += chunk;
+        count -= chunk;
+    }
+}
+
+void PSX_Span_Gouraud(WORD* pDst, int r, int g, int b, int rStep, int gStep, int bStep, int count)
+{
+    if (count > 0)
+    {
+        Span_Kernels().mGouraud(pDst, r, g, b, rStep, gStep, bStep, count);
+    }
+}
+
+void PSX_Span_Clut4(WORD* pDst, const BYTE* pNibbles, const WORD* pClut, int count)
+{
+    if (count > 0)
+    {
+        Span_Kernels().mClut4(pDst, pNibbles, pClut, count);
+    }
+}
+
+namespace Test
+{
+    static PsxSpanMode MakeMode(bool skipBlack, PsxSpanBlend blend, DWORD abr, int modulateColour)
+    {
+        PsxSpanMode mode;
+        mode.mSkipBlack = skipBlack;
+        mode.mBlend = blend;
+        mode.mAbr = abr;
+        mode.mpAbrLut = &sPsx_abr_lut_C215E0[abr];
+        if (modulateColour >= 0)
+        {
+            mode.mpModulate[0] = stru_C1D1C0[modulateColour].field_0;
+            mode.mpModulate[1] = stru_C1D1C0[(modulateColour + 11) & 31].field_0;
+            mode.mpModulate[2] = stru_C1D1C0[(modulateColour + 23) & 31].field_0;
+        }
+        return mode;
+    }
+
+    static void Test_Span_Texels(PsxSimdLevel level)
+    {
+        std::mt19937 rng(1234);
+
+        // All possible texels with a random background, odd sized so the scalar tail gets used too
+        const int kCount = 65536 + 13;
+        std::vector<WORD> texels(kCount);
+        std::vector<WORD> background(kCount);
+        for (int i = 0; i < kCount; i++)
+        {
+            texels[i] = static_cast<WORD>(i);
+            background[i] = static_cast<WORD>(rng());
+        }
+        std::shuffle(texels.begin(), texels.end(), rng);
+
+        std::vector<WORD> expected(kCount);
+        std::vector<WORD> actual(kCount);
+
+        const PsxSpanBlend blendModes[] = { PsxSpanBlend::eNone, PsxSpanBlend::eSemiTransFlag, PsxSpanBlend::eAlways };
+        const int modulateColours[] = { -1, 16, 3, 31 };
+
+        for (DWORD abr = 0; abr < 4; abr++)
+        {
+            for (PsxSpanBlend blend : blendModes)
+            {
+                for (int modulateColour : modulateColours)
+                {
+                    for (int skipBlack = 0; skipBlack < 2; skipBlack++)
+                    {
+                        const PsxSpanMode mode = MakeMode(skipBlack != 0, blend, abr, modulateColour);
+
+                        expected = background;
+                        PSX_Span_SetSimdLevel(PsxSimdLevel::eScalar);
+                        PSX_Span_Texels(expected.data(), texels.data(), kCount, mode);
+
+                        actual = background;
+                        PSX_Span_SetSimdLevel(level);
+                        PSX_Span_Texels(actual.data(), texels.data(), kCount, mode);
+
+                        ASSERT_EQ(expected, actual);
+
+                        // Unaligned and short runs
+                        for (int offset = 0; offset < 3; offset++)
+                        {
+                            for (int count = 0; count < 40; count++)
+                            {
+                                expected = background;
+                                PSX_Span_SetSimdLevel(PsxSimdLevel::eScalar);
+                                PSX_Span_Texels(expected.data() + offset, texels.data() + count, count, mode);
+
+                                actual = background;
+                                PSX_Span_SetSimdLevel(level);
+                                PSX_Span_Texels(actual.data() + offset, texels.data() + count, count, mode);
+
+                                ASSERT_EQ(expected, actual);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    static void Test_Span_Solid(PsxSimdLevel level)
+    {
+        const WORD colours[] = { 0x0000, 0x0020, 0xFFFF, 0x7C1F, 0x8421 };
+        for (WORD colour : colours)
+        {
+            for (DWORD abr = 0; abr < 4; abr++)
+            {
+                const PsxSpanMode mode = MakeMode(false, PsxSpanBlend::eAlways, abr, -1);
+
+                std::vector<WORD> expected(150);
+                std::vector<WORD> actual(150);
+                for (size_t i = 0; i < expected.size(); i++)
+                {
+                    expected[i] = static_cast<WORD>(i * 0x1357);
+                }
+                actual = expected;
+
+                PSX_Span_SetSimdLevel(PsxSimdLevel::eScalar);
+                PSX_Span_Solid(expected.data(), colour, 149, mode);
+
+                PSX_Span_SetSimdLevel(level);
+                PSX_Span_Solid(actual.data(), colour, 149, mode);
+
+                ASSERT_EQ(expected, actual);
+            }
+        }
+    }
+
+    static void Test_Span_Gouraud(PsxSimdLevel level)
+    {
+        std::mt19937 rng(5678);
+        for (int i = 0; i < 500; i++)
+        {
+            const int count = static_cast<int>(rng() % 100);
+            const int r = static_cast<int>(rng());
+            const int g = static_cast<int>(rng());
+            const int b = static_cast<int>(rng());
+            const int rStep = static_cast<int>(rng()) >> (rng() % 24);
+            const int gStep = static_cast<int>(rng()) >> (rng() % 24);
+            const int bStep = static_cast<int>(rng()) >> (rng() % 24);
+
+            std::vector<WORD> expected(count + 1, 0xABCD);
+            std::vector<WORD> actual(count + 1, 0xABCD);
+
+            PSX_Span_SetSimdLevel(PsxSimdLevel::eScalar);
+            PSX_Span_Gouraud(expected.data(), r, g, b, rStep, gStep, bStep, count);
+
+            PSX_Span_SetSimdLevel(level);
+            PSX_Span_Gouraud(actual.data(), r, g, b, rStep, gStep, bStep, count);
+
+            ASSERT_EQ(expected, actual);
+        }
+    }
+
+    static void Test_Span_Clut4(PsxSimdLevel level)
+    {
+        std::mt19937 rng(91011);
+
+        WORD clut[16] = {};
+        for (WORD& entry : clut)
+        {
+            entry = static_cast<WORD>(rng());
+        }
+
+        BYTE nibbles[64] = {};
+        for (BYTE& entry : nibbles)
+        {
+            entry = static_cast<BYTE>(rng());
+        }
+
+        for (int count = 0; count <= 100; count++)
+        {
+            WORD expected[100] = {};
+            WORD actual[100] = {};
+
+            PSX_Span_SetSimdLevel(PsxSimdLevel::eScalar);
+            PSX_Span_Clut4(expected, nibbles, clut, count);
+
+            PSX_Span_SetSimdLevel(level);
+            PSX_Span_Clut4(actual, nibbles, clut, count);
+
+            for (int i = 0; i < 100; i++)
+            {
+                ASSERT_EQ(expected[i], actual[i]);
+            }
+        }
+    }
+
+    void PsxRenderSpansTests()
+    {
+        // Builds the blending and modulation LUTs the scalar kernels use
+        PSX_EMU_SetDispType_4F9960(2);
+
+        const PsxSimdLevel oldLevel = PSX_Span_GetSimdLevel();
+        const PsxSimdLevel maxLevel = PSX_Span_DetectSimdLevel();
+        for (int level = static_cast<int>(PsxSimdLevel::eSSE2); level <= static_cast<int>(maxLevel); level++)
+        {
+            Test_Span_Texels(static_cast<PsxSimdLevel>(level));
+            Test_Span_Solid(static_cast<PsxSimdLevel>(level));
+            Test_Span_Gouraud(static_cast<PsxSimdLevel>(level));
+            Test_Span_Clut4(static_cast<PsxSimdLevel>(level));
+        }
+        PSX_Span_SetSimdLevel(oldLevel);
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+
+// Semi trans blending LUTs, one per abr mode, indexed by [foreground][background] component.
+struct Psx_Test
+{
+    __int16 r[32][32];
+    __int16 g[32][32];
+    __int16 b[32][32];
+};
+ALIVE_ASSERT_SIZEOF(Psx_Test, 0x1800); // 3072 words
+
+// Colour modulation LUT row, indexed by the texel component.
+struct Psx_Data
+{
+    BYTE field_0[32];
+};
+ALIVE_ASSERT_SIZEOF(Psx_Data, 32);
+
+namespace Test
+{
+    void PsxRenderSpansTests();
+}
+
+enum class PsxSpanBlend
+{
+    eNone,
+    eSemiTransFlag, // Only texels with 0x20 set are blended
+    eAlways,
+};
+
+// Describes how a run of texels is written to the frame buffer.
+struct PsxSpanMode
+{
+    // 0 texels are see through
+    bool mSkipBlack = true;
+
+    PsxSpanBlend mBlend = PsxSpanBlend::eNone;
+
+    // sTexture_page_abr_BD0F18 and its LUT, the vector paths compute the blend instead of using the LUT
+    DWORD mAbr = 0;
+    const Psx_Test* mpAbrLut = nullptr;
+
+    // r, g, b rows of stru_C1D1C0 to modulate the texel by, or nullptr to use the texel as is.
+    // The vector paths take the colour from entry 16 (texel * colour / 16) of each row.
+    const BYTE* mpModulate[3] = {};
+};
+
+enum class PsxSimdLevel
+{
+    eScalar = 0,
+    eSSE2 = 1,
+    eAVX2 = 2,
+};
+
+// Best level the CPU (and OS) supports.
+PsxSimdLevel PSX_Span_DetectSimdLevel();
+
+// Selects the span kernels, the level is clamped to what the CPU supports. Returns the level in use.
+PsxSimdLevel PSX_Span_SetSimdLevel(PsxSimdLevel level);
+PsxSimdLevel PSX_Span_GetSimdLevel();
+
+// Writes count texels to pDst as described by mode.
+void PSX_Span_Texels(WORD* pDst, const WORD* pTexels, int count, const PsxSpanMode& mode);
+
+// Same as PSX_Span_Texels with every texel set to colour.
+void PSX_Span_Solid(WORD* pDst, WORD colour, int count, const PsxSpanMode& mode);
+
+// Writes count gouraud shaded pixels, r/g/b are 16.16 fixed point and are stepped by rStep/gStep/bStep per pixel.
+void PSX_Span_Gouraud(WORD* pDst, int r, int g, int b, int rStep, int gStep, int bStep, int count);
+
+// Looks up count 4bit texels starting at the low nibble of pNibbles.
+void PSX_Span_Clut4(WORD* pDst, const BYTE* pNibbles, const WORD* pClut, int count);
+
+// When false the scalar kernels are always used.
+extern bool gRenderSimdEnabled;
@@ -30,6 +30,12 @@ public:
     void Draw(Poly_G4& poly) override;
 
     void Upload(BitDepth bitDepth, const PSX_RECT& rect, const BYTE* pPixels) override;
+
+    // Added to every prim's y by the Draw calls.
+    int FrameYOffset() const
+    {
+        return mFrame_yOff;
+    }
 private:
     bool mFrameStarted = false;
 
@@ -0,0 +1,326 @@
+#include "stdafx.h"
+#include "ResourceHeapIndex.hpp"
+#include "Function.hpp"
+#include <algorithm>
+#include <memory>
+
+bool gResourceHeapSizeClasses = true;
+
+// Entries are only dropped when looked at, rebuild if too many stale ones pile up
+const size_t kMaxIndexEntries = 4096;
+
+using ResourceHeapItem = ResourceManager::ResourceHeapItem;
+
+static ResourceManager::Header* HeaderOf(ResourceHeapItem* pItem)
+{
+    return ResourceManager::Get_Header_49C410(&pItem->field_0_ptr);
+}
+
+// A block starts with its header and its size includes the header
+static BYTE* BlockStart(ResourceHeapItem* pItem)
+{
+    return reinterpret_cast<BYTE*>(HeaderOf(pItem));
+}
+
+static BYTE* BlockEnd(ResourceHeapItem* pItem)
+{
+    return BlockStart(pItem) + HeaderOf(pItem)->field_0_size;
+}
+
+int ResourceHeapIndex::ClassOf(DWORD size)
+{
+    int sizeClass = 0;
+    while (size > 1 && sizeClass < kClassCount - 1)
+    {
+        size >>= 1;
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+bool ResourceHeapIndex::IsFree(const ResourceHeapItem* pItem)
+{
+    // Items that have been merged away have no block
+    return pItem->field_0_ptr && HeaderOf(const_cast<ResourceHeapItem*>(pItem))->field_8_type == ResourceManager::Resource_Free;
+}
+
+void ResourceHeapIndex::MergeWithNext(ResourceHeapItem* pItem)
+{
+    ResourceManager::Header* pHeader = HeaderOf(pItem);
+    bool bMerged = false;
+    for (ResourceHeapItem* pNext = pItem->field_4_pNext; pNext && IsFree(pNext); pNext = pItem->field_4_pNext)
+    {
+        pHeader->field_0_size += HeaderOf(pNext)->field_0_size;
+        pItem->field_4_pNext = pNext->field_4_pNext;
+        ResourceManager::Pop_List_Item_49BD90(pNext);
+        bMerged = true;
+    }
+
+    if (bMerged)
+    {
+        mFreeByEnd[BlockEnd(pItem)] = pItem;
+    }
+}
+
+ResourceHeapItem* ResourceHeapIndex::FreeBlockBefore(ResourceHeapItem* pItem)
+{
+    auto it = mFreeByEnd.find(BlockStart(pItem));
+    if (it == mFreeByEnd.end())
+    {
+        return nullptr;
+    }
+
+    ResourceHeapItem* pBefore = it->second;
+    if (pBefore == pItem || !IsFree(pBefore) || BlockEnd(pBefore) != BlockStart(pItem))
+    {
+        // Allocated, merged away or moved since it was filed
+        mFreeByEnd.erase(it);
+        return nullptr;
+    }
+    return pBefore;
+}
+
+void ResourceHeapIndex::Add(ResourceHeapItem* pItem)
+{
+    if (pItem)
+    {
+        mRecentlyFreed.push_back(pItem);
+    }
+}
+
+void ResourceHeapIndex::File(ResourceHeapItem* pItem)
+{
+    const int sizeClass = ClassOf(HeaderOf(pItem)->field_0_size);
+    mClasses[sizeClass].push_back(pItem);
+    mNonEmptyClasses |= 1u << sizeClass;
+    mEntryCount++;
+    mFreeByEnd[BlockEnd(pItem)] = pItem;
+}
+
+void ResourceHeapIndex::MergeRecentlyFreed()
+{
+    for (ResourceHeapItem* pItem : mRecentlyFreed)
+    {
+        if (!IsFree(pItem))
+        {
+            continue;
+        }
+
+        // Go back to the start of the run of free blocks so the whole run becomes one block
+        ResourceHeapItem* pStart = pItem;
+        while (ResourceHeapItem* pBefore = FreeBlockBefore(pStart))
+        {
+            pStart = pBefore;
+        }
+
+        MergeWithNext(pStart);
+        File(pStart);
+    }
+    mRecentlyFreed.clear();
+}
+
+void ResourceHeapIndex::Rebuild()
+{
+    for (auto& entries : mClasses)
+    {
+        entries.clear();
+    }
+    mRecentlyFreed.clear();
+    mFreeByEnd.clear();
+    mNonEmptyClasses = 0;
+    mEntryCount = 0;
+
+    for (ResourceHeapItem* pItem = ResourceManager::First_Heap_Item(); pItem; pItem = pItem->field_4_pNext)
+    {
+        if (IsFree(pItem))
+        {
+            MergeWithNext(pItem);
+            File(pItem);
+        }
+    }
+
+    mDirty = false;
+}
+
+ResourceHeapItem* ResourceHeapIndex::FindFree(DWORD size)
+{
+    if (mDirty || mEntryCount > kMaxIndexEntries)
+    {
+        Rebuild();
+    }
+    else
+    {
+        MergeRecentlyFreed();
+    }
+
+    // Blocks in the size's own class might be too small so the closest fit is taken from it, any block in a bigger
+    // class will do so the first one that is still free is taken
+    const int ownClass = ClassOf(size);
+    for (int sizeClass = ownClass; sizeClass < kClassCount; sizeClass++)
+    {
+        if (!(mNonEmptyClasses & (1u << sizeClass)))
+        {
+            continue;
+        }
+
+        auto& entries = mClasses[sizeClass];
+        size_t bestIdx = entries.size();
+        DWORD bestSize = 0;
+        for (size_t i = 0; i < entries.size();)
+        {
+            ResourceHeapItem* pItem = entries[i];
+            if (!IsFree(pItem))
+            {
+                entries[i] = entries.back();
+                entries.pop_back();
+                mEntryCount--;
+                continue;
+            }
+
+            MergeWithNext(pItem);
+            const DWORD blockSize = HeaderOf(pItem)->field_0_size;
+            if (ClassOf(blockSize) != sizeClass)
+            {
+                // Grew or was split since it was filed
+                entries[i] = entries.back();
+                entries.pop_back();
+                mEntryCount--;
+                File(pItem);
+                continue;
+            }
+
+            if (blockSize >= size && (bestIdx == entries.size() || blockSize < bestSize))
+            {
+                bestIdx = i;
+                bestSize = blockSize;
+                if (sizeClass != ownClass || blockSize == size)
+                {
+                    break;
+                }
+            }
+            i++;
+        }
+
+        ResourceHeapItem* pFound = nullptr;
+        if (bestIdx < entries.size())
+        {
+            pFound = entries[bestIdx];
+            entries[bestIdx] = entries.back();
+            entries.pop_back();
+            mEntryCount--;
+        }
+
+        if (entries.empty())
+        {
+            mNonEmptyClasses &= ~(1u << sizeClass);
+        }
+
+        if (pFound)
+        {
+            return pFound;
+        }
+    }
+    return nullptr;
+}
+
+ResourceHeapIndex* ResourceHeapIndex_Get()
+{
+    static std::unique_ptr<ResourceHeapIndex> sIndex;
+
+    // The game's own code allocates and frees blocks without telling the index
+    if (RunningAsInjectedDll() || !gResourceHeapSizeClasses)
+    {
+        sIndex.reset();
+        return nullptr;
+    }
+
+    if (!sIndex)
+    {
+        sIndex.reset(new ResourceHeapIndex());
+    }
+    return sIndex.get();
+}
+
+ResourceHeapStats& ResourceHeap_Stats()
+{
+    static ResourceHeapStats sStats;
+    return sStats;
+}
+
+void ResourceHeap_MeasureFree(ResourceHeapStats& stats)
+{
+    stats.mFreeBytes = 0;
+    stats.mLargestFreeBlock = 0;
+    stats.mFreeBlocks = 0;
+
+    DWORD runSize = 0;
+    for (ResourceHeapItem* pItem = ResourceManager::First_Heap_Item(); pItem; pItem = pItem->field_4_pNext)
+    {
+        ResourceManager::Header* pHeader = HeaderOf(pItem);
+        if (pHeader->field_8_type == ResourceManager::Resource_Free)
+        {
+            if (runSize == 0)
+            {
+                stats.mFreeBlocks++;
+            }
+            runSize += pHeader->field_0_size;
+            stats.mFreeBytes += pHeader->field_0_size;
+            stats.mLargestFreeBlock = std::max(stats.mLargestFreeBlock, runSize);
+        }
+        else
+        {
+            runSize = 0;
+        }
+    }
+}
+
+namespace Test
+{
+    static void ResourceHeapIndex_BestFit_Test()
+    {
+        const DWORD savedUsedSize = sManagedMemoryUsedSize_AB4A04;
+        const DWORD savedPeakUsage = sPeakedManagedMemUsage_AB4A08;
+
+        ResourceManager::Init_49BCE0();
+        ASSERT_NE(nullptr, ResourceHeapIndex_Get());
+
+        BYTE** ppA = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 1, 1000);
+        BYTE** ppB = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 2, 200);
+        BYTE** ppC = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 3, 1000);
+        BYTE** ppD = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 4, 200);
+        BYTE** ppE = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 5, 100);
+        ASSERT_NE(nullptr, ppE);
+
+        BYTE* pA = *ppA;
+        BYTE* pD = *ppD;
+        ResourceManager::FreeResource_49C330(ppA);
+        ResourceManager::FreeResource_49C330(ppD);
+
+        // First fit would have used the space A left, D's is a closer fit
+        BYTE** ppF = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 6, 150);
+        ASSERT_EQ(pD, *ppF);
+
+        // A and B are next to each other so they become one block that is big enough
+        ResourceManager::FreeResource_49C330(ppB);
+        BYTE** ppG = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_Palt, 7, 1100);
+        ASSERT_EQ(pA, *ppG);
+        ASSERT_EQ(ppG, ResourceManager::GetLoadedResource_49C2A0(ResourceManager::Resource_Palt, 7, FALSE, FALSE));
+        ASSERT_EQ(ppC, ResourceManager::GetLoadedResource_49C2A0(ResourceManager::Resource_Palt, 3, FALSE, FALSE));
+
+        // What's left of A + B, what's left of D and the rest of the heap
+        ResourceHeapStats stats;
+        ResourceHeap_MeasureFree(stats);
+        ASSERT_EQ(3u, stats.mFreeBlocks);
+        ASSERT_LT(stats.mLargestFreeBlock, stats.mFreeBytes);
+
+        ResourceManager::Init_49BCE0();
+        ResourceHeap_Stats() = {};
+        sManagedMemoryUsedSize_AB4A04 = savedUsedSize;
+        sPeakedManagedMemUsage_AB4A08 = savedPeakUsage;
+    }
+
+    void ResourceHeapIndexTests()
+    {
+        ResourceHeapIndex_BestFit_Test();
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "ResourceManager.hpp"
+#include <vector>
+#include <unordered_map>
+
+namespace Test
+{
+    void ResourceHeapIndexTests();
+}
+
+struct ResourceHeapStats
+{
+    unsigned int mAllocs = 0;
+    unsigned int mFailedAllocs = 0;
+    double mTotalAllocUs = 0.0;
+    double mMaxAllocUs = 0.0;
+    unsigned int mCompactions = 0;
+    double mLastCompactionMs = 0.0;
+
+    // Filled in by ResourceHeap_MeasureFree
+    DWORD mFreeBytes = 0;
+    DWORD mLargestFreeBlock = 0;
+    DWORD mFreeBlocks = 0;
+};
+
+// Segregated free lists over the blocks of the resource heap, one per power of two size class, so an allocation
+// can go straight to a block that is big enough instead of walking every block in the heap.
+//
+// The heap itself is unchanged, blocks are still handles in to the one static buffer in address order so
+// Reclaim_Memory_49C470 can move them around. Entries are checked when they are looked at and stale ones dropped,
+// which means the index doesn't need to know about every place that changes a block.
+class ResourceHeapIndex
+{
+public:
+    // Call when a block becomes free, it is merged with any free neighbours on the next FindFree.
+    void Add(ResourceManager::ResourceHeapItem* pItem);
+
+    // Returns the closest fit from the size's own class or else the first block of the next non empty class, or
+    // nullptr. Free neighbours are merged the same way Allocate_New_Block_49BFB0 merges them.
+    ResourceManager::ResourceHeapItem* FindFree(DWORD size);
+
+    // Blocks were moved or merged behind the index's back, rebuilt on the next FindFree.
+    void Invalidate()
+    {
+        mDirty = true;
+    }
+
+    void Rebuild();
+
+    static const int kClassCount = 32;
+
+private:
+    static int ClassOf(DWORD size);
+    static bool IsFree(const ResourceManager::ResourceHeapItem* pItem);
+
+    void MergeWithNext(ResourceManager::ResourceHeapItem* pItem);
+    ResourceManager::ResourceHeapItem* FreeBlockBefore(ResourceManager::ResourceHeapItem* pItem);
+    void File(ResourceManager::ResourceHeapItem* pItem);
+    void MergeRecentlyFreed();
+
+    std::vector<ResourceManager::ResourceHeapItem*> mClasses[kClassCount];
+    std::vector<ResourceManager::ResourceHeapItem*> mRecentlyFreed;
+
+    // Filed free blocks by the address just past their end, so a freed block can find a free block right before it
+    // without walking the heap. Checked when looked up like the size classes.
+    std::unordered_map<BYTE*, ResourceManager::ResourceHeapItem*> mFreeByEnd;
+    unsigned int mNonEmptyClasses = 0;
+    size_t mEntryCount = 0;
+    bool mDirty = true;
+};
+
+// Returns the index or nullptr when it is turned off.
+ResourceHeapIndex* ResourceHeapIndex_Get();
+
+ResourceHeapStats& ResourceHeap_Stats();
+
+// Walks the heap to fill in the free space stats, adjacent free blocks count as one.
+void ResourceHeap_MeasureFree(ResourceHeapStats& stats);
+
+// When false blocks are allocated by walking the heap like the original game.
+extern bool gResourceHeapSizeClasses;
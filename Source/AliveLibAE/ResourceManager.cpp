@@ -10,6 +10,11 @@
 #include "PsxRender.hpp"
 #include "PsxDisplay.hpp"
 #include "Sys.hpp"
+#include "AnimationFrameCache.hpp"
+#include "ResourceHeapIndex.hpp"
+#include "ResourcePrefetch.hpp"
+#include "FrameProfiler.hpp"
+#include <chrono>
 
 ALIVE_VAR(1, 0x5C1BB0, ResourceManager*, pResourceManager_5C1BB0, nullptr);
 
@@ -33,6 +38,13 @@ ALIVE_ARY(1, 0x5D1E30, ResourceManager::ResourceHeapItem, kLinkedListArraySize,
 
 ALIVE_VAR(1, 0xAB49F8, BYTE*, spResourceHeapEnd_AB49F8, nullptr);
 
+// The file being loaded was read ahead or is in the mapped LVL so the state machine can go through it without
+// waiting for the disc
+static bool sbLoadingFileInMemory = false;
+
+// How long LoadingLoop_465590 can spend loading files that are in memory before letting a frame go by
+const DWORD kInMemoryLoadMsPerFrame = 16;
+
 // TODO: Move to own file
 EXPORT void CCSTD sub_465BC0(int /*a1*/)
 {
@@ -136,6 +148,16 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
             field_30_start_sector = pLvlFileRec1->field_C_start_sector + sLvlArchive_5BC520.field_4_cd_pos;
             PSX_Pos_To_CdLoc_4FADD0(field_30_start_sector, &field_44_cdLoc);
 
+            if (ResourcePrefetcher* pPrefetcher = ResourcePrefetch_Get())
+            {
+                ResourcePrefetch_OnFileLoading(field_2C_pFileItem);
+                sbLoadingFileInMemory = sLvlArchive_5BC520.Is_Mapped() || pPrefetcher->IsReady(field_30_start_sector);
+            }
+            else
+            {
+                sbLoadingFileInMemory = sLvlArchive_5BC520.Is_Mapped();
+            }
+
             sbLoadingInProgress_5C1B96 = 1;
             field_42_state = State_Allocate_Memory_For_File;
         }
@@ -154,6 +176,7 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
         {
             // Failed to allocate, free some memory and loop around for another go
             ResourceManager::Reclaim_Memory_49C470(200000);
+            sbLoadingFileInMemory = false;
         }
         break;
 
@@ -178,6 +201,23 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
         break;
 
     case State_Read_Sectors_ASync:
+        if (const BYTE* pMapped = sLvlArchive_5BC520.Map_Sectors(field_30_start_sector, field_34_num_sectors))
+        {
+            memcpy(field_3C_pLoadingHeader, pMapped, field_34_num_sectors << 11);
+            field_42_state = State_File_Read_Completed;
+            break;
+        }
+
+        if (ResourcePrefetcher* pPrefetcher = ResourcePrefetch_Get())
+        {
+            if (pPrefetcher->Take(field_30_start_sector, field_34_num_sectors, field_3C_pLoadingHeader))
+            {
+                field_42_state = State_File_Read_Completed;
+                break;
+            }
+            sbLoadingFileInMemory = false;
+        }
+
         if (PSX_CD_File_Read_4FB210(field_34_num_sectors, field_3C_pLoadingHeader))
         {
             field_42_state = State_Wait_For_Read_Complete;
@@ -210,6 +250,7 @@ void ResourceManager::vLoadFile_StateMachine_464A70()
 
     case State_Load_Completed:
         sbLoadingInProgress_5C1B96 = 0;
+        sbLoadingFileInMemory = false;
         OnResourceLoaded_464CE0();
         field_48_dArray.field_4_used_size = 0; // TODO: Needs to be private
         Decrement_Pending_Count_49C610();
@@ -535,10 +576,21 @@ void ResourceManager::LoadResourceFile_465460(const char* filename, Camera* pCam
 
 void ResourceManager::LoadingLoop_465590(__int16 bShowLoadingIcon)
 {
+    FRAME_PROFILE_PHASE(FramePhase::eLoading);
+
     while (!field_20_files_pending_loading.IsEmpty())
     {
         SYS_EventsPump_494580();
         VUpdate();  // vLoadFile_StateMachine_464A70 - process loading of files
+
+        // Files that are already in memory are loaded without waiting a frame for each state
+        const DWORD startTicks = SYS_GetTicks();
+        const bool bFilesCanBeInMemory = ResourcePrefetch_Get() || sLvlArchive_5BC520.Is_Mapped();
+        while (sbLoadingFileInMemory || (field_42_state == State_Wait_For_Load_Request && !field_20_files_pending_loading.IsEmpty() && bFilesCanBeInMemory && SYS_GetTicks() - startTicks < kInMemoryLoadMsPerFrame))
+        {
+            VUpdate();
+        }
+
         PSX_VSync_4F6170(0);
         const int ticks = loading_ticks_5C1BAC++ + 1;
         if (bShowLoadingIcon && !bHideLoadingIcon_5C1BAA && ticks > 180)
@@ -682,6 +734,16 @@ void CC ResourceManager::Init_49BCE0()
     sResourceLinkedList_5D1E30[0].field_0_ptr = &sResourceHeap_5D29F4[sizeof(Header)];
     sResourceLinkedList_5D1E30[0].field_4_pNext = nullptr;
 
+    if (AnimationFrameCache* pCache = AnimFrameCache_Get())
+    {
+        pCache->Clear();
+    }
+
+    if (ResourceHeapIndex* pIndex = ResourceHeapIndex_Get())
+    {
+        pIndex->Invalidate();
+    }
+
     Header* pHeader = Get_Header_49C410(&sResourceLinkedList_5D1E30[0].field_0_ptr);
     pHeader->field_0_size = kResHeapSize;
     pHeader->field_8_type = Resource_Free;
@@ -728,6 +790,11 @@ ResourceManager::ResourceHeapItem* CC ResourceManager::Split_block_49BDC0(Resour
 
         // Update old size
         pToSplit->field_0_size = size;
+
+        if (ResourceHeapIndex* pIndex = ResourceHeapIndex_Get())
+        {
+            pIndex->Add(pNewListItem);
+        }
     }
 
     return pItem;
@@ -804,7 +871,55 @@ BYTE** CC ResourceManager::Allocate_New_Locked_Resource_49BF40(DWORD type, DWORD
     return Alloc_New_Resource_Impl(type, id, size, true, BlockAllocMethod::eLastMatching);
 }
 
+// Same as eFirstMatching but takes the closest fitting block from the size class index instead of the first one
+static BYTE** Allocate_New_Block_SizeClass(ResourceHeapIndex* pIndex, int sizeBytes)
+{
+    const unsigned int size = (sizeBytes + 3) & ~3u;
+    ResourceManager::ResourceHeapItem* pListItem = pIndex->FindFree(size);
+    if (!pListItem)
+    {
+        // Could still be free blocks the index missed, let the original have a go
+        BYTE** ppRes = ResourceManager::Allocate_New_Block_Impl(sizeBytes, ResourceManager::BlockAllocMethod::eFirstMatching);
+        pIndex->Invalidate();
+        return ppRes;
+    }
+
+    sManagedMemoryUsedSize_AB4A04 += size;
+    if (sManagedMemoryUsedSize_AB4A04 >= sPeakedManagedMemUsage_AB4A08)
+    {
+        sPeakedManagedMemUsage_AB4A08 = sManagedMemoryUsedSize_AB4A04;
+    }
+    return &ResourceManager::Split_block_49BDC0(pListItem, size)->field_0_ptr;
+}
+
 BYTE** CC ResourceManager::Allocate_New_Block_49BFB0(int sizeBytes, BlockAllocMethod allocMethod)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    BYTE** ppRes = nullptr;
+    ResourceHeapIndex* pIndex = ResourceHeapIndex_Get();
+    if (pIndex && allocMethod == BlockAllocMethod::eFirstMatching)
+    {
+        ppRes = Allocate_New_Block_SizeClass(pIndex, sizeBytes);
+    }
+    else
+    {
+        ppRes = Allocate_New_Block_Impl(sizeBytes, allocMethod);
+    }
+
+    ResourceHeapStats& stats = ResourceHeap_Stats();
+    const double allocUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    stats.mAllocs++;
+    stats.mTotalAllocUs += allocUs;
+    stats.mMaxAllocUs = std::max(stats.mMaxAllocUs, allocUs);
+    if (!ppRes)
+    {
+        stats.mFailedAllocs++;
+    }
+    return ppRes;
+}
+
+BYTE** ResourceManager::Allocate_New_Block_Impl(int sizeBytes, BlockAllocMethod allocMethod)
 {
     ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC;
     ResourceHeapItem* pHeapMem = nullptr;
@@ -952,6 +1067,12 @@ signed __int16 CC ResourceManager::Move_Resources_To_DArray_49C1C0(BYTE** ppRes,
     if (pHeader)
     {
         pHeader->field_8_type = Resource_Free;
+
+        if (ResourceHeapIndex* pIndex = ResourceHeapIndex_Get())
+        {
+            pIndex->Add(pItemToAdd);
+        }
+
         if (pItemToAdd->field_4_pNext)
         {
             // Size of next item - location of current res
@@ -1008,10 +1129,21 @@ signed __int16 CC ResourceManager::FreeResource_49C330(BYTE** handle)
     {
         return 1;
     }
+
+    // A heap handle is its own list item, which saves the index looking for it
+    if (Is_Heap_Handle(handle))
+    {
+        return FreeResource_Item(*handle, reinterpret_cast<ResourceHeapItem*>(handle));
+    }
     return FreeResource_Impl_49C360(*handle);
 }
 
 signed __int16 CC ResourceManager::FreeResource_Impl_49C360(BYTE* handle)
+{
+    return FreeResource_Item(handle, nullptr);
+}
+
+signed __int16 ResourceManager::FreeResource_Item(BYTE* handle, ResourceHeapItem* pItem)
 {
     if (handle)
     {
@@ -1027,11 +1159,41 @@ signed __int16 CC ResourceManager::FreeResource_Impl_49C360(BYTE* handle)
             pHeader->field_8_type = Resource_Free;
             pHeader->field_6_flags = 0;
             sManagedMemoryUsedSize_AB4A04 -= pHeader->field_0_size;
+
+            // The handle can be given to another resource now
+            if (AnimationFrameCache* pCache = AnimFrameCache_Get())
+            {
+                pCache->ForgetBlock(handle);
+            }
+
+            if (ResourceHeapIndex* pIndex = ResourceHeapIndex_Get())
+            {
+                // Only callers that just have the block have to look for its item
+                for (DWORD i = 0; !pItem && i < kLinkedListArraySize; i++)
+                {
+                    if (sResourceLinkedList_5D1E30[i].field_0_ptr == handle)
+                    {
+                        pItem = &sResourceLinkedList_5D1E30[i];
+                    }
+                }
+                pIndex->Add(pItem);
+            }
         }
     }
     return 1;
 }
 
+bool ResourceManager::Is_Heap_Handle(BYTE** ppRes)
+{
+    const ResourceHeapItem* pItem = reinterpret_cast<const ResourceHeapItem*>(ppRes);
+    return pItem >= &sResourceLinkedList_5D1E30[0] && pItem < &sResourceLinkedList_5D1E30[kLinkedListArraySize];
+}
+
+ResourceManager::ResourceHeapItem* ResourceManager::First_Heap_Item()
+{
+    return sFirstLinkedListItem_5D29EC;
+}
+
 ResourceManager::Header* CC ResourceManager::Get_Header_49C410(BYTE** ppRes)
 {
     return reinterpret_cast<Header*>((*ppRes - sizeof(Header)));
@@ -1051,6 +1213,8 @@ void CC ResourceManager::Reclaim_Memory_49C470(unsigned int sizeToReclaim)
         sAllocationFailed_AB4A0C = 0;
     }
 
+    const auto start = std::chrono::steady_clock::now();
+
     ResourceHeapItem* pListItem = sFirstLinkedListItem_5D29EC;
     ResourceHeapItem* pToUpdate = nullptr;
 
@@ -1062,7 +1226,7 @@ void CC ResourceManager::Reclaim_Memory_49C470(unsigned int sizeToReclaim)
             ResourceHeapItem* pNext = pListItem->field_4_pNext;
             if (!pNext)
             {
-                return;
+                break;
             }
 
             Header* pNextHeader = Get_Header_49C410(&pNext->field_0_ptr);
@@ -1132,6 +1296,16 @@ void CC ResourceManager::Reclaim_Memory_49C470(unsigned int sizeToReclaim)
             pListItem = pListItem->field_4_pNext;
         }
     }
+
+    // Everything has moved
+    if (ResourceHeapIndex* pIndex = ResourceHeapIndex_Get())
+    {
+        pIndex->Invalidate();
+    }
+
+    ResourceHeapStats& stats = ResourceHeap_Stats();
+    stats.mCompactions++;
+    stats.mLastCompactionMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 void CC ResourceManager::Increment_Pending_Count_49C5F0()
@@ -1162,6 +1336,16 @@ void CC ResourceManager::Free_Resource_Of_Type_49C6B0(DWORD type)
             pHeader->field_4_ref_count = 0;
 
             sManagedMemoryUsedSize_AB4A04 -= pHeader->field_0_size;
+
+            if (AnimationFrameCache* pCache = AnimFrameCache_Get())
+            {
+                pCache->ForgetHandle(&pListItem->field_0_ptr);
+            }
+
+            if (ResourceHeapIndex* pIndex = ResourceHeapIndex_Get())
+            {
+                pIndex->Add(pListItem);
+            }
         }
         pListItem = pListItem->field_4_pNext;
     }
@@ -145,6 +145,7 @@ public:
     EXPORT static BYTE** CC Alloc_New_Resource_49BED0(DWORD type, DWORD id, DWORD size);
     EXPORT static BYTE** CC Allocate_New_Locked_Resource_49BF40(DWORD type, DWORD id, DWORD size);
     EXPORT static BYTE** CC Allocate_New_Block_49BFB0(int sizeBytes, BlockAllocMethod allocMethod);
+    static BYTE** Allocate_New_Block_Impl(int sizeBytes, BlockAllocMethod allocMethod);
     EXPORT static int CC LoadResourceFile_49C130(const char* filename, TLoaderFn pFn, Camera* a4, Camera* pCamera);
     EXPORT static signed __int16 CC LoadResourceFile_49C170(const char* pFileName, Camera* pCamera);
     EXPORT static signed __int16 CC Move_Resources_To_DArray_49C1C0(BYTE** ppRes, DynamicArrayT<BYTE*>* pArray);
@@ -152,6 +153,11 @@ public:
     EXPORT static void CC Inc_Ref_Count_49C310(BYTE **ppRes);
     EXPORT static signed __int16 CC FreeResource_49C330(BYTE** handle);
     EXPORT static signed __int16 CC FreeResource_Impl_49C360(BYTE* handle);
+    // pItem is the handle's list item if the caller knows it, else nullptr.
+    static signed __int16 FreeResource_Item(BYTE* handle, ResourceHeapItem* pItem);
+    // True for handles that are owned by the resource heap, as opposed to pointers to data that lives elsewhere.
+    static bool Is_Heap_Handle(BYTE** ppRes);
+    static ResourceHeapItem* First_Heap_Item();
     EXPORT static Header* CC Get_Header_49C410(BYTE** ppRes);
     EXPORT static void CC Reclaim_Memory_49C470(unsigned int size);
     EXPORT static void CC Increment_Pending_Count_49C5F0();
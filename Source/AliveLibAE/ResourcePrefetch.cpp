@@ -0,0 +1,531 @@
+#include "stdafx.h"
+#include "ResourcePrefetch.hpp"
+#include "Function.hpp"
+#include "Io.hpp"
+#include "Psx.hpp"
+#include "LvlArchive.hpp"
+#include "Map.hpp"
+#include "Path.hpp"
+#include "Abe.hpp"
+#include <memory>
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
+int gResourcePrefetchBudgetKb = 8192;
+
+const int kPrefetchThreads = 2;
+const int kSectorSize = 2048;
+
+ResourcePrefetcher::ResourcePrefetcher(int threadCount, size_t budgetBytes)
+    : mBudgetBytes(budgetBytes)
+{
+    for (int i = 0; i < threadCount; i++)
+    {
+        mThreads.emplace_back(&ResourcePrefetcher::WorkerThread, this);
+    }
+}
+
+ResourcePrefetcher::~ResourcePrefetcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mQuit = true;
+    }
+    mWorkReady.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void ResourcePrefetcher::Drop(TEntries::iterator it)
+{
+    if (it->second.mState == State::eReady)
+    {
+        mStats.mUnused++;
+        mStats.mBytesHeld -= it->second.mData.size();
+    }
+    mEntries.erase(it);
+}
+
+void ResourcePrefetcher::SetArchive(const char* pFilePath)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    const std::string newPath = pFilePath ? pFilePath : "";
+    if (newPath == mArchivePath)
+    {
+        return;
+    }
+
+    while (!mEntries.empty())
+    {
+        Drop(mEntries.begin());
+    }
+
+    // Reads of the old LVL that are still going are thrown away when they finish
+    mArchivePath = newPath;
+    mArchiveId++;
+}
+
+void ResourcePrefetcher::Want(const std::vector<File>& files)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mArchivePath.empty())
+        {
+            return;
+        }
+
+        for (auto& entry : mEntries)
+        {
+            entry.second.mPriority = ~0u;
+        }
+
+        size_t wantedBytes = 0;
+        unsigned int priority = 0;
+        for (const File& file : files)
+        {
+            const size_t fileBytes = static_cast<size_t>(file.mNumSectors) * kSectorSize;
+            if (wantedBytes + fileBytes > mBudgetBytes)
+            {
+                continue;
+            }
+            wantedBytes += fileBytes;
+
+            auto it = mEntries.find(file.mStartSector);
+            if (it == mEntries.end())
+            {
+                it = mEntries.emplace(file.mStartSector, Entry()).first;
+                it->second.mNumSectors = file.mNumSectors;
+            }
+            it->second.mPriority = priority++;
+        }
+
+        for (auto it = mEntries.begin(); it != mEntries.end();)
+        {
+            auto next = std::next(it);
+            if (it->second.mPriority == ~0u)
+            {
+                Drop(it);
+            }
+            it = next;
+        }
+    }
+    mWorkReady.notify_all();
+}
+
+bool ResourcePrefetcher::IsReady(int startSector)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    auto it = mEntries.find(startSector);
+    return it != mEntries.end() && it->second.mState == State::eReady;
+}
+
+bool ResourcePrefetcher::Take(int startSector, int numSectors, void* pBuffer)
+{
+    std::unique_lock<std::mutex> lock(mLock);
+    auto it = mEntries.find(startSector);
+    if (it == mEntries.end() || it->second.mNumSectors != numSectors || it->second.mState == State::eQueued)
+    {
+        // Not worth waiting for the workers to get to it
+        if (it != mEntries.end())
+        {
+            Drop(it);
+        }
+        mStats.mMisses++;
+        return false;
+    }
+
+    const bool bLate = it->second.mState == State::eReading;
+    const unsigned int archiveId = mArchiveId;
+    mReadDone.wait(lock, [&]()
+    {
+        it = mEntries.find(startSector);
+        return mArchiveId != archiveId || it == mEntries.end() || it->second.mState != State::eReading;
+    });
+
+    if (mArchiveId != archiveId || it == mEntries.end() || it->second.mState != State::eReady)
+    {
+        mStats.mMisses++;
+        return false;
+    }
+
+    memcpy(pBuffer, it->second.mData.data(), it->second.mData.size());
+    mStats.mBytesHeld -= it->second.mData.size();
+    mEntries.erase(it);
+
+    if (bLate)
+    {
+        mStats.mLateHits++;
+    }
+    else
+    {
+        mStats.mHits++;
+    }
+    return true;
+}
+
+ResourcePrefetchStats ResourcePrefetcher::Stats()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+    return mStats;
+}
+
+void ResourcePrefetcher::WorkerThread()
+{
+    IO_FileHandleType hFile = nullptr;
+    unsigned int fileArchiveId = 0;
+
+    for (;;)
+    {
+        int startSector = 0;
+        int numSectors = 0;
+        unsigned int archiveId = 0;
+        std::string archivePath;
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            TEntries::iterator next;
+            mWorkReady.wait(lock, [&]()
+            {
+                if (mQuit)
+                {
+                    return true;
+                }
+
+                next = mEntries.end();
+                for (auto it = mEntries.begin(); it != mEntries.end(); it++)
+                {
+                    if (it->second.mState == State::eQueued && (next == mEntries.end() || it->second.mPriority < next->second.mPriority))
+                    {
+                        next = it;
+                    }
+                }
+                return next != mEntries.end();
+            });
+
+            if (mQuit)
+            {
+                break;
+            }
+
+            next->second.mState = State::eReading;
+            startSector = next->first;
+            numSectors = next->second.mNumSectors;
+            archiveId = mArchiveId;
+            if (fileArchiveId != archiveId)
+            {
+                archivePath = mArchivePath;
+            }
+        }
+
+        if (fileArchiveId != archiveId)
+        {
+            if (hFile)
+            {
+                IO_Close(hFile);
+            }
+            hFile = IO_Open(archivePath.c_str(), "rb");
+            fileArchiveId = archiveId;
+        }
+
+        // Go through the CD position conversions the same way the resource manager's read does
+        CdlLOC cdLoc = {};
+        PSX_Pos_To_CdLoc_4FADD0(startSector, &cdLoc);
+        const int filePos = PSX_CdLoc_To_Pos_4FAE40(&cdLoc);
+
+        // Like PSX_CD_File_Read_4FB210 a short read of the last file in the LVL is fine
+        std::vector<BYTE> data(static_cast<size_t>(numSectors) * kSectorSize);
+        bool bRead = false;
+        if (hFile)
+        {
+            IO_Seek(hFile, filePos * kSectorSize, SEEK_SET);
+            bRead = IO_Read(hFile, data.data(), 1u, data.size()) > 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            auto it = mEntries.find(startSector);
+            if (mArchiveId == archiveId && it != mEntries.end() && it->second.mState == State::eReading)
+            {
+                if (bRead)
+                {
+                    it->second.mData = std::move(data);
+                    it->second.mState = State::eReady;
+                    mStats.mPrefetched++;
+                    mStats.mBytesHeld += it->second.mData.size();
+                }
+                else
+                {
+                    mEntries.erase(it);
+                }
+            }
+        }
+        mReadDone.notify_all();
+    }
+
+    if (hFile)
+    {
+        IO_Close(hFile);
+    }
+}
+
+static std::string sArchivePath;
+
+ResourcePrefetcher* ResourcePrefetch_Get()
+{
+    static std::unique_ptr<ResourcePrefetcher> sPrefetcher;
+    static size_t sBudgetBytes = 0;
+
+    // Loose files opened with sbEnable_PCOpen_5CA4B0 all start at sector 0 so they can't be told apart
+    if (RunningAsInjectedDll() || gResourcePrefetchBudgetKb <= 0 || sbEnable_PCOpen_5CA4B0)
+    {
+        sPrefetcher.reset();
+        return nullptr;
+    }
+
+    const size_t budgetBytes = static_cast<size_t>(gResourcePrefetchBudgetKb) * 1024;
+    if (!sPrefetcher || sBudgetBytes != budgetBytes)
+    {
+        sPrefetcher.reset(new ResourcePrefetcher(kPrefetchThreads, budgetBytes));
+        sPrefetcher->SetArchive(sArchivePath.empty() ? nullptr : sArchivePath.c_str());
+        sBudgetBytes = budgetBytes;
+    }
+    return sPrefetcher.get();
+}
+
+void ResourcePrefetch_OnArchiveOpened(const char* pFilePath)
+{
+    sArchivePath = pFilePath ? pFilePath : "";
+    if (ResourcePrefetcher* pPrefetcher = ResourcePrefetch_Get())
+    {
+        pPrefetcher->SetArchive(pFilePath);
+    }
+}
+
+struct PrefetchCameraKey
+{
+    LevelIds mLevel;
+    __int16 mPath;
+    __int16 mX;
+    __int16 mY;
+
+    bool operator < (const PrefetchCameraKey& rhs) const
+    {
+        return std::tie(mLevel, mPath, mX, mY) < std::tie(rhs.mLevel, rhs.mPath, rhs.mX, rhs.mY);
+    }
+};
+
+// Files other than the .CAM that were loaded for each camera, filled in as cameras are visited
+static std::map<PrefetchCameraKey, std::vector<std::string>> sCameraFiles;
+
+void ResourcePrefetch_OnFileLoading(ResourceManager::ResourceManager_FileRecord* pFileRec)
+{
+    if (!ResourcePrefetch_Get())
+    {
+        return;
+    }
+
+    for (int i = 0; i < pFileRec->field_10_file_sections_dArray.Size(); i++)
+    {
+        const ResourceManager::ResourceManager_FilePartRecord_18* pFilePart = pFileRec->field_10_file_sections_dArray.ItemAt(i);
+        if (!pFilePart)
+        {
+            break;
+        }
+
+        const Camera* pCamera = pFilePart->field_8_pCamera ? pFilePart->field_8_pCamera : pFilePart->field_C_fn_arg_pCamera;
+        if (!pCamera || strcmp(pCamera->field_1E_cam_name, pFileRec->field_0_fileName) == 0)
+        {
+            continue;
+        }
+
+        std::vector<std::string>& files = sCameraFiles[{ pCamera->field_1A_level, pCamera->field_18_path, pCamera->field_14_xpos, pCamera->field_16_ypos }];
+        if (std::find(files.begin(), files.end(), pFileRec->field_0_fileName) == files.end())
+        {
+            files.emplace_back(pFileRec->field_0_fileName);
+        }
+    }
+}
+
+static void AddFile(const char* pFileName, std::vector<ResourcePrefetcher::File>& files)
+{
+    LvlFileRecord* pRec = sLvlArchive_5BC520.Find_File_Record_433160(pFileName);
+    if (!pRec)
+    {
+        return;
+    }
+
+    const int startSector = pRec->field_C_start_sector + sLvlArchive_5BC520.field_4_cd_pos;
+    for (const ResourcePrefetcher::File& file : files)
+    {
+        if (file.mStartSector == startSector)
+        {
+            return;
+        }
+    }
+    files.push_back({ startSector, pRec->field_10_num_sectors });
+}
+
+static void AddCamera(const Map& map, int xpos, int ypos, std::vector<ResourcePrefetcher::File>& files)
+{
+    if (xpos < 0 || ypos < 0 || xpos >= sPath_dword_BB47C0->field_6_cams_on_x || ypos >= sPath_dword_BB47C0->field_8_cams_on_y)
+    {
+        return;
+    }
+
+    // Same look up as Map::Create_Camera_4829E0
+    const BYTE* pPathData = *map.field_54_path_res_array.field_0_pPathRecs[map.field_2_current_path];
+    auto pCamName = reinterpret_cast<const CameraName*>(&pPathData[(xpos + (ypos * sPath_dword_BB47C0->field_6_cams_on_x)) * sizeof(CameraName)]);
+    if (!pCamName->name[0])
+    {
+        return;
+    }
+
+    char camFileName[16] = {};
+    strncpy(camFileName, pCamName->name, ALIVE_COUNTOF(CameraName::name));
+    strcat(camFileName, ".CAM");
+    AddFile(camFileName, files);
+
+    auto it = sCameraFiles.find({ map.field_0_current_level, map.field_2_current_path, static_cast<__int16>(xpos), static_cast<__int16>(ypos) });
+    if (it != sCameraFiles.end())
+    {
+        for (const std::string& fileName : it->second)
+        {
+            AddFile(fileName.c_str(), files);
+        }
+    }
+}
+
+void ResourcePrefetch_OnCameraChanged(Map& map)
+{
+    ResourcePrefetcher* pPrefetcher = ResourcePrefetch_Get();
+    if (!pPrefetcher || !sPath_dword_BB47C0 || !map.field_2C_camera_array[0])
+    {
+        return;
+    }
+
+    PSX_RECT currentRect = {};
+    map.Get_Camera_World_Rect_481410(CameraPos::eCamCurrent_0, &currentRect);
+
+    int heroX = (currentRect.x + currentRect.w) / 2;
+    int heroY = (currentRect.y + currentRect.h) / 2;
+    if (sActiveHero_5C1B68 && sActiveHero_5C1B68->field_C0_path_number == map.field_2_current_path)
+    {
+        heroX = FP_GetExponent(sActiveHero_5C1B68->field_B8_xpos);
+        heroY = FP_GetExponent(sActiveHero_5C1B68->field_BC_ypos);
+    }
+
+    struct Neighbour
+    {
+        Camera* mpCamera;
+        int mDistance;
+    };
+
+    std::vector<Neighbour> neighbours;
+    for (CameraPos pos : { CameraPos::eCamTop_1, CameraPos::eCamBottom_2, CameraPos::eCamLeft_3, CameraPos::eCamRight_4 })
+    {
+        PSX_RECT rect = {};
+        if (map.Get_Camera_World_Rect_481410(pos, &rect))
+        {
+            const int dx = std::max({ rect.x - heroX, 0, heroX - rect.w });
+            const int dy = std::max({ rect.y - heroY, 0, heroY - rect.h });
+            neighbours.push_back({ map.field_2C_camera_array[static_cast<int>(pos)], dx + dy });
+        }
+    }
+
+    std::stable_sort(neighbours.begin(), neighbours.end(), [](const Neighbour& lhs, const Neighbour& rhs)
+    {
+        return lhs.mDistance < rhs.mDistance;
+    });
+
+    // Going to a neighbour loads its neighbours, the ones next to the current camera are already loaded
+    std::vector<ResourcePrefetcher::File> files;
+    const int cx = map.field_D0_cam_x_idx;
+    const int cy = map.field_D2_cam_y_idx;
+    for (const Neighbour& neighbour : neighbours)
+    {
+        const int nx = neighbour.mpCamera->field_14_xpos;
+        const int ny = neighbour.mpCamera->field_16_ypos;
+        const int offsets[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+        for (const auto& offset : offsets)
+        {
+            const int x = nx + offset[0];
+            const int y = ny + offset[1];
+            if (std::abs(x - cx) + std::abs(y - cy) == 2)
+            {
+                AddCamera(map, x, y, files);
+            }
+        }
+    }
+
+    if (sLvlArchive_5BC520.Is_Mapped())
+    {
+        // Nothing needs copying, the OS can read the pages in
+        for (const ResourcePrefetcher::File& file : files)
+        {
+            sLvlArchive_5BC520.Will_Need(file.mStartSector, file.mNumSectors);
+        }
+        return;
+    }
+
+    pPrefetcher->Want(files);
+}
+
+namespace Test
+{
+    static void ResourcePrefetch_ReadAhead_Test()
+    {
+        const char* kFileName = "prefetch_test.tmp";
+
+        std::vector<BYTE> fileData(8 * kSectorSize);
+        for (size_t i = 0; i < fileData.size(); i++)
+        {
+            fileData[i] = static_cast<BYTE>(i * 7 + i / kSectorSize);
+        }
+
+        FILE* hFile = fopen(kFileName, "wb");
+        ASSERT_NE(nullptr, hFile);
+        fwrite(fileData.data(), 1, fileData.size(), hFile);
+        fclose(hFile);
+
+        {
+            ResourcePrefetcher prefetcher(kPrefetchThreads, 4 * kSectorSize);
+            prefetcher.SetArchive(kFileName);
+
+            // The last file doesn't fit in the budget
+            prefetcher.Want({ { 3, 2 }, { 1, 1 }, { 5, 3 } });
+
+            const auto timeOut = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!(prefetcher.IsReady(3) && prefetcher.IsReady(1)) && std::chrono::steady_clock::now() < timeOut)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            std::vector<BYTE> buffer(2 * kSectorSize);
+            ASSERT_EQ(true, prefetcher.Take(3, 2, buffer.data()));
+            ASSERT_EQ(0, memcmp(buffer.data(), &fileData[3 * kSectorSize], buffer.size()));
+
+            // Taken files are gone
+            ASSERT_EQ(false, prefetcher.Take(3, 2, buffer.data()));
+            ASSERT_EQ(false, prefetcher.Take(5, 3, buffer.data()));
+
+            // Sector 1 is no longer wanted
+            prefetcher.Want({ { 6, 1 } });
+            ASSERT_EQ(false, prefetcher.IsReady(1));
+
+            const ResourcePrefetchStats stats = prefetcher.Stats();
+            ASSERT_EQ(1u, stats.mHits);
+            ASSERT_EQ(2u, stats.mMisses);
+            ASSERT_EQ(1u, stats.mUnused);
+        }
+
+        remove(kFileName);
+    }
+
+    void ResourcePrefetchTests()
+    {
+        ResourcePrefetch_ReadAhead_Test();
+    }
+}
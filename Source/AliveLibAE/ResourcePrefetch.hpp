@@ -0,0 +1,107 @@
+#pragma once
+
+#include "FunctionFwd.hpp"
+#include "ResourceManager.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <vector>
+#include <string>
+
+class Map;
+
+namespace Test
+{
+    void ResourcePrefetchTests();
+}
+
+struct ResourcePrefetchStats
+{
+    unsigned int mHits = 0;       // Had already been read ahead
+    unsigned int mLateHits = 0;   // Was still being read ahead, waited for it to finish
+    unsigned int mMisses = 0;     // Read from the LVL as normal
+    unsigned int mPrefetched = 0; // Files read ahead
+    unsigned int mUnused = 0;     // Read ahead but dropped before anything loaded them
+    size_t mBytesHeld = 0;
+};
+
+// Reads files of the open LVL on worker threads before the resource manager asks for them. Only the raw
+// sectors are read, the resource manager still allocates the block and copies them in to it on the game
+// thread so nothing else has to be thread safe.
+class ResourcePrefetcher
+{
+public:
+    struct File
+    {
+        int mStartSector; // The same sector vLoadFile_StateMachine_464A70 seeks to
+        int mNumSectors;
+    };
+
+    ResourcePrefetcher(int threadCount, size_t budgetBytes);
+    ~ResourcePrefetcher();
+
+    // Sets the LVL that files are read from, nullptr stops reading. Drops everything read from the old one.
+    void SetArchive(const char* pFilePath);
+
+    // Replaces the files to read ahead, most wanted first. Files that don't fit in the budget are skipped and
+    // files that were read but are no longer wanted are dropped.
+    void Want(const std::vector<File>& files);
+
+    // True if the file has been read ahead and can be taken without waiting.
+    bool IsReady(int startSector);
+
+    // Copies the file in to pBuffer and returns true if it was read ahead, waits for it if it is still being
+    // read. Returns false if the file needs reading as normal.
+    bool Take(int startSector, int numSectors, void* pBuffer);
+
+    ResourcePrefetchStats Stats();
+
+private:
+    enum class State
+    {
+        eQueued,
+        eReading,
+        eReady,
+    };
+
+    struct Entry
+    {
+        int mNumSectors = 0;
+        unsigned int mPriority = 0;
+        State mState = State::eQueued;
+        std::vector<BYTE> mData;
+    };
+
+    using TEntries = std::map<int, Entry>;
+
+    void WorkerThread();
+    void Drop(TEntries::iterator it);
+
+    std::vector<std::thread> mThreads;
+    std::mutex mLock;
+    std::condition_variable mWorkReady;
+    std::condition_variable mReadDone;
+    TEntries mEntries; // By start sector
+    std::string mArchivePath;
+    unsigned int mArchiveId = 0;
+    size_t mBudgetBytes = 0;
+    ResourcePrefetchStats mStats;
+    bool mQuit = false;
+};
+
+// Returns the prefetcher sized by gResourcePrefetchBudgetKb, or nullptr when it is turned off.
+ResourcePrefetcher* ResourcePrefetch_Get();
+
+// Tells the prefetcher which LVL sLvlArchive_5BC520 has open, nullptr if it failed to open.
+void ResourcePrefetch_OnArchiveOpened(const char* pFilePath);
+
+// Remembers which files each camera loaded so they can be read ahead the next time the camera is close by.
+void ResourcePrefetch_OnFileLoading(ResourceManager::ResourceManager_FileRecord* pFileRec);
+
+// Reads ahead the cameras the next screen change could load, the neighbours of the current camera's
+// neighbours, nearest to the hero first.
+void ResourcePrefetch_OnCameraChanged(Map& map);
+
+// Memory the files that are read ahead can use in KB, 0 or less turns it off.
+extern int gResourcePrefetchBudgetKb;
@@ -248,6 +248,7 @@ public:
 
     void SetBrain(TScrabAIFn fn);
     bool BrainIs(TScrabAIFn fn);
+    const char* BrainName() const;
 public:
     EXPORT void M_Stand_0_4A8220();
     EXPORT void M_Walk_1_4A84D0();
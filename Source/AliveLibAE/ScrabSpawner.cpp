@@ -102,20 +102,11 @@ void ScrabSpawner::vUpdate_4AB510()
         field_40_bFindSpawnedScrab = FALSE;
         if (field_3C_spawned_scrab_id != -1)
         {
-            for (int i=0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_3C_spawned_scrab_id, Types::eScrab_112);
+            if (pObj)
             {
-                BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
-                {
-                    break;
-                }
-
-                if (pObj->field_4_typeId == Types::eScrab_112 && pObj->field_C_objectId == field_3C_spawned_scrab_id)
-                {
-                    // Redundant ??
-                    field_3C_spawned_scrab_id = pObj->field_8_object_id;
-                    break;
-                }
+                // Redundant ??
+                field_3C_spawned_scrab_id = pObj->field_8_object_id;
             }
         }
     }
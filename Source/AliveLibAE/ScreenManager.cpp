@@ -8,6 +8,9 @@
 #include "Primitives.hpp"
 #include "VRam.hpp"
 #include "Psx.hpp"
+#include "AnimationFrameCache.hpp"
+#include "CameraCache.hpp"
+#include "CamDecoder.hpp"
 
 ALIVE_VAR(1, 0x5BB5F4, ScreenManager*, pScreenManager_5BB5F4, nullptr);
 ALIVE_ARY(1, 0x5b86c8, SprtTPage, 300, sSpriteTPageBuffer_5B86C8, {});
@@ -157,7 +160,7 @@ namespace Oddlib
 
         }
 
-        BitsLogic(int& aPrev, ScreenManager* aStrat)
+        BitsLogic(int& aPrev, CamVlcDecoder* aStrat)
             : param1(0), param2(0), param3(0), param4(0)
         {
             // Grab 3x next bits
@@ -198,7 +201,7 @@ namespace Oddlib
 
 }
 
-int ScreenManager::next_bits()
+int CamVlcDecoder::next_bits()
 {
     int ret = 0;
     if (g_left7_array <= 0)
@@ -224,7 +227,7 @@ int ScreenManager::next_bits()
 }
 
 
-void ScreenManager::vlc_decode(WORD* aCamSeg, WORD* aDst)
+void CamVlcDecoder::vlc_decode(const WORD* aCamSeg, WORD* aDst)
 {
     unsigned int vlcPtrIndex = 0;
     unsigned int camSrcPtrIndex = 0;
@@ -314,7 +317,7 @@ void ScreenManager::vlc_decode(WORD* aCamSeg, WORD* aDst)
 
 
 // This function takes a 16x240 strip of bits and processes as 16x16 sized macro blocks, thus there are 240/16=15 macro blocks
-void ScreenManager::process_segment(WORD* aVlcBufferPtr, int xPos)
+void CamVlcDecoder::process_segment(WORD* aVlcBufferPtr, int xPos)
 {
     g_pointer_to_vlc_buffer = aVlcBufferPtr;       // This is decoding one 16x240 seg
 
@@ -332,7 +335,7 @@ void ScreenManager::process_segment(WORD* aVlcBufferPtr, int xPos)
     }
 }
 
-void ScreenManager::vlc_decoder(int aR, int aG, int aB, signed int aWidth, int aVramX, int aVramY)
+void CamVlcDecoder::vlc_decoder(int aR, int aG, int aB, signed int aWidth, int aVramX, int aVramY)
 {
     while (aWidth != 2) // Quad tree through 16, 8, 4, 2 sizes
     {
@@ -358,19 +361,18 @@ void ScreenManager::vlc_decoder(int aR, int aG, int aB, signed int aWidth, int a
     write_4_pixel_block(r, g, b, aVramX, aVramY);
 }
 
-static void SetPixel16(WORD* pLocked, DWORD pitch, int x, int y, WORD colour)
+static void SetPixel16(WORD* pPixels, DWORD pitch, int x, int y, WORD colour)
 {
-    y += (512/2)+16; // Write to lower half of vram
-    pLocked[x + (y * pitch)] = colour;
+    pPixels[x + (y * pitch)] = colour;
 }
 
-void ScreenManager::write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddlib::BitsLogic& aG, const Oddlib::BitsLogic& aB, int aVramX, int aVramY)
+void CamVlcDecoder::write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddlib::BitsLogic& aG, const Oddlib::BitsLogic& aB, int aVramX, int aVramY)
 {
     using namespace Oddlib;
 
-    WORD* pData = reinterpret_cast<WORD*>(sPsxVram_C1D160.field_4_pLockedPixels);
-    DWORD pitch = sPsxVram_C1D160.field_10_locked_pitch / 2;
-    
+    WORD* pData = mpPixels;
+    const DWORD pitch = mPitch;
+
     // Will go out of bounds due to macro blocks being 16x16, hence bounds check
     if (aVramY < 240)
     {
@@ -388,6 +390,31 @@ void ScreenManager::write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddli
 const int kStripSize = 16;
 const int kNumStrips = 640 / kStripSize;
 
+void CamVlcDecoder::DecodeCamera(const WORD* pCamBits, WORD* pPixels, int pitch)
+{
+    // Same size as the VLC resource DecompressCameraToVRam_40EF60 used to allocate for every camera
+    mVlcBuffer.resize(0x7E00 / sizeof(WORD));
+    mpPixels = pPixels;
+    mPitch = pitch;
+
+    const WORD* pIter = pCamBits;
+    for (int i = 0; i < kNumStrips; i++)
+    {
+        const WORD stripSize = *pIter;
+        pIter++;
+
+        if (stripSize > 0)
+        {
+            vlc_decode(pIter, mVlcBuffer.data());
+            process_segment(mVlcBuffer.data(), i * kStripSize);
+        }
+
+        pIter += (stripSize / sizeof(WORD));
+    }
+
+    mpPixels = nullptr;
+}
+
 static bool IsHackedAOCamera(WORD** ppBits)
 {
     // If they are its a "hacked" camera from paulsapps level editor. This editor used an
@@ -430,31 +457,30 @@ void ScreenManager::DecompressCameraToVRam_40EF60(WORD** ppBits)
     }
     else
     {
-        BYTE** ppVlc = ResourceManager::Alloc_New_Resource_49BED0(ResourceManager::Resource_VLC, 0, 0x7E00); // 4 KB
-        if (ppVlc)
+        if (BMP_Lock_4F1FF0(&sPsxVram_C1D160))
         {
-            if (BMP_Lock_4F1FF0(&sPsxVram_C1D160))
+            // Write to lower half of vram
+            const int pitch = sPsxVram_C1D160.field_10_locked_pitch / 2;
+            WORD* pCameraPixels = reinterpret_cast<WORD*>(sPsxVram_C1D160.field_4_pLockedPixels) + ((256 + 16) * pitch);
+
+            CameraCache* pCache = CameraCache_Get();
+            const CameraCache::Key key = CameraCache_KeyOf(reinterpret_cast<BYTE**>(ppBits));
+            const DWORD checksum = pCache ? CameraCache::Checksum(*ppBits) : 0;
+            if (!pCache || !pCache->CopyTo(key, checksum, pCameraPixels, pitch))
             {
-                WORD* pIter = *ppBits;
-                for (int i = 0; i < kNumStrips; i++)
+                static CamDecoder sDecoder;
+                sDecoder.DecodeCamera(*ppBits, pCameraPixels, pitch);
+                if (pCache)
                 {
-                    const WORD stripSize = *pIter;
-                    pIter++;
-
-                    if (stripSize > 0)
-                    {
-                        vlc_decode(pIter, reinterpret_cast<WORD*>(*ppVlc));
-                        process_segment(reinterpret_cast<WORD*>(*ppVlc), i * kStripSize);
-                    }
-
-                    pIter += (stripSize / sizeof(WORD));
+                    pCache->Add(key, checksum, pCameraPixels, pitch);
                 }
-                BMP_unlock_4F2100(&sPsxVram_C1D160);
             }
-            ResourceManager::FreeResource_49C330(ppVlc);
+            BMP_unlock_4F2100(&sPsxVram_C1D160);
         }
     }
 
+    AnimFrameCache_OnVRamWritten({ 0, 256 + 16, 640, 240 });
+
     UnsetDirtyBits_40EDE0(0);
     UnsetDirtyBits_40EDE0(1);
     UnsetDirtyBits_40EDE0(2);
@@ -4,6 +4,7 @@
 #include "Psx.hpp"
 #include "FixedPoint.hpp"
 #include "Primitives.hpp"
+#include <vector>
 
 struct Prim_Sprt;
 
@@ -34,6 +35,34 @@ namespace Oddlib
     struct BitsLogic;
 }
 
+// Decodes the VLC compressed strips of a CAM's Bits resource. All the decoding state lives in the decoder so
+// each thread can have its own. This is the original bit at a time decoder, CamDecoder is the fast one and is
+// tested against this.
+class CamVlcDecoder
+{
+public:
+    static const int kWidth = 640;
+    static const int kHeight = 240;
+
+    // Decodes the whole camera in to kWidth x kHeight rgb565 pixels, pitch is in pixels.
+    void DecodeCamera(const WORD* pCamBits, WORD* pPixels, int pitch);
+
+    void process_segment(WORD* aVlcBufferPtr, int xPos);
+    void vlc_decode(const WORD* aCamSeg, WORD* aDst);
+    void vlc_decoder(int aR, int aG, int aB, signed int aWidth, int aVramX, int aVramY);
+    void write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddlib::BitsLogic& aG, const Oddlib::BitsLogic& aB, int aVramX, int aVramY);
+    int next_bits();
+
+private:
+    std::vector<WORD> mVlcBuffer;
+    WORD* mpPixels = nullptr;
+    int mPitch = 0;
+
+    signed int g_left7_array = 0;
+    int g_right25_array = 0;
+    unsigned short int* g_pointer_to_vlc_buffer = nullptr;
+};
+
 struct SprtTPage
 {
     Prim_Sprt mSprt;
@@ -60,11 +89,6 @@ public:
     virtual BaseGameObject* VDestructor(signed int flags) override;
     virtual void VUpdate() override {}
 
-    void process_segment(WORD* aVlcBufferPtr, int xPos);
-    void vlc_decode(WORD* aCamSeg, WORD* aDst);
-    void vlc_decoder(int aR, int aG, int aB, signed int aWidth, int aVramX, int aVramY);
-    void write_4_pixel_block(const Oddlib::BitsLogic& aR, const Oddlib::BitsLogic& aG, const Oddlib::BitsLogic& aB, int aVramX, int aVramY);
-
     EXPORT void DecompressCameraToVRam_40EF60(WORD** ppBits);
 
     EXPORT ScreenManager* ctor_40E3E0(BYTE** ppBits, FP_Point* pCameraOffset);
@@ -73,7 +97,6 @@ public:
    
     EXPORT void dtor_40E490();
     EXPORT BaseGameObject* vdtor_40E460(signed int flags);
-    int next_bits();
 
     EXPORT static int CC GetTPage_40F040(TPageMode tp, TPageAbr abr, int* xpos, int* ypos);
     
@@ -110,10 +133,6 @@ public:
     int field_5C_padding;
     int field_60_padding;
     DirtyBits field_64_20x16_dirty_bits[8];
-
-    signed int g_left7_array = 0;
-    int g_right25_array = 0;
-    unsigned short int* g_pointer_to_vlc_buffer = nullptr;
 };
 //ALIVE_ASSERT_SIZEOF(ScreenManager, 0x1A4u);
 
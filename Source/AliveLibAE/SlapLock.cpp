@@ -12,6 +12,7 @@
 #include "PossessionFlicker.hpp"
 #include "Particle.hpp"
 #include "ParticleBurst.hpp"
+#include "ObjectTypeIndex.hpp"
 
 SlapLock* SlapLock::ctor_43DC80(Path_SlapLock* pTlv, int tlvInfo)
 {
@@ -55,15 +56,10 @@ SlapLock* SlapLock::ctor_43DC80(Path_SlapLock* pTlv, int tlvInfo)
 
     field_130_has_ghost = field_118_pTlv->field_18_has_ghost;
 
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> slapLockOrbWhirlWinds(gBaseGameObject_list_BB47C4, Types::eSlapLock_OrbWhirlWind_60);
+    while (BaseGameObject* pObj = slapLockOrbWhirlWinds.Next())
     {
-        BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eSlapLock_OrbWhirlWind_60 && static_cast<SlapLockWhirlWind*>(pObj)->SwitchId() == field_118_pTlv->field_14_target_tomb_id2)
+        if (static_cast<SlapLockWhirlWind*>(pObj)->SwitchId() == field_118_pTlv->field_14_target_tomb_id2)
         {
             field_130_has_ghost = Choice_short::eNo_0;
         }
@@ -234,19 +230,10 @@ void SlapLock::vUpdate_43DF90()
 
             if (field_134_id != -1)
             {
-                for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+                BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_134_id, Types::eAbilityRing_104);
+                if (pObj)
                 {
-                    BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                    if (!pObj)
-                    {
-                        break;
-                    }
-
-                    if (pObj->field_4_typeId == Types::eAbilityRing_104 && pObj->field_C_objectId == field_134_id)
-                    {
-                        field_134_id = pObj->field_8_object_id;
-                        break;
-                    }
+                    field_134_id = pObj->field_8_object_id;
                 }
             }
         }
@@ -33,6 +33,8 @@
 #include "AmbientSound.hpp"
 #include "VRam.hpp"
 #include "Electrocute.hpp"
+#include "ObjectGrid.hpp"
+#include "ObjectTypeIndex.hpp"
 
 const SfxDefinition stru_5607E0[17] =
 {
@@ -387,6 +389,11 @@ bool Slig::BrainIs(TSligAIFn fn)
     return ::BrainIs(fn, field_154_brain_state, sSligAITable);
 }
 
+const char* Slig::BrainName() const
+{
+    return ::BrainName(field_154_brain_state, sSligAITable);
+}
+
 Slig* Slig::ctor_4B1370(Path_Slig* pTlv, int tlvInfo)
 {
     ctor_408240(17);
@@ -1822,18 +1829,10 @@ void Slig::M_Sleeping_32_4B89A0()
 void Slig::M_SleepingToStand_33_4B8C50()
 {
     // OWI hack - kill all particles, even if they're not ours!
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> snoozeParticles(gBaseGameObject_list_BB47C4, Types::eSnoozeParticle_124);
+    while (BaseGameObject* pObj = snoozeParticles.Next())
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eSnoozeParticle_124)
-        {
-            static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
-        }
+        static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
     }
 
     if (field_20_animation.field_92_current_frame >= 2 && field_20_animation.field_92_current_frame <= 10)
@@ -2451,14 +2450,9 @@ void Slig::M_Beat_51_4B6C00()
             field_BC_ypos - k2Scaled
         );
 
-        for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+        ObjectsNear<BaseAliveGameObject> nearObjs(gBaseAliveGameObjects_5C1B7C, hitRect);
+        while (BaseAliveGameObject* pObj = nearObjs.Next())
         {
-            BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-            if (!pObj)
-            {
-                break;
-            }
-
             if (pObj != this)
             {
                 if (pObj->field_4_typeId == Types::eMudokon_110 || pObj->field_4_typeId == Types::eCrawlingSlig_26)
@@ -3241,15 +3235,10 @@ __int16 Slig::AI_ListenToGlukkon_IdleListen(BaseAliveGameObject* pGlukkonObj, Li
                         {
                             field_108_next_motion = eSligMotions::M_LiftGrip_46_4B3700;
 
-                            for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+                            ObjectsOfType<BaseAliveGameObject> sligs(gBaseAliveGameObjects_5C1B7C, Types::eSlig_125);
+                            while (BaseAliveGameObject* pFoundSlig = sligs.Next())
                             {
-                                BaseAliveGameObject* pFoundSlig = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-                                if (!pFoundSlig)
-                                {
-                                    break;
-                                }
-
-                                if (pFoundSlig->field_4_typeId == Types::eSlig_125 && pFoundSlig != this && pFoundSlig->field_108_next_motion == eSligMotions::M_LiftGrip_46_4B3700)
+                                if (pFoundSlig != this && pFoundSlig->field_108_next_motion == eSligMotions::M_LiftGrip_46_4B3700)
                                 {
                                     field_108_next_motion = eSligMotions::M_StandIdle_0_4B4EC0;
                                 }
@@ -4794,32 +4783,25 @@ void Slig::Init_4BB0D0()
         break;
 
     case Path_Slig::StartState::ListeningToGlukkon_6:
-        for (int i=0; i<gBaseGameObject_list_BB47C4->Size(); i++)
+    {
+        ObjectsOfType<BaseGameObject> glukkons(gBaseGameObject_list_BB47C4, Types::eGlukkon_67);
+        while (BaseGameObject* pObj = glukkons.Next())
         {
-            BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-            if (!pObj)
+            auto pGlukkon = static_cast<BaseAliveGameObject*>(pObj);
+            if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(
+                pGlukkon->field_C2_lvl_number,
+                pGlukkon->field_C0_path_number,
+                pGlukkon->field_B8_xpos,
+                pGlukkon->field_BC_ypos,
+                0))
             {
+                field_208_glukkon_obj_id = pGlukkon->field_8_object_id;
+                sSligsUnderControlCount_BAF7E8++;
+                field_216_flags.Set(Flags_216::eBit1_FollowGlukkon);
+                SetBrain(&Slig::AI_ListeningToGlukkon_4_4B9D20);
+                field_11C_ai_sub_state = AI_ListeningToGlukkon_States::IdleListening_1;
                 break;
             }
-
-            if (pObj->field_4_typeId == Types::eGlukkon_67)
-            {
-                auto pGlukkon = static_cast<BaseAliveGameObject*>(pObj);
-                if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(
-                    pGlukkon->field_C2_lvl_number,
-                    pGlukkon->field_C0_path_number,
-                    pGlukkon->field_B8_xpos,
-                    pGlukkon->field_BC_ypos,
-                    0))
-                {
-                    field_208_glukkon_obj_id = pGlukkon->field_8_object_id;
-                    sSligsUnderControlCount_BAF7E8++;
-                    field_216_flags.Set(Flags_216::eBit1_FollowGlukkon);
-                    SetBrain(&Slig::AI_ListeningToGlukkon_4_4B9D20);
-                    field_11C_ai_sub_state = AI_ListeningToGlukkon_States::IdleListening_1;
-                    break;
-                }
-            }
         }
 
         if (!field_208_glukkon_obj_id)
@@ -4827,6 +4809,7 @@ void Slig::Init_4BB0D0()
             SetBrain(&Slig::AI_Inactive_32_4B9430);
         }
         break;
+    }
 
     default:
         SetBrain(&Slig::AI_Paused_33_4B8DD0);
@@ -6637,14 +6620,9 @@ BaseAliveGameObject* Slig::FindBeatTarget_4BD070(int /*typeToFind*/, int gridBlo
         true
     );
 
-    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsNear<BaseAliveGameObject> nearObjs(gBaseAliveGameObjects_5C1B7C, hitRect);
+    while (BaseAliveGameObject* pObj = nearObjs.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
         if (pObj != this && pObj->field_4_typeId == Types::eMudokon_110)
         {
             PSX_RECT bRect = {};
@@ -6791,25 +6769,17 @@ int Slig::vGetSaveState_4BFB10(Slig_State* pState)
 
     if (field_114_flags.Get(Flags_114::e114_Bit11_Electrocuting))
     {
-        for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+        ObjectsOfType<BaseGameObject> electrocutes(gBaseGameObject_list_BB47C4, Types::eElectrocute_150);
+        while (BaseGameObject* pObj = electrocutes.Next())
         {
-            BaseGameObject* pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-            if (!pObj)
+            auto pElectrocute = static_cast<Electrocute*>(pObj);
+            if (pElectrocute->field_20_target_obj_id == field_8_object_id)
             {
+                pState->field_1E_r = pElectrocute->field_24_r;
+                pState->field_20_g = pElectrocute->field_26_g;
+                pState->field_22_b = pElectrocute->field_28_b;
                 break;
             }
-
-            if (pObj->field_4_typeId == Types::eElectrocute_150)
-            {
-                auto pElectrocute = static_cast<Electrocute*>(pObj);
-                if (pElectrocute->field_20_target_obj_id == field_8_object_id)
-                {
-                    pState->field_1E_r = pElectrocute->field_24_r;
-                    pState->field_20_g = pElectrocute->field_26_g;
-                    pState->field_22_b = pElectrocute->field_28_b;
-                    break;
-                }
-            }
         }
     }
     pState->field_24_bFlipX = field_20_animation.field_4_flags.Get(AnimFlags::eBit5_FlipX);
@@ -6982,15 +6952,10 @@ __int16 Slig::HeardGlukkonToListenTo_4B9690(GameSpeakEvents glukkonSpeak)
         return 0;
     }
 
-    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsOfType<BaseAliveGameObject> sligs(gBaseAliveGameObjects_5C1B7C, Types::eSlig_125);
+    while (BaseAliveGameObject* pObj = sligs.Next())
     {
-        BaseAliveGameObject*pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj != this && pObj->field_4_typeId == Types::eSlig_125)
+        if (pObj != this)
         {
             auto* pOtherSlig = static_cast<Slig*>(pObj);
             if (pOtherSlig->field_CC_sprite_scale == sControlledCharacter_5C1B8C->field_CC_sprite_scale && 
@@ -541,6 +541,7 @@ private:
 public:
     void SetBrain(TSligAIFn fn);
     bool BrainIs(TSligAIFn fn);
+    const char* BrainName() const;
 private:
     int field_118_tlvInfo;
 public:
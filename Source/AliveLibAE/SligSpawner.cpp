@@ -78,20 +78,11 @@ void SligSpawner::vUpdate_409830()
 
         if (field_3C_spawned_slig_obj_id != -1)
         {
-            for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+            BaseGameObject* pObj = BaseGameObject::Find_By_TlvId(field_3C_spawned_slig_obj_id, Types::eSlig_125);
+            if (pObj)
             {
-                auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-                if (!pObj)
-                {
-                    break;
-                }
-
-                if (pObj->field_4_typeId == Types::eSlig_125 && pObj->field_C_objectId == field_3C_spawned_slig_obj_id)
-                {
-                    // Seems redundant ?
-                    field_3C_spawned_slig_obj_id = pObj->field_8_object_id;
-                    break;
-                }
+                // Seems redundant ?
+                field_3C_spawned_slig_obj_id = pObj->field_8_object_id;
             }
         }
     }
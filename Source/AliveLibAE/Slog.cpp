@@ -23,6 +23,7 @@
 #include "SwitchStates.hpp"
 #include "PsxDisplay.hpp"
 #include "Mudokon.hpp"
+#include "ObjectTypeIndex.hpp"
 
 ALIVE_VAR(1, 0xBAF7F2, short, sSlogCount_BAF7F2, 0);
 
@@ -1099,18 +1100,10 @@ void Slog::M_MoveHeadDownwards_16_4C70D0()
 
 void Slog::M_Bark_17_4C7000()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> snoozeParticles(gBaseGameObject_list_BB47C4, Types::eSnoozeParticle_124);
+    while (BaseGameObject* pObj = snoozeParticles.Next())
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eSnoozeParticle_124)
-        {
-            static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
-        }
+        static_cast<SnoozeParticle*>(pObj)->field_1E4_state = SnoozeParticle::SnoozeParticleState::BlowingUp_2;
     }
 
     if (field_108_next_motion != -1)
@@ -3246,26 +3239,18 @@ void Slog::MoveOnLine_4C5DA0()
 
 Bone* Slog::FindBone_4C25B0()
 {
-    for (int i = 0; i < gBaseGameObject_list_BB47C4->Size(); i++)
+    ObjectsOfType<BaseGameObject> bones(gBaseGameObject_list_BB47C4, Types::eBone_11);
+    while (BaseGameObject* pObj = bones.Next())
     {
-        auto pObj = gBaseGameObject_list_BB47C4->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eBone_11)
+        auto pBone = static_cast<Bone*>(pObj);
+        if (pBone->VCanThrow_49E350())
         {
-            auto pBone = static_cast<Bone*>(pObj);
-            if (pBone->VCanThrow_49E350())
+            if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pBone->field_C2_lvl_number, pBone->field_C0_path_number, pBone->field_B8_xpos, pBone->field_BC_ypos, 0) &&
+                pBone->field_D6_scale == field_D6_scale)
             {
-                if (gMap_5C3030.Is_Point_In_Current_Camera_4810D0(pBone->field_C2_lvl_number, pBone->field_C0_path_number, pBone->field_B8_xpos, pBone->field_BC_ypos, 0) &&
-                    pBone->field_D6_scale == field_D6_scale)
+                if (FP_Abs(field_BC_ypos - pBone->field_BC_ypos) <= FP_FromInteger(50) || pBone->VCanBeEaten_411560())
                 {
-                    if (FP_Abs(field_BC_ypos - pBone->field_BC_ypos) <= FP_FromInteger(50) || pBone->VCanBeEaten_411560())
-                    {
-                        return pBone;
-                    }
+                    return pBone;
                 }
             }
         }
@@ -3577,23 +3562,15 @@ __int16 Slog::PlayerOrNakedSligNear_4C26A0()
         return 1;
     }
 
-    for (int i = 0; i < gBaseAliveGameObjects_5C1B7C->Size(); i++)
+    ObjectsOfType<BaseAliveGameObject> crawlingSligs(gBaseAliveGameObjects_5C1B7C, Types::eCrawlingSlig_26);
+    while (BaseAliveGameObject* pObj = crawlingSligs.Next())
     {
-        BaseAliveGameObject* pObj = gBaseAliveGameObjects_5C1B7C->ItemAt(i);
-        if (!pObj)
-        {
-            break;
-        }
-
-        if (pObj->field_4_typeId == Types::eCrawlingSlig_26)
+        // Is this naked slig near?
+        if (FP_Abs(pObj->field_B8_xpos - field_B8_xpos) < kMinXDist &&
+            FP_Abs(pObj->field_BC_ypos - field_BC_ypos) < kMinYDist &&
+            pObj->field_CC_sprite_scale == field_CC_sprite_scale)
         {
-            // Is this naked slig near?
-            if (FP_Abs(pObj->field_B8_xpos - field_B8_xpos) < kMinXDist &&
-                FP_Abs(pObj->field_BC_ypos - field_BC_ypos) < kMinYDist &&
-                pObj->field_CC_sprite_scale == field_CC_sprite_scale)
-            {
-                return 1;
-            }
+            return 1;
         }
     }
     return 0;
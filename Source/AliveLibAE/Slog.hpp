@@ -276,6 +276,11 @@ private:
     EXPORT __int16 Facing_4C4020(FP xpos);
 
 public:
+    unsigned __int16 BrainState() const
+    {
+        return field_120_brain_state_idx;
+    }
+
     int field_118_target_id;
     __int16 field_11C_biting_target;
 private:
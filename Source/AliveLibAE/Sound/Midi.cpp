@@ -213,52 +213,62 @@ EXPORT signed __int16 CC SND_VAB_Load_4C9FE0(SoundBlockInfo* pSoundBlockInfo, __
         return 0;
     }
 
-    int vabBodySize = 0;
-    if (sbEnable_PCOpen_5CA4B0)
-    {
-        vabBodySize = pVabBodyFile->field_14_file_size;
-    }
-    else
-    {
-        vabBodySize = pVabBodyFile->field_10_num_sectors << 11; // TODO * 4096 ?
-    }
-
-    // Load the VB file data
-    BYTE** ppVabBody = GetMidiVars()->Alloc_New_Resource(ResourceManager::Resource_VabBody, vabId, vabBodySize);
-    if (!ppVabBody)
+    // The VB is only read while the samples are loaded so a mapped LVL can be used as is
+    BYTE** ppVabBody = nullptr;
+    const BYTE* pVabBody = sLvlArchive_5BC520.Map_File(pVabBodyFile);
+    if (!pVabBody)
     {
-        // Maybe filed due to OOM cause its huge, free the abe resources and try again
-        if (!GetMidiVars()->sSnd_ReloadAbeResources())
+        int vabBodySize = 0;
+        if (sbEnable_PCOpen_5CA4B0)
         {
-            GetMidiVars()->sSnd_ReloadAbeResources() = TRUE;
-            sActiveHero_5C1B68->Free_Resources_44D420();
+            vabBodySize = pVabBodyFile->field_14_file_size;
+        }
+        else
+        {
+            vabBodySize = pVabBodyFile->field_10_num_sectors << 11; // TODO * 4096 ?
         }
 
-        // Compact/reclaim any other memory we can too
-        GetMidiVars()->Reclaim_Memory(0);
-
-        // If it fails again there is no recovery, in either case caller will restore abes resources
+        // Load the VB file data
         ppVabBody = GetMidiVars()->Alloc_New_Resource(ResourceManager::Resource_VabBody, vabId, vabBodySize);
         if (!ppVabBody)
         {
-            return 0;
+            // Maybe filed due to OOM cause its huge, free the abe resources and try again
+            if (!GetMidiVars()->sSnd_ReloadAbeResources())
+            {
+                GetMidiVars()->sSnd_ReloadAbeResources() = TRUE;
+                sActiveHero_5C1B68->Free_Resources_44D420();
+            }
+
+            // Compact/reclaim any other memory we can too
+            GetMidiVars()->Reclaim_Memory(0);
+
+            // If it fails again there is no recovery, in either case caller will restore abes resources
+            ppVabBody = GetMidiVars()->Alloc_New_Resource(ResourceManager::Resource_VabBody, vabId, vabBodySize);
+            if (!ppVabBody)
+            {
+                return 0;
+            }
         }
-    }
 
-    // Now we can read the actual VB data
-    sLvlArchive_5BC520.Read_File_4330A0(pVabBodyFile, *ppVabBody);
+        // Now we can read the actual VB data
+        sLvlArchive_5BC520.Read_File_4330A0(pVabBodyFile, *ppVabBody);
+        pVabBody = *ppVabBody;
+    }
 
     // Convert the records in the header to internal representation
     pSoundBlockInfo->field_8_vab_id = SsVabOpenHead_4FC620(reinterpret_cast<VabHeader*>(pSoundBlockInfo->field_C_pVabHeader));
 
     // Load actual sample data
 
-    SsVabTransBody_4FC840(reinterpret_cast<VabBodyRecord*>(*ppVabBody), static_cast<short>(pSoundBlockInfo->field_8_vab_id));
+    SsVabTransBody_4FC840(reinterpret_cast<VabBodyRecord*>(const_cast<BYTE*>(pVabBody)), static_cast<short>(pSoundBlockInfo->field_8_vab_id));
 
     SsVabTransCompleted_4FE060(SS_WAIT_COMPLETED);
 
     // Now the sound samples are loaded we don't need the VB data anymore
-    GetMidiVars()->FreeResource(ppVabBody);
+    if (ppVabBody)
+    {
+        GetMidiVars()->FreeResource(ppVabBody);
+    }
     return 1;
 }
 
@@ -355,6 +365,8 @@ EXPORT void CC SND_Load_VABS_4CA350(SoundBlockInfo* pSoundBlockInfo, int reverb)
 
 int CC SFX_SfxDefinition_Play_4CA420(const SfxDefinition* sfxDef, __int16 volume, __int16 pitch_min, __int16 pitch_max)
 {
+    // The channels the note went on to can't be taken by the sequencer before their pitch is set
+    SsExt_Lock lock;
     if (!volume)
     {
         volume = sfxDef->field_3_default_volume;
@@ -430,6 +442,7 @@ EXPORT void CC SFX_SetPitch_4CA510(const SfxDefinition* pSfx, int channelsBits,
 
 EXPORT int CC SND_4CA5D0(int program, int vabId, int note, __int16 vol, __int16 min, __int16 max)
 {
+    SsExt_Lock lock;
     int volClamped = 0;
     if (vol < 10)
     {
@@ -481,6 +494,7 @@ EXPORT int CC SND_4CA5D0(int program, int vabId, int note, __int16 vol, __int16
 
 int CC SFX_SfxDefinition_Play_4CA700(const SfxDefinition* sfxDef, __int16 volLeft, __int16 volRight, __int16 pitch_min, __int16 pitch_max)
 {
+    SsExt_Lock lock;
     if (pitch_min == 0x7FFF)
     {
         pitch_min = sfxDef->field_4_pitch_min;
@@ -531,6 +545,7 @@ int CC SFX_SfxDefinition_Play_4CA700(const SfxDefinition* sfxDef, __int16 volLef
 
 EXPORT void CC SND_Stop_Channels_Mask_4CA810(DWORD bitMask)
 {
+    SsExt_Lock lock;
     for (int i = 0; i < 24; i++) // TODO: Constant
     {
         // Does the index match a bit in the bitmask?
@@ -544,6 +559,7 @@ EXPORT void CC SND_Stop_Channels_Mask_4CA810(DWORD bitMask)
 
 EXPORT void SND_Stop_All_Seqs_4CA850()
 {
+    SsExt_Lock lock;
     // TODO: Why is there 16 of these but 32 of sMidiStruct2Ary32_C13400? Seems like they should match in size
     GetMidiVars()->sSeqsPlaying_count_word() = 0;
     for (short i = 0; i < 16; i++)
@@ -564,6 +580,7 @@ EXPORT void SND_Stop_All_Seqs_4CA850()
 
 EXPORT void SND_Seq_Stop_4CA8E0()
 {
+    SsExt_Lock lock;
     for (short i = 0; i < 16; i++)
     {
         if (GetMidiVars()->sSeq_Ids_word().ids[i] >= 0)
@@ -581,6 +598,7 @@ EXPORT void SND_Seq_Stop_4CA8E0()
 
 EXPORT signed __int16 CC SND_SEQ_PlaySeq_4CA960(unsigned __int16 idx, __int16 repeatCount, __int16 bDontStop)
 {
+    SsExt_Lock lock;
     OpenSeqHandle& rec = GetMidiVars()->sSeqDataTable()[idx];
     if (!rec.field_C_ppSeq_Data)
     {
@@ -644,6 +662,7 @@ EXPORT signed __int16 CC SND_SEQ_PlaySeq_4CA960(unsigned __int16 idx, __int16 re
 
 EXPORT __int16 CC SND_SEQ_Play_4CAB10(unsigned __int16 idx, __int16 repeatCount, __int16 volLeft, __int16 volRight)
 {
+    SsExt_Lock lock;
     OpenSeqHandle& rec = GetMidiVars()->sSeqDataTable()[idx];
     if (!rec.field_C_ppSeq_Data)
     {
@@ -749,6 +768,7 @@ EXPORT void CC SND_SEQ_SetVol_4CAD20(int idx, __int16 volLeft, __int16 volRight)
 
 EXPORT void CC SND_SEQ_Stop_4CAE60(unsigned __int16 idx)
 {
+    SsExt_Lock lock;
     if (GetMidiVars()->sSeqDataTable()[idx].field_A_id_seqOpenId != -1 && GetMidiVars()->sSeqDataTable()[idx].field_C_ppSeq_Data)
     {
         if (SsIsEos_4FDA80(GetMidiVars()->sSeqDataTable()[idx].field_A_id_seqOpenId, 0))
@@ -7,6 +7,12 @@
 #include "Sound.hpp" // SoundEntry structure
 #include "Sys.hpp" // SYS_GetTicks
 #include "PathData.hpp" // SoundBlockInfo, SeqPathDataRecord
+#include "AdsrEnvelope.hpp"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 
 struct VagAtr
@@ -219,6 +225,7 @@ EXPORT void CC MIDI_Wait_4FCE50();
 
 void SsExt_CloseAllVabs()
 {
+    SsExt_Lock lock;
     for (int i = 0; i < kMaxVabs; i++)
     {
         if (gSpuVars->sVagCounts()[i] > 0)
@@ -230,6 +237,7 @@ void SsExt_CloseAllVabs()
 
 void SsExt_StopPlayingSamples()
 {
+    SsExt_Lock lock;
     for (int i = 0; i < kNumChannels; i++)
     {
         if (gSpuVars->sMidi_Channels().channels[i].field_1C_adsr.field_3_state)
@@ -249,17 +257,20 @@ EXPORT void CC SSInit_4FC230()
 
 EXPORT void CC SpuInitHot_4FC320()
 {
+    SsExt_Lock lock;
     gSpuVars->sMidi_Inited_dword() = 1;
     gSpuVars->sMidiTime() = SYS_GetTicks();
 }
 
 EXPORT void SsEnd_4FC350()
 {
+    SsExt_Lock lock;
     gSpuVars->sMidi_Inited_dword() = 0;
 }
 
 EXPORT void CC SsSetMVol_4FC360(__int16 left, __int16 right)
 {
+    SsExt_Lock lock;
     gSpuVars->sGlobalVolumeLevel_left() = left;
     gSpuVars->sGlobalVolumeLevel_right() = right;
 }
@@ -325,6 +336,7 @@ EXPORT int CC SND_SoundsDat_Read_4FC4E0(VabHeader *pVabHeader, VabBodyRecord *pV
 
 EXPORT void CC SsVabClose_4FC5B0(int vabId)
 {
+    SsExt_Lock lock;
     SsUtAllKeyOff_4FDFE0(0); // TODO: Check argument ??
 
     if (gSpuVars->sVagCounts()[vabId] - 1 >= 0)
@@ -343,6 +355,7 @@ EXPORT void CC SsVabClose_4FC5B0(int vabId)
 
 EXPORT __int16 CC SsVabOpenHead_4FC620(VabHeader* pVabHeader)
 {
+    SsExt_Lock lock;
     if (!pVabHeader)
     {
         return -1;
@@ -426,16 +439,22 @@ EXPORT void CC SsVabTransBody_4FC840(VabBodyRecord* pVabBody, __int16 vabId)
         return;
     }
 
+    // The sequencer lock is only taken to publish each entry, holding it over the reads would stop the audio thread
+    // mixing until the whole VAB had loaded
     gSpuVars->sSoundDatFileHandle() = IO_Open("sounds.dat", "rb");
     gSpuVars->sSoundDatIsNull() = gSpuVars->sSoundDatFileHandle() == nullptr;
 
     assert(vabId < 4);
     VabHeader* pVabHeader = gSpuVars->spVabHeaders()[vabId];
     const int vagCount = gSpuVars->sVagCounts()[vabId];
+    std::vector<BYTE> sampleData;
     for (int i = 0; i < vagCount; i++)
     {
         SoundEntry* pEntry = &gSpuVars->sSoundEntryTable16().table[vabId][i];
-        memset(pEntry, 0, sizeof(SoundEntry));
+        {
+            SsExt_Lock lock;
+            memset(pEntry, 0, sizeof(SoundEntry));
+        }
 
         if (!(i & 7))
         {
@@ -451,6 +470,13 @@ EXPORT void CC SsVabTransBody_4FC840(VabBodyRecord* pVabBody, __int16 vabId)
 
         if (sampleLen > 0)
         {
+            // Read the sample data in to a temp buffer, 16 bit mono as SND_New is asked for below
+            const int kBlockAlign = 2;
+            sampleData.assign(sampleLen * kBlockAlign, 0);
+            const bool bRead = SND_SoundsDat_Read_4FC4E0(pVabHeader, pVabBody, i, sampleData.data()) != 0;
+
+            SsExt_Lock lock;
+
             // Find matching converted vag to set field_C / field_6_adsr
             const int unused_field = sub_4FC470(pVabHeader, pVabBody, i);
             const BYTE unused_copy = unused_field != 0 ? 4 : 0;
@@ -470,22 +496,10 @@ EXPORT void CC SsVabTransBody_4FC840(VabBodyRecord* pVabBody, __int16 vabId)
                 }
             }
 
-            // Allocate pEntry
-            if (GetSoundAPI().SND_New(pEntry, sampleLen, 44100, 16, 0) == 0)
+            // Allocate pEntry and load it into the sound buffer
+            if (GetSoundAPI().SND_New(pEntry, sampleLen, 44100, 16, 0) == 0 && bRead)
             {
-                // Allocate a temp buffer to read sounds.dat bytes into
-                void* pTempBuffer = ae_malloc_4F4E60(sampleLen * pEntry->field_1D_blockAlign);
-                if (pTempBuffer)
-                {
-                    // Read the sample data
-                    memset(pTempBuffer, 0, sampleLen * pEntry->field_1D_blockAlign);
-                    if (SND_SoundsDat_Read_4FC4E0(pVabHeader, pVabBody, i, pTempBuffer))
-                    {
-                        // Load it into the sound buffer
-                        GetSoundAPI().SND_Load(pEntry, pTempBuffer, sampleLen);
-                    }
-                    ae_free_4F4EA0(pTempBuffer);
-                }
+                GetSoundAPI().SND_Load(pEntry, sampleData.data(), sampleLen);
             }
         }
     }
@@ -711,6 +725,14 @@ EXPORT int CC MIDI_PlayMidiNote_4FCB30(int vabId, int program, int note, int lef
 
 EXPORT void CC MIDI_Wait_4FCE50()
 {
+    // Notes start on the frame they are due on when the audio thread plays the sequencer, spinning there would only
+    // hold up the audio
+    if (SsExt_SeqOnAudioThread())
+    {
+        gSpuVars->sMidi_WaitUntil() = 0;
+        return;
+    }
+
     while (SYS_GetTicks() < gSpuVars->sMidi_WaitUntil())
     {
 
@@ -721,6 +743,7 @@ EXPORT void CC MIDI_Wait_4FCE50()
 
 EXPORT int CC MIDI_PlayerPlayMidiNote_4FCE80(int vabId, int program, int note, int leftVol, int rightVol, int volume)
 {
+    SsExt_Lock lock;
     if (gSpuVars->sSoundDatIsNull())
     {
         return 0;
@@ -739,6 +762,7 @@ EXPORT int CC MIDI_PlayerPlayMidiNote_4FCE80(int vabId, int program, int note, i
 
 EXPORT int CC SsVoKeyOn_4FCF10(int vabIdAndProgram, int pitch, unsigned __int16 leftVol, unsigned __int16 rightVol)
 {
+    SsExt_Lock lock;
     MIDI_Stop_Existing_Single_Note_4FCFF0((vabIdAndProgram & 127) | (((vabIdAndProgram >> 8) & 31) << 8), pitch);
 
     if (gSpuVars->sSoundDatIsNull())
@@ -1144,6 +1168,7 @@ EXPORT void CC MIDI_SkipBytes_4FD6C0(MIDI_SeqSong* pData, int length)
 
 EXPORT __int16 CC SsSeqOpen_4FD6D0(BYTE* pSeqData, __int16 seqIdx)
 {
+    SsExt_Lock lock;
     // Read header
     SeqHeader seqHeader = {};
     MIDI_Read_SEQ_Header_4FD870(&pSeqData, &seqHeader, sizeof(SeqHeader));
@@ -1226,6 +1251,7 @@ EXPORT void CC MIDI_Read_SEQ_Header_4FD870(BYTE** pSrc, SeqHeader* pDst, unsigne
 
 EXPORT void CC SsSeqClose_4FD8D0(__int16 idx)
 {
+    SsExt_Lock lock;
     SsSeqStop_4FD9C0(idx);
     gSpuVars->sMidiSeqSongs(idx).field_C_volume = 0;
     gSpuVars->sMidiSeqSongs(idx).field_0_seq_data = 0;
@@ -1235,6 +1261,7 @@ EXPORT void CC SsSeqClose_4FD8D0(__int16 idx)
 
 EXPORT void CC SsSeqPlay_4FD900(unsigned __int16 idx, char repeatMode, __int16 repeatCount)
 {
+    SsExt_Lock lock;
     if (idx < 32u)
     {
         MIDI_SeqSong& rec = gSpuVars->sMidiSeqSongs(idx);
@@ -1271,6 +1298,7 @@ EXPORT void CC SsSeqPlay_4FD900(unsigned __int16 idx, char repeatMode, __int16 r
 
 EXPORT void CC SsSeqStop_4FD9C0(__int16 idx)
 {
+    SsExt_Lock lock;
     if (gSpuVars->sMidiSeqSongs(idx).field_0_seq_data)
     {
         gSpuVars->sMidiSeqSongs(idx).field_2B_repeatMode = 0;
@@ -1299,6 +1327,7 @@ EXPORT void CC SsSeqStop_4FD9C0(__int16 idx)
 
 EXPORT unsigned __int16 CC SsIsEos_4FDA80(__int16 idx, __int16 kZero)
 {
+    SsExt_Lock lock;
     if (!kZero)
     {
         if (gSpuVars->sMidiSeqSongs(idx).field_0_seq_data)
@@ -1315,6 +1344,7 @@ EXPORT unsigned __int16 CC SsIsEos_4FDA80(__int16 idx, __int16 kZero)
 
 EXPORT void CC SsSeqSetVol_4FDAC0(__int16 idx, __int16 volLeft, __int16 volRight)
 {
+    SsExt_Lock lock;
     if (gSpuVars->sMidiSeqSongs(idx).field_0_seq_data)
     {
         // TODO: Refactor
@@ -1328,6 +1358,7 @@ EXPORT void CC SsSeqSetVol_4FDAC0(__int16 idx, __int16 volLeft, __int16 volRight
 
 EXPORT void CC MIDI_SetTempo_4FDB80(__int16 idx, __int16 kZero, __int16 tempo)
 {
+    SsExt_Lock lock;
     if (!kZero)
     {
         if (gSpuVars->sMidiSeqSongs(idx).field_10_quaterNoteRes >= 0) // TODO: BUG - will div zero?
@@ -1351,6 +1382,12 @@ EXPORT void CC SsSetTickMode_4FDC20(int)
 
 EXPORT void CC SsSeqCalledTbyT_4FDC80()
 {
+    if (SsExt_SeqOnAudioThread())
+    {
+        return;
+    }
+
+    SsExt_Lock lock;
     if (!gSpuVars->sbDisableSeqs())
     {
         const DWORD currentTime = SYS_GetTicks();
@@ -1374,6 +1411,9 @@ EXPORT void CC SsSeqCalledTbyT_4FDC80()
     }
 }
 
+// Keeps the reciprocals of each channel's phase lengths between ticks
+static AdsrEnvelope sAdsrEnvelopes[kNumChannels];
+
 EXPORT void CC MIDI_ADSR_Update_4FDCE0()
 {
     for (int i = 0; i < kNumChannels; i++)
@@ -1409,19 +1449,14 @@ EXPORT void CC MIDI_ADSR_Update_4FDCE0()
                 }
                 else
                 {
-                    MIDI_Set_Volume_4FDE80(
-                        pChannel,
-                        (signed __int64)(((double)timeDiff2 / (double)pChannel->field_1C_adsr.field_4_attack
-                            + (double)timeDiff2 / (double)pChannel->field_1C_adsr.field_4_attack
-                            - (double)timeDiff2 / (double)pChannel->field_1C_adsr.field_4_attack * ((double)timeDiff2 / (double)pChannel->field_1C_adsr.field_4_attack))
-                            * (double)pChannel->field_C_vol));
+                    MIDI_Set_Volume_4FDE80(pChannel, sAdsrEnvelopes[i].Attack(timeDiff2, pChannel->field_1C_adsr.field_4_attack, pChannel->field_C_vol));
                     break;
                 }
             case 3:
                 if (timeDiff1 < pChannel->field_1C_adsr.field_6_sustain)
                 {
                     const int v8 = pChannel->field_C_vol * (16 - pChannel->field_1C_adsr.field_8_decay) >> 4;
-                    MIDI_Set_Volume_4FDE80(pChannel, pChannel->field_C_vol - timeDiffSquared * v8 / (pChannel->field_1C_adsr.field_6_sustain * pChannel->field_1C_adsr.field_6_sustain));
+                    MIDI_Set_Volume_4FDE80(pChannel, sAdsrEnvelopes[i].Decay(timeDiffSquared, pChannel->field_1C_adsr.field_6_sustain, pChannel->field_C_vol, v8));
                     break;
                 }
                 pChannel->field_1C_adsr.field_3_state = 3;
@@ -1457,7 +1492,7 @@ EXPORT void CC MIDI_ADSR_Update_4FDCE0()
                 }
                 else
                 {
-                    MIDI_Set_Volume_4FDE80(pChannel, pChannel->field_C_vol - timeDiffSquared * pChannel->field_C_vol / (pChannel->field_1C_adsr.field_A_release * pChannel->field_1C_adsr.field_A_release));
+                    MIDI_Set_Volume_4FDE80(pChannel, sAdsrEnvelopes[i].Release(timeDiffSquared, pChannel->field_1C_adsr.field_A_release, pChannel->field_C_vol));
                 }
                 break;
             default:
@@ -1504,6 +1539,7 @@ EXPORT __int16 CC MIDI_PitchBend_4FDEC0(__int16 program, __int16 pitch)
 
 EXPORT __int16 CC SsUtChangePitch_4FDF70(__int16 voice, int /*vabId*/, int /*prog*/, __int16 old_note, __int16 old_fine, __int16 new_note, __int16 new_fine)
 {
+    SsExt_Lock lock;
     const float freq = pow(1.059463094359f, (float)(new_fine + ((new_note - (signed int)old_note) << 7) - old_fine) * 0.0078125f);
     GetSoundAPI().SND_Buffer_Set_Frequency1(gSpuVars->sMidi_Channels().channels[voice].field_0_sound_buffer_field_4, freq);
     return 0;
@@ -1512,6 +1548,7 @@ EXPORT __int16 CC SsUtChangePitch_4FDF70(__int16 voice, int /*vabId*/, int /*pro
 
 EXPORT void CC SsUtAllKeyOff_4FDFE0(int)
 {
+    SsExt_Lock lock;
     // Stop all backwards
     short idx = kNumChannels - 1;
     do
@@ -1523,6 +1560,7 @@ EXPORT void CC SsUtAllKeyOff_4FDFE0(int)
 
 EXPORT __int16 CC SsUtKeyOffV_4FE010(__int16 idx)
 {
+    SsExt_Lock lock;
     MIDI_Channel* pChannel = &gSpuVars->sMidi_Channels().channels[idx];
     if (pChannel->field_1C_adsr.field_3_state)
     {
@@ -1594,3 +1632,138 @@ EXPORT void CC VSyncCallback_4F8C40(TVSyncCallBackFn)
 {
     // Stub
 }
+
+static std::recursive_mutex sSeqMutex;
+static std::atomic<bool> sbSeqOnAudioThread{ false };
+
+SsExt_Lock::SsExt_Lock()
+{
+    sSeqMutex.lock();
+}
+
+SsExt_Lock::~SsExt_Lock()
+{
+    sSeqMutex.unlock();
+}
+
+bool SsExt_SeqOnAudioThread()
+{
+    return sbSeqOnAudioThread;
+}
+
+void SsExt_SetSeqOnAudioThread(bool bOnAudioThread)
+{
+    sbSeqOnAudioThread = bOnAudioThread;
+}
+
+void SsExt_SeqClock::Start(int sampleRate, DWORD startMs)
+{
+    mSampleRate = sampleRate;
+    mStartMs = startMs;
+    mFrame = 0;
+    mFramesToAdvance = 0;
+}
+
+int SsExt_SeqClock::Tick(int maxFrames)
+{
+    // The caller has rendered what the last tick asked for
+    mFrame += mFramesToAdvance;
+
+    SsExt_Lock lock;
+    const DWORD now = FrameToMs(mFrame);
+    gSpuVars->sMidiTime() = now;
+
+    unsigned long long nextFrame = mFrame + maxFrames;
+    if (!gSpuVars->sbDisableSeqs())
+    {
+        for (int i = 0; i < 32; i++)
+        {
+            MIDI_SeqSong& song = gSpuVars->sMidiSeqSongs(i);
+            if (song.field_0_seq_data && song.field_2B_repeatMode == 1)
+            {
+                gSpuVars->MIDI_ParseMidiMessage(i);
+
+                // Everything up to now has been played so this is the time of the song's next event
+                if (song.field_0_seq_data && song.field_2B_repeatMode == 1 && song.field_4_time > now)
+                {
+                    nextFrame = std::min(nextFrame, MsToFrame(song.field_4_time));
+                }
+            }
+        }
+        MIDI_ADSR_Update_4FDCE0();
+    }
+
+    mFramesToAdvance = static_cast<int>(std::max<unsigned long long>(nextFrame - mFrame, 1));
+    return mFramesToAdvance;
+}
+
+unsigned long long SsExt_SeqClock::Frame() const
+{
+    return mFrame;
+}
+
+DWORD SsExt_SeqClock::FrameToMs(unsigned long long frame) const
+{
+    return mStartMs + static_cast<DWORD>((frame * 1000) / mSampleRate);
+}
+
+unsigned long long SsExt_SeqClock::MsToFrame(DWORD ms) const
+{
+    // The first frame whose time is at or after ms
+    const unsigned long long elapsedMs = static_cast<DWORD>(ms - mStartMs);
+    return ((elapsedMs * mSampleRate) + 999) / 1000;
+}
+
+namespace Test
+{
+    static void SsExt_SeqClock_Test()
+    {
+        const DWORD oldMidiTime = gSpuVars->sMidiTime();
+        const char oldDisableSeqs = gSpuVars->sbDisableSeqs();
+        gSpuVars->sbDisableSeqs() = 0;
+
+        // A song that is due to end 10ms in
+        BYTE endOfTrack[] = { 0xFF, 0x2F, 0x00 };
+        const int songIdx = 5;
+        MIDI_SeqSong& song = gSpuVars->sMidiSeqSongs(songIdx);
+        const MIDI_SeqSong oldSong = song;
+        memset(&song, 0, sizeof(MIDI_SeqSong));
+        song.field_0_seq_data = endOfTrack;
+        song.field_1C_pSeqData = endOfTrack;
+        song.field_2B_repeatMode = 1;
+        song.field_18_repeatCount = 1;
+        song.field_2E_seqAccessNum = -1;
+        song.field_4_time = 1000 + 10;
+
+        SsExt_SeqClock clock;
+        clock.Start(44100, 1000);
+
+        // Ticks every 64 frames and then stops short on the frame 10ms is on
+        unsigned long long rendered = 0;
+        int ticks = 0;
+        while (rendered < 441)
+        {
+            ASSERT_EQ(1, SsIsEos_4FDA80(songIdx, 0));
+            rendered += clock.Tick(64);
+            ticks++;
+        }
+        ASSERT_EQ(441u, rendered);
+        ASSERT_EQ(7, ticks);
+        ASSERT_EQ(1, SsIsEos_4FDA80(songIdx, 0));
+
+        // The tick on that frame plays it
+        clock.Tick(64);
+        ASSERT_EQ(441u, clock.Frame());
+        ASSERT_EQ(1010u, gSpuVars->sMidiTime());
+        ASSERT_EQ(0, SsIsEos_4FDA80(songIdx, 0));
+
+        song = oldSong;
+        gSpuVars->sbDisableSeqs() = oldDisableSeqs;
+        gSpuVars->sMidiTime() = oldMidiTime;
+    }
+
+    void PsxSpuApiTests()
+    {
+        SsExt_SeqClock_Test();
+    }
+}
@@ -4,6 +4,11 @@
 #include "Sound/Sound.hpp"
 #include "Io.hpp"
 
+namespace Test
+{
+    void PsxSpuApiTests();
+}
+
 struct ProgAtr
 {
     BYTE field_0_num_tones;
@@ -242,3 +247,44 @@ EXPORT void CC SsSeqCalledTbyT_4FDC80();
 void SsExt_CloseAllVabs();
 
 void SsExt_StopPlayingSamples();
+
+// Held while the sequencer or the MIDI channels are read or changed. Only needed because the audio thread can
+// drive the sequencer, everything the game calls in to takes it and it can be taken more than once.
+class SsExt_Lock
+{
+public:
+    SsExt_Lock();
+    ~SsExt_Lock();
+
+    SsExt_Lock(const SsExt_Lock&) = delete;
+    SsExt_Lock& operator = (const SsExt_Lock&) = delete;
+};
+
+// Plays the sequencer in audio time. Rather than SsSeqCalledTbyT_4FDC80 playing whatever became due in the last
+// 30ms, the audio thread renders up to the frame the next event is due on, plays it and carries on, so notes and
+// ADSR changes land on the frame they are meant to.
+class SsExt_SeqClock
+{
+public:
+    void Start(int sampleRate, DWORD startMs);
+
+    // Plays every event and ADSR change due at the current frame and returns how many frames, at most maxFrames, to
+    // render before calling again.
+    int Tick(int maxFrames);
+
+    // The frame the last Tick was on.
+    unsigned long long Frame() const;
+
+private:
+    DWORD FrameToMs(unsigned long long frame) const;
+    unsigned long long MsToFrame(DWORD ms) const;
+
+    int mSampleRate = 44100;
+    DWORD mStartMs = 0;
+    unsigned long long mFrame = 0;
+    int mFramesToAdvance = 0;
+};
+
+// True while an SsExt_SeqClock is driving the sequencer, SsSeqCalledTbyT_4FDC80 does nothing then.
+bool SsExt_SeqOnAudioThread();
+void SsExt_SetSeqOnAudioThread(bool bOnAudioThread);
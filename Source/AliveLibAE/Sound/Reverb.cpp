@@ -3,15 +3,35 @@
 
 #if USE_SDL2_SOUND
 
+#include "Function.hpp"
 #include <math.h>
 #include <iostream>
 #include <memory>
 #include <vector>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+
+int gReverbEngine = static_cast<int>(ReverbEngine::eFreeverb);
+
+// gReverbEngine as handed to the audio thread
+static std::atomic<int> sReverbWantedEngine{ static_cast<int>(ReverbEngine::eFreeverb) };
+
+// Samples each engine works on at a time
+const int kReverbBlockSize = 1024;
+
+class Reverb
+{
+public:
+    virtual ~Reverb() = default;
+
+    // Adds the reverb of count samples of pDst back on to pDst at volume out of SDL_MIX_MAXVOLUME
+    virtual void Mix(StereoSample_S16* pDst, int count, int volume) = 0;
+};
 
 // Reference https://www.vegardno.net/2016/05/writing-reverb-filter-from-first.html
 
 const int ReverbEchos = 24;
-static StereoSample_S16 sReverbBuffer[1024 * 32] = {};
 const float gReverbMix = 1.0f / ReverbEchos;
 
 class FeedbackBuffer
@@ -32,7 +52,7 @@ public:
     {
         mBuffer[mIdx].left += s.left;
         mBuffer[mIdx].right += s.right;
-        
+
         mIdx++;
 
         if (mIdx >= mSamples)
@@ -54,54 +74,363 @@ public:
     std::vector<StereoSample_S32> mBuffer;
 };
 
-static std::vector<std::unique_ptr<FeedbackBuffer>> gFeedbackBuffers;
+// The original reverb, 24 echoes that each feed back in to themselves
+class EchoReverb final : public Reverb
+{
+public:
+    explicit EchoReverb(int sampleRate)
+    {
+        const int sampleGap = sampleRate / 800;
+        for (int i = 1; i <= ReverbEchos; i++)
+        {
+            mFeedbackBuffers.emplace_back(new FeedbackBuffer((sampleGap + (i * 2)) * i)); // make_unique not in all supports cpp stdlibs
+        }
+    }
 
-void Reverb_Init(int sampleRate)
+    void Mix(StereoSample_S16* pDst, int count, int volume) override
+    {
+        for (int start = 0; start < count; start += kReverbBlockSize)
+        {
+            const int blockCount = std::min(kReverbBlockSize, count - start);
+            for (int i = 0; i < blockCount; i++)
+            {
+                PushSample(pDst[start + i]);
+                Update(i);
+            }
+
+            SDL_MixAudioFormat(reinterpret_cast<Uint8 *>(&pDst[start]), reinterpret_cast<Uint8 *>(mReverbBuffer), AUDIO_S16, blockCount * sizeof(StereoSample_S16), volume);
+            // memcpy(&pDst[start], mReverbBuffer, blockCount * sizeof(StereoSample_S16)); // Uncomment to hear only reverb
+        }
+    }
+
+private:
+    void PushSample(StereoSample_S16 v)
+    {
+        for (auto& buffer : mFeedbackBuffers)
+        {
+            buffer->PushSample(v);
+        }
+    }
+
+    void Update(int index)
+    {
+        mReverbBuffer[index].left = 0;
+        mReverbBuffer[index].right = 0;
+
+        for (auto& buffer : mFeedbackBuffers)
+        {
+            const StereoSample_S32 v = buffer->GetSample();
+
+            mReverbBuffer[index].left += static_cast<signed short>(v.left * gReverbMix);
+            mReverbBuffer[index].right += static_cast<signed short>(v.right * gReverbMix);
+        }
+    }
+
+    std::vector<std::unique_ptr<FeedbackBuffer>> mFeedbackBuffers;
+    StereoSample_S16 mReverbBuffer[kReverbBlockSize] = {};
+};
+
+// Reference https://ccrma.stanford.edu/~jos/pasp/Freeverb.html
+//
+// 8 damped comb filters in parallel then 4 allpass filters in series for each channel. All 24 delay lines
+// are in one buffer and each filter runs over a whole block before the next one so there is nothing to
+// look up per sample.
+class Freeverb final : public Reverb
+{
+public:
+    explicit Freeverb(int sampleRate)
+    {
+        // The tunings are in samples at 44100
+        static const int kCombTuning[kCombCount] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+        static const int kAllpassTuning[kAllpassCount] = { 556, 441, 341, 225 };
+        static const int kStereoSpread = 23;
+
+        const float rateScale = sampleRate / 44100.0f;
+        int totalSize = 0;
+        for (int channel = 0; channel < 2; channel++)
+        {
+            const int spread = channel * kStereoSpread;
+            for (int i = 0; i < kCombCount; i++)
+            {
+                totalSize += InitLine(mCombs[channel][i], totalSize, kCombTuning[i] + spread, rateScale);
+            }
+
+            for (int i = 0; i < kAllpassCount; i++)
+            {
+                totalSize += InitLine(mAllpasses[channel][i], totalSize, kAllpassTuning[i] + spread, rateScale);
+            }
+        }
+        mDelays.resize(totalSize);
+    }
+
+    void Mix(StereoSample_S16* pDst, int count, int volume) override
+    {
+        const float wetVolume = volume / static_cast<float>(SDL_MIX_MAXVOLUME);
+        for (int start = 0; start < count; start += kReverbBlockSize)
+        {
+            const int blockCount = std::min(kReverbBlockSize, count - start);
+
+            // Keeps the feedback from decaying in to denormals which are very slow on x86
+            const float kAntiDenormal = 1e-18f;
+            for (int i = 0; i < blockCount; i++)
+            {
+                mInput[i] = ((pDst[start + i].left + pDst[start + i].right) * kInputGain) + kAntiDenormal;
+            }
+
+            for (int channel = 0; channel < 2; channel++)
+            {
+                float* pWet = mWet[channel];
+                std::fill(pWet, pWet + blockCount, 0.0f);
+
+                for (DelayLine& comb : mCombs[channel])
+                {
+                    Comb(comb, mInput, pWet, blockCount);
+                }
+
+                for (DelayLine& allpass : mAllpasses[channel])
+                {
+                    Allpass(allpass, pWet, blockCount);
+                }
+            }
+
+            for (int i = 0; i < blockCount; i++)
+            {
+                StereoSample_S16& dst = pDst[start + i];
+                dst.left = Saturate(dst.left + (mWet[0][i] * wetVolume));
+                dst.right = Saturate(dst.right + (mWet[1][i] * wetVolume));
+            }
+        }
+    }
+
+private:
+    static const int kCombCount = 8;
+    static const int kAllpassCount = 4;
+
+    // Freeverb's defaults, a room size and damping of 0.5
+    static constexpr float kInputGain = 0.015f;
+    static constexpr float kFeedback = 0.84f;
+    static constexpr float kDamp = 0.2f;
+    static constexpr float kAllpassFeedback = 0.5f;
+
+    struct DelayLine
+    {
+        int mOffset = 0; // In to mDelays
+        int mSize = 0;
+        int mIdx = 0;
+        float mFilterStore = 0.0f;
+    };
+
+    static int InitLine(DelayLine& line, int offset, int tuning, float rateScale)
+    {
+        line.mOffset = offset;
+        line.mSize = std::max(1, static_cast<int>(tuning * rateScale));
+        return line.mSize;
+    }
+
+    static Sint16 Saturate(float value)
+    {
+        return static_cast<Sint16>(std::min(std::max(value, -32768.0f), 32767.0f));
+    }
+
+    // Calls fn(pLine, offset in to the block, count) for each run of the line that doesn't wrap
+    template <typename TFn>
+    void ForEachRun(DelayLine& line, int count, TFn fn)
+    {
+        int i = 0;
+        while (i < count)
+        {
+            const int run = std::min(count - i, line.mSize - line.mIdx);
+            fn(&mDelays[line.mOffset + line.mIdx], i, run);
+            line.mIdx += run;
+            if (line.mIdx == line.mSize)
+            {
+                line.mIdx = 0;
+            }
+            i += run;
+        }
+    }
+
+    void Comb(DelayLine& comb, const float* pIn, float* pOut, int count)
+    {
+        float store = comb.mFilterStore;
+        ForEachRun(comb, count, [&](float* pLine, int offset, int run)
+        {
+            for (int i = 0; i < run; i++)
+            {
+                const float delayed = pLine[i];
+                store = (delayed * (1.0f - kDamp)) + (store * kDamp);
+                pLine[i] = pIn[offset + i] + (store * kFeedback);
+                pOut[offset + i] += delayed;
+            }
+        });
+        comb.mFilterStore = store;
+    }
+
+    void Allpass(DelayLine& allpass, float* pInOut, int count)
+    {
+        ForEachRun(allpass, count, [&](float* pLine, int offset, int run)
+        {
+            for (int i = 0; i < run; i++)
+            {
+                const float delayed = pLine[i];
+                const float in = pInOut[offset + i];
+                pInOut[offset + i] = delayed - in;
+                pLine[i] = in + (delayed * kAllpassFeedback);
+            }
+        });
+    }
+
+    DelayLine mCombs[2][kCombCount];
+    DelayLine mAllpasses[2][kAllpassCount];
+    std::vector<float> mDelays;
+    float mInput[kReverbBlockSize] = {};
+    float mWet[2][kReverbBlockSize] = {};
+};
+
+static Reverb* Reverb_Create(ReverbEngine engine, int sampleRate)
 {
-    const int sampleGap = sampleRate / 800;
-    for (int i = 1; i <= ReverbEchos; i++)
+    if (engine == ReverbEngine::eEchoes)
     {
-        gFeedbackBuffers.emplace_back(new FeedbackBuffer((sampleGap + (i * 2)) * i)); // make_unique not in all supports cpp stdlibs
+        return new EchoReverb(sampleRate);
     }
+    return new Freeverb(sampleRate);
+}
+
+static std::unique_ptr<Reverb> sReverb;
+static int sReverbSampleRate = 0;
+static int sReverbCreatedEngine = -1;
+
+void Reverb_SetEngine(int engine)
+{
+    gReverbEngine = engine;
+    sReverbWantedEngine = engine;
+}
+
+void Reverb_Init(int sampleRate)
+{
+    sReverbSampleRate = sampleRate;
+    sReverbCreatedEngine = sReverbWantedEngine;
+    sReverb.reset(Reverb_Create(static_cast<ReverbEngine>(sReverbCreatedEngine), sampleRate));
 }
 
 void Reverb_DeInit()
 {
-    gFeedbackBuffers.clear();
+    sReverb.reset();
 }
 
-void Reverb_PushSample(StereoSample_S16 v)
+void Reverb_Mix(StereoSample_S16 * dst, SDL_AudioFormat /*format*/, Uint32 len, int volume)
 {
-    for (auto& buffer : gFeedbackBuffers)
+    // The ini is read after the sound system starts
+    if (sReverbCreatedEngine != sReverbWantedEngine)
     {
-        buffer->PushSample(v);
+        Reverb_Init(sReverbSampleRate);
+    }
+
+    if (sReverb)
+    {
+        sReverb->Mix(dst, static_cast<int>(len / sizeof(StereoSample_S16)), volume);
     }
 }
 
-inline void Reverb_Update(int index)
+void Reverb_RunBenchmark()
 {
-    sReverbBuffer[index].left = 0;
-    sReverbBuffer[index].right = 0;
+    const int kSeconds = 10;
+    const int kBufferSamples = 2048; // What the SDL device asks for at a time by default
 
-    for (auto& buffer : gFeedbackBuffers)
+    for (int sampleRate : { 22050, 44100, 48000 })
     {
-        const StereoSample_S32 v = buffer->GetSample();
+        std::vector<StereoSample_S16> buffer(kBufferSamples);
+        for (ReverbEngine engine : { ReverbEngine::eEchoes, ReverbEngine::eFreeverb })
+        {
+            std::unique_ptr<Reverb> pReverb(Reverb_Create(engine, sampleRate));
 
-        sReverbBuffer[index].left += static_cast<signed short>(v.left * gReverbMix);
-        sReverbBuffer[index].right += static_cast<signed short>(v.right * gReverbMix);
+            unsigned int seed = 1;
+            const int totalSamples = sampleRate * kSeconds;
+            double totalMs = 0.0;
+            for (int done = 0; done < totalSamples; done += kBufferSamples)
+            {
+                // Bursts of noise so there is always a tail to work on
+                for (int i = 0; i < kBufferSamples; i++)
+                {
+                    seed = (seed * 1103515245) + 12345;
+                    const Sint16 noise = ((done + i) % sampleRate) < sampleRate / 4 ? static_cast<Sint16>((seed >> 16) & 0x1FFF) - 0x1000 : 0;
+                    buffer[i].left = noise;
+                    buffer[i].right = noise;
+                }
+
+                const auto start = std::chrono::steady_clock::now();
+                pReverb->Mix(buffer.data(), kBufferSamples, SDL_MIX_MAXVOLUME);
+                totalMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            LOG_INFO("Reverb benchmark " << (engine == ReverbEngine::eEchoes ? "echoes" : "freeverb") << " " << sampleRate << "Hz "
+                << totalMs / kSeconds << " ms per second of audio");
+        }
     }
 }
 
-void Reverb_Mix(StereoSample_S16 * dst, SDL_AudioFormat format, Uint32 len, int volume)
+namespace Test
 {
-    for (unsigned int i = 0; i < len / sizeof(StereoSample_S16); i++)
+    static void Reverb_Freeverb_ImpulseTail_Test()
     {
-        Reverb_PushSample(dst[i]);
-        Reverb_Update(i);
+        for (int sampleRate : { 22050, 44100, 48000 })
+        {
+            Freeverb reverb(sampleRate);
+
+            // An impulse then 2 seconds of nothing, mixed in odd sized buffers to cross the block and line ends
+            std::vector<StereoSample_S16> samples(sampleRate * 2);
+            samples[0].left = 30000;
+            samples[0].right = 30000;
+            for (size_t start = 0; start < samples.size(); start += 1500)
+            {
+                reverb.Mix(&samples[start], static_cast<int>(std::min<size_t>(1500, samples.size() - start)), SDL_MIX_MAXVOLUME);
+            }
+
+            // Nothing comes back before the shortest comb, the left channel's first, then it does
+            const int shortestComb = static_cast<int>(1116 * (sampleRate / 44100.0f));
+            for (int i = 1; i < shortestComb; i++)
+            {
+                ASSERT_EQ(0, samples[i].left) << i;
+                ASSERT_EQ(0, samples[i].right) << i;
+            }
+            ASSERT_NE(0, samples[shortestComb].left);
+
+            const auto Energy = [&](size_t from, size_t count)
+            {
+                double energy = 0.0;
+                for (size_t i = from; i < from + count; i++)
+                {
+                    energy += (samples[i].left * samples[i].left) + (samples[i].right * samples[i].right);
+                }
+                return energy;
+            };
+
+            // Rings out over the first half second then dies away
+            const size_t halfSecond = sampleRate / 2;
+            const double first = Energy(0, halfSecond);
+            const double last = Energy(samples.size() - halfSecond, halfSecond);
+            ASSERT_GT(first, 0.0);
+            ASSERT_LT(last, first / 100.0);
+        }
     }
 
-    SDL_MixAudioFormat(reinterpret_cast<Uint8 *>(dst), reinterpret_cast<Uint8 *>(sReverbBuffer), format, len, volume);
-    // memcpy(dst, sReverbBuffer, len); // Uncomment to hear only reverb
+    static void Reverb_Freeverb_Silence_Test()
+    {
+        Freeverb reverb(44100);
+        std::vector<StereoSample_S16> samples(5000);
+        reverb.Mix(samples.data(), static_cast<int>(samples.size()), SDL_MIX_MAXVOLUME);
+        for (const StereoSample_S16& sample : samples)
+        {
+            ASSERT_EQ(0, sample.left);
+            ASSERT_EQ(0, sample.right);
+        }
+    }
+
+    void ReverbTests()
+    {
+        Reverb_Freeverb_ImpulseTail_Test();
+        Reverb_Freeverb_Silence_Test();
+    }
 }
 
 #endif
@@ -5,10 +5,28 @@
 
 #if USE_SDL2_SOUND
 
+namespace Test
+{
+    void ReverbTests();
+}
+
+enum class ReverbEngine
+{
+    eEchoes = 0,   // The original 24 feedback echoes
+    eFreeverb = 1, // Comb + allpass network
+};
+
+// Which ReverbEngine Reverb_Mix uses, as set by the ini. Only the game thread touches it.
+extern int gReverbEngine;
+
+// Sets gReverbEngine and passes it to the audio thread, which switches engine before mixing its next block.
+void Reverb_SetEngine(int engine);
+
 void Reverb_Init(int sampleRate);
 void Reverb_DeInit();
-void Reverb_PushSample(StereoSample_S16 v);
-void Reverb_Update(int index);
 void Reverb_Mix(StereoSample_S16 * dst, SDL_AudioFormat format, Uint32 len, int volume);
 
-#endif
\ No newline at end of file
+// Logs how long each engine takes to process a second of audio at a few sample rates.
+void Reverb_RunBenchmark();
+
+#endif
@@ -0,0 +1,370 @@
+#include "stdafx.h"
+#include "SDLSoundMixer.hpp"
+
+#if USE_SDL2_SOUND
+
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define SOUND_MIX_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define SOUND_MIX_SSE2 0
+#endif
+
+// Sample to accumulator scale for a voice at full volume, SDL_MixAudioFormat's volume and iVolume's 0-127 folded in to one
+static const float kVoiceScale = (kSoundMixVoiceVolume / static_cast<float>(SDL_MIX_MAXVOLUME)) / 127.0f;
+
+// One block of a voice after resampling, mono voices only use mLeft
+struct SoundMixBlock
+{
+    float mLeft[kSoundMixBlockSize];
+    float mRight[kSoundMixBlockSize];
+    float mGain[kSoundMixBlockSize];
+};
+
+static bool Voice_Reached_End(SDLSoundBuffer::AE_SDL_Voice_State& state, float& pos, int frameCount)
+{
+    if (pos >= frameCount)
+    {
+        pos = 0;
+        if (!state.bLoop)
+        {
+            state.eStatus = SDLSoundBufferStatus::Stopped;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns how many frames were written, less than count if the voice stopped
+template <AudioFilterMode FilterMode>
+static int Resample_Mono(SDLSoundBuffer::AE_SDL_Voice_State& state, const Sint16* pSamples, float* pOut, int count)
+{
+    const int sampleCount = state.iSampleCount;
+    const float step = state.fFrequency;
+    float pos = state.fPlaybackPosition;
+
+    int i = 0;
+    while (i < count)
+    {
+        const int idx = static_cast<int>(pos);
+        if (FilterMode == AudioFilterMode::Linear)
+        {
+            const float s1 = pSamples[idx];
+            const float s2 = pSamples[idx + 1 < sampleCount ? idx + 1 : 0];
+            pOut[i] = s1 + ((s2 - s1) * (pos - idx));
+        }
+        else
+        {
+            pOut[i] = pSamples[idx];
+        }
+        i++;
+
+        pos += step;
+        if (Voice_Reached_End(state, pos, sampleCount))
+        {
+            break;
+        }
+    }
+
+    state.fPlaybackPosition = pos;
+    return i;
+}
+
+// Stereo voices are only FMV audio which is already at the output rate so there is no filtering
+static int Resample_Stereo(SDLSoundBuffer::AE_SDL_Voice_State& state, const Sint16* pSamples, float* pLeft, float* pRight, int count)
+{
+    const int frameCount = state.iSampleCount / state.iChannels;
+    const float step = state.fFrequency;
+    float pos = state.fPlaybackPosition;
+
+    int i = 0;
+    while (i < count)
+    {
+        const int idx = static_cast<int>(pos);
+        pLeft[i] = pSamples[idx * 2];
+        pRight[i] = pSamples[(idx * 2) + 1];
+        i++;
+
+        pos += step;
+        if (Voice_Reached_End(state, pos, frameCount))
+        {
+            break;
+        }
+    }
+
+    state.fPlaybackPosition = pos;
+    return i;
+}
+
+// The volume steps by one a frame towards its target and each frame is mixed at the volume after its step
+static void Ramp_Volume(SDLSoundBuffer::AE_SDL_Voice_State& state, float* pGain, int count)
+{
+    int volume = state.iVolume;
+    const int target = state.iVolumeTarget;
+    if (volume == target)
+    {
+        std::fill(pGain, pGain + count, volume * kVoiceScale);
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (volume < target)
+        {
+            volume++;
+        }
+        else if (volume > target)
+        {
+            volume--;
+        }
+        pGain[i] = volume * kVoiceScale;
+    }
+    state.iVolume = volume;
+}
+
+// pDst[i] += pSrc[i] * pGain[i] * scale
+static void Accumulate(float* pDst, const float* pSrc, const float* pGain, float scale, int count)
+{
+    int i = 0;
+#if SOUND_MIX_SSE2
+    const __m128 vScale = _mm_set1_ps(scale);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 src = _mm_mul_ps(_mm_loadu_ps(&pSrc[i]), _mm_mul_ps(_mm_loadu_ps(&pGain[i]), vScale));
+        _mm_storeu_ps(&pDst[i], _mm_add_ps(_mm_loadu_ps(&pDst[i]), src));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        pDst[i] += pSrc[i] * (pGain[i] * scale);
+    }
+}
+
+static Sint16 Saturate_S16(float value)
+{
+    // lrint rounds to nearest like _mm_cvtps_epi32
+    return static_cast<Sint16>(std::lrint(std::min(std::max(value, -32768.0f), 32767.0f)));
+}
+
+void SoundMixBuffer::Begin(int frameCount)
+{
+    if (static_cast<int>(mLeft.size()) < frameCount)
+    {
+        mLeft.resize(frameCount);
+        mRight.resize(frameCount);
+    }
+
+    mFrameCount = frameCount;
+    std::fill(mLeft.begin(), mLeft.begin() + frameCount, 0.0f);
+    std::fill(mRight.begin(), mRight.begin() + frameCount, 0.0f);
+}
+
+void SoundMixBuffer::MixVoice(SDLSoundBuffer::AE_SDL_Voice_State& state, const Sint16* pSamples, AudioFilterMode filterMode)
+{
+    SoundMixBlock block;
+    for (int offset = 0; offset < mFrameCount; offset += kSoundMixBlockSize)
+    {
+        if (state.eStatus != SDLSoundBufferStatus::Playing || state.iSampleCount == 0)
+        {
+            break;
+        }
+
+        const int count = std::min(kSoundMixBlockSize, mFrameCount - offset);
+        if (state.iChannels == 2)
+        {
+            const int mixed = Resample_Stereo(state, pSamples, block.mLeft, block.mRight, count);
+            Ramp_Volume(state, block.mGain, mixed);
+            Accumulate(&mLeft[offset], block.mLeft, block.mGain, 1.0f, mixed);
+            Accumulate(&mRight[offset], block.mRight, block.mGain, 1.0f, mixed);
+        }
+        else
+        {
+            float leftPan = 1.0f;
+            float rightPan = 1.0f;
+            if (gAudioStereo)
+            {
+                if (state.iPan < 0)
+                {
+                    rightPan = (10000 - abs(state.iPan)) / 10000.0f;
+                }
+                else if (state.iPan > 0)
+                {
+                    leftPan = (10000 - abs(state.iPan)) / 10000.0f;
+                }
+            }
+
+            const int mixed = filterMode == AudioFilterMode::Linear ?
+                Resample_Mono<AudioFilterMode::Linear>(state, pSamples, block.mLeft, count) :
+                Resample_Mono<AudioFilterMode::NoFilter>(state, pSamples, block.mLeft, count);
+            Ramp_Volume(state, block.mGain, mixed);
+            Accumulate(&mLeft[offset], block.mLeft, block.mGain, leftPan, mixed);
+            Accumulate(&mRight[offset], block.mLeft, block.mGain, rightPan, mixed);
+        }
+    }
+}
+
+void SoundMixBuffer::Resolve(StereoSample_S16* pOut) const
+{
+    int i = 0;
+#if SOUND_MIX_SSE2
+    const __m128 kMin = _mm_set1_ps(-32768.0f);
+    const __m128 kMax = _mm_set1_ps(32767.0f);
+    for (; i + 4 <= mFrameCount; i += 4)
+    {
+        const __m128i left = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&mLeft[i]), kMin), kMax));
+        const __m128i right = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(&mRight[i]), kMin), kMax));
+
+        // L0 R0 L1 R1 L2 R2 L3 R3
+        const __m128i interleaved = _mm_packs_epi32(_mm_unpacklo_epi32(left, right), _mm_unpackhi_epi32(left, right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pOut[i]), interleaved);
+    }
+#endif
+    for (; i < mFrameCount; i++)
+    {
+        pOut[i].left = Saturate_S16(mLeft[i]);
+        pOut[i].right = Saturate_S16(mRight[i]);
+    }
+}
+
+namespace Test
+{
+    static SDLSoundBuffer::AE_SDL_Voice_State MonoVoice(int sampleCount, int volume, int volumeTarget, float frequency, bool bLoop)
+    {
+        SDLSoundBuffer::AE_SDL_Voice_State state = {};
+        state.iVolume = volume;
+        state.iVolumeTarget = volumeTarget;
+        state.fFrequency = frequency;
+        state.eStatus = SDLSoundBufferStatus::Playing;
+        state.bLoop = bLoop;
+        state.iSampleCount = sampleCount;
+        state.iChannels = 1;
+        state.iBlockAlign = 2;
+        return state;
+    }
+
+    // What RenderMonoSample and SDL_MixAudioFormat did a sample at a time
+    static void Reference_Mix_Mono(SDLSoundBuffer::AE_SDL_Voice_State& state, const Sint16* pSamples, std::vector<StereoSample_S16>& out)
+    {
+        for (auto& outSample : out)
+        {
+            if (state.eStatus != SDLSoundBufferStatus::Playing)
+            {
+                break;
+            }
+
+            if (state.iVolume < state.iVolumeTarget)
+            {
+                state.iVolume++;
+            }
+            else if (state.iVolume > state.iVolumeTarget)
+            {
+                state.iVolume--;
+            }
+
+            const int idx = static_cast<int>(state.fPlaybackPosition);
+            const int s1 = pSamples[idx];
+            const int s2 = pSamples[(idx + 1) % state.iSampleCount];
+            const int s = static_cast<int>(s1 + ((s2 - s1) * (state.fPlaybackPosition - floorf(state.fPlaybackPosition))));
+
+            const int leftPan = state.iPan > 0 ? 10000 - abs(state.iPan) : 10000;
+            const int rightPan = state.iPan < 0 ? 10000 - abs(state.iPan) : 10000;
+            const int left = (((s * leftPan) / 10000) * state.iVolume) / 127;
+            const int right = (((s * rightPan) / 10000) * state.iVolume) / 127;
+            outSample.left = static_cast<Sint16>(outSample.left + ((left * kSoundMixVoiceVolume) / SDL_MIX_MAXVOLUME));
+            outSample.right = static_cast<Sint16>(outSample.right + ((right * kSoundMixVoiceVolume) / SDL_MIX_MAXVOLUME));
+
+            state.fPlaybackPosition += state.fFrequency;
+            if (state.fPlaybackPosition >= state.iSampleCount)
+            {
+                state.fPlaybackPosition = 0;
+                if (!state.bLoop)
+                {
+                    state.eStatus = SDLSoundBufferStatus::Stopped;
+                }
+            }
+        }
+    }
+
+    static void SDLSoundMixer_MatchesPerSampleMix_Test()
+    {
+        const bool savedStereo = gAudioStereo;
+        gAudioStereo = true;
+
+        std::vector<Sint16> samples(150);
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            samples[i] = static_cast<Sint16>(sinf(i * 0.21f) * 20000.0f);
+        }
+
+        // Ramps up while it plays and ends part way through the second block
+        SDLSoundBuffer::AE_SDL_Voice_State voice = MonoVoice(static_cast<int>(samples.size()), 10, 100, 1.7f, false);
+        voice.iPan = -4000;
+        SDLSoundBuffer::AE_SDL_Voice_State reference = voice;
+
+        const int kFrames = 203;
+        SoundMixBuffer mixer;
+        mixer.Begin(kFrames);
+        mixer.MixVoice(voice, samples.data(), AudioFilterMode::Linear);
+
+        std::vector<StereoSample_S16> mixed(kFrames);
+        mixer.Resolve(mixed.data());
+
+        std::vector<StereoSample_S16> expected(kFrames);
+        Reference_Mix_Mono(reference, samples.data(), expected);
+
+        for (int i = 0; i < kFrames; i++)
+        {
+            // The reference truncates at every step
+            ASSERT_NEAR(expected[i].left, mixed[i].left, 2);
+            ASSERT_NEAR(expected[i].right, mixed[i].right, 2);
+        }
+
+        ASSERT_EQ(SDLSoundBufferStatus::Stopped, voice.eStatus);
+        ASSERT_EQ(reference.iVolume, voice.iVolume);
+        ASSERT_EQ(0.0f, voice.fPlaybackPosition);
+
+        gAudioStereo = savedStereo;
+    }
+
+    static void SDLSoundMixer_Saturates_Test()
+    {
+        const bool savedStereo = gAudioStereo;
+        gAudioStereo = true;
+
+        const Sint16 kLoud[2] = { 32767, -32768 };
+
+        // An odd frame count so the tail past the last vector is covered too
+        const int kFrames = 70;
+        SoundMixBuffer mixer;
+        mixer.Begin(kFrames);
+        for (int i = 0; i < 4; i++)
+        {
+            SDLSoundBuffer::AE_SDL_Voice_State voice = MonoVoice(2, 127, 127, 1.0f, true);
+            mixer.MixVoice(voice, kLoud, AudioFilterMode::NoFilter);
+            ASSERT_EQ(SDLSoundBufferStatus::Playing, voice.eStatus);
+        }
+
+        std::vector<StereoSample_S16> mixed(kFrames);
+        mixer.Resolve(mixed.data());
+        for (int i = 0; i < kFrames; i++)
+        {
+            const Sint16 expected = (i % 2) ? -32768 : 32767;
+            ASSERT_EQ(expected, mixed[i].left);
+            ASSERT_EQ(expected, mixed[i].right);
+        }
+
+        gAudioStereo = savedStereo;
+    }
+
+    void SDLSoundMixerTests()
+    {
+        SDLSoundMixer_MatchesPerSampleMix_Test();
+        SDLSoundMixer_Saturates_Test();
+    }
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "SDLSoundBuffer.hpp"
+
+#if USE_SDL2_SOUND
+
+namespace Test
+{
+    void SDLSoundMixerTests();
+}
+
+enum AudioFilterMode
+{
+    NoFilter = 0,
+    Linear = 1,
+};
+
+// Frames of a voice that are mixed together, the voice state is only looked at once per block
+const int kSoundMixBlockSize = 64;
+
+// What SDL_MixAudioFormat was given for each voice, out of SDL_MIX_MAXVOLUME
+const int kSoundMixVoiceVolume = 45;
+
+// Sums voices in to float accumulators, one array per channel so the inner loops are straight runs of
+// multiply-adds. Nothing is clipped until Resolve so loud scenes no longer clip once per voice.
+class SoundMixBuffer
+{
+public:
+    // Clears the accumulators for frameCount frames of output.
+    void Begin(int frameCount);
+
+    // Resamples, ramps and pans the voice in to the accumulators, advancing its playback position and volume
+    // the same way the per sample loop did. Stops the voice if it reaches the end and isn't looping.
+    void MixVoice(SDLSoundBuffer::AE_SDL_Voice_State& state, const Sint16* pSamples, AudioFilterMode filterMode);
+
+    // Writes the accumulators to pOut, saturated to 16 bits.
+    void Resolve(StereoSample_S16* pOut) const;
+
+    int FrameCount() const
+    {
+        return mFrameCount;
+    }
+
+private:
+    std::vector<float> mLeft;
+    std::vector<float> mRight;
+    int mFrameCount = 0;
+};
+
+#endif
@@ -3,6 +3,15 @@
 #include "SDLSoundBuffer.hpp"
 #include "Reverb.hpp"
 #include "Sys.hpp"
+#include "Function.hpp"
+#include <algorithm>
+
+int gAudioBufferSamples = 2048;
+int gAudioLatencyMs = 0;
+bool gAudioThreadSequencer = true;
+
+// Only matters if a post is missed, AudioCallBack normally wakes the render thread well before this
+const Uint32 kRenderWakeTimeoutMs = 50;
 
 void SDLSoundSystem::Init(unsigned int /*sampleRate*/, int /*bitsPerSample*/, int /*isStereo*/)
 {
@@ -23,7 +32,12 @@ void SDLSoundSystem::Init(unsigned int /*sampleRate*/, int /*bitsPerSample*/, in
     mAudioDeviceSpec.format = AUDIO_S16;
     mAudioDeviceSpec.channels = 2;
     mAudioDeviceSpec.freq = 44100;
-    mAudioDeviceSpec.samples = 2048;
+    Uint16 deviceSamples = 256;
+    while (deviceSamples < gAudioBufferSamples && deviceSamples < 0x8000)
+    {
+        deviceSamples *= 2;
+    }
+    mAudioDeviceSpec.samples = deviceSamples;
     mAudioDeviceSpec.userdata = this;
 
     if (SDL_OpenAudio(&mAudioDeviceSpec, NULL) < 0)
@@ -67,7 +81,27 @@ void SDLSoundSystem::Init(unsigned int /*sampleRate*/, int /*bitsPerSample*/, in
     mCreated = true;
 
     // Correctly size the lock free buffer on the main thread before any other threads start
-    mAudioRingBuffer.resize(mAudioDeviceSpec.samples * 2);
+    size_t ringSamples = mAudioDeviceSpec.samples * 2;
+    if (gAudioLatencyMs > 0)
+    {
+        // The device buffer is part of the latency too, but the ring always needs to hold one device buffer
+        const size_t targetSamples = (static_cast<size_t>(gAudioLatencyMs) * mAudioDeviceSpec.freq) / 1000;
+        ringSamples = std::max<size_t>(targetSamples > mAudioDeviceSpec.samples ? targetSamples - mAudioDeviceSpec.samples : 0, mAudioDeviceSpec.samples);
+    }
+    mAudioRingBuffer.resize(ringSamples);
+
+    // Render a device buffer at a time, or half the ring if it is smaller so it is topped up before it runs dry
+    mRenderWatermark = std::min<size_t>(mAudioDeviceSpec.samples, ringSamples / 2);
+    mRenderWake = SDL_CreateSemaphore(0);
+
+    LOG_INFO("Audio ring buffer " << ringSamples << " samples, target latency " << Stats().mTargetLatencyMs << "ms");
+
+    // The original game's code would be changing the sequencer without taking the lock
+    if (gAudioThreadSequencer && !RunningAsInjectedDll())
+    {
+        mSeqClock.Start(mAudioDeviceSpec.freq, SYS_GetTicks());
+        SsExt_SetSeqOnAudioThread(true);
+    }
 
     // TODO: Test just running this on the main thread
     mRenderAudioThread.reset(new std::thread(std::bind(&SDLSoundSystem::RenderAudioThread, this)));
@@ -98,12 +132,19 @@ HRESULT SDLSoundSystem::Release()
         // Stop the audio call back
         SDL_PauseAudio(1);
 
+        // Hand the sequencer back to SsSeqCalledTbyT_4FDC80
+        SsExt_SetSeqOnAudioThread(false);
+
         // Stop audio rendering thread
         mRenderAudioThreadQuit = true;
+        SDL_SemPost(mRenderWake);
         if (mRenderAudioThread && mRenderAudioThread->joinable())
         {
             mRenderAudioThread->join();
         }
+
+        SDL_DestroySemaphore(mRenderWake);
+        mRenderWake = nullptr;
     }
 
     // Shutdown the sound system
@@ -123,22 +164,44 @@ SDLSoundSystem::~SDLSoundSystem()
     // TODO: Clean up outstanding samples in sAE_ActiveVoices
 }
 
+SDLAudioStats SDLSoundSystem::Stats() const
+{
+    SDLAudioStats stats;
+    stats.mCallbacks = mCallbacks;
+    stats.mUnderruns = mUnderruns;
+    stats.mRenderWakes = mRenderWakes;
+
+    if (mAudioDeviceSpec.freq > 0)
+    {
+        const float msPerSample = 1000.0f / mAudioDeviceSpec.freq;
+        stats.mLatencyMs = (mAudioRingBuffer.getAvailableRead() + mAudioDeviceSpec.samples) * msPerSample;
+        stats.mTargetLatencyMs = (mAudioRingBuffer.getSize() + mAudioDeviceSpec.samples) * msPerSample;
+    }
+    return stats;
+}
+
 void SDLSoundSystem::AudioCallBack(Uint8 *stream, int len)
 {
     memset(stream, 0, len);
 
+    mCallbacks++;
+
+    // Play what there is and leave the rest silent rather than dropping the whole buffer
     StereoSample_S16* pSampleBuffer = reinterpret_cast<StereoSample_S16*>(stream);
     const int bufferLenSamples = len / sizeof(StereoSample_S16);
-    const int readAvilSamples = static_cast<int>(mAudioRingBuffer.getAvailableRead());
-    if (readAvilSamples > 0 && readAvilSamples < bufferLenSamples)
+    const int readSamples = std::min(static_cast<int>(mAudioRingBuffer.getAvailableRead()), bufferLenSamples);
+    if (readSamples < bufferLenSamples)
     {
-        LOG_WARNING("Audio buffer underflow!");
+        mUnderruns++;
     }
 
-    if (!mAudioRingBuffer.read(pSampleBuffer, bufferLenSamples))
+    if (readSamples > 0 && !mAudioRingBuffer.read(pSampleBuffer, readSamples))
     {
         LOG_ERROR("Ring buffer read failure!");
     }
+
+    // There is space in the ring buffer now
+    SDL_SemPost(mRenderWake);
 }
 
 
@@ -148,16 +211,20 @@ void SDLSoundSystem::RenderAudioThread()
     while (!mRenderAudioThreadQuit)
     {
         const size_t bufferSize = mAudioRingBuffer.getAvailableWrite();
-        if (bufferSize > 0)
+        if (bufferSize < mRenderWatermark)
         {
-            tmpBuffer.resize(bufferSize);
-            memset(tmpBuffer.data(), 0, tmpBuffer.size() * sizeof(StereoSample_S16));
-            RenderAudio(tmpBuffer.data(), static_cast<int>(tmpBuffer.size()));
-            if (!mAudioRingBuffer.write(tmpBuffer.data(), tmpBuffer.size()))
-            {
-                // Couldn't write all the data, should never happen ??
-                LOG_ERROR("Ring buffer write failed");
-            }
+            SDL_SemWaitTimeout(mRenderWake, kRenderWakeTimeoutMs);
+            continue;
+        }
+
+        mRenderWakes++;
+        tmpBuffer.resize(bufferSize);
+        memset(tmpBuffer.data(), 0, tmpBuffer.size() * sizeof(StereoSample_S16));
+        RenderAudio(tmpBuffer.data(), static_cast<int>(tmpBuffer.size()));
+        if (!mAudioRingBuffer.write(tmpBuffer.data(), tmpBuffer.size()))
+        {
+            // Couldn't write all the data, should never happen ??
+            LOG_ERROR("Ring buffer write failed");
         }
     }
     LOG_INFO("Quit");
@@ -165,46 +232,47 @@ void SDLSoundSystem::RenderAudioThread()
 
 void SDLSoundSystem::RenderAudio(StereoSample_S16* pSampleBuffer, int sampleBufferCount)
 {
-    // Check if our buffer size changes, and if its buffer, then resize the array
-    if (sampleBufferCount > mCurrentSoundBufferSize)
+    // Mix up to each frame the sequencer has something due on, then let it play it before mixing the rest
+    int frame = 0;
+    while (frame < sampleBufferCount)
     {
-        mTempSoundBuffer.resize(sampleBufferCount);
-        mNoReverbBuffer.resize(sampleBufferCount);
-        mCurrentSoundBufferSize = sampleBufferCount;
+        int frameCount = sampleBufferCount - frame;
+        if (SsExt_SeqOnAudioThread())
+        {
+            frameCount = mSeqClock.Tick(std::min(frameCount, kSoundMixBlockSize));
+        }
+
+        MixFrames(pSampleBuffer + frame, frameCount);
+        frame += frameCount;
     }
 
-    if (mTempSoundBuffer.empty())
+    // Do Reverb Pass
+    if (gReverbEnabled)
     {
-        mTempSoundBuffer.resize(sampleBufferCount);
-        mNoReverbBuffer.resize(sampleBufferCount);
+        Reverb_Mix(pSampleBuffer, AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), kMixVolume);
     }
+}
 
-    memset(mNoReverbBuffer.data(), 0, sampleBufferCount * sizeof(StereoSample_S16));
+void SDLSoundSystem::MixFrames(StereoSample_S16* pSampleBuffer, int frameCount)
+{
+    mMixBuffer.Begin(frameCount);
 
     for (int vi = 0; vi < MAX_VOICE_COUNT; vi++)
     {
         SDLSoundBuffer * pVoice = sAE_ActiveVoices[vi];
         if (pVoice)
         {
-            RenderSoundBuffer(*pVoice, pSampleBuffer, sampleBufferCount);
+            RenderSoundBuffer(*pVoice);
         }
     }
 
-    // Do Reverb Pass
-    if (gReverbEnabled)
-    {
-        Reverb_Mix(pSampleBuffer, AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), kMixVolume);
-
-        // Mix our no reverb buffer
-        SDL_MixAudioFormat(reinterpret_cast<Uint8 *>(pSampleBuffer), reinterpret_cast<Uint8 *>(mNoReverbBuffer.data()), AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), kMixVolume);
-    }
+    // Only clipped once all the voices are summed
+    mMixBuffer.Resolve(pSampleBuffer);
 }
 
 
-void SDLSoundSystem::RenderSoundBuffer(SDLSoundBuffer& entry, StereoSample_S16* pSampleBuffer, int sampleBufferCount)
+void SDLSoundSystem::RenderSoundBuffer(SDLSoundBuffer& entry)
 {
-    bool reverbPass = false;
-
     SDLSoundBuffer* pVoice = &entry;
 
     if (pVoice == nullptr || !pVoice->mBuffer || pVoice->mBuffer->empty())
@@ -218,117 +286,9 @@ void SDLSoundSystem::RenderSoundBuffer(SDLSoundBuffer& entry, StereoSample_S16*
         return;
     }
 
-    // Clear Temp Sample Buffer
-    memset(mTempSoundBuffer.data(), 0, sampleBufferCount * sizeof(StereoSample_S16));
-
-    Sint16* pVoiceBufferPtr = reinterpret_cast<Sint16*>(pVoice->GetBuffer()->data());
-
-    for (int i = 0; i < sampleBufferCount; i++)
-    {
-        if (pVoice->mBuffer->empty() || pVoice->mState.eStatus != SDLSoundBufferStatus::Playing || pVoice->mState.iSampleCount == 0)
-        {
-            break;
-        }
-
-        if (pVoice->mState.iVolume < pVoice->mState.iVolumeTarget)
-        {
-            pVoice->mState.iVolume++;
-        }
-        else if (pVoice->mState.iVolume > pVoice->mState.iVolumeTarget)
-        {
-            pVoice->mState.iVolume--;
-        }
-
-        if (pVoice->mState.iChannels == 2)
-        {
-            reverbPass = true; // Todo: determine this with flags in the sound object itself.
-                                // For Stereo buffers. The only time this is played is for FMV's.
-                                // Right now, unless the playback device is at 44100 hz, it sounds awful.
-                                // TODO: Resampling for stereo
-
-            RenderStereoSample(pVoiceBufferPtr, pVoice, i);
-
-        }
-        else
-        {
-            reverbPass = true;
-
-            RenderMonoSample(pVoiceBufferPtr, pVoice, i);
-
-        }
-
-        if (pVoice->mState.fPlaybackPosition >= pVoice->mState.iSampleCount / pVoice->mState.iChannels)
-        {
-            pVoice->mState.fPlaybackPosition = 0;
-            if (!pVoice->mState.bLoop)
-            {
-                pVoice->mState.eStatus = SDLSoundBufferStatus::Stopped;
-            }
-        }
-    }
-
-    if (reverbPass)
-    {
-        SDL_MixAudioFormat(reinterpret_cast<Uint8 *>(pSampleBuffer), reinterpret_cast<Uint8 *>(mTempSoundBuffer.data()), AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), 45);
-    }
-    else
-    {
-        SDL_MixAudioFormat(reinterpret_cast<Uint8 *>(mNoReverbBuffer.data()), reinterpret_cast<Uint8 *>(mTempSoundBuffer.data()), AUDIO_S16, sampleBufferCount * sizeof(StereoSample_S16), 45);
-    }
-}
-
-
-void SDLSoundSystem::RenderMonoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, int i)
-{
-    int s = 0;
-
-    switch (mAudioFilterMode)
-    {
-    case AudioFilterMode::NoFilter:
-        s = pVoiceBufferPtr[static_cast<int>(pVoice->mState.fPlaybackPosition)];
-        break;
-    case AudioFilterMode::Linear:
-        const signed short s1 = pVoiceBufferPtr[static_cast<int>(pVoice->mState.fPlaybackPosition)];
-        const signed short s2 = pVoiceBufferPtr[(static_cast<int>(pVoice->mState.fPlaybackPosition) + 1) % pVoice->mState.iSampleCount];
-
-        s = static_cast<int>((s1 + ((s2 - s1) * (pVoice->mState.fPlaybackPosition - floorf(pVoice->mState.fPlaybackPosition)))));
-        break;
-    }
-
-    signed int leftPan = 10000;
-    signed int rightPan = 10000;
-
-    if (gAudioStereo)
-    {
-        if (pVoice->mState.iPan < 0)
-        {
-            rightPan = 10000 - abs(pVoice->mState.iPan);
-        }
-        else if (pVoice->mState.iPan > 0)
-        {
-            leftPan = 10000 - abs(pVoice->mState.iPan);
-        }
-    }
-    else
-    {
-        signed int r = (leftPan + rightPan) / 2;
-        leftPan = r;
-        rightPan = r;
-    }
-
-    mTempSoundBuffer[i].left = static_cast<signed short>((((s * leftPan) / 10000) * pVoice->mState.iVolume) / 127);
-    mTempSoundBuffer[i].right = static_cast<signed short>((((s * rightPan) / 10000) * pVoice->mState.iVolume) / 127);
-
-    pVoice->mState.fPlaybackPosition += pVoice->mState.fFrequency;
-}
-
-void SDLSoundSystem::RenderStereoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, int i)
-{
-    StereoSample_S16 pSample = reinterpret_cast<StereoSample_S16*>(pVoiceBufferPtr)[static_cast<int>(pVoice->mState.fPlaybackPosition)];
-    mTempSoundBuffer[i].left = static_cast<signed short>((pSample.left * pVoice->mState.iVolume) / 127);
-    mTempSoundBuffer[i].right = static_cast<signed short>((pSample.right * pVoice->mState.iVolume) / 127);
-
-    pVoice->mState.fPlaybackPosition += pVoice->mState.fFrequency;
+    // TODO: Stereo buffers are only used for FMV's, unless the playback device is at 44100 hz they sound awful.
+    // TODO: Resampling for stereo
+    mMixBuffer.MixVoice(pVoice->mState, reinterpret_cast<const Sint16*>(pVoice->GetBuffer()->data()), mAudioFilterMode);
 }
 
 void SDLSoundSystem::AudioCallBackStatic(void* userdata, Uint8 *stream, int len)
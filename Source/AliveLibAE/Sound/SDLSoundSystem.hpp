@@ -2,15 +2,20 @@
 
 #include "Sound.hpp"
 #include "SoundSDL.hpp"
+#include "SDLSoundMixer.hpp"
+#include "PsxSpuApi.hpp"
 #include <thread>
 
 #define CI_DISABLE_ASSERTS
 #include <cinder/audio/dsp/RingBuffer.h>
 
-enum AudioFilterMode
+struct SDLAudioStats
 {
-    NoFilter = 0,
-    Linear = 1,
+    unsigned int mCallbacks = 0;
+    unsigned int mUnderruns = 0;   // Callbacks that got less audio than they asked for
+    unsigned int mRenderWakes = 0; // Times the render thread woke up to fill the ring buffer
+    float mLatencyMs = 0.0f;       // Audio rendered but not heard yet, the ring buffer plus the device buffer
+    float mTargetLatencyMs = 0.0f;
 };
 
 // An SDL implementation of used IDirectSound API's
@@ -26,6 +31,8 @@ public:
 
     HRESULT Release();
 
+    SDLAudioStats Stats() const;
+
     // Called by audio thread - time critical
     static void AudioCallBackStatic(void * userdata, Uint8 *stream, int len);
 
@@ -39,24 +46,40 @@ private:
 
     void RenderAudio(StereoSample_S16* pSampleBuffer, int sampleBufferCount);
 
-    void RenderSoundBuffer(SDLSoundBuffer& entry, StereoSample_S16* pSampleBuffer, int sampleBufferCount);
-
-    void RenderMonoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, int i);
+    void MixFrames(StereoSample_S16* pSampleBuffer, int frameCount);
 
-    void RenderStereoSample(Sint16* pVoiceBufferPtr, SDLSoundBuffer* pVoice, int i);
+    void RenderSoundBuffer(SDLSoundBuffer& entry);
 
 private:
     SDL_AudioSpec mAudioDeviceSpec = {};
     static constexpr int kMixVolume = 127;
 
-    int mCurrentSoundBufferSize = 0;
     AudioFilterMode mAudioFilterMode = AudioFilterMode::Linear;
-    std::vector<StereoSample_S16> mTempSoundBuffer;
-    std::vector<StereoSample_S16> mNoReverbBuffer;
+    SoundMixBuffer mMixBuffer;
+    SsExt_SeqClock mSeqClock;
     cinder::audio::dsp::RingBufferT<StereoSample_S16> mAudioRingBuffer;
     std::atomic_bool mRenderAudioThreadQuit{ false };
     std::unique_ptr<std::thread> mRenderAudioThread;
 
+    // Posted by AudioCallBack after it reads from the ring buffer, the render thread sleeps on it until
+    // at least mRenderWatermark samples can be written
+    SDL_sem* mRenderWake = nullptr;
+    size_t mRenderWatermark = 0;
+
+    std::atomic<unsigned int> mCallbacks{ 0 };
+    std::atomic<unsigned int> mUnderruns{ 0 };
+    std::atomic<unsigned int> mRenderWakes{ 0 };
+
 
     bool mCreated = false;
 };
+
+// Samples in the SDL device buffer, rounded up to a power of two.
+extern int gAudioBufferSamples;
+
+// Play the MIDI sequencer from the render thread in audio time rather than polling it from the game thread.
+extern bool gAudioThreadSequencer;
+
+// Total latency to aim for, this sizes the ring buffer the render thread fills. 0 or less makes the ring
+// buffer twice the device buffer.
+extern int gAudioLatencyMs;
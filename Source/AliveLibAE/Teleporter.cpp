@@ -14,6 +14,7 @@
 #include "Spark.hpp"
 #include "ParticleBurst.hpp"
 #include "Electrocute.hpp"
+#include "ObjectGrid.hpp"
 
 Teleporter* Teleporter::ctor_4DC1E0(Path_Teleporter* pTlv, DWORD tlvInfo)
 {
@@ -350,6 +351,7 @@ void Teleporter::vUpdate_4DC400()
             sControlledCharacter_5C1B8C->field_BC_ypos = FP_FromInteger(pTeleporterTlv->field_8_top_left.field_2_y);
             sControlledCharacter_5C1B8C->field_F8_LastLineYPos = sControlledCharacter_5C1B8C->field_BC_ypos;
         }
+        ObjectGrid_OnObjectMoved(sControlledCharacter_5C1B8C);
         field_30_state = TeleporterState::eOutOfTeleporter_4;
     }
     break;
@@ -71,8 +71,12 @@ EXPORT void CC VGA_Shutdown_4F3170()
 #endif
 #endif
 
-    IRenderer::GetRenderer()->Destroy();
-    IRenderer::FreeRenderer();
+    // Never created when running headless
+    if (IRenderer::GetRenderer())
+    {
+        IRenderer::GetRenderer()->Destroy();
+        IRenderer::FreeRenderer();
+    }
 
     sVGA_Inited_BC0BB8 = false;
 
@@ -2,6 +2,7 @@
 #include "VRam.hpp"
 #include "Function.hpp"
 #include "PsxDisplay.hpp"
+#include "AnimationFrameCache.hpp"
 #include <gmock/gmock.h>
 
 const int kMaxAllocs = 512;
@@ -198,6 +199,9 @@ EXPORT void CC Vram_alloc_explicit_4955F0(__int16 x, __int16 y, __int16 w, __int
 
 EXPORT void CC Vram_free_495A60(PSX_Point xy, PSX_Point wh)
 {
+    // Whatever is there now can't be relied on once it's been given to something else
+    AnimFrameCache_OnVRamWritten({ xy.field_0_x, xy.field_2_y, wh.field_0_x, wh.field_2_y });
+
     // Find the allocation
     for (int i = 0; i < sVramNumberOfAllocations_5CC888; i++)
     {
@@ -33,6 +33,24 @@
 #include "LvlArchive.hpp"
 #include "ObjectIds.hpp"
 #include "PsxRender.hpp"
+#include "PsxRenderSpans.hpp"
+#include "AnimationFrameCache.hpp"
+#include "ObjectGrid.hpp"
+#include "ObjectTypeIndex.hpp"
+#include "CollisionGrid.hpp"
+#include "ResourceHeapIndex.hpp"
+#include "ResourcePrefetch.hpp"
+#include "Sound/SDLSoundMixer.hpp"
+#include "Sound/Reverb.hpp"
+#include "Masher.hpp"
+#include "MovieDecodeQueue.hpp"
+#include "CameraCache.hpp"
+#include "CamDecoder.hpp"
+#include "FrameProfiler.hpp"
+#include "FramePacer.hpp"
+#include "PsxRenderCommands.hpp"
+#include "Sound/PsxSpuApi.hpp"
+#include "AdsrEnvelope.hpp"
 #include "VRam.hpp"
 #include "Compression.hpp"
 #include "BaseAnimatedWithPhysicsGameObject.hpp"
@@ -52,6 +70,7 @@ static void RunTests()
     ::testing::InitGoogleMock(&argCount, &cmdLine);
 
     Test::CollisionTests();
+    Test::CollisionGridTests();
     Test::VRamTests();
     Test::AnimationTests();
     Test::BmpTests();
@@ -61,7 +80,28 @@ static void RunTests()
     Test::EventTests();
     Test::ScreenManagerTests();
     Test::ObjectIdsTests();
+    Test::BaseGameObjectTests();
     Test::PsxRenderTests();
+    Test::PsxRenderSpansTests();
+    Test::AnimationFrameCacheTests();
+    Test::ObjectGridTests();
+    Test::ObjectTypeIndexTests();
+    Test::ResourceHeapIndexTests();
+    Test::ResourcePrefetchTests();
+    Test::LvlArchiveTests();
+    Test::MasherTests();
+    Test::MovieDecodeQueueTests();
+    Test::CameraCacheTests();
+    Test::CamDecoderTests();
+    Test::FrameProfilerTests();
+    Test::FramePacerTests();
+    Test::PsxRenderCommandsTests();
+    Test::PsxSpuApiTests();
+    Test::AdsrEnvelopeTests();
+#if USE_SDL2_SOUND
+    Test::SDLSoundMixerTests();
+    Test::ReverbTests();
+#endif
     Test::BaseAnimatedWithPhysicsGameObjectTests();
     Test::Math_Tests();
     Test::QuikSave_Tests();
@@ -0,0 +1,200 @@
+#include "stdafx_common.h"
+#include "AdsrEnvelope.hpp"
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+#include <gmock/gmock.h>
+
+int AdsrEnvelope::Attack(int t, int attackMs, int peak)
+{
+    if (attackMs != mAttackMs)
+    {
+        mAttackMs = attackMs;
+        mAttackScale = attackMs > 0 ? (1ull << 32) / static_cast<unsigned int>(attackMs) : 0;
+    }
+
+    if (t <= 0 || t >= attackMs)
+    {
+        return t <= 0 ? 0 : peak;
+    }
+
+    // x in 16.16 then x * (2 - x) in 32.32
+    const unsigned long long x = (static_cast<unsigned long long>(t) * mAttackScale) >> 16;
+    const unsigned long long curve = x * ((2ull << 16) - x);
+    const int volume = static_cast<int>((static_cast<unsigned long long>(std::abs(peak)) * curve) >> 32);
+    return peak < 0 ? -volume : volume;
+}
+
+int AdsrEnvelope::Decay(int tSquared, int lengthMs, int from, int drop)
+{
+    return FallBy(mDecay, tSquared, lengthMs, from, drop);
+}
+
+int AdsrEnvelope::Release(int tSquared, int lengthMs, int from)
+{
+    return FallBy(mRelease, tSquared, lengthMs, from, from);
+}
+
+int AdsrEnvelope::FallBy(Fall& fall, int tSquared, int lengthMs, int from, int drop)
+{
+    if (lengthMs <= 0)
+    {
+        return from;
+    }
+
+    const unsigned long long lengthSquared = static_cast<unsigned long long>(lengthMs) * lengthMs;
+    if (fall.mLengthMs != lengthMs || fall.mDrop != drop)
+    {
+        fall.mLengthMs = lengthMs;
+        fall.mDrop = drop;
+        fall.mScale = (static_cast<unsigned long long>(std::abs(static_cast<long long>(drop))) << 32) / lengthSquared;
+    }
+
+    if (tSquared < 0 || static_cast<unsigned long long>(tSquared) >= lengthSquared)
+    {
+        // Only when a player carries on with the time from the last phase, once per note at most
+        return static_cast<int>(from - (static_cast<long long>(tSquared) * drop) / static_cast<long long>(lengthSquared));
+    }
+
+    const int fallen = static_cast<int>((static_cast<unsigned long long>(tSquared) * fall.mScale) >> 32);
+    return drop < 0 ? from + fallen : from - fallen;
+}
+
+namespace Test
+{
+    // How MIDI_ADSR_Update_4FDCE0 worked out the attack
+    static int ReferenceAttack(int t, int attackMs, int peak)
+    {
+        const double x = static_cast<double>(t) / static_cast<double>(attackMs);
+        return static_cast<int>(static_cast<long long>((x + x - x * x) * static_cast<double>(peak)));
+    }
+
+    // And the decay and release, in 64 bits as the original's 32 bit ints overflowed on long releases
+    static int ReferenceFall(int tSquared, int lengthMs, int from, int drop)
+    {
+        return static_cast<int>(from - (static_cast<long long>(tSquared) * drop) / (static_cast<long long>(lengthMs) * lengthMs));
+    }
+
+    // A spread of times through a phase that always includes both ends
+    static std::vector<int> PhaseTimes(int lengthMs)
+    {
+        std::vector<int> times;
+        const int step = std::max(1, lengthMs / 24);
+        for (int t = 0; t < lengthMs; t += step)
+        {
+            times.push_back(t);
+        }
+        times.push_back(lengthMs - 1);
+        return times;
+    }
+
+    // The phase lengths SsVabOpenHead_4FC620 can make from a VAB's ADSR words
+    static std::set<int> VabAttacks()
+    {
+        std::set<int> attacks;
+        for (int rate = 0; rate < 128; rate++)
+        {
+            const int attack = static_cast<int>(std::min(powf(2.0f, rate * 0.25f) * 0.09f, 32767.0f));
+
+            // Scaled by how hard the note was hit when it is played
+            for (int volume = 0; volume < 128; volume++)
+            {
+                const int scaled = static_cast<unsigned short>((attack * (127 - volume)) / 64);
+                if (scaled > 0)
+                {
+                    attacks.insert(scaled);
+                }
+            }
+        }
+        return attacks;
+    }
+
+    static std::set<int> VabDecayLengths()
+    {
+        std::set<int> lengths;
+        for (int level = 0; level < 16; level++)
+        {
+            const float sustainLevel = static_cast<float>(2 * (~level & 0xF));
+            lengths.insert(static_cast<int>((sustainLevel / 15.0f) * 600.0));
+        }
+        return lengths;
+    }
+
+    static std::set<int> VabReleases()
+    {
+        std::set<int> releases = { 125, 300 }; // AO's and AE's key off minimums
+        for (int rate = 0; rate < 32; rate++)
+        {
+            const int release = static_cast<int>(std::min(pow(2, rate) * 0.045f, 32767.0));
+            releases.insert(release);
+            releases.insert(std::max(release, 300));
+        }
+        releases.erase(0);
+        return releases;
+    }
+
+    static void AdsrEnvelope_Attack_Test()
+    {
+        AdsrEnvelope envelope;
+        for (int attackMs : VabAttacks())
+        {
+            for (int peak = 1; peak < 128; peak += 9)
+            {
+                for (int t : PhaseTimes(attackMs))
+                {
+                    ASSERT_NEAR(ReferenceAttack(t, attackMs, peak), envelope.Attack(t, attackMs, peak), 1) << "attack " << attackMs << " t " << t << " peak " << peak;
+                }
+            }
+        }
+    }
+
+    static void AdsrEnvelope_Decay_Test()
+    {
+        AdsrEnvelope envelope;
+        for (int lengthMs : VabDecayLengths())
+        {
+            if (lengthMs == 0)
+            {
+                continue;
+            }
+
+            for (int decay = 0; decay <= 16; decay++)
+            {
+                for (int peak = 0; peak < 128; peak += 3)
+                {
+                    const int drop = peak * (16 - decay) >> 4;
+                    for (int t : PhaseTimes(lengthMs))
+                    {
+                        ASSERT_NEAR(ReferenceFall(t * t, lengthMs, peak, drop), envelope.Decay(t * t, lengthMs, peak, drop), 1) << "decay " << lengthMs << " t " << t << " peak " << peak << " drop " << drop;
+                    }
+                }
+            }
+        }
+
+        // The tick an attack ends on carries the attack's time over, so the time can be past the end of the decay
+        ASSERT_EQ(ReferenceFall(1000 * 1000, 400, 100, 50), envelope.Decay(1000 * 1000, 400, 100, 50));
+    }
+
+    static void AdsrEnvelope_Release_Test()
+    {
+        AdsrEnvelope envelope;
+        for (int lengthMs : VabReleases())
+        {
+            for (int from = 0; from < 128; from += 3)
+            {
+                for (int t : PhaseTimes(lengthMs))
+                {
+                    ASSERT_NEAR(ReferenceFall(t * t, lengthMs, from, from), envelope.Release(t * t, lengthMs, from), 1) << "release " << lengthMs << " t " << t << " from " << from;
+                }
+            }
+        }
+    }
+
+    void AdsrEnvelopeTests()
+    {
+        AdsrEnvelope_Attack_Test();
+        AdsrEnvelope_Decay_Test();
+        AdsrEnvelope_Release_Test();
+    }
+}
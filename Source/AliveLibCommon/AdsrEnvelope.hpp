@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Test
+{
+    void AdsrEnvelopeTests();
+}
+
+// The volume curves of the MIDI player's ADSR envelopes. The attack rises as 2x - x^2 of the peak volume and the
+// decay and release fall by x^2 of how far they drop, x being how far through the phase the voice is. Each voice
+// keeps the fixed point reciprocals of its phase lengths so a tick is only integer multiplies and shifts, they are
+// only worked out again when the phase's parameters change.
+class AdsrEnvelope
+{
+public:
+    // Volume t ms in to an attack of attackMs that rises to peak, 0 <= t < attackMs.
+    int Attack(int t, int attackMs, int peak);
+
+    // from less tSquared * drop / lengthMs^2, for the decay and release phases. The players square the time
+    // themselves as they don't always square the time in to the phase.
+    int Decay(int tSquared, int lengthMs, int from, int drop);
+    int Release(int tSquared, int lengthMs, int from);
+
+private:
+    struct Fall
+    {
+        int mLengthMs = 0;
+        int mDrop = 0;
+        unsigned long long mScale = 0; // |drop| / lengthMs^2 in 32.32
+    };
+
+    static int FallBy(Fall& fall, int tSquared, int lengthMs, int from, int drop);
+
+    int mAttackMs = 0;
+    unsigned long long mAttackScale = 0; // 1 / attackMs in 32.32
+    Fall mDecay;
+    Fall mRelease;
+};
@@ -56,6 +56,18 @@ TypeName LocalVar_##VarName = Value;\
 AliveVar Var_##VarName(#VarName, Addr, sizeof(LocalVar_##VarName), std::is_pointer<TypeName>::value, std::is_const<TypeName>::value);\
 TypeName& VarName = (Redirect && RunningAsInjectedDll()) ? *reinterpret_cast<TypeName*>(Addr) : LocalVar_##VarName;
 
+// Same as ALIVE_VAR/ALIVE_ARY but each thread gets its own copy. When injected every thread uses the game's copy
+// so anything touching these from more than one thread has to be turned off when RunningAsInjectedDll().
+#define ALIVE_VAR_TLS(Redirect, Addr, TypeName, VarName, Value)\
+thread_local TypeName LocalVar_##VarName = Value;\
+AliveVar Var_##VarName(#VarName, Addr, sizeof(TypeName), std::is_pointer<TypeName>::value, std::is_const<TypeName>::value);\
+thread_local TypeName& VarName = (Redirect && RunningAsInjectedDll()) ? *reinterpret_cast<TypeName*>(Addr) : LocalVar_##VarName;
+
+#define ALIVE_ARY_TLS(Redirect, Addr, TypeName, Size, VarName, ...)\
+thread_local TypeName LocalArray_##VarName[Size]=__VA_ARGS__;\
+AliveVar Var_##VarName(#VarName, Addr, sizeof(TypeName) * Size, std::is_pointer<TypeName>::value, std::is_const<TypeName>::value);\
+thread_local TypeName* VarName = (Redirect && RunningAsInjectedDll()) ? reinterpret_cast<TypeName*>(Addr) : reinterpret_cast<TypeName*>(&LocalArray_##VarName[0]);
+
 
 void CheckVars();
 
@@ -151,3 +163,24 @@ void SetBrain(AIFunctionType fn, AIFunctionType& brainVar, const AITable& table)
 #endif
     brainVar = fn;
 }
+
+// The name of the brain brainVar is set to, nullptr if it isn't one in the table
+template <class AIFunctionType, class AITable>
+const char* BrainName(const AIFunctionType& brainVar, const AITable& table)
+{
+    for (const auto& addrPair : table)
+    {
+        if (addrPair.mOurFn == brainVar)
+        {
+            return addrPair.fnName;
+        }
+
+#if _WIN32 || !_WIN64
+        if (RunningAsInjectedDll() && memcmp(&addrPair.mOriginal, &brainVar, sizeof(DWORD)) == 0)
+        {
+            return addrPair.fnName;
+        }
+#endif
+    }
+    return nullptr;
+}
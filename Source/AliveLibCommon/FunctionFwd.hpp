@@ -48,3 +48,6 @@ extern TypeName& VarName;
 #define ALIVE_ARY_EXTERN(TypeName, Size, VarName)\
 extern AliveVar Var_##VarName;\
 extern TypeName* VarName ;
+
+#define ALIVE_VAR_TLS_EXTERN(TypeName, VarName)\
+extern thread_local TypeName& VarName;
@@ -2,7 +2,21 @@
 #include "Masher.hpp"
 #include "Function.hpp"
 #include "masher_tables.hpp"
+#include "WorkerGroup.hpp"
 #include <array>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <gmock/gmock.h>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MASHER_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define MASHER_SSE2 0
+#endif
+
+int gMovieDecodeThreads = 0;
 
 ALIVE_VAR(1, 0xbbb314, Movie_IO, sMovie_IO_BBB314, {});
 
@@ -652,12 +666,16 @@ int16_t* ddv_func7_DecodeMacroBlock_impl(int16_t* inPtr, int16_t* outputBlockPtr
 // by an out of bounds write somewhere.
 typedef std::array<int32_t, 64 * 4> T64IntsArray;
 
-static T64IntsArray Cr_block = {};
-static T64IntsArray Cb_block = {};
-static T64IntsArray Y1_block = {};
-static T64IntsArray Y2_block = {};
-static T64IntsArray Y3_block = {};
-static T64IntsArray Y4_block = {};
+// The idct output of one macro block, each decoding thread has its own
+struct MasherMacroBlock
+{
+    T64IntsArray mCr;
+    T64IntsArray mCb;
+    T64IntsArray mY1;
+    T64IntsArray mY2;
+    T64IntsArray mY3;
+    T64IntsArray mY4;
+};
 
 
 void half_idct(T64IntsArray& pSource, T64IntsArray& pDestination, int nPitch, int nIncrement, int nShift)
@@ -710,6 +728,127 @@ void idct(int16_t* input, T64IntsArray& pDestination) // dst is 64 dwords
     half_idct(pTemp, pDestination, 1, 8, 18);
 }
 
+#if MASHER_SSE2
+// Low 32 bits of a * b for each lane, SSE2 has no 32 bit multiply so the even and odd lanes are done separately
+static inline __m128i Mul32_SSE2(__m128i a, int b)
+{
+    const __m128i vb = _mm_set1_epi32(b);
+    const __m128i even = _mm_mul_epu32(a, vb);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), vb);
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// half_idct of 4 neighbouring columns at once, s[k] is row k of the columns
+static inline void half_idct_SSE2(const __m128i* s, __m128i* d, int nShift)
+{
+    const __m128i shift = _mm_cvtsi32_si128(nShift);
+    const __m128i s0 = _mm_slli_epi32(s[0], 13); // * 8192
+    const __m128i s4 = _mm_slli_epi32(s[4], 13);
+
+    const __m128i t4 = _mm_add_epi32(_mm_add_epi32(s0, Mul32_SSE2(s[2], 10703)), _mm_add_epi32(s4, Mul32_SSE2(s[6], 4433)));
+    const __m128i t5 = _mm_sub_epi32(_mm_add_epi32(s0, Mul32_SSE2(s[2], 4433)), _mm_add_epi32(s4, Mul32_SSE2(s[6], 10704)));
+    const __m128i t6 = _mm_add_epi32(_mm_sub_epi32(_mm_sub_epi32(s0, Mul32_SSE2(s[2], 4433)), s4), Mul32_SSE2(s[6], 10704));
+    const __m128i t7 = _mm_sub_epi32(_mm_add_epi32(_mm_sub_epi32(s0, Mul32_SSE2(s[2], 10703)), s4), Mul32_SSE2(s[6], 4433));
+
+    const __m128i t0 = _mm_add_epi32(_mm_add_epi32(Mul32_SSE2(s[1], 11363), Mul32_SSE2(s[3], 9633)), _mm_add_epi32(Mul32_SSE2(s[5], 6437), Mul32_SSE2(s[7], 2260)));
+    const __m128i t1 = _mm_sub_epi32(_mm_sub_epi32(Mul32_SSE2(s[1], 9633), Mul32_SSE2(s[3], 2259)), _mm_add_epi32(Mul32_SSE2(s[5], 11362), Mul32_SSE2(s[7], 6436)));
+    const __m128i t2 = _mm_add_epi32(_mm_sub_epi32(Mul32_SSE2(s[1], 6437), Mul32_SSE2(s[3], 11362)), _mm_add_epi32(Mul32_SSE2(s[5], 2261), Mul32_SSE2(s[7], 9633)));
+    const __m128i t3 = _mm_sub_epi32(_mm_add_epi32(_mm_sub_epi32(Mul32_SSE2(s[1], 2260), Mul32_SSE2(s[3], 6436)), Mul32_SSE2(s[5], 9633)), Mul32_SSE2(s[7], 11363));
+
+    d[0] = _mm_sra_epi32(_mm_add_epi32(t4, t0), shift);
+    d[1] = _mm_sra_epi32(_mm_add_epi32(t5, t1), shift);
+    d[2] = _mm_sra_epi32(_mm_add_epi32(t6, t2), shift);
+    d[3] = _mm_sra_epi32(_mm_add_epi32(t7, t3), shift);
+    d[4] = _mm_sra_epi32(_mm_sub_epi32(t7, t3), shift);
+    d[5] = _mm_sra_epi32(_mm_sub_epi32(t6, t2), shift);
+    d[6] = _mm_sra_epi32(_mm_sub_epi32(t5, t1), shift);
+    d[7] = _mm_sra_epi32(_mm_sub_epi32(t4, t0), shift);
+}
+
+static inline void Transpose4x4_SSE2(__m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3)
+{
+    const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    const __m128i t1 = _mm_unpacklo_epi32(r2, r3);
+    const __m128i t2 = _mm_unpackhi_epi32(r0, r1);
+    const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    r0 = _mm_unpacklo_epi64(t0, t1);
+    r1 = _mm_unpackhi_epi64(t0, t1);
+    r2 = _mm_unpacklo_epi64(t2, t3);
+    r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// rows[k * 2 + h] is columns h * 4 to h * 4 + 3 of row k
+static void Transpose8x8_SSE2(__m128i* rows)
+{
+    Transpose4x4_SSE2(rows[0], rows[2], rows[4], rows[6]);
+    Transpose4x4_SSE2(rows[1], rows[3], rows[5], rows[7]);
+    Transpose4x4_SSE2(rows[8], rows[10], rows[12], rows[14]);
+    Transpose4x4_SSE2(rows[9], rows[11], rows[13], rows[15]);
+
+    // Swap the top right and bottom left quarters
+    for (int k = 0; k < 4; k++)
+    {
+        std::swap(rows[(k * 2) + 1], rows[((k + 4) * 2)]);
+    }
+}
+
+// Same result as idct, both passes work on 4 columns at a time and the second pass is done on the transpose
+static void idct_SSE2(const int16_t* input, T64IntsArray& pDestination)
+{
+    __m128i rows[16];
+    for (int i = 0; i < 16; i++)
+    {
+        // Sign extend the low half of each dword
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + (i * 8)));
+        rows[i] = _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+    }
+
+    __m128i s[8];
+    __m128i d[8];
+    for (int h = 0; h < 2; h++)
+    {
+        for (int k = 0; k < 8; k++)
+        {
+            s[k] = rows[(k * 2) + h];
+        }
+        half_idct_SSE2(s, d, 11);
+        for (int k = 0; k < 8; k++)
+        {
+            rows[(k * 2) + h] = d[k];
+        }
+    }
+
+    Transpose8x8_SSE2(rows);
+    for (int h = 0; h < 2; h++)
+    {
+        for (int k = 0; k < 8; k++)
+        {
+            s[k] = rows[(k * 2) + h];
+        }
+        half_idct_SSE2(s, d, 18);
+        for (int k = 0; k < 8; k++)
+        {
+            rows[(k * 2) + h] = d[k];
+        }
+    }
+    Transpose8x8_SSE2(rows);
+
+    for (int i = 0; i < 16; i++)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&pDestination[i * 4]), rows[i]);
+    }
+}
+#endif
+
+static void idct_fast(int16_t* input, T64IntsArray& pDestination)
+{
+#if MASHER_SSE2
+    idct_SSE2(input, pDestination);
+#else
+    idct(input, pDestination);
+#endif
+}
+
 
 static void after_block_decode_no_effect_q_impl(int quantScale)
 {
@@ -998,6 +1137,230 @@ void Masher::Decode_4EA670()
     MMX_Decode_4E6C60(nullptr);
 }
 
+struct Macroblock_RGB_Struct
+{
+    unsigned char Red;
+    unsigned char Green;
+    unsigned char Blue;
+    unsigned char A;
+};
+
+static int To1d(int x, int y)
+{
+    // 8x8 index to x64 index
+    return y * 8 + x;
+}
+
+static unsigned char Clamp(f32 v)
+{
+    if (v < 0.0f) v = 0.0f;
+    if (v > 255.0f) v = 255.0f;
+    return (unsigned char)v;
+}
+
+static void SetElement(int x, int y, int width, int height, u16* ptr, u16 value, bool doubleWidth, bool doubleHeight)
+{
+    if (doubleWidth)
+    {
+        x *= 2;
+    }
+
+    if (doubleHeight)
+    {
+        y *= 2;
+    }
+
+    ptr[(width * y) + x] = value;
+
+    if (doubleWidth)
+    {
+        if (x + 1 < width)
+        {
+            ptr[(width * y) + x + 1] = value;
+        }
+    }
+
+    if (doubleHeight)
+    {
+        if (y + 1 < height)
+        {
+            ptr[(width * (y + 1)) + x] = value;
+
+            if (doubleWidth)
+            {
+                if (x + 1 < width)
+                {
+                    ptr[(width * (y + 1)) + x + 1] = value;
+                }
+            }
+        }
+    }
+}
+
+static uint16_t rgb888torgb565(Macroblock_RGB_Struct& rgb888Pixel)
+{
+    uint8_t red = rgb888Pixel.Red;
+    uint8_t green = rgb888Pixel.Green;
+    uint8_t blue = rgb888Pixel.Blue;
+
+    uint16_t b = (blue >> 3) & 0x1f;
+    uint16_t g = ((green >> 2) & 0x3f) << 5;
+    uint16_t r = ((red >> 3) & 0x1f) << 11;
+
+    return (uint16_t)(r | g | b);
+}
+
+// The Y block and index within it that covers pixel x, y of the macro block
+static int32_t LumaAt(const MasherMacroBlock& block, int x, int y)
+{
+    const T64IntsArray& yBlock = (y < 8) ? (x < 8 ? block.mY1 : block.mY2) : (x < 8 ? block.mY3 : block.mY4);
+    return yBlock[To1d(x & 7, y & 7)];
+}
+
+// Converts the macro block to a 16x16 block of rgb565 pixels stored row by row
+static void ConvertYuvToRgb565(const MasherMacroBlock& block, u16* pOut)
+{
+    for (int y = 0; y < kMacroBlockHeight; y++)
+    {
+        for (int x = 0; x < kMacroBlockWidth; x++)
+        {
+            const f32 Y = static_cast<f32>(LumaAt(block, x, y));
+            const f32 Cb = static_cast<f32>(block.mCb[To1d(x / 2, y / 2)]);
+            const f32 Cr = static_cast<f32>(block.mCr[To1d(x / 2, y / 2)]);
+
+            const f32 r = Y + 1.402f * Cb;
+            const f32 g = Y - 0.3437f * Cr - 0.7143f * Cb;
+            const f32 b = Y + 1.772f * Cr;
+
+            Macroblock_RGB_Struct rgb = {};
+            rgb.Red = Clamp(r);
+            rgb.Green = Clamp(g);
+            rgb.Blue = Clamp(b);
+
+            // Actually is no alpha in FMVs
+            pOut[(y * kMacroBlockWidth) + x] = rgb888torgb565(rgb);
+        }
+    }
+}
+
+#if MASHER_SSE2
+static inline __m128i ClampToByte_SSE2(__m128 v)
+{
+    return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f)));
+}
+
+// Same as ConvertYuvToRgb565 but 8 pixels at a time, the float maths is in the same order so
+// the results only differ when the compiler has contracted the scalar version in to fused multiply-adds
+static void ConvertYuvToRgb565_SSE2(const MasherMacroBlock& block, u16* pOut)
+{
+    const __m128 kCbToR = _mm_set1_ps(1.402f);
+    const __m128 kCrToG = _mm_set1_ps(0.3437f);
+    const __m128 kCbToG = _mm_set1_ps(0.7143f);
+    const __m128 kCrToB = _mm_set1_ps(1.772f);
+    const __m128i kBias = _mm_set1_epi32(0x8000);
+
+    for (int y = 0; y < kMacroBlockHeight; y++)
+    {
+        const int32_t* pCb = &block.mCb[To1d(0, y / 2)];
+        const int32_t* pCr = &block.mCr[To1d(0, y / 2)];
+        for (int half = 0; half < 2; half++)
+        {
+            const T64IntsArray& yBlock = (y < 8) ? (half == 0 ? block.mY1 : block.mY2) : (half == 0 ? block.mY3 : block.mY4);
+            const int32_t* pY = &yBlock[To1d(0, y & 7)];
+
+            u16* pDst = pOut + (y * kMacroBlockWidth) + (half * 8);
+            for (int quad = 0; quad < 2; quad++)
+            {
+                // 4 luma samples share 2 chroma samples
+                const __m128i cbPair = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pCb + (half * 4) + (quad * 2)));
+                const __m128i crPair = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pCr + (half * 4) + (quad * 2)));
+                const __m128 Cb = _mm_cvtepi32_ps(_mm_unpacklo_epi32(cbPair, cbPair));
+                const __m128 Cr = _mm_cvtepi32_ps(_mm_unpacklo_epi32(crPair, crPair));
+                const __m128 Y = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pY + (quad * 4))));
+
+                const __m128i r = ClampToByte_SSE2(_mm_add_ps(Y, _mm_mul_ps(kCbToR, Cb)));
+                const __m128i g = ClampToByte_SSE2(_mm_sub_ps(_mm_sub_ps(Y, _mm_mul_ps(kCrToG, Cr)), _mm_mul_ps(kCbToG, Cb)));
+                const __m128i b = ClampToByte_SSE2(_mm_add_ps(Y, _mm_mul_ps(kCrToB, Cr)));
+
+                __m128i pixel = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(r, 3), 11), _mm_slli_epi32(_mm_srli_epi32(g, 2), 5));
+                pixel = _mm_or_si128(pixel, _mm_srli_epi32(b, 3));
+
+                // No unsigned saturating pack in SSE2, bias in to signed range, pack and flip the top bit back
+                pixel = _mm_packs_epi32(_mm_sub_epi32(pixel, kBias), _mm_setzero_si128());
+                pixel = _mm_xor_si128(pixel, _mm_set1_epi16(static_cast<short>(0x8000)));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + (quad * 4)), pixel);
+            }
+        }
+    }
+}
+#endif
+
+static void ConvertYuvToRgbAndBlit(const MasherMacroBlock& block, u16* pixelBuffer, int xoff, int yoff, int width, int height, bool doubleWidth, bool doubleHeight)
+{
+    u16 pixels[kMacroBlockWidth * kMacroBlockHeight];
+#if MASHER_SSE2
+    ConvertYuvToRgb565_SSE2(block, pixels);
+#else
+    ConvertYuvToRgb565(block, pixels);
+#endif
+
+    const int scaleX = doubleWidth ? 2 : 1;
+    const int scaleY = doubleHeight ? 2 : 1;
+    if (doubleWidth && doubleHeight && (xoff + kMacroBlockWidth) * scaleX <= width && (yoff + kMacroBlockHeight) * scaleY <= height)
+    {
+        // Whole block is on screen, write each source row out twice as wide and twice over
+        for (int y = 0; y < kMacroBlockHeight; y++)
+        {
+            u16* pRow = pixelBuffer + (((yoff + y) * 2) * width) + (xoff * 2);
+            for (int x = 0; x < kMacroBlockWidth; x++)
+            {
+                const u16 pixel = pixels[(y * kMacroBlockWidth) + x];
+                pRow[x * 2] = pixel;
+                pRow[(x * 2) + 1] = pixel;
+            }
+            memcpy(pRow + width, pRow, kMacroBlockWidth * 2 * sizeof(u16));
+        }
+        return;
+    }
+
+    for (int x = 0; x < kMacroBlockWidth; x++)
+    {
+        for (int y = 0; y < kMacroBlockHeight; y++)
+        {
+            // Due to macro block padding this can be out of bounds
+            int xpos = x + xoff;
+            int ypos = y + yoff;
+            if (xpos < width && ypos < height)
+            {
+                SetElement(xpos, ypos, width, height, pixelBuffer, pixels[(y * kMacroBlockWidth) + x], doubleWidth, doubleHeight);
+            }
+        }
+    }
+}
+
+static WorkerGroup* Masher_GetWorkers()
+{
+    static std::unique_ptr<WorkerGroup> sWorkers;
+
+    int threadCount = gMovieDecodeThreads;
+    if (threadCount == 0)
+    {
+        threadCount = std::min(static_cast<int>(std::thread::hardware_concurrency()), 4);
+    }
+
+    if (threadCount <= 1)
+    {
+        sWorkers.reset();
+        return nullptr;
+    }
+
+    if (!sWorkers || sWorkers->Count() != threadCount)
+    {
+        sWorkers.reset(new WorkerGroup(threadCount));
+    }
+    return sWorkers.get();
+}
+
 void Masher::MMX_Decode_4E6C60(BYTE* pPixelBuffer)
 {
     if (!field_61_bHasVideo)
@@ -1033,57 +1396,63 @@ void Masher::MMX_Decode_4E6C60(BYTE* pPixelBuffer)
 
     after_block_decode_no_effect_q_impl(quantScale);
 
+    // The coefficients are variable length so each block can only be found by unpacking the one before it,
+    // this part has to stay serial but it is cheap next to the idct and colour conversion
+    const int blockStride = field_90_64_or_0 * 2; // Convert to byte count 64*4=256
     int16_t* bitstreamCurPos = (int16_t*)field_44_decoded_frame_data_buffer;
-    int16_t* block1Output = (int16_t*)field_8C_macro_block_buffer;
-
-    int xoff = 0;
-    for (int xBlock = 0; xBlock < blocksX; xBlock++)
+    int16_t* blockOutput = (int16_t*)field_8C_macro_block_buffer;
+    for (int i = 0; i < blocksX * blocksY * 6; i++)
     {
-        int yoff = 0;
-        for (int yBlock = 0; yBlock < blocksY; yBlock++)
-        {
-            const int dataSizeBytes = field_90_64_or_0 * 2; // Convert to byte count 64*4=256
-
-            int16_t* afterBlock1Ptr = ddv_func7_DecodeMacroBlock_impl(bitstreamCurPos, block1Output, 0);
-            idct(block1Output, Cr_block);
-            int16_t* block2Output = dataSizeBytes + block1Output;
-
-            int16_t* afterBlock2Ptr = ddv_func7_DecodeMacroBlock_impl(afterBlock1Ptr, block2Output, 0);
-            idct(block2Output, Cb_block);
-            int16_t* block3Output = dataSizeBytes + block2Output;
-
-            int16_t* afterBlock3Ptr = ddv_func7_DecodeMacroBlock_impl(afterBlock2Ptr, block3Output, 1);
-            idct(block3Output, Y1_block);
-            int16_t* block4Output = dataSizeBytes + block3Output;
-
-            int16_t* afterBlock4Ptr = ddv_func7_DecodeMacroBlock_impl(afterBlock3Ptr, block4Output, 1);
-            idct(block4Output, Y2_block);
-            int16_t* block5Output = dataSizeBytes + block4Output;
-
-            int16_t* afterBlock5Ptr = ddv_func7_DecodeMacroBlock_impl(afterBlock4Ptr, block5Output, 1);
-            idct(block5Output, Y3_block);
-            int16_t* block6Output = dataSizeBytes + block5Output;
+        // Each macro block is Cr, Cb, Y1, Y2, Y3, Y4
+        bitstreamCurPos = ddv_func7_DecodeMacroBlock_impl(bitstreamCurPos, blockOutput, (i % 6) >= 2);
+        blockOutput += blockStride;
+    }
 
-            bitstreamCurPos = ddv_func7_DecodeMacroBlock_impl(afterBlock5Ptr, block6Output, 1);
-            idct(block6Output, Y4_block);
-            block1Output = dataSizeBytes + block6Output;
+    if (!pPixelBuffer)
+    {
+        // Only skipping the frame, nothing would see the idct output
+        return;
+    }
 
-            if (pPixelBuffer)
+    // Columns of macro blocks write to different pixels so they can be done at the same time
+    int16_t* pBlocks = (int16_t*)field_8C_macro_block_buffer;
+    auto fnDecodeColumns = [&](int firstColumn, int endColumn)
+    {
+        MasherMacroBlock block;
+        for (int xBlock = firstColumn; xBlock < endColumn; xBlock++)
+        {
+            for (int yBlock = 0; yBlock < blocksY; yBlock++)
             {
+                int16_t* pMacroBlock = pBlocks + (((xBlock * blocksY) + yBlock) * 6 * blockStride);
+                idct_fast(pMacroBlock + (0 * blockStride), block.mCr);
+                idct_fast(pMacroBlock + (1 * blockStride), block.mCb);
+                idct_fast(pMacroBlock + (2 * blockStride), block.mY1);
+                idct_fast(pMacroBlock + (3 * blockStride), block.mY2);
+                idct_fast(pMacroBlock + (4 * blockStride), block.mY3);
+                idct_fast(pMacroBlock + (5 * blockStride), block.mY4);
+
                 // TODO: Should probably be using gMasher_pitch_bytes_BB4AF8 ??
-                ConvertYuvToRgbAndBlit((u16*)pPixelBuffer, xoff, yoff,
+                ConvertYuvToRgbAndBlit(block, (u16*)pPixelBuffer, xBlock * kMacroBlockWidth, yBlock * kMacroBlockHeight,
                     640,
                     480,
                     true,
                     true);
-
-                // pPixelBuffer += gMasher_pitch_bytes_BB4AF8;
             }
-
-            yoff += kMacroBlockHeight;
         }
-        xoff += kMacroBlockWidth;
+    };
+
+    WorkerGroup* pWorkers = Masher_GetWorkers();
+    if (!pWorkers)
+    {
+        fnDecodeColumns(0, blocksX);
+        return;
     }
+
+    const int count = pWorkers->Count();
+    pWorkers->Run([&](int index)
+    {
+        fnDecodeColumns((blocksX * index) / count, (blocksX * (index + 1)) / count);
+    });
 }
 
 ALIVE_VAR(1, 0xbbb9b4, int, gMasher_num_channels_BBB9B4, 0);
@@ -1145,130 +1514,111 @@ void* CC Masher::GetDecompressedAudioFrame_4EAC60(Masher* pMasher)
     return result;
 }
 
-int Masher::To1d(int x, int y)
+namespace Test
 {
-    // 8x8 index to x64 index
-    return y * 8 + x;
-}
-
-unsigned char Masher::Clamp(f32 v)
-{
-    if (v < 0.0f) v = 0.0f;
-    if (v > 255.0f) v = 255.0f;
-    return (unsigned char)v;
-}
-
-void Masher::SetElement(int x, int y, int width, int height, u16* ptr, u16 value, bool doubleWidth, bool doubleHeight)
-{
-    if (doubleWidth)
-    {
-        x *= 2;
-    }
-
-    if (doubleHeight)
+    static void RandomMacroBlock(std::mt19937& rng, MasherMacroBlock& block)
     {
-        y *= 2;
-    }
-
-    ptr[(width * y) + x] = value;
-
-    if (doubleWidth)
-    {
-        if (x + 1 < width)
+        std::uniform_int_distribution<int> luma(-64, 320);
+        std::uniform_int_distribution<int> chroma(-160, 160);
+        for (int i = 0; i < 64; i++)
         {
-            ptr[(width * y) + x + 1] = value;
+            block.mY1[i] = luma(rng);
+            block.mY2[i] = luma(rng);
+            block.mY3[i] = luma(rng);
+            block.mY4[i] = luma(rng);
+            block.mCb[i] = chroma(rng);
+            block.mCr[i] = chroma(rng);
         }
     }
 
-    if (doubleHeight)
+    static void Test_IdctMatchesScalar()
     {
-        if (y + 1 < height)
+#if MASHER_SSE2
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int> coefficient(-2048, 2047);
+        for (int run = 0; run < 256; run++)
         {
-            ptr[(width * (y + 1)) + x] = value;
+            // Coefficients are stored every other int16
+            int16_t input[64 * 2] = {};
+            for (int i = 0; i < 64; i++)
+            {
+                input[i * 2] = static_cast<int16_t>(coefficient(rng));
+                input[(i * 2) + 1] = static_cast<int16_t>(coefficient(rng));
+            }
 
-            if (doubleWidth)
+            T64IntsArray expected = {};
+            T64IntsArray got = {};
+            idct(input, expected);
+            idct_SSE2(input, got);
+            for (int i = 0; i < 64; i++)
             {
-                if (x + 1 < width)
-                {
-                    ptr[(width * (y + 1)) + x + 1] = value;
-                }
+                ASSERT_EQ(expected[i], got[i]);
             }
         }
+#endif
     }
-}
 
-uint16_t Masher::rgb888torgb565(Macroblock_RGB_Struct& rgb888Pixel)
-{
-    uint8_t red = rgb888Pixel.Red;
-    uint8_t green = rgb888Pixel.Green;
-    uint8_t blue = rgb888Pixel.Blue;
-
-    uint16_t b = (blue >> 3) & 0x1f;
-    uint16_t g = ((green >> 2) & 0x3f) << 5;
-    uint16_t r = ((red >> 3) & 0x1f) << 11;
-
-    return (uint16_t)(r | g | b);
-}
-
-void Masher::ConvertYuvToRgbAndBlit(u16* pixelBuffer, int xoff, int yoff, int width, int height, bool doubleWidth, bool doubleHeight)
-{
-    // convert the Y1 Y2 Y3 Y4 and Cb and Cr blocks into a 16x16 array of (Y, Cb, Cr) pixels
-    struct Macroblock_YCbCr_Struct
-    {
-        f32 Y;
-        f32 Cb;
-        f32 Cr;
-    };
-
-    std::array< std::array<Macroblock_YCbCr_Struct, 16>, 16> Macroblock_YCbCr = {};
-
-    for (int x = 0; x < 8; x++)
+    static void Test_ColourConversionMatchesScalar()
     {
-        for (int y = 0; y < 8; y++)
+#if MASHER_SSE2
+        std::mt19937 rng(5678);
+        for (int run = 0; run < 64; run++)
         {
-            Macroblock_YCbCr[x][y].Y = static_cast<f32>(Y1_block[To1d(x, y)]);
-            Macroblock_YCbCr[x + 8][y].Y = static_cast<f32>(Y2_block[To1d(x, y)]);
-            Macroblock_YCbCr[x][y + 8].Y = static_cast<f32>(Y3_block[To1d(x, y)]);
-            Macroblock_YCbCr[x + 8][y + 8].Y = static_cast<f32>(Y4_block[To1d(x, y)]);
-
-            Macroblock_YCbCr[x * 2][y * 2].Cb = static_cast<f32>(Cb_block[To1d(x, y)]);
-            Macroblock_YCbCr[x * 2 + 1][y * 2].Cb = static_cast<f32>(Cb_block[To1d(x, y)]);
-            Macroblock_YCbCr[x * 2][y * 2 + 1].Cb = static_cast<f32>(Cb_block[To1d(x, y)]);
-            Macroblock_YCbCr[x * 2 + 1][y * 2 + 1].Cb = static_cast<f32>(Cb_block[To1d(x, y)]);
-
-            Macroblock_YCbCr[x * 2][y * 2].Cr = static_cast<f32>(Cr_block[To1d(x, y)]);
-            Macroblock_YCbCr[x * 2 + 1][y * 2].Cr = static_cast<f32>(Cr_block[To1d(x, y)]);
-            Macroblock_YCbCr[x * 2][y * 2 + 1].Cr = static_cast<f32>(Cr_block[To1d(x, y)]);
-            Macroblock_YCbCr[x * 2 + 1][y * 2 + 1].Cr = static_cast<f32>(Cr_block[To1d(x, y)]);
+            MasherMacroBlock block;
+            RandomMacroBlock(rng, block);
+
+            u16 expected[kMacroBlockWidth * kMacroBlockHeight] = {};
+            u16 got[kMacroBlockWidth * kMacroBlockHeight] = {};
+            ConvertYuvToRgb565(block, expected);
+            ConvertYuvToRgb565_SSE2(block, got);
+            for (int i = 0; i < kMacroBlockWidth * kMacroBlockHeight; i++)
+            {
+                ASSERT_LE(std::abs(((expected[i] >> 11) & 0x1f) - ((got[i] >> 11) & 0x1f)), 1);
+                ASSERT_LE(std::abs(((expected[i] >> 5) & 0x3f) - ((got[i] >> 5) & 0x3f)), 1);
+                ASSERT_LE(std::abs((expected[i] & 0x1f) - (got[i] & 0x1f)), 1);
+            }
         }
+#endif
     }
 
-    // Convert the (Y, Cb, Cr) pixels into RGB pixels
-    std::array< std::array<Macroblock_RGB_Struct, 16>, 16> Macroblock_RGB = {};
-
-    for (u32 x = 0; x < kMacroBlockWidth; x++)
+    static void Test_BlitDoublesPixels()
     {
-        for (u32 y = 0; y < kMacroBlockHeight; y++)
+        std::mt19937 rng(42);
+        MasherMacroBlock block;
+        RandomMacroBlock(rng, block);
+
+        const int width = 64;
+        const int height = 64;
+        std::vector<u16> screen(width * height, 0xDEAD);
+        ConvertYuvToRgbAndBlit(block, screen.data(), 16, 16, width, height, true, true);
+
+        u16 pixels[kMacroBlockWidth * kMacroBlockHeight] = {};
+#if MASHER_SSE2
+        ConvertYuvToRgb565_SSE2(block, pixels);
+#else
+        ConvertYuvToRgb565(block, pixels);
+#endif
+        for (int y = 0; y < height; y++)
         {
-            const f32 r = (Macroblock_YCbCr[x][y].Y) + 1.402f *  Macroblock_YCbCr[x][y].Cb;
-            const f32 g = (Macroblock_YCbCr[x][y].Y) - 0.3437f * Macroblock_YCbCr[x][y].Cr - 0.7143f * Macroblock_YCbCr[x][y].Cb;
-            const f32 b = (Macroblock_YCbCr[x][y].Y) + 1.772f *  Macroblock_YCbCr[x][y].Cr;
-
-            Macroblock_RGB[x][y].Red = Clamp(r);
-            Macroblock_RGB[x][y].Green = Clamp(g);
-            Macroblock_RGB[x][y].Blue = Clamp(b);
-
-            // Due to macro block padding this can be out of bounds
-            int xpos = x + xoff;
-            int ypos = y + yoff;
-            if (xpos < width && ypos < height)
+            for (int x = 0; x < width; x++)
             {
-
-                u16 pixel16Value = rgb888torgb565(Macroblock_RGB[x][y]);
-                // Actually is no alpha in FMVs
-                // pixelValue = (pixelValue << 8) + Macroblock_RGB[x][y].A
-                SetElement(xpos, ypos, width, height, pixelBuffer, pixel16Value, doubleWidth, doubleHeight);
+                if (x < 32 || y < 32)
+                {
+                    ASSERT_EQ(0xDEAD, screen[(y * width) + x]);
+                }
+                else
+                {
+                    const u16 expected = pixels[(((y - 32) / 2) * kMacroBlockWidth) + ((x - 32) / 2)];
+                    ASSERT_EQ(expected, screen[(y * width) + x]);
+                }
             }
         }
     }
+
+    void MasherTests()
+    {
+        Test_IdctMatchesScalar();
+        Test_ColourConversionMatchesScalar();
+        Test_BlitDoublesPixels();
+    }
 }
@@ -14,6 +14,15 @@ struct Movie_IO
 
 Movie_IO& GetMovieIO();
 
+namespace Test
+{
+    void MasherTests();
+}
+
+// Threads the idct and colour conversion of each movie frame is split over, 0 picks one per core up to 4
+// and 1 decodes on the calling thread only.
+extern int gMovieDecodeThreads;
+
 struct Masher_Header
 {
     int field_0_ddv_version;
@@ -100,26 +109,6 @@ public:
     // Same as 0x52899C in MGSI.exe
     static void* CC GetDecompressedAudioFrame_4EAC60(Masher* pMasher);
 private:
-    struct Macroblock_RGB_Struct
-    {
-        unsigned char Red;
-        unsigned char Green;
-        unsigned char Blue;
-        unsigned char A;
-    };
-
-    static int To1d(int x, int y);
-
-    static unsigned char Clamp(f32 v);
-
-
-    static void SetElement(int x, int y, int width, int height, u16* ptr, u16 value, bool doubleWidth, bool doubleHeight);
-
-    static uint16_t rgb888torgb565(Macroblock_RGB_Struct& rgb888Pixel);
-
-    static void ConvertYuvToRgbAndBlit(u16* pixelBuffer, int xoff, int yoff, int width, int height, bool doubleWidth, bool doubleHeight);
-
-
     void* field_0_file_handle;
 public:
     Masher_Header field_4_ddv_header;
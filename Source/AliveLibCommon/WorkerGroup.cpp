@@ -0,0 +1,73 @@
+#include "stdafx_common.h"
+#include "WorkerGroup.hpp"
+
+WorkerGroup::WorkerGroup(int count)
+{
+    for (int index = 1; index < count; index++)
+    {
+        mThreads.emplace_back(&WorkerGroup::WorkerThread, this, index);
+    }
+}
+
+WorkerGroup::~WorkerGroup()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mQuit = true;
+    }
+    mJobReady.notify_all();
+
+    for (std::thread& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerGroup::Run(const std::function<void(int)>& fnJob)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mpJob = &fnJob;
+        mJobId++;
+        mJobsRunning = static_cast<int>(mThreads.size());
+    }
+    mJobReady.notify_all();
+
+    fnJob(0);
+
+    std::unique_lock<std::mutex> lock(mLock);
+    mJobDone.wait(lock, [this]() { return mJobsRunning == 0; });
+    mpJob = nullptr;
+}
+
+void WorkerGroup::WorkerThread(int index)
+{
+    unsigned int lastJobId = 0;
+    for (;;)
+    {
+        const std::function<void(int)>* pJob = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mJobReady.wait(lock, [&]() { return mQuit || mJobId != lastJobId; });
+            if (mQuit)
+            {
+                return;
+            }
+            lastJobId = mJobId;
+            pJob = mpJob;
+        }
+
+        (*pJob)(index);
+
+        bool lastJob = false;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            lastJob = --mJobsRunning == 0;
+        }
+
+        if (lastJob)
+        {
+            mJobDone.notify_one();
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+// Runs a job once per index, the calling thread does index 0 and the rest are done by worker
+// threads that stay alive between jobs.
+class WorkerGroup
+{
+public:
+    explicit WorkerGroup(int count);
+    ~WorkerGroup();
+
+    int Count() const
+    {
+        return static_cast<int>(mThreads.size()) + 1;
+    }
+
+    // Calls fnJob(index) for every index below Count(), returns once they have all finished.
+    void Run(const std::function<void(int)>& fnJob);
+
+private:
+    void WorkerThread(int index);
+
+    std::vector<std::thread> mThreads;
+    std::mutex mLock;
+    std::condition_variable mJobReady;
+    std::condition_variable mJobDone;
+    const std::function<void(int)>* mpJob = nullptr;
+    unsigned int mJobId = 0;
+    int mJobsRunning = 0;
+    bool mQuit = false;
+};
@@ -10,6 +10,7 @@ option(XINPUT_SUPPORT "Adds XINPUT support to the game and replaces in game font
 option(USE_SDL2 "Use SDL2 instead of Win32 APIs." ON)
 option(USE_SDL2_SOUND "Use SDL2 for audio." ON)
 option(USE_SDL2_IO "Use SDL2 for all File/Stream IO." ON)
+option(FRAME_PROFILER "Time the phases of each frame when frame_profiler is set in the ini, F9 records a Chrome trace." ON)
 option(ORIGINAL_PS1_BEHAVIOR "Fixes bugs in the PSX Emu layer / Gameplay to match PS1 version of the game." ON)
 
 CONFIGURE_FILE(${CMAKE_CURRENT_SOURCE_DIR}/Source/config.h.in ${CMAKE_CURRENT_SOURCE_DIR}/Source/AliveLibCommon/config.h)